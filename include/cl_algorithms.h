@@ -0,0 +1,439 @@
+// sorting, selection and searching of arrays, specialized for each element type. Unlike qsort, which calls the
+// comparison through a function pointer for every pair, the comparison is inlined into each instantiation.
+//
+// declare_array_algorithms(name, type) declares and define_array_algorithms(name, type, less) defines the functions
+// name##_sort, name##_stable_sort, ... for arrays of type ordered by less(a, b). less takes two type * and is true if
+// *a goes strictly before *b. It is expanded in place, so it is best a macro, e.g. for an array of Records by key:
+//
+// #define RECORD_KEY_LESS(a, b) ((a)->key < (b)->key)
+// define_array_algorithms(Record_by_key, Record, RECORD_KEY_LESS)
+//
+// less must be a strict weak order. In particular, the instantiations for double and float below do not handle NaN
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h> // uintptr_t
+#include <limits.h> // CHAR_BIT
+#include <string.h>
+#include "cl_utils.h"
+
+#ifndef CL_ALGORITHMS_H
+#define CL_ALGORITHMS_H
+
+// ranges up to this size are insertion sorted
+#ifndef CL_SORT_INSERTION
+#define CL_SORT_INSERTION 24
+#endif
+
+// ranges above this size take the pivot as the pseudo median of 9 rather than the median of 3
+#ifndef CL_SORT_NINTHER
+#define CL_SORT_NINTHER 128
+#endif
+
+// elements up to this size are partitioned without branching on the comparison, moving every element once so that a
+// mispredicted comparison costs nothing. Larger elements are partitioned by swapping only the misplaced ones
+#ifndef CL_SORT_BRANCHLESS_SIZE
+#define CL_SORT_BRANCHLESS_SIZE 16
+#endif
+
+// the natural order of numeric types
+#define CL_LESS(a, b) (*(a) < *(b))
+
+#define declare_array_algorithms(name, type)                                        \
+/* introsort: quicksort falling back to heapsort, O(N log N) worst case, not stable */ \
+void name##_sort(type * arr, size_t num);                                           \
+/* merge sort, stable. buf must hold num elements */                                \
+void name##_stable_sort_buffered(type * arr, size_t num, type * buf);               \
+/* as stable_sort_buffered with a temporary buffer, CL_MALLOC_FAILURE if it cannot be allocated */ \
+enum cl_status name##_stable_sort(type * arr, size_t num);                          \
+/* the smallest k elements to the front of arr in order, the rest in no particular order. O(N + k log k) */ \
+void name##_partial_sort(type * arr, size_t k, size_t num);                         \
+/* the element that would be at nth if arr were sorted to nth, with no greater element before it and no smaller */ \
+/* after it. O(N) on average. Returns arr + nth, NULL if nth >= num */              \
+type * name##_nth_element(type * arr, size_t nth, size_t num);                      \
+/* on a sorted array, the first element not before value, arr + num if there is none */ \
+type * name##_lower_bound(type * arr, size_t num, type * value);                    \
+/* on a sorted array, the first element after value, arr + num if there is none */  \
+type * name##_upper_bound(type * arr, size_t num, type * value);                    \
+/* on a sorted array, the first element equal to value, NULL if there is none */    \
+type * name##_binary_search(type * arr, size_t num, type * value);                  \
+bool name##_is_sorted(type * arr, size_t num);                                      \
+
+#define define_array_algorithms(name, type, less)                                   \
+static inline void name##_swap(type * a, type * b) {                                \
+    type tmp = *a;                                                                  \
+    *a = *b;                                                                        \
+    *b = tmp;                                                                       \
+}                                                                                   \
+static void name##_insertion_sort(type * arr, size_t num) {                         \
+    for (size_t i = 1; i < num; i++) {                                              \
+        if (less(arr + i, arr + i - 1)) {                                           \
+            type tmp = arr[i];                                                      \
+            size_t j = i;                                                           \
+            do {                                                                    \
+                arr[j] = arr[j-1];                                                  \
+                j--;                                                                \
+            } while (j && less(&tmp, arr + j - 1));                                 \
+            arr[j] = tmp;                                                           \
+        }                                                                           \
+    }                                                                               \
+}                                                                                   \
+static void name##_sift_down(type * arr, size_t root, size_t num) {                 \
+    type tmp = arr[root];                                                           \
+    size_t child;                                                                   \
+    while ((child = 2 * root + 1) < num) {                                          \
+        if (child + 1 < num && less(arr + child, arr + child + 1)) {                \
+            child++;                                                                \
+        }                                                                           \
+        if (!less(&tmp, arr + child)) {                                             \
+            break;                                                                  \
+        }                                                                           \
+        arr[root] = arr[child];                                                     \
+        root = child;                                                               \
+    }                                                                               \
+    arr[root] = tmp;                                                                \
+}                                                                                   \
+static void name##_heap_sort(type * arr, size_t num) {                              \
+    for (size_t i = num / 2; i-- > 0;) {                                            \
+        name##_sift_down(arr, i, num);                                              \
+    }                                                                               \
+    for (size_t i = num; i-- > 1;) {                                                \
+        name##_swap(arr, arr + i);                                                  \
+        name##_sift_down(arr, 0, i);                                                \
+    }                                                                               \
+}                                                                                   \
+/* orders *a, *b, *c */                                                             \
+static inline void name##_sort3(type * a, type * b, type * c) {                     \
+    if (less(b, a)) {                                                               \
+        name##_swap(a, b);                                                          \
+    }                                                                               \
+    if (less(c, b)) {                                                               \
+        name##_swap(b, c);                                                          \
+        if (less(b, a)) {                                                           \
+            name##_swap(a, b);                                                      \
+        }                                                                           \
+    }                                                                               \
+}                                                                                   \
+/* moves the pivot to arr[0] */                                                     \
+static void name##_choose_pivot(type * arr, size_t num) {                           \
+    size_t mid = num / 2;                                                           \
+    if (num > CL_SORT_NINTHER) {                                                    \
+        name##_sort3(arr, arr + mid, arr + num - 1);                                \
+        name##_sort3(arr + 1, arr + mid - 1, arr + num - 2);                        \
+        name##_sort3(arr + 2, arr + mid + 1, arr + num - 3);                        \
+        name##_sort3(arr + mid - 1, arr + mid, arr + mid + 1);                      \
+        name##_swap(arr, arr + mid);                                                \
+    } else {                                                                        \
+        name##_sort3(arr + mid, arr, arr + num - 1);                                \
+    }                                                                               \
+}                                                                                   \
+/* partitions around the pivot at arr[0] and returns its final index p. The elements before p go before the pivot */ \
+/* or, with equal_left, do not go after it. The elements after p do not go before it, or go after it */ \
+static size_t name##_partition(type * arr, size_t num, bool equal_left) {           \
+    type pivot = arr[0];                                                            \
+    size_t lt = 1;                                                                  \
+    if (sizeof(type) <= CL_SORT_BRANCHLESS_SIZE) {                                  \
+        /* [1, lt) belong left and [lt, i) right. arr[i] is swapped to lt and the boundary moves past it if it */ \
+        /* belongs left, otherwise the element it displaced goes back to i on the right */ \
+        for (size_t i = 1; i < num; i++) {                                          \
+            type tmp = arr[i];                                                      \
+            arr[i] = arr[lt];                                                       \
+            arr[lt] = tmp;                                                          \
+            lt += equal_left ? !less(&pivot, &tmp) : less(&tmp, &pivot);            \
+        }                                                                           \
+    } else {                                                                        \
+        size_t i = 1, j = num - 1;                                                  \
+        while (true) {                                                              \
+            while (i <= j && (equal_left ? !less(&pivot, arr + i) : less(arr + i, &pivot))) { \
+                i++;                                                                \
+            }                                                                       \
+            while (i <= j && !(equal_left ? !less(&pivot, arr + j) : less(arr + j, &pivot))) { \
+                j--;                                                                \
+            }                                                                       \
+            if (i >= j) {                                                           \
+                break;                                                              \
+            }                                                                       \
+            name##_swap(arr + i++, arr + j--);                                      \
+        }                                                                           \
+        lt = i;                                                                     \
+    }                                                                               \
+    name##_swap(arr, arr + lt - 1);                                                 \
+    return lt - 1;                                                                  \
+}                                                                                   \
+/* unless leftmost, arr[-1] does not go after any element of the range. If it also does not go before the pivot, */ \
+/* no element goes before the pivot, so the elements equal to it are split off in one pass and not visited again */ \
+static void name##_introsort(type * arr, size_t num, size_t depth, bool leftmost) { \
+    while (num > CL_SORT_INSERTION) {                                               \
+        if (!depth--) {                                                             \
+            name##_heap_sort(arr, num);                                             \
+            return;                                                                 \
+        }                                                                           \
+        name##_choose_pivot(arr, num);                                              \
+        if (!leftmost && !less(arr - 1, arr)) {                                     \
+            size_t p = name##_partition(arr, num, true);                            \
+            arr += p + 1;                                                           \
+            num -= p + 1;                                                           \
+            continue;                                                               \
+        }                                                                           \
+        size_t p = name##_partition(arr, num, false);                               \
+        if (p < num - p - 1) { /* recurse into the smaller part */                  \
+            name##_introsort(arr, p, depth, leftmost);                              \
+            arr += p + 1;                                                           \
+            num -= p + 1;                                                           \
+            leftmost = false;                                                       \
+        } else {                                                                    \
+            name##_introsort(arr + p + 1, num - p - 1, depth, false);               \
+            num = p;                                                                \
+        }                                                                           \
+    }                                                                               \
+    name##_insertion_sort(arr, num);                                                \
+}                                                                                   \
+static size_t name##_depth_limit(size_t num) {                                      \
+    size_t depth = 0;                                                               \
+    while (num >>= 1) {                                                             \
+        depth += 2;                                                                 \
+    }                                                                               \
+    return depth;                                                                   \
+}                                                                                   \
+void name##_sort(type * arr, size_t num) {                                          \
+    if (!arr || num < 2) {                                                          \
+        return;                                                                     \
+    }                                                                               \
+    name##_introsort(arr, num, name##_depth_limit(num), true);                      \
+}                                                                                   \
+static void name##_merge(type * src, size_t lo, size_t mid, size_t hi, type * dest) { \
+    size_t i = lo, j = mid, k = lo;                                                 \
+    while (i < mid && j < hi) {                                                     \
+        dest[k++] = less(src + j, src + i) ? src[j++] : src[i++];                   \
+    }                                                                               \
+    memcpy(dest + k, src + i, sizeof(type) * (mid - i));                            \
+    k += mid - i;                                                                   \
+    memcpy(dest + k, src + j, sizeof(type) * (hi - j));                             \
+}                                                                                   \
+void name##_stable_sort_buffered(type * arr, size_t num, type * buf) {              \
+    if (!arr || num < 2) {                                                          \
+        return;                                                                     \
+    }                                                                               \
+    for (size_t lo = 0; lo < num; lo += CL_SORT_INSERTION) {                        \
+        name##_insertion_sort(arr + lo, (num - lo > CL_SORT_INSERTION) ? CL_SORT_INSERTION : num - lo); \
+    }                                                                               \
+    /* bottom-up merges alternating between arr and buf */                          \
+    type * src = arr, * dest = buf;                                                 \
+    for (size_t width = CL_SORT_INSERTION; width < num; width <<= 1) {              \
+        for (size_t lo = 0; lo < num; lo += 2 * width) {                            \
+            size_t mid = (num - lo > width) ? lo + width : num;                     \
+            size_t hi = (num - mid > width) ? mid + width : num;                    \
+            name##_merge(src, lo, mid, hi, dest);                                   \
+        }                                                                           \
+        type * tmp = src;                                                           \
+        src = dest;                                                                 \
+        dest = tmp;                                                                 \
+    }                                                                               \
+    if (src != arr) {                                                               \
+        memcpy(arr, src, sizeof(type) * num);                                       \
+    }                                                                               \
+}                                                                                   \
+enum cl_status name##_stable_sort(type * arr, size_t num) {                         \
+    if (num <= CL_SORT_INSERTION) { /* no merging necessary */                      \
+        name##_stable_sort_buffered(arr, num, NULL);                                \
+        return CL_SUCCESS;                                                          \
+    }                                                                               \
+    type * buf = (type *) CL_MALLOC(sizeof(type) * num);                            \
+    if (!buf) {                                                                     \
+        return CL_MALLOC_FAILURE;                                                   \
+    }                                                                               \
+    name##_stable_sort_buffered(arr, num, buf);                                     \
+    CL_FREE(buf);                                                                   \
+    return CL_SUCCESS;                                                              \
+}                                                                                   \
+type * name##_nth_element(type * arr, size_t nth, size_t num) {                     \
+    if (!arr || nth >= num) {                                                       \
+        return NULL;                                                                \
+    }                                                                               \
+    type * base = arr;                                                              \
+    size_t n = num, k = nth, depth = name##_depth_limit(num);                       \
+    bool leftmost = true;                                                           \
+    while (n > CL_SORT_INSERTION) {                                                 \
+        if (!depth--) {                                                             \
+            name##_heap_sort(base, n);                                              \
+            return arr + nth;                                                       \
+        }                                                                           \
+        name##_choose_pivot(base, n);                                               \
+        if (!leftmost && !less(base - 1, base)) { /* see introsort */               \
+            size_t p = name##_partition(base, n, true);                             \
+            if (k <= p) { /* all equal to the pivot */                              \
+                return arr + nth;                                                   \
+            }                                                                       \
+            base += p + 1;                                                          \
+            n -= p + 1;                                                             \
+            k -= p + 1;                                                             \
+            continue;                                                               \
+        }                                                                           \
+        size_t p = name##_partition(base, n, false);                                \
+        if (k == p) {                                                               \
+            return arr + nth;                                                       \
+        }                                                                           \
+        if (k < p) {                                                                \
+            n = p;                                                                  \
+        } else {                                                                    \
+            base += p + 1;                                                          \
+            n -= p + 1;                                                             \
+            k -= p + 1;                                                             \
+            leftmost = false;                                                       \
+        }                                                                           \
+    }                                                                               \
+    name##_insertion_sort(base, n);                                                 \
+    return arr + nth;                                                               \
+}                                                                                   \
+void name##_partial_sort(type * arr, size_t k, size_t num) {                        \
+    if (!arr || !k) {                                                               \
+        return;                                                                     \
+    }                                                                               \
+    if (k > num) {                                                                  \
+        k = num;                                                                    \
+    }                                                                               \
+    name##_nth_element(arr, k - 1, num);                                            \
+    name##_sort(arr, k - 1);                                                        \
+}                                                                                   \
+type * name##_lower_bound(type * arr, size_t num, type * value) {                   \
+    if (!arr || !num) {                                                             \
+        return arr;                                                                 \
+    }                                                                               \
+    /* the answer stays in [arr, arr + num]. Halving without a branch on the comparison compiles to a cmov */ \
+    while (num > 1) {                                                               \
+        size_t half = num / 2;                                                      \
+        arr = less(arr + half - 1, value) ? arr + half : arr;                       \
+        num -= half;                                                                \
+    }                                                                               \
+    return arr + less(arr, value);                                                  \
+}                                                                                   \
+type * name##_upper_bound(type * arr, size_t num, type * value) {                   \
+    if (!arr || !num) {                                                             \
+        return arr;                                                                 \
+    }                                                                               \
+    while (num > 1) {                                                               \
+        size_t half = num / 2;                                                      \
+        arr = !less(value, arr + half - 1) ? arr + half : arr;                      \
+        num -= half;                                                                \
+    }                                                                               \
+    return arr + !less(value, arr);                                                 \
+}                                                                                   \
+type * name##_binary_search(type * arr, size_t num, type * value) {                 \
+    type * found = name##_lower_bound(arr, num, value);                             \
+    return (found && found < arr + num && !less(value, found)) ? found : NULL;      \
+}                                                                                   \
+bool name##_is_sorted(type * arr, size_t num) {                                     \
+    for (size_t i = 1; i < num; i++) {                                              \
+        if (less(arr + i, arr + i - 1)) {                                           \
+            return false;                                                           \
+        }                                                                           \
+    }                                                                               \
+    return true;                                                                    \
+}                                                                                   \
+
+declare_array_algorithms(double, double)
+declare_array_algorithms(float, float)
+declare_array_algorithms(long, long)
+declare_array_algorithms(int, int)
+declare_array_algorithms(size_t, size_t)
+
+// bits per digit of the radix sorts. 11 bits sort 64 bit keys in 6 passes and 32 bit keys in 3 with a table of counts
+// that still fits in the L1 cache. 8 bits take more passes over smaller tables
+#ifndef CL_RADIX_BITS
+#define CL_RADIX_BITS 11
+#endif
+
+#define CL_RADIX_BUCKETS ((size_t) 1 << CL_RADIX_BITS)
+#define CL_RADIX_PASSES(key_type) ((sizeof(key_type) * CHAR_BIT + CL_RADIX_BITS - 1) / CL_RADIX_BITS)
+// number of counts of the histogram of a radix sort on key_type
+#define CL_RADIX_HIST_LEN(key_type) (CL_RADIX_PASSES(key_type) * CL_RADIX_BUCKETS)
+
+// key of a signed integer whose unsigned order is the signed order
+#define CL_RADIX_SIGNED_KEY(key_type, a) ((key_type) *(a) ^ ((key_type) 1 << (sizeof(key_type) * CHAR_BIT - 1)))
+
+// LSD radix sort of arrays of type by key(a), an unsigned integer of key_type for each type * a, from the least to the most
+// significant digit of CL_RADIX_BITS. Stable and O(N * CL_RADIX_PASSES(key_type)) regardless of the keys. Passes in
+// which all keys share the digit are skipped
+#define declare_array_radix_sort(name, type)                                        \
+/* adds the counts of the digits of the keys of arr to hist of CL_RADIX_HIST_LEN(key_type) counts. The histograms */ \
+/* of separate parts of an array add up to that of the array, so they can be computed in parallel */ \
+void name##_radix_histogram(type * arr, size_t num, size_t * hist);                 \
+/* buf holds num elements and hist the histogram of arr, which is overwritten */    \
+void name##_radix_sort_buffered(type * arr, size_t num, type * buf, size_t * hist); \
+/* as radix_sort_buffered with temporary buffers, CL_MALLOC_FAILURE if they cannot be allocated */ \
+enum cl_status name##_radix_sort(type * arr, size_t num);                           \
+
+#define define_array_radix_sort(name, type, key_type, key)                          \
+void name##_radix_histogram(type * arr, size_t num, size_t * hist) {                \
+    for (size_t i = 0; i < num; i++) {                                              \
+        key_type k = key(arr + i);                                                  \
+        for (size_t pass = 0; pass < CL_RADIX_PASSES(key_type); pass++) {           \
+            hist[pass * CL_RADIX_BUCKETS + ((k >> (pass * CL_RADIX_BITS)) & (CL_RADIX_BUCKETS - 1))]++; \
+        }                                                                           \
+    }                                                                               \
+}                                                                                   \
+void name##_radix_sort_buffered(type * arr, size_t num, type * buf, size_t * hist) { \
+    if (!arr || num < 2) {                                                          \
+        return;                                                                     \
+    }                                                                               \
+    type * src = arr, * dest = buf;                                                 \
+    for (size_t pass = 0; pass < CL_RADIX_PASSES(key_type); pass++) {               \
+        size_t * count = hist + pass * CL_RADIX_BUCKETS;                            \
+        size_t shift = pass * CL_RADIX_BITS;                                        \
+        if (count[(key(src) >> shift) & (CL_RADIX_BUCKETS - 1)] == num) {           \
+            continue; /* the keys all have the same digit */                        \
+        }                                                                           \
+        size_t offset = 0;                                                          \
+        for (size_t d = 0; d < CL_RADIX_BUCKETS; d++) {                             \
+            size_t c = count[d];                                                    \
+            count[d] = offset;                                                      \
+            offset += c;                                                            \
+        }                                                                           \
+        for (size_t i = 0; i < num; i++) {                                          \
+            dest[count[(key(src + i) >> shift) & (CL_RADIX_BUCKETS - 1)]++] = src[i]; \
+        }                                                                           \
+        type * tmp = src;                                                           \
+        src = dest;                                                                 \
+        dest = tmp;                                                                 \
+    }                                                                               \
+    if (src != arr) {                                                               \
+        memcpy(arr, src, sizeof(type) * num);                                       \
+    }                                                                               \
+}                                                                                   \
+enum cl_status name##_radix_sort(type * arr, size_t num) {                          \
+    if (!arr || num < 2) {                                                          \
+        return CL_SUCCESS;                                                          \
+    }                                                                               \
+    type * buf = (type *) CL_MALLOC(sizeof(type) * num);                            \
+    size_t * hist = (size_t *) CL_MALLOC(sizeof(size_t) * CL_RADIX_HIST_LEN(key_type)); \
+    if (!buf || !hist) {                                                            \
+        CL_FREE(buf);                                                               \
+        CL_FREE(hist);                                                              \
+        return CL_MALLOC_FAILURE;                                                   \
+    }                                                                               \
+    memset(hist, 0, sizeof(size_t) * CL_RADIX_HIST_LEN(key_type));                  \
+    name##_radix_histogram(arr, num, hist);                                         \
+    name##_radix_sort_buffered(arr, num, buf, hist);                                \
+    CL_FREE(buf);                                                                   \
+    CL_FREE(hist);                                                                  \
+    return CL_SUCCESS;                                                              \
+}                                                                                   \
+
+// keys of the pre-defined radix sorts
+#define CL_RADIX_SIZE_T_KEY(a) (*(a))
+#define CL_RADIX_LONG_KEY(a) CL_RADIX_SIGNED_KEY(unsigned long, a)
+#define CL_RADIX_INT_KEY(a) CL_RADIX_SIGNED_KEY(unsigned int, a)
+#define CL_RADIX_PVOID_KEY(a) ((uintptr_t) *(a))
+
+declare_array_radix_sort(size_t, size_t)
+declare_array_radix_sort(long, long)
+declare_array_radix_sort(int, int)
+declare_array_radix_sort(pvoid, pvoid)
+
+// MSD radix sort of C strings in strcmp order, one byte at a time from the first. Buckets of strings are split until
+// they are small enough to insertion sort, so only the distinguishing prefixes of long keys are read. buf holds num
+// pointers
+void cstr_radix_sort_buffered(char ** arr, size_t num, char ** buf);
+enum cl_status cstr_radix_sort(char ** arr, size_t num);
+
+#endif // CL_ALGORITHMS_H
@@ -1,9 +1,22 @@
+// binary search tree of nodes stored by position in an array: the children of index i are at 2i + 1 and 2i + 2
 #include <stddef.h>
+#include <stdarg.h>
+#include "cl_node.h"
+#include "cl_tree_utils.h"
+#include "cl_circular_buffer.h"
 
 #ifndef CL_ARRAY_BINARY_TREE_H
 #define CL_ARRAY_BINARY_TREE_H
 
-typedef struct ArrayBinaryTree ArrayBinaryTree;
+typedef struct ArrayBinaryTree {
+    Node ** nodes;      // NULL where there is no node
+    size_t capacity;
+    NodeAttributes * NA;
+    size_t size;        // extent of the array in use: one past the last index that may hold a node
+    int (*compare) (Node_type(KEY), Node_type(KEY));
+    Node * block;       // nodes allocated together by ArrayBinaryTree_build_from_sorted. NULL if none
+    Node * block_end;
+} ArrayBinaryTree;
 
 enum abt_status {
 	ABT_SUCCESS = 0,
@@ -13,4 +26,33 @@ enum abt_status {
 	ABT_INDEX_OUT_OF_BOUNDS = -10,
 };
 
-#endif // CL_ARRAY_BINARY_TREE_H
\ No newline at end of file
+ArrayBinaryTree * ArrayBinaryTree_new(size_t capacity, int (*compare) (Node_type(KEY), Node_type(KEY)), unsigned int node_flags, int narg_pairs, ...);
+ArrayBinaryTree * vArrayBinaryTree_new(size_t capacity, int (*compare) (Node_type(KEY), Node_type(KEY)), unsigned int node_flags, int narg_pairs, va_list args);
+// abt->nodes must have capacity elements
+void ArrayBinaryTree_init(ArrayBinaryTree * abt, size_t capacity, int (*compare) (Node_type(KEY), Node_type(KEY)), NodeAttributes * NA);
+void ArrayBinaryTree_del(ArrayBinaryTree * abt);
+size_t ArrayBinaryTree_size(ArrayBinaryTree * abt);
+size_t ArrayBinaryTree_subtree_size(ArrayBinaryTree * abt, size_t index);
+size_t ArrayBinaryTree_diameter(ArrayBinaryTree * abt, size_t index);
+size_t ArrayBinaryTree_depth(ArrayBinaryTree * abt, size_t index);
+size_t ArrayBinaryTree_height(ArrayBinaryTree * abt, size_t index);
+size_t ArrayBinaryTree_approx_height(ArrayBinaryTree * abt);
+
+// moves the subtree at root so that it is rooted at target, which must be empty apart from nodes of that subtree
+int ArrayBinaryTree_move_subtree(ArrayBinaryTree * abt, size_t root, size_t target);
+// ABT_FAILURE if there is no node at index or no child to lift into it
+int ArrayBinaryTree_rotate(ArrayBinaryTree * abt, size_t index, int dir);
+int ArrayBinaryTree_split_rotate(ArrayBinaryTree * abt, size_t index, int dir);
+
+// replaces the contents of abt with a complete tree of the sorted keys in O(N). values may be NULL
+int ArrayBinaryTree_build_from_sorted(ArrayBinaryTree * abt, Node_type(KEY) * keys, void ** values, size_t num);
+
+// index of the leftmost/rightmost node of the subtree at index. abt->size if there is no node at index
+size_t ArrayBinaryTree_leftmost(ArrayBinaryTree * abt, size_t index);
+size_t ArrayBinaryTree_rightmost(ArrayBinaryTree * abt, size_t index);
+// index of the node with key by binary search. abt->size if key is not found
+size_t ArrayBinaryTree_find(ArrayBinaryTree * abt, Node_type(KEY) key);
+// fills path with the indices from the root to the node with key. ABT_FAILURE if key is not found
+int ArrayBinaryTree_path_to(CircularBuffer * path, ArrayBinaryTree * abt, Node_type(KEY) key);
+
+#endif // CL_ARRAY_BINARY_TREE_H
@@ -0,0 +1,97 @@
+// B+ tree used as an ordered map of KEY to VALUE with unique keys
+// https://en.wikipedia.org/wiki/B%2B_tree
+// keys are packed in sorted arrays so that a search touches a few cache lines per level rather than one node per
+// comparison as in LinkedBinaryTree. Values live only in the leaves, which are linked in key order for range scans.
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "cl_core.h"
+#include "cl_node.h"
+#include "cl_tree_utils.h"
+
+#ifndef CL_BTREE_H
+#define CL_BTREE_H
+
+// maximum number of keys in a node. Must be at least 4. The default fills the key array of a node with 4 cache lines
+// of 64 bytes on 64-bit systems
+#ifndef BTREE_MAX_KEYS
+#define BTREE_MAX_KEYS 32
+#endif
+
+// all nodes but the root have at least this many keys
+#define BTREE_MIN_KEYS (BTREE_MAX_KEYS / 2)
+
+typedef struct BTreeNode {
+    unsigned int nkeys;
+    bool leaf;
+    Node_type(KEY) keys[BTREE_MAX_KEYS];
+} BTreeNode;
+
+// separator keys[i] is the smallest key in the subtree at children[i+1]
+typedef struct BTreeInner {
+    BTreeNode node;
+    BTreeNode * children[BTREE_MAX_KEYS + 1];
+} BTreeInner;
+
+typedef struct BTreeLeaf {
+    BTreeNode node;
+    void * values[BTREE_MAX_KEYS];
+    struct BTreeLeaf * prev;
+    struct BTreeLeaf * next;
+} BTreeLeaf;
+
+// inserting an existing key fails unless flags include TREE_MOD_UPDATE, in which case the value is replaced
+typedef struct BTree {
+    BTreeNode * root;
+    BTreeLeaf * first;
+    BTreeLeaf * last;
+    size_t size;
+    size_t height;
+    int (*compare) (Node_type(KEY), Node_type(KEY));
+    TREE_FLAG_TYPE flags;
+} BTree;
+
+typedef struct BTreeIterator {
+    BTree * bt;
+    BTreeLeaf * leaf;
+    unsigned int index;
+    Node_type(KEY) end_key;
+    enum iterator_status stop;
+} BTreeIterator, BTreeIteratorIterator, BTreeKeyIterator;
+
+BTree * BTree_new(int (*compare) (Node_type(KEY), Node_type(KEY)), TREE_FLAG_TYPE flags);
+void BTree_init(BTree * bt, int (*compare) (Node_type(KEY), Node_type(KEY)), TREE_FLAG_TYPE flags);
+void BTree_del(BTree * bt);
+// removes all elements
+void BTree_clear(BTree * bt);
+size_t BTree_size(BTree * bt);
+bool BTree_is_empty(BTree * bt);
+
+// All O(log N)
+enum cl_status BTree_insert(BTree * bt, Node_type(KEY) key, void * value);
+void * BTree_get(BTree * bt, Node_type(KEY) key);
+bool BTree_contains(BTree * bt, Node_type(KEY) key);
+// returns CL_FAILURE if key is not found
+enum cl_status BTree_erase(BTree * bt, Node_type(KEY) key);
+// returns the value of the removed key or NULL if key is not found
+void * BTree_pop(BTree * bt, Node_type(KEY) key);
+// NULL if empty
+Node_type(KEY) BTree_min(BTree * bt);
+Node_type(KEY) BTree_max(BTree * bt);
+
+//Iterators. Values are returned in key order
+void BTreeIterator_init(BTreeIterator * bt_iter, BTree * bt);
+// iterates over keys in [start_key, end_key). A NULL start_key or end_key leaves that side unbounded
+void BTreeIterator_init_range(BTreeIterator * bt_iter, BTree * bt, Node_type(KEY) start_key, Node_type(KEY) end_key);
+void * BTreeIterator_next(BTreeIterator * bt_iter);
+// key of the element last returned by next
+Node_type(KEY) BTreeIterator_key(BTreeIterator * bt_iter);
+enum iterator_status BTreeIterator_stop(BTreeIterator * bt_iter);
+void BTreeIteratorIterator_init(BTreeIteratorIterator * bt_iter_iter, BTreeIterator * bt_iter);
+void * BTreeIteratorIterator_next(BTreeIteratorIterator * bt_iter);
+enum iterator_status BTreeIteratorIterator_stop(BTreeIteratorIterator * bt_iter);
+void BTreeKeyIterator_init(BTreeKeyIterator * key_iter, BTree * bt);
+Node_type(KEY) BTreeKeyIterator_next(BTreeKeyIterator * key_iter);
+enum iterator_status BTreeKeyIterator_stop(BTreeKeyIterator * key_iter);
+
+#endif // CL_BTREE_H
@@ -62,7 +62,15 @@ CircularBufferIterator * CircularBufferIterator_new(CircularBuffer * cb);
 void CircularBufferIterator_del(CircularBufferIterator * cb_iter);
 void CircularBufferIterator_init(CircularBufferIterator * cb_iter, CircularBuffer * cb);
 void * CircularBufferIterator_next(CircularBufferIterator * cb_iter);
+// copies contiguous runs of the buffer directly
+size_t CircularBufferIterator_next_n(CircularBufferIterator * cb_iter, void ** out, size_t max);
 enum iterator_status CircularBufferIterator_stop(CircularBufferIterator * cb_iter);
+// halves the remaining range by index. grain is in elements
+bool CircularBufferIterator_split(CircularBufferIterator * cb_iter, CircularBufferIterator * other, size_t grain);
+// O(1)
+size_t CircularBufferIterator_advance(CircularBufferIterator * cb_iter, size_t n);
+// exact
+size_t CircularBufferIterator_size_hint(CircularBufferIterator * cb_iter);
 
 void CircularBufferIteratorIterator_init(CircularBufferIteratorIterator * cb_iter_iter, CircularBufferIterator * cb_iter);
 void * CircularBufferIteratorIterator_next(CircularBufferIteratorIterator * cb_iter);
@@ -77,6 +85,8 @@ enum cl_status CircularBuffer_insert(CircularBuffer * cb, size_t ptr_index, void
 void * CircularBuffer_pop_front(CircularBuffer * cb);
 void * CircularBuffer_pop_back(CircularBuffer * cb);
 void * CircularBuffer_remove(CircularBuffer * cb, size_t index);
+// stable sort in ascending order of comp. Realigns the buffer so that head is at 0 and it is no longer reversed
+enum cl_status CircularBuffer_sort(CircularBuffer * cb, int (*comp)(void*, void*));
 //CircularBufferIterator * CircularBuffer_slice(CircularBuffer *, size_t, size_t, long long);
 
 // TODO: provide backward version implementation of _CircularBuffer_index_map_fwd
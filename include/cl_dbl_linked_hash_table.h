@@ -27,11 +27,16 @@ typedef LinkedHashTable DblLinkedHashTable;
 typedef LinkedHashTableKeyIterator DblLinkedHashTableKeyIterator;
 typedef LinkedHashTableItemIterator DblLinkedHashTableItemIterator;
 typedef LinkedHashTableValueIterator DblLinkedHashTableValueIterator;
+typedef LinkedHashTableBinIterator DblLinkedHashTableBinIterator;
 
 DblLinkedHashTable * DblLinkedHashTable_new(hash_t (*hash) (const void *, size_t), int (*comp) (const void *, const void *), size_t capacity, float max_load_factor, unsigned int flags, int narg_pairs, ...);
 void DblLinkedHashTable_init(DblLinkedHashTable * hash_table, hash_t (*hash) (const void *, size_t), int (*comp) (const void *, const void *), size_t capacity, float max_load_factor, NodeAttributes * NA);
 void DblLinkedHashTable_del(DblLinkedHashTable * hash_table);
 int DblLinkedHashTable_set(DblLinkedHashTable * hash_table, void * key, void * value);
+// as LinkedHashTable_upsert and LinkedHashTable_aggregate, which must not be used on a DblLinkedHashTable because they
+// leave the PREV_INORDER links of new nodes unset
+void ** DblLinkedHashTable_upsert(DblLinkedHashTable * hash_table, void * key, bool * inserted);
+int DblLinkedHashTable_aggregate(DblLinkedHashTable * hash_table, void * iter, void * (*next)(void*), enum iterator_status (*stop)(void*), void * (*key)(void * element, void * ctx), int (*accumulate)(void ** value, void * element, void * ctx), void * ctx);
 //DoubleLinkedHashNode * DblLinkedHashTable_get_node(DblLinkedHashTable * hash_table, void * key);
 void * DblLinkedHashTable_get(DblLinkedHashTable * hash_table, void * key);
 bool DblLinkedHashTable_contains(DblLinkedHashTable * hash_table, void * key);
@@ -57,8 +62,18 @@ void DblLinkedHashTableItemIterator_del(DblLinkedHashTableItemIterator * item_it
 const void * DblLinkedHashTableKeyIterator_next(DblLinkedHashTableKeyIterator * key_iter);
 void * DblLinkedHashTableValueIterator_next(DblLinkedHashTableValueIterator * value_iter);
 DictItem * DblLinkedHashTableItemIterator_next(DblLinkedHashTableItemIterator * item_iter);
+size_t DblLinkedHashTableKeyIterator_next_n(DblLinkedHashTableKeyIterator * key_iter, const void ** out, size_t max);
+size_t DblLinkedHashTableValueIterator_next_n(DblLinkedHashTableValueIterator * value_iter, void ** out, size_t max);
 enum iterator_status DblLinkedHashTableKeyIterator_stop(DblLinkedHashTableKeyIterator * key_iter);
 enum iterator_status DblLinkedHashTableValueIterator_stop(DblLinkedHashTableValueIterator * value_iter);
 enum iterator_status DblLinkedHashTableItemIterator_stop(DblLinkedHashTableItemIterator * item_iter);
+size_t DblLinkedHashTableKeyIterator_size_hint(DblLinkedHashTableKeyIterator * key_iter);
+size_t DblLinkedHashTableValueIterator_size_hint(DblLinkedHashTableValueIterator * value_iter);
+size_t DblLinkedHashTableItemIterator_size_hint(DblLinkedHashTableItemIterator * item_iter);
+
+void DblLinkedHashTableBinIterator_init(DblLinkedHashTableBinIterator * bin_iter, DblLinkedHashTable * hash_table);
+DictItem * DblLinkedHashTableBinIterator_next(DblLinkedHashTableBinIterator * bin_iter);
+enum iterator_status DblLinkedHashTableBinIterator_stop(DblLinkedHashTableBinIterator * bin_iter);
+bool DblLinkedHashTableBinIterator_split(DblLinkedHashTableBinIterator * bin_iter, DblLinkedHashTableBinIterator * other, size_t grain);
 
 #endif // DBL_LINKED_HASH_TABLE_H
@@ -17,9 +17,18 @@ typedef struct DblLinkedListIterator {
     enum iterator_status stop;
 } DblLinkedListIterator, DblLinkedListIteratorIterator;
 
+// a position in a DblLinkedList for sequential edits in O(1) each. node == NULL is the position past the back of the 
+// list, which behaves as if the list were circular: advancing from it is not possible, retreating goes to the back, 
+// inserting before it pushes back and inserting after it pushes front. Respects reversal of the list
+typedef struct DblLinkedListCursor {
+    DblLinkedList * dll;
+    Node * node;
+    size_t index;
+} DblLinkedListCursor;
+
 DblLinkedList * DblLinkedList_new(unsigned int flags, int narg_pairs, ...);
 void DblLinkedList_init(DblLinkedList * dll, NodeAttributes * NA);
-extern const void (*DblLinkedList_del)(DblLinkedList * dll);
+extern void (*DblLinkedList_del)(DblLinkedList * dll);
 void DblLinkedList_reverse(DblLinkedList * dll);
 
 extern size_t (*DblLinkedList_size)(DblLinkedList *);
@@ -41,9 +50,39 @@ void * DblLinkedList_remove(DblLinkedList * dll, size_t loc);
 void * DblLinkedList_pop_front(DblLinkedList * dll);
 void * DblLinkedList_pop_back(DblLinkedList * dll);
 
+// moves the nodes [first, last) of src in front of dest_pos in dest. dest_pos == NULL moves them to the back of dest and
+// last == NULL moves through the back of src. dest and src may be the same list if dest_pos is not in [first, last)
+// relinking is O(1) but counting the moved nodes is O(K). Reversed lists are fully reversed first (TRO)
+enum cl_status DblLinkedList_splice(DblLinkedList * dest, Node * dest_pos, DblLinkedList * src, Node * first, Node * last);
+// same as DblLinkedList_splice when the number of nodes in [first, last) is already known, e.g. from cursor indices. O(1)
+enum cl_status DblLinkedList_splice_n(DblLinkedList * dest, Node * dest_pos, DblLinkedList * src, Node * first, Node * last, size_t count);
+// moves node and all nodes after it in dll to the back of dest
+enum cl_status DblLinkedList_split_at(DblLinkedList * dll, Node * node, DblLinkedList * dest);
+
+// stable merge sort in ascending order of comp. A reversed list is first physically reversed so that the result is forward
+enum cl_status DblLinkedList_sort(DblLinkedList * dll, int (*comp)(void*, void*));
+
+// Cursor
+// places the cursor at index. index == size places it past the back. Search is from the closer end
+void DblLinkedListCursor_init(DblLinkedListCursor * cursor, DblLinkedList * dll, size_t index);
+void * DblLinkedListCursor_get(DblLinkedListCursor * cursor);
+size_t DblLinkedListCursor_index(DblLinkedListCursor * cursor);
+bool DblLinkedListCursor_advance(DblLinkedListCursor * cursor);
+bool DblLinkedListCursor_retreat(DblLinkedListCursor * cursor);
+// the cursor stays on the same element
+enum cl_status DblLinkedListCursor_insert_before(DblLinkedListCursor * cursor, void * val);
+enum cl_status DblLinkedListCursor_insert_after(DblLinkedListCursor * cursor, void * val);
+// removes the element under the cursor and moves the cursor to the following element
+void * DblLinkedListCursor_erase(DblLinkedListCursor * cursor);
+
 //Iterators
 void DblLinkedListIterator_init(DblLinkedListIterator * dll_iter, DblLinkedList * dll);
 void * DblLinkedListIterator_next(DblLinkedListIterator * dll_iter);
+size_t DblLinkedListIterator_next_n(DblLinkedListIterator * dll_iter, void ** out, size_t max);
+// O(n) without fetching the values
+size_t DblLinkedListIterator_advance(DblLinkedListIterator * dll_iter, size_t n);
+// the size of the list, exact until the first element is taken
+size_t DblLinkedListIterator_size_hint(DblLinkedListIterator * dll_iter);
 enum iterator_status DblLinkedListIterator_stop(DblLinkedListIterator * dll_iter);
 void DblLinkedListIteratorIterator_init(DblLinkedListIteratorIterator * dll_iter_iter, DblLinkedListIterator * dll_iter);
 void * DblLinkedListIteratorIterator_next(DblLinkedListIteratorIterator * dll_iter);
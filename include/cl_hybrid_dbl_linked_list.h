@@ -14,15 +14,35 @@ typedef struct HybridDblLinkedList {
     size_t max_elements;
 } HybridDblLinkedList;
 
+// per-element iterator. Walks the array in each block directly with a pointer increment
 typedef struct HybridDblLinkedListIterator {
-    Slice arr_iter;
     HybridDblLinkedList * hdll;
-    Node * node;
+    Node * node;        // block currently being iterated
+    void ** loc;        // location in the block's array of the next element
+    size_t remaining;   // number of elements left in the current block
+    int step;           // +1 or -1 depending on whether the list is reversed
+    Node * end;         // block at which iteration stops, NULL for the end of the list
     enum iterator_status stop;
 } HybridDblLinkedListIterator, HybridDblLinkedListIteratorIterator;
 
+// a contiguous span of elements in one block of a HybridDblLinkedList
+// if reversed, the elements should be consumed from arr[size-1] down to arr[0] to respect the list order
+typedef struct HybridDblLinkedListBlock {
+    void ** arr;
+    size_t size;
+    bool reversed;
+} HybridDblLinkedListBlock;
+
+// block-wise iterator. Each call to next yields the span of a full block
+typedef struct HybridDblLinkedListBlockIterator {
+    HybridDblLinkedList * hdll;
+    Node * node;
+    HybridDblLinkedListBlock block;
+    enum iterator_status stop;
+} HybridDblLinkedListBlockIterator, HybridDblLinkedListBlockIteratorIterator;
+
 HybridDblLinkedList * HybridDblLinkedList_new(unsigned int flags, int narg_pairs, ...);
-void HybridDblLinkedList_init(HybridDblLinkedList * hdll, NodeAttributes * NA);
+void HybridDblLinkedList_init(HybridDblLinkedList * hdll, NodeAttributes * NA, size_t max_elements);
 void HybridDblLinkedList_del(HybridDblLinkedList * hdll);
 void HybridDblLinkedList_reverse(HybridDblLinkedList * hdll);
 size_t HybridDblLinkedList_size(HybridDblLinkedList * hdll);
@@ -39,16 +59,41 @@ void * HybridDblLinkedList_remove(HybridDblLinkedList * hdll, size_t loc);
 void * HybridDblLinkedList_pop_front(HybridDblLinkedList * hdll);
 void * HybridDblLinkedList_pop_back(HybridDblLinkedList * hdll);
 
+// moves the elements [first, last) of src in front of index dest_pos of dest. Whole blocks are relinked and only the 
+// blocks containing first, last and dest_pos are split, copying fewer than P elements each. dest and src must have the 
+// same block size. If dest == src, dest_pos cannot be in (first, last). Reversed lists are fully reversed first (TRO)
+enum cl_status HybridDblLinkedList_splice(HybridDblLinkedList * dest, size_t dest_pos, HybridDblLinkedList * src, size_t first, size_t last);
+// moves the elements from index onward to the back of dest
+enum cl_status HybridDblLinkedList_split_at(HybridDblLinkedList * hdll, size_t index, HybridDblLinkedList * dest);
+
+// stable sort in ascending order of comp. The block structure is preserved, only the elements move
+enum cl_status HybridDblLinkedList_sort(HybridDblLinkedList * hdll, int (*comp)(void*, void*));
+
 // generally should only use this if the elements are unique in the value or you are sure you only want the first occurrence
 // for all other use cases, the filter functionality is better.
-void * HybridDblLinkedList_find(HybridDblLinkedList * hdll, void * value, int (*comp)(void*, void*));
+void * HybridDblLinkedList_find(HybridDblLinkedList * hdll, void * value, int (*comp)(void*, void*), size_t * index);
 
 //Iterators
 void HybridDblLinkedListIterator_init(HybridDblLinkedListIterator * hdll_iter, HybridDblLinkedList * hdll);
 void * HybridDblLinkedListIterator_next(HybridDblLinkedListIterator * hdll_iter);
+// copies the elements of each block in one pass
+size_t HybridDblLinkedListIterator_next_n(HybridDblLinkedListIterator * hdll_iter, void ** out, size_t max);
 enum iterator_status HybridDblLinkedListIterator_stop(HybridDblLinkedListIterator * hdll_iter);
+// splits the remaining blocks so that each part has about half of the elements. grain is in elements
+bool HybridDblLinkedListIterator_split(HybridDblLinkedListIterator * hdll_iter, HybridDblLinkedListIterator * other, size_t grain);
+// skips whole blocks at a time, O(n/P)
+size_t HybridDblLinkedListIterator_advance(HybridDblLinkedListIterator * hdll_iter, size_t n);
+// the size of the list, exact until the first element is taken or the iterator is split
+size_t HybridDblLinkedListIterator_size_hint(HybridDblLinkedListIterator * hdll_iter);
 void HybridDblLinkedListIteratorIterator_init(HybridDblLinkedListIteratorIterator * hdll_iter_iter, HybridDblLinkedListIterator * hdll_iter);
 void * HybridDblLinkedListIteratorIterator_next(HybridDblLinkedListIteratorIterator * hdll_iter);
 enum iterator_status HybridDblLinkedListIteratorIterator_stop(HybridDblLinkedListIteratorIterator * hdll_iter);
 
+void HybridDblLinkedListBlockIterator_init(HybridDblLinkedListBlockIterator * blk_iter, HybridDblLinkedList * hdll);
+HybridDblLinkedListBlock * HybridDblLinkedListBlockIterator_next(HybridDblLinkedListBlockIterator * blk_iter);
+enum iterator_status HybridDblLinkedListBlockIterator_stop(HybridDblLinkedListBlockIterator * blk_iter);
+void HybridDblLinkedListBlockIteratorIterator_init(HybridDblLinkedListBlockIteratorIterator * blk_iter_iter, HybridDblLinkedListBlockIterator * blk_iter);
+HybridDblLinkedListBlock * HybridDblLinkedListBlockIteratorIterator_next(HybridDblLinkedListBlockIteratorIterator * blk_iter);
+enum iterator_status HybridDblLinkedListBlockIteratorIterator_stop(HybridDblLinkedListBlockIteratorIterator * blk_iter);
+
 #endif // CL_HYBRID_LINKED_LIST_H
\ No newline at end of file
@@ -53,6 +53,32 @@ void OBJECTIterator_del(OBJECTITerator * obj_iter) {
     // iterator may be against convention for some, but it is required for implementing a for_each
     // MACRO. The simple "solution" to this behavior for OBJECTIterator_next output NULL or an 
     // appropriate stop condition and use that to implement their own stop
+4) Optionally, an ITERABLE can fetch elements in batches, which saves a call per element when used
+    through the function pointers of the generic Iterator:
+size_t OBJECTIterator_next_n(OBJECTIterator * obj_iter, TYPE ** out, size_t max) {
+    // writes up to max subsequent elements to out and returns the number written. Fewer than max
+    // are written only if the elements ran out, after which OBJECTIteratorend gives ITERATOR_STOP.
+    // Leaves the iterator as if OBJECTIterator_next had been called for each element, so the two
+    // can be mixed
+}
+5) Iterables that can be divided for parallel processing (see cl_parallel.h) define
+bool OBJECTIterator_split(OBJECTIterator * obj_iter, OBJECTIterator * other, size_t grain) {
+    // on an iterator that has not started, moves about half of the remaining elements to other, leaving
+    // obj_iter with the first part. Fails without modifying either if either part would be smaller than
+    // grain. The unit of grain is up to the ITERABLE, e.g. blocks or hash bins rather than elements
+}
+6) Iterables that can skip elements faster than one next at a time define
+size_t OBJECTIterator_advance(OBJECTIterator * obj_iter, size_t n) {
+    // skips the next n elements and returns the number skipped, leaving obj_iter as if OBJECTIterator_next had
+    // been called n times. Fewer than n are skipped only if the elements ran out, after which OBJECTIteratorend
+    // gives ITERATOR_STOP
+}
+7) Iterables that know how many elements are left define
+size_t OBJECTIterator_size_hint(OBJECTIterator * obj_iter) {
+    // returns an upper bound on the number of elements OBJECTIterator_next will still return, exact for an
+    // iterator that has not started unless it drops elements like Filter. ITERATOR_SIZE_UNKNOWN if there is no
+    // bound. Used to allocate the results of comprehensions once
+}
 */
 
 /* 
@@ -93,6 +119,9 @@ but say you want to change the point at which the stop condition is checked, e.g
 #define COMPREHENSION_SCALE 2
 #endif // COMPREHENSION_SCALE
 
+// size_hint of an iterator that cannot bound its number of elements
+#define ITERATOR_SIZE_UNKNOWN SIZE_MAX
+
 enum iterator_status {
     ITERATOR_FAIL = -1,
     ITERATOR_GO,
@@ -100,6 +129,14 @@ enum iterator_status {
     ITERATOR_PAUSE,
 };
 
+// number of elements left from loc (inclusive) to end (exclusive) in steps of step
+static inline size_t iterator_range_count(size_t loc, size_t end, long long step) {
+    if (step > 0) {
+        return loc < end ? (end - loc + step - 1) / step : 0;
+    }
+    return loc > end ? (loc - end - step - 1) / -step : 0;
+}
+
 #define declare_array_sequence(type)            \
 type * type##_get(type * seq, size_t index);    \
 
@@ -155,6 +192,10 @@ void type##Iterator_init(type##Iterator * iter, type * array, size_t num);
 void type##Iterator_del(type##Iterator * iter);                                                         \
 type * type##Iterator_next(type##Iterator * iter);                                                      \
 enum iterator_status type##Iterator_stop(type##Iterator * iter);                                        \
+size_t type##Iterator_next_n(type##Iterator * iter, type ** out, size_t max);                          \
+bool type##Iterator_split(type##Iterator * iter, type##Iterator * other, size_t grain);                 \
+size_t type##Iterator_advance(type##Iterator * iter, size_t n);                                         \
+size_t type##Iterator_size_hint(type##Iterator * iter);                                                 \
 size_t type##Iterator_elem_size(type##Iterator *iter);                                                  \
 void type##IteratorIterator_init(type##IteratorIterator *iter_iter, type##Iterator * iter);             \
 type * type##IteratorIterator_next(type##Iterator *iter);                                               \
@@ -170,6 +211,35 @@ declare_array_iterable(char)
 declare_array_iterable(size_t)
 declare_array_iterable(pvoid)
 
+// number of independent accumulators in the array reductions. Splitting the dependency chain of a reduction lets the
+// compiler vectorize it and overlap the latency of successive operations
+#ifndef CL_REDUCE_LANES
+#define CL_REDUCE_LANES 8
+#endif
+
+// reductions of numeric arrays. The type##_ functions work on a contiguous array while the type##Iterator_ functions
+// consume the remaining elements of an iterator, using the same kernels if the step is 1. min and max return the first
+// extreme element, NULL if there are none. Floating point sums, products and dots are accumulated in a different order
+// than a sequential loop, so their rounding may differ slightly
+#define declare_array_reductions(type)                                          \
+type type##_sum(type * arr, size_t num);                                        \
+type type##_product(type * arr, size_t num);                                    \
+type * type##_min(type * arr, size_t num);                                      \
+type * type##_max(type * arr, size_t num);                                      \
+type type##_dot(type * a, type * b, size_t num);                                \
+type type##Iterator_sum(type##Iterator * iter);                                 \
+type type##Iterator_product(type##Iterator * iter);                             \
+type * type##Iterator_min(type##Iterator * iter);                               \
+type * type##Iterator_max(type##Iterator * iter);                               \
+/* consumes both iterators and stops at the shorter */                          \
+type type##Iterator_dot(type##Iterator * a, type##Iterator * b);                \
+
+declare_array_reductions(double)
+declare_array_reductions(float)
+declare_array_reductions(long)
+declare_array_reductions(int)
+declare_array_reductions(size_t)
+
 /* 
 this macro generates the implementation definitions for an array of type 'type', e.g. if your 
 container is type * object, declare_array_iterator(type) will make all the appropriate 
@@ -231,6 +301,48 @@ enum iterator_status type##Iterator_stop(type##Iterator * iter) {
     }                                                                                       \
     return iter->stop;                                                                      \
 }                                                                                           \
+size_t type##Iterator_next_n(type##Iterator * iter, type ** out, size_t max) {             \
+    size_t n = 0;                                                                           \
+    type * el;                                                                              \
+    while (n < max && (el = type##Iterator_next(iter))) { /* direct call, inlined */        \
+        out[n++] = el;                                                                      \
+    }                                                                                       \
+    return n;                                                                               \
+}                                                                                           \
+bool type##Iterator_split(type##Iterator * iter, type##Iterator * other, size_t grain) {    \
+    if (!iter || !other || iter->stop != ITERATOR_PAUSE || !iter->num) {                    \
+        return false;                                                                       \
+    }                                                                                       \
+    size_t count = iterator_range_count(iter->loc, iter->end, iter->step);                  \
+    size_t half = count / 2;                                                                \
+    if (!half || half < grain) {                                                            \
+        return false;                                                                       \
+    }                                                                                       \
+    *other = *iter;                                                                         \
+    other->loc += (count - half) * iter->step;                                              \
+    iter->end = other->loc;                                                                 \
+    return true;                                                                            \
+}                                                                                           \
+size_t type##Iterator_advance(type##Iterator * iter, size_t n) {                            \
+    if (!iter || !n || iter->stop == ITERATOR_STOP) {                                       \
+        return 0;                                                                           \
+    }                                                                                       \
+    bool started = iter->stop == ITERATOR_GO;                                               \
+    size_t remaining = iter->num ? iterator_range_count(iter->loc, iter->end, iter->step) - started : 0; \
+    if (n > remaining) {                                                                    \
+        iter->stop = ITERATOR_STOP;                                                         \
+        return remaining;                                                                   \
+    }                                                                                       \
+    iter->loc += (n - !started) * iter->step; /* the first element of a new iterator is at loc */ \
+    iter->stop = ITERATOR_GO;                                                               \
+    return n;                                                                               \
+}                                                                                           \
+size_t type##Iterator_size_hint(type##Iterator * iter) {                                    \
+    if (!iter || !iter->num || iter->stop == ITERATOR_STOP) {                               \
+        return 0;                                                                           \
+    }                                                                                       \
+    return iterator_range_count(iter->loc, iter->end, iter->step) - (iter->stop == ITERATOR_GO); \
+}                                                                                           \
 size_t type##Iterator_elem_size(type##Iterator *iter) {                                     \
     return sizeof(type);                                                                    \
 }                                                                                           \
@@ -255,6 +367,203 @@ size_t type##IteratorIterator_elem_size(type##Iterator * iter) {
 }                                                                                           \
 define_array_sequence(type)                                                                 \
 
+
+#define define_array_reductions(type)                                                       \
+type type##_sum(type * arr, size_t num) {                                                   \
+    type acc[CL_REDUCE_LANES] = {0};                                                        \
+    size_t i = 0;                                                                           \
+    for (; i + CL_REDUCE_LANES <= num; i += CL_REDUCE_LANES) {                              \
+        for (size_t j = 0; j < CL_REDUCE_LANES; j++) {                                      \
+            acc[j] += arr[i + j];                                                           \
+        }                                                                                   \
+    }                                                                                       \
+    type total = 0;                                                                         \
+    for (; i < num; i++) {                                                                  \
+        total += arr[i];                                                                    \
+    }                                                                                       \
+    for (size_t j = 0; j < CL_REDUCE_LANES; j++) {                                          \
+        total += acc[j];                                                                    \
+    }                                                                                       \
+    return total;                                                                           \
+}                                                                                           \
+type type##_product(type * arr, size_t num) {                                               \
+    type acc[CL_REDUCE_LANES];                                                              \
+    for (size_t j = 0; j < CL_REDUCE_LANES; j++) {                                          \
+        acc[j] = 1;                                                                         \
+    }                                                                                       \
+    size_t i = 0;                                                                           \
+    for (; i + CL_REDUCE_LANES <= num; i += CL_REDUCE_LANES) {                              \
+        for (size_t j = 0; j < CL_REDUCE_LANES; j++) {                                      \
+            acc[j] *= arr[i + j];                                                           \
+        }                                                                                   \
+    }                                                                                       \
+    type total = 1;                                                                         \
+    for (; i < num; i++) {                                                                  \
+        total *= arr[i];                                                                    \
+    }                                                                                       \
+    for (size_t j = 0; j < CL_REDUCE_LANES; j++) {                                          \
+        total *= acc[j];                                                                    \
+    }                                                                                       \
+    return total;                                                                           \
+}                                                                                           \
+/* finds the extreme value branch-free, then its first position */                         \
+type * type##_min(type * arr, size_t num) {                                                 \
+    if (!arr || !num) {                                                                     \
+        return NULL;                                                                        \
+    }                                                                                       \
+    type acc[CL_REDUCE_LANES];                                                              \
+    for (size_t j = 0; j < CL_REDUCE_LANES; j++) {                                          \
+        acc[j] = arr[0];                                                                    \
+    }                                                                                       \
+    size_t i = 0;                                                                           \
+    for (; i + CL_REDUCE_LANES <= num; i += CL_REDUCE_LANES) {                              \
+        for (size_t j = 0; j < CL_REDUCE_LANES; j++) {                                      \
+            acc[j] = arr[i + j] < acc[j] ? arr[i + j] : acc[j];                             \
+        }                                                                                   \
+    }                                                                                       \
+    type best = arr[0];                                                                     \
+    for (; i < num; i++) {                                                                  \
+        best = arr[i] < best ? arr[i] : best;                                               \
+    }                                                                                       \
+    for (size_t j = 0; j < CL_REDUCE_LANES; j++) {                                          \
+        best = acc[j] < best ? acc[j] : best;                                               \
+    }                                                                                       \
+    for (i = 0; i < num; i++) {                                                             \
+        if (arr[i] == best) {                                                               \
+            return arr + i;                                                                 \
+        }                                                                                   \
+    }                                                                                       \
+    return arr; /* only if the values are unordered, e.g. NaN */                            \
+}                                                                                           \
+type * type##_max(type * arr, size_t num) {                                                 \
+    if (!arr || !num) {                                                                     \
+        return NULL;                                                                        \
+    }                                                                                       \
+    type acc[CL_REDUCE_LANES];                                                              \
+    for (size_t j = 0; j < CL_REDUCE_LANES; j++) {                                          \
+        acc[j] = arr[0];                                                                    \
+    }                                                                                       \
+    size_t i = 0;                                                                           \
+    for (; i + CL_REDUCE_LANES <= num; i += CL_REDUCE_LANES) {                              \
+        for (size_t j = 0; j < CL_REDUCE_LANES; j++) {                                      \
+            acc[j] = arr[i + j] > acc[j] ? arr[i + j] : acc[j];                             \
+        }                                                                                   \
+    }                                                                                       \
+    type best = arr[0];                                                                     \
+    for (; i < num; i++) {                                                                  \
+        best = arr[i] > best ? arr[i] : best;                                               \
+    }                                                                                       \
+    for (size_t j = 0; j < CL_REDUCE_LANES; j++) {                                          \
+        best = acc[j] > best ? acc[j] : best;                                               \
+    }                                                                                       \
+    for (i = 0; i < num; i++) {                                                             \
+        if (arr[i] == best) {                                                               \
+            return arr + i;                                                                 \
+        }                                                                                   \
+    }                                                                                       \
+    return arr;                                                                             \
+}                                                                                           \
+type type##_dot(type * a, type * b, size_t num) {                                           \
+    type acc[CL_REDUCE_LANES] = {0};                                                        \
+    size_t i = 0;                                                                           \
+    for (; i + CL_REDUCE_LANES <= num; i += CL_REDUCE_LANES) {                              \
+        for (size_t j = 0; j < CL_REDUCE_LANES; j++) {                                      \
+            acc[j] += a[i + j] * b[i + j];                                                  \
+        }                                                                                   \
+    }                                                                                       \
+    type total = 0;                                                                         \
+    for (; i < num; i++) {                                                                  \
+        total += a[i] * b[i];                                                               \
+    }                                                                                       \
+    for (size_t j = 0; j < CL_REDUCE_LANES; j++) {                                          \
+        total += acc[j];                                                                    \
+    }                                                                                       \
+    return total;                                                                           \
+}                                                                                           \
+/* returns the first remaining element of iter and sets their number in count. iter is stopped */ \
+static type * type##Iterator_consume(type##Iterator * iter, size_t * count) {              \
+    *count = 0;                                                                             \
+    if (!iter) {                                                                            \
+        return NULL;                                                                        \
+    }                                                                                       \
+    type * first = NULL;                                                                    \
+    if (iter->stop != ITERATOR_STOP && iter->num) {                                         \
+        bool started = iter->stop == ITERATOR_GO;                                           \
+        *count = iterator_range_count(iter->loc, iter->end, iter->step) - started;          \
+        if (*count) {                                                                       \
+            first = iter->array + iter->loc + (started ? iter->step : 0);                   \
+        }                                                                                   \
+    }                                                                                       \
+    iter->stop = ITERATOR_STOP;                                                             \
+    return first;                                                                           \
+}                                                                                           \
+type type##Iterator_sum(type##Iterator * iter) {                                            \
+    size_t count;                                                                           \
+    type * first = type##Iterator_consume(iter, &count);                                    \
+    if (count && iter->step == 1) {                                                         \
+        return type##_sum(first, count);                                                    \
+    }                                                                                       \
+    type total = 0;                                                                         \
+    for (size_t i = 0; i < count; i++) {                                                    \
+        total += first[(ptrdiff_t) i * iter->step];                                         \
+    }                                                                                       \
+    return total;                                                                           \
+}                                                                                           \
+type type##Iterator_product(type##Iterator * iter) {                                        \
+    size_t count;                                                                           \
+    type * first = type##Iterator_consume(iter, &count);                                    \
+    if (count && iter->step == 1) {                                                         \
+        return type##_product(first, count);                                                \
+    }                                                                                       \
+    type total = 1;                                                                         \
+    for (size_t i = 0; i < count; i++) {                                                    \
+        total *= first[(ptrdiff_t) i * iter->step];                                         \
+    }                                                                                       \
+    return total;                                                                           \
+}                                                                                           \
+type * type##Iterator_min(type##Iterator * iter) {                                          \
+    size_t count;                                                                           \
+    type * first = type##Iterator_consume(iter, &count);                                    \
+    if (count && iter->step == 1) {                                                         \
+        return type##_min(first, count);                                                    \
+    }                                                                                       \
+    type * best = first;                                                                    \
+    for (size_t i = 1; i < count; i++) {                                                    \
+        if (first[(ptrdiff_t) i * iter->step] < *best) {                                    \
+            best = first + (ptrdiff_t) i * iter->step;                                      \
+        }                                                                                   \
+    }                                                                                       \
+    return best;                                                                            \
+}                                                                                           \
+type * type##Iterator_max(type##Iterator * iter) {                                          \
+    size_t count;                                                                           \
+    type * first = type##Iterator_consume(iter, &count);                                    \
+    if (count && iter->step == 1) {                                                         \
+        return type##_max(first, count);                                                    \
+    }                                                                                       \
+    type * best = first;                                                                    \
+    for (size_t i = 1; i < count; i++) {                                                    \
+        if (first[(ptrdiff_t) i * iter->step] > *best) {                                    \
+            best = first + (ptrdiff_t) i * iter->step;                                      \
+        }                                                                                   \
+    }                                                                                       \
+    return best;                                                                            \
+}                                                                                           \
+type type##Iterator_dot(type##Iterator * a, type##Iterator * b) {                           \
+    size_t na, nb;                                                                          \
+    type * fa = type##Iterator_consume(a, &na);                                             \
+    type * fb = type##Iterator_consume(b, &nb);                                             \
+    size_t count = na < nb ? na : nb;                                                       \
+    if (count && a->step == 1 && b->step == 1) {                                            \
+        return type##_dot(fa, fb, count);                                                   \
+    }                                                                                       \
+    type total = 0;                                                                         \
+    for (size_t i = 0; i < count; i++) {                                                    \
+        total += fa[(ptrdiff_t) i * a->step] * fb[(ptrdiff_t) i * b->step];                 \
+    }                                                                                       \
+    return total;                                                                           \
+}                                                                                           \
+
 #define for_each(insttype, inst, iterable_type, ...)								        \
 iterable_type##Iterator UNIQUE_VAR_NAME(inst##iterable_type);                                           \
 iterable_type##Iterator_init(&UNIQUE_VAR_NAME(inst##iterable_type), __VA_ARGS__);                      \
@@ -324,6 +633,65 @@ if (new_obj##_capacity > comprehension_size) {
 }                                                                                                       \
 }                                                                                                       \
 
+// as array_comprehension for iterables that define ITERABLEIterator_size_hint (note 7). The array is allocated once with
+// the hint and only shrunk if fewer elements were produced, e.g. by a Filter. An unknown hint grows as array_comprehension
+#define sized_array_comprehension(type_out, new_obj, function, type_in, iterable, ...)                  \
+iterable##Iterator UNIQUE_VAR_NAME(new_obj##_iter);                                                     \
+iterable##Iterator_init(&UNIQUE_VAR_NAME(new_obj##_iter), __VA_ARGS__);                                 \
+size_t new_obj##_capacity = iterable##Iterator_size_hint(&UNIQUE_VAR_NAME(new_obj##_iter));             \
+if (new_obj##_capacity == ITERATOR_SIZE_UNKNOWN) {                                                      \
+    new_obj##_capacity = INIT_COMPREHENSION_SIZE;                                                       \
+}                                                                                                       \
+type_out * new_obj = new_obj##_capacity ? (type_out *) CL_MALLOC(sizeof(type_out)*new_obj##_capacity) : NULL; \
+if (!new_obj) {                                                                                         \
+    new_obj##_capacity = 0;                                                                             \
+}                                                                                                       \
+{                                                                                                       \
+size_t comprehension_size = 0;                                                                          \
+for (type_in * comprehension_el = (type_in *) iterable##Iterator_next(&UNIQUE_VAR_NAME(new_obj##_iter)); !iterable##Iterator_stop(&UNIQUE_VAR_NAME(new_obj##_iter)); comprehension_el = (type_in *) iterable##Iterator_next(&UNIQUE_VAR_NAME(new_obj##_iter))) { \
+    if (comprehension_size == new_obj##_capacity) { /* the hint was too small */                        \
+        size_t comprehension_capacity = new_obj##_capacity ? new_obj##_capacity * COMPREHENSION_SCALE : INIT_COMPREHENSION_SIZE; \
+        bool comprehension_go = true;                                                                   \
+        RESIZE_REALLOC(comprehension_go, type_out, new_obj, comprehension_capacity);                    \
+        if (!comprehension_go) {                                                                        \
+            break;                                                                                      \
+        }                                                                                               \
+        new_obj##_capacity = comprehension_capacity;                                                    \
+    }                                                                                                   \
+    function((type_out*)new_obj + comprehension_size, comprehension_el);                                \
+    comprehension_size++;                                                                               \
+}                                                                                                       \
+if (comprehension_size && new_obj##_capacity > comprehension_size) {                                    \
+    bool comprehension_go = true;                                                                       \
+    RESIZE_REALLOC(comprehension_go, type_out, new_obj, comprehension_size);                            \
+    if (comprehension_go) {                                                                             \
+        new_obj##_capacity = comprehension_size;                                                        \
+    }                                                                                                   \
+} else if (!comprehension_size) {                                                                       \
+    CL_FREE(new_obj);                                                                                   \
+    new_obj = NULL;                                                                                     \
+    new_obj##_capacity = 0;                                                                             \
+}                                                                                                       \
+}                                                                                                       \
+
+// as array_comprehension but writes into buf, which holds capacity elements of type_out and may come from anywhere, e.g.
+// the stack or an arena. Nothing is allocated. Stops after capacity elements and declares size_t count, the number
+// written
+#define array_comprehension_into(type_out, buf, capacity, count, function, type_in, iterable, ...)      \
+size_t count = 0;                                                                                       \
+{                                                                                                       \
+iterable##Iterator UNIQUE_VAR_NAME(count##_iter);                                                       \
+iterable##Iterator_init(&UNIQUE_VAR_NAME(count##_iter), __VA_ARGS__);                                   \
+while (count < (capacity)) {                                                                            \
+    type_in * comprehension_el = (type_in *) iterable##Iterator_next(&UNIQUE_VAR_NAME(count##_iter));   \
+    if (iterable##Iterator_stop(&UNIQUE_VAR_NAME(count##_iter))) {                                      \
+        break;                                                                                          \
+    }                                                                                                   \
+    function((type_out*)(buf) + count, comprehension_el);                                               \
+    count++;                                                                                            \
+}                                                                                                       \
+}                                                                                                       \
+
 /*****************************Generic Iterating*******************************/
 
 // Iterator
@@ -331,10 +699,22 @@ typedef struct Iterator {
     void * obj; // keeps track of the state of the iterator
     void * (*next)(void*);
     enum iterator_status (*stop)(void*);
+    size_t (*next_n)(void*, void**, size_t); // optional, NULL falls back to next and stop
+    size_t (*advance)(void*, size_t); // optional, NULL falls back to next and stop
+    size_t (*size_hint)(void*); // optional, NULL gives ITERATOR_SIZE_UNKNOWN
 } Iterator, IteratorIterator;
 
 void Iterator_init(Iterator * iter, void * obj, void * (*next) (void*), enum iterator_status (*stop)(void*));
+void Iterator_set_next_n(Iterator * iter, size_t (*next_n)(void*, void**, size_t));
 void * Iterator_next(Iterator * iter);
+// see note 4) at the top. Costs one indirect call per batch if next_n is set
+size_t Iterator_next_n(Iterator * iter, void ** out, size_t max);
+void Iterator_set_advance(Iterator * iter, size_t (*advance)(void*, size_t));
+// see note 6) at the top
+size_t Iterator_advance(Iterator * iter, size_t n);
+void Iterator_set_size_hint(Iterator * iter, size_t (*size_hint)(void*));
+// see note 7) at the top
+size_t Iterator_size_hint(Iterator * iter);
 enum iterator_status Iterator_stop(Iterator * iter);
 void IteratorIterator_init(IteratorIterator * iter_iter, Iterator * iter);
 void * IteratorIterator_next(IteratorIterator * iter_iter);
@@ -345,6 +725,11 @@ iterable_type##Iterator UNIQUE_VAR_NAME(iterable_type);\
 iterable_type##Iterator_init(&UNIQUE_VAR_NAME(iterable_type), __VA_ARGS__);      \
 Iterator_init(piter_inst, (void*)&UNIQUE_VAR_NAME(iterable_type), (void* (*)(void*)) iterable_type##Iterator_next, (enum iterator_status (*)(void*)) iterable_type##Iterator_stop);\
 
+// as iterate for iterable types that define iterable_type##Iterator_next_n
+#define iterate_batched(piter_inst, iterable_type, ...)\
+iterate(piter_inst, iterable_type, __VA_ARGS__)\
+Iterator_set_next_n(piter_inst, (size_t (*)(void*, void**, size_t)) iterable_type##Iterator_next_n);\
+
 /********************0*************Filtering***********************************/
 
 typedef struct Filter {
@@ -354,10 +739,15 @@ typedef struct Filter {
 
 void Filter_init(Filter * filt, bool (*func)(void*), void * iter_obj, void * (*iter_next)(void*), enum iterator_status (*iter_stop)(void*));
 void * Filter_next(Filter * filt);
+// fetches batches from the underlying iterator and compacts the accepted elements into out
+size_t Filter_next_n(Filter * filt, void ** out, size_t max);
 enum iterator_status Filter_stop(Filter * iter);
+// the size_hint of the filtered iterator, since any of its elements may pass
+size_t Filter_size_hint(Filter * filt);
 void FilterIterator_init(FilterIterator * filt_iter, Filter * filt);
 void * FilterIterator_next(FilterIterator * filt_iter);
 enum iterator_status FilterIterator_stop(FilterIterator * filt_iter);
+size_t FilterIterator_size_hint(FilterIterator * filt_iter);
 
 /*
 create a filterIterable object that matches python's filter(function, iterable built-in)
@@ -373,6 +763,11 @@ iterable_type##Iterator UNIQUE_VAR_NAME(iterable_type);\
 iterable_type##Iterator_init(&UNIQUE_VAR_NAME(iterable_type), __VA_ARGS__);\
 Filter_init(pfilter_obj, function, &UNIQUE_VAR_NAME(iterable_type), (void* (*)(void*))iterable_type##Iterator_next, (enum iterator_status (*)(void*))iterable_type##Iterator_stop)    \
 
+// as filter for iterable types that define iterable_type##Iterator_next_n
+#define filter_batched(pfilter_obj, function, iterable_type, ...)                                                                           \
+filter(pfilter_obj, function, iterable_type, __VA_ARGS__);                                                                                  \
+Iterator_set_next_n((Iterator*)(pfilter_obj), (size_t (*)(void*, void**, size_t))iterable_type##Iterator_next_n)                            \
+
 /**********************************Slicing************************************/
 
 #define SLICE_CORRECT_STEP_SIGN(start, stop, step) (start <= stop ? (step ? REFLECT_TO_POS(step) : 1) : (step ? REFLECT_TO_NEG(step) : -1))
@@ -387,10 +782,23 @@ Slice_init(pslice_inst, (void*)obj, (void* (*)(void*, size_t))sliceable_type##_g
 #define GET_SLICE_MACRO(_1,_2,_3,_4,SLICE_MACRO,...) SLICE_MACRO
 #define slice(pslice_inst, sliceable_type, obj, ...) GET_SLICE_MACRO(__VA_ARGS__, SLICE3_HELPER, SLICE2, SLICE1, SLICE0, UNUSED)(pslice_inst, sliceable_type, obj, __VA_ARGS__)
 
+// as slice with all arguments for iterables that define iterable_type##Iterator_advance and iterable_type##_size, e.g.
+// linked lists. Iterating the slice is O(stop) instead of the O(stop^2) of slice over a get that walks the list
+#define slice_iterator(pslice_inst, iterable_type, obj, start, stop, step)                                                            \
+iterable_type##Iterator UNIQUE_VAR_NAME(slice_src_iter);                                                                            \
+iterable_type##Iterator_init(&UNIQUE_VAR_NAME(slice_src_iter), obj);                                                                \
+Iterator UNIQUE_VAR_NAME(slice_src);                                                                                                \
+Iterator_init(&UNIQUE_VAR_NAME(slice_src), &UNIQUE_VAR_NAME(slice_src_iter), (void* (*)(void*)) iterable_type##Iterator_next, (enum iterator_status (*)(void*)) iterable_type##Iterator_stop); \
+Iterator_set_advance(&UNIQUE_VAR_NAME(slice_src), (size_t (*)(void*, size_t)) iterable_type##Iterator_advance);                      \
+Slice_init_iterator(pslice_inst, &UNIQUE_VAR_NAME(slice_src), iterable_type##_size(obj), CYCLE_TO_POS(start, iterable_type##_size(obj)), CYCLE_TO_POS(stop, iterable_type##_size(obj)), step)
+
 // TODO: make SliceIterator an actual iterator
+// a slice either gets its elements by index with get or, for iterables without random access, pulls them from src
 typedef struct Slice {
     void * obj;
     void * (*get)(void *, size_t);
+    Iterator * src;
+    size_t pos;     // index of the next element of src
     size_t loc;
     size_t size;
     size_t start;
@@ -400,11 +808,208 @@ typedef struct Slice {
 } Slice, SliceIterator;
 
 void Slice_init(Slice * sl, void * obj, void*(*get)(void*, size_t), size_t size, size_t start, size_t stop, long long int step);
+// slices the elements of src, which must not have started, skipping between them with Iterator_advance. Each element is
+// then reached in O(1) amortized for iterables that define advance, rather than by a get call that walks from the
+// start each time. size is the number of elements in src. Only positive steps are supported; the slice is empty
+// otherwise. Copies made with SliceIterator_init share src, so the slice and its copies are iterated only once
+void Slice_init_iterator(Slice * sl, Iterator * src, size_t size, size_t start, size_t stop, long long int step);
 void * Slice_next(Slice * sl);
+size_t Slice_next_n(Slice * sl, void ** out, size_t max);
+bool Slice_split(Slice * sl, Slice * other, size_t grain);
+size_t Slice_advance(Slice * sl, size_t n);
+size_t Slice_size_hint(Slice * sl);
 enum iterator_status Slice_stop(Slice * sl);
 void SliceIterator_init(SliceIterator * sl_iter, Slice * sl);
 void * SliceIterator_next(SliceIterator * sl_iter);
 enum iterator_status SliceIterator_stop(SliceIterator * sl_iter);
+size_t SliceIterator_size_hint(SliceIterator * sl_iter);
+
+/*********************************Pipelines***********************************/
+
+/*
+lazy map/filter/take/skip/take_while/drop_while stages over a single source iterator. Rather than wrapping one
+adaptor in another, which costs an indirect call per layer per element, stages are appended to a single Pipeline and
+applied in one loop. Only the user functions are called through pointers. Stages are applied in the order added,
+e.g. filter then take(3) gives the first 3 elements passing the filter
+
+map functions return the new element. Any storage they write to must outlive its use by the consumer
+the source may be advanced past the last element produced by take or take_while
+*/
+
+#ifndef PIPELINE_MAX_STAGES
+#define PIPELINE_MAX_STAGES 8
+#endif // PIPELINE_MAX_STAGES
+
+typedef struct PipelineStage {
+    unsigned char type;
+    void * (*map)(void*);
+    bool (*pred)(void*);
+    size_t count;           // remaining elements for take and skip, whether still dropping for drop_while
+} PipelineStage;
+
+typedef struct Pipeline {
+    Iterator iter;          // source
+    PipelineStage stages[PIPELINE_MAX_STAGES];
+    unsigned int nstages;
+    bool done;              // a take stage is exhausted, stop without reading the source again
+    enum iterator_status stop;
+} Pipeline, PipelineIterator;
+
+void Pipeline_init(Pipeline * pl, void * obj, void * (*next)(void*), enum iterator_status (*stop)(void*));
+// append stages. Return CL_FAILURE if PIPELINE_MAX_STAGES are already in use or after iteration has started
+enum cl_status Pipeline_map(Pipeline * pl, void * (*func)(void*));
+enum cl_status Pipeline_filter(Pipeline * pl, bool (*pred)(void*));
+enum cl_status Pipeline_take(Pipeline * pl, size_t num);
+enum cl_status Pipeline_skip(Pipeline * pl, size_t num);
+enum cl_status Pipeline_take_while(Pipeline * pl, bool (*pred)(void*));
+enum cl_status Pipeline_drop_while(Pipeline * pl, bool (*pred)(void*));
+void * Pipeline_next(Pipeline * pl);
+// reads batches from the source and runs all stages over each batch in place
+size_t Pipeline_next_n(Pipeline * pl, void ** out, size_t max);
+enum iterator_status Pipeline_stop(Pipeline * pl);
+// copies the stages and shares the source
+void PipelineIterator_init(PipelineIterator * pl_iter, Pipeline * pl);
+void * PipelineIterator_next(PipelineIterator * pl_iter);
+size_t PipelineIterator_next_n(PipelineIterator * pl_iter, void ** out, size_t max);
+enum iterator_status PipelineIterator_stop(PipelineIterator * pl_iter);
+
+// the named macro parameters must be unique in a local scope. Stages are added afterwards with Pipeline_map etc.
+#define pipeline(ppipeline_obj, iterable_type, ...)                                                                                         \
+iterable_type##Iterator UNIQUE_VAR_NAME(iterable_type);\
+iterable_type##Iterator_init(&UNIQUE_VAR_NAME(iterable_type), __VA_ARGS__);\
+Pipeline_init(ppipeline_obj, &UNIQUE_VAR_NAME(iterable_type), (void* (*)(void*))iterable_type##Iterator_next, (enum iterator_status (*)(void*))iterable_type##Iterator_stop)    \
+
+// as pipeline for iterable types that define iterable_type##Iterator_next_n
+#define pipeline_batched(ppipeline_obj, iterable_type, ...)                                                                                 \
+pipeline(ppipeline_obj, iterable_type, __VA_ARGS__);                                                                                        \
+Iterator_set_next_n((Iterator*)(ppipeline_obj), (size_t (*)(void*, void**, size_t))iterable_type##Iterator_next_n)                          \
+
+/******************************Zipping & Chaining*****************************/
+
+// iterates over num iterators in lock step. Each call to next returns items, filled with the next element of each.
+// Stops with the shortest iterator. iters and items must have num elements and outlive the Zip
+typedef struct Zip {
+    Iterator * iters;
+    void ** items;
+    size_t num;
+    enum iterator_status stop;
+} Zip, ZipIterator;
+
+void Zip_init(Zip * zip, Iterator * iters, void ** items, size_t num);
+void ** Zip_next(Zip * zip);
+enum iterator_status Zip_stop(Zip * zip);
+void ZipIterator_init(ZipIterator * zip_iter, Zip * zip);
+void ** ZipIterator_next(ZipIterator * zip_iter);
+enum iterator_status ZipIterator_stop(ZipIterator * zip_iter);
+
+// iterates over each of num iterators in turn. iters must outlive the Chain
+typedef struct Chain {
+    Iterator * iters;
+    size_t num;
+    size_t cur;
+    enum iterator_status stop;
+} Chain, ChainIterator;
+
+void Chain_init(Chain * chain, Iterator * iters, size_t num);
+void * Chain_next(Chain * chain);
+size_t Chain_next_n(Chain * chain, void ** out, size_t max);
+enum iterator_status Chain_stop(Chain * chain);
+void ChainIterator_init(ChainIterator * chain_iter, Chain * chain);
+void * ChainIterator_next(ChainIterator * chain_iter);
+size_t ChainIterator_next_n(ChainIterator * chain_iter, void ** out, size_t max);
+enum iterator_status ChainIterator_stop(ChainIterator * chain_iter);
+
+/**********************************Chunking***********************************/
+
+typedef struct Chunk {
+    void ** arr;
+    size_t size;
+} Chunk;
+
+// groups the elements of an iterator into chunks of up to size elements, filled with Iterator_next_n. The last chunk
+// may be short. buf must have size elements and outlive the Chunked; it is overwritten by each call to next
+typedef struct Chunked {
+    Iterator iter;
+    Chunk chunk;
+    size_t size;
+    enum iterator_status stop;
+} Chunked, ChunkedIterator;
+
+void Chunked_init(Chunked * ch, void ** buf, size_t size, void * obj, void * (*next)(void*), enum iterator_status (*stop)(void*));
+Chunk * Chunked_next(Chunked * ch);
+enum iterator_status Chunked_stop(Chunked * ch);
+void ChunkedIterator_init(ChunkedIterator * ch_iter, Chunked * ch);
+Chunk * ChunkedIterator_next(ChunkedIterator * ch_iter);
+enum iterator_status ChunkedIterator_stop(ChunkedIterator * ch_iter);
+
+#define chunked(pchunked_obj, buf, size, iterable_type, ...)                                                                                \
+iterable_type##Iterator UNIQUE_VAR_NAME(iterable_type);\
+iterable_type##Iterator_init(&UNIQUE_VAR_NAME(iterable_type), __VA_ARGS__);\
+Chunked_init(pchunked_obj, buf, size, &UNIQUE_VAR_NAME(iterable_type), (void* (*)(void*))iterable_type##Iterator_next, (enum iterator_status (*)(void*))iterable_type##Iterator_stop)    \
+
+#define chunked_batched(pchunked_obj, buf, size, iterable_type, ...)                                                                        \
+chunked(pchunked_obj, buf, size, iterable_type, __VA_ARGS__);                                                                               \
+Iterator_set_next_n((Iterator*)(pchunked_obj), (size_t (*)(void*, void**, size_t))iterable_type##Iterator_next_n)                           \
+
+/*******************************Combinatorics*********************************/
+
+// The combinatoric iterators yield indices into a sequence of n elements. Each call to next rewrites the same caller
+// provided buffer in place and returns it, so nothing is allocated per item; copy the indices out to keep them.
+// Copies made with XIterator_init restart from the beginning and share the buffer.
+
+// all n! orderings of 0, ..., n - 1 by Heap's algorithm; each differs from the previous by exchanging the positions
+// swapped[0] and swapped[1]. buf must have 2 * n elements: the permutation followed by the algorithm's counters.
+// n == 0 yields one empty permutation
+typedef struct Permutations {
+    size_t * idx;
+    size_t * count;
+    size_t n;
+    size_t i;
+    size_t swapped[2];
+    enum iterator_status stop;
+} Permutations, PermutationsIterator;
+
+void Permutations_init(Permutations * perm, size_t * buf, size_t n);
+size_t * Permutations_next(Permutations * perm);
+enum iterator_status Permutations_stop(Permutations * perm);
+void PermutationsIterator_init(PermutationsIterator * perm_iter, Permutations * perm);
+size_t * PermutationsIterator_next(PermutationsIterator * perm_iter);
+enum iterator_status PermutationsIterator_stop(PermutationsIterator * perm_iter);
+
+// all C(n, k) sets of k indices in 0, ..., n - 1, each in increasing order, by the revolving door algorithm: each
+// differs from the previous by removing the index out and adding the index in. The order is not lexicographic.
+// buf must have k + 1 elements, the last holds n as a sentinel. k == 0 yields one empty set, k > n none
+typedef struct Combinations {
+    size_t * idx;
+    size_t n;
+    size_t k;
+    size_t out;
+    size_t in;
+    enum iterator_status stop;
+} Combinations, CombinationsIterator;
+
+void Combinations_init(Combinations * comb, size_t * buf, size_t n, size_t k);
+size_t * Combinations_next(Combinations * comb);
+enum iterator_status Combinations_stop(Combinations * comb);
+void CombinationsIterator_init(CombinationsIterator * comb_iter, Combinations * comb);
+size_t * CombinationsIterator_next(CombinationsIterator * comb_iter);
+enum iterator_status CombinationsIterator_stop(CombinationsIterator * comb_iter);
+
+// all C(n + k - 1, k) non-decreasing sequences of k indices in 0, ..., n - 1 in lexicographic order, in amortized
+// constant time per item. buf must have k elements. k == 0 yields one empty sequence, n == 0 with k > 0 none
+typedef struct CombinationsWithReplacement {
+    size_t * idx;
+    size_t n;
+    size_t k;
+    enum iterator_status stop;
+} CombinationsWithReplacement, CombinationsWithReplacementIterator;
+
+void CombinationsWithReplacement_init(CombinationsWithReplacement * comb, size_t * buf, size_t n, size_t k);
+size_t * CombinationsWithReplacement_next(CombinationsWithReplacement * comb);
+enum iterator_status CombinationsWithReplacement_stop(CombinationsWithReplacement * comb);
+void CombinationsWithReplacementIterator_init(CombinationsWithReplacementIterator * comb_iter, CombinationsWithReplacement * comb);
+size_t * CombinationsWithReplacementIterator_next(CombinationsWithReplacementIterator * comb_iter);
+enum iterator_status CombinationsWithReplacementIterator_stop(CombinationsWithReplacementIterator * comb_iter);
 
 /*********************************Reversing***********************************/
 
@@ -473,7 +1078,8 @@ iterable_type##Iterator_init(&UNIQUE_VAR_NAME(iterable_type), __VA_ARGS__);
 Enumerator_init(penum_inst, (void*)&UNIQUE_VAR_NAME(iterable_type), (void* (*)(void*)) iterable_type##Iterator_next, (enum iterator_status (*)(void*)) iterable_type##Iterator_stop);\
 */
 
-// it is assumed poutput is a pointer to the correct type
+// it is assumed poutput is a pointer to the correct type. These work for any iterable; for the numeric array iterables,
+// type##_sum/type##_product and their iterator versions are much faster
 #define sum(type, poutput, iterable_type, ...)      \
 for_each(type, el, iterable_type, __VA_ARGS__) {    \
     *poutput += *el;                                \
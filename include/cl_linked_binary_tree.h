@@ -1,11 +1,127 @@
+// red-black tree of linked nodes used as an ordered map of KEY to VALUE
+// https://en.wikipedia.org/wiki/Red%E2%80%93black_tree
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "cl_core.h"
+#include "cl_node.h"
+#include "cl_tree_utils.h"
+#include "cl_circular_buffer.h"
+
 #ifndef LINKEDBINARYTREE_H
 #define LINKEDBINARYTREE_H
 
+// the behavior on keys that compare equal is set by the TREE_MOD flags in cl_tree_utils.h
+// TREE_MOD_UNIQUE: insert of an existing key fails or, with TREE_MOD_UPDATE, replaces its value
+// otherwise equal keys are kept in insertion order and TREE_MOD_ORDER_MASK picks which of them find/erase act on
 typedef struct LinkedBinaryTree {
     Node * root;
     NodeAttributes * NA;
     size_t size;
+    Node * block;       // nodes allocated together by the bulk constructors, freed with the tree. NULL if none
+    Node * block_end;
+    int (*compare) (Node_type(KEY), Node_type(KEY));
+    TREE_FLAG_TYPE flags;
 } LinkedBinaryTree;
 
+// order is one of the TREE_ITERATE_* orders in cl_tree_utils.h, optionally with TREE_ITERATE_REVERSE to visit right
+// children first. Uses only the links in the nodes; no memory is allocated
+typedef struct LinkedBinaryTreeIterator {
+    LinkedBinaryTree * lbt;
+    Node * node;
+    size_t depth;
+    TREE_FLAG_TYPE order;
+    int dir;
+    enum iterator_status stop;
+} LinkedBinaryTreeIterator, LinkedBinaryTreeIteratorIterator;
+
+// intervals [KEY, END] overlapping [start, end], in key order. Uses only the links in the nodes
+typedef struct LinkedBinaryTreeIntervalIterator {
+    LinkedBinaryTree * lbt;
+    Node * node;
+    Node_type(KEY) start;
+    Node_type(END) end;
+    enum iterator_status stop;
+} LinkedBinaryTreeIntervalIterator;
+
+LinkedBinaryTree * LinkedBinaryTree_new(int (*compare) (Node_type(KEY), Node_type(KEY)), TREE_FLAG_TYPE flags, unsigned int node_flags, int narg_pairs, ...);
+LinkedBinaryTree * vLinkedBinaryTree_new(int (*compare) (Node_type(KEY), Node_type(KEY)), TREE_FLAG_TYPE flags, unsigned int node_flags, int narg_pairs, va_list args);
+// NA must have at least the attributes VALUE, KEY, LEFT, RIGHT, PARENT, COLOR & SIZE
+void LinkedBinaryTree_init(LinkedBinaryTree * lbt, int (*compare) (Node_type(KEY), Node_type(KEY)), TREE_FLAG_TYPE flags, NodeAttributes * NA);
+void LinkedBinaryTree_del(LinkedBinaryTree * lbt);
+// removes all nodes, leaves NodeAttributes in place
+void LinkedBinaryTree_clear(LinkedBinaryTree * lbt);
+size_t LinkedBinaryTree_size(LinkedBinaryTree * lbt);
+bool LinkedBinaryTree_is_empty(LinkedBinaryTree * lbt);
+// SIZE of node, maintained through all modifications. O(1)
+size_t LinkedBinaryTree_subtree_size(LinkedBinaryTree * lbt, Node * node);
+// fills path with the nodes from the root to node
+int LinkedBinaryTree_path_to(CircularBuffer * path, LinkedBinaryTree * lbt, Node * node);
+int LinkedBinaryTree_rotate(LinkedBinaryTree * lbt, Node * node, int dir);
+int LinkedBinaryTree_split_rotate(LinkedBinaryTree * lbt, Node * node, int dir);
+
+// ordered map. All O(log N)
+enum cl_status LinkedBinaryTree_insert(LinkedBinaryTree * lbt, Node_type(KEY) key, void * value);
+Node * LinkedBinaryTree_find(LinkedBinaryTree * lbt, Node_type(KEY) key);
+void * LinkedBinaryTree_get(LinkedBinaryTree * lbt, Node_type(KEY) key);
+bool LinkedBinaryTree_contains(LinkedBinaryTree * lbt, Node_type(KEY) key);
+// returns CL_FAILURE if key is not found
+enum cl_status LinkedBinaryTree_erase(LinkedBinaryTree * lbt, Node_type(KEY) key);
+// node MUST BE IN lbt! returns the value of the node
+void * LinkedBinaryTree_remove_node(LinkedBinaryTree * lbt, Node * node);
+// first node with key >= key. NULL if there is none
+Node * LinkedBinaryTree_lower_bound(LinkedBinaryTree * lbt, Node_type(KEY) key);
+// first node with key > key. NULL if there is none
+Node * LinkedBinaryTree_upper_bound(LinkedBinaryTree * lbt, Node_type(KEY) key);
+Node * LinkedBinaryTree_min(LinkedBinaryTree * lbt);
+Node * LinkedBinaryTree_max(LinkedBinaryTree * lbt);
+// in-order neighbors. NULL past the ends
+Node * LinkedBinaryTree_next(LinkedBinaryTree * lbt, Node * node);
+Node * LinkedBinaryTree_prev(LinkedBinaryTree * lbt, Node * node);
+
+// order statistics from the SIZE attribute. All O(log N)
+// node at index k (0-based) in order. NULL if k >= size
+Node * LinkedBinaryTree_select(LinkedBinaryTree * lbt, size_t k);
+// number of keys < key
+size_t LinkedBinaryTree_rank(LinkedBinaryTree * lbt, Node_type(KEY) key);
+// index of node in order. node MUST BE IN lbt!
+size_t LinkedBinaryTree_node_rank(LinkedBinaryTree * lbt, Node * node);
+// number of keys in [start_key, end_key)
+size_t LinkedBinaryTree_count_range(LinkedBinaryTree * lbt, Node_type(KEY) start_key, Node_type(KEY) end_key);
+
+// bulk construction. Replaces the contents of lbt with a balanced tree in O(N). The nodes are allocated in one block
+// in sorted order; nodes of the block that are removed are only released when lbt is cleared. Not available for
+// interval trees, whose END is not known to these functions
+// keys MUST BE SORTED by the compare of lbt. values may be NULL
+enum cl_status LinkedBinaryTree_build_from_sorted(LinkedBinaryTree * lbt, Node_type(KEY) * keys, void ** values, size_t num);
+// set operations on a and b, which must be ordered by the same compare, into dest in O(N+M). dest must be distinct
+// from a and b. Equal keys are matched one to one and the value is taken from a
+enum cl_status LinkedBinaryTree_union(LinkedBinaryTree * dest, LinkedBinaryTree * a, LinkedBinaryTree * b);
+enum cl_status LinkedBinaryTree_intersection(LinkedBinaryTree * dest, LinkedBinaryTree * a, LinkedBinaryTree * b);
+// keys of a not matched in b
+enum cl_status LinkedBinaryTree_difference(LinkedBinaryTree * dest, LinkedBinaryTree * a, LinkedBinaryTree * b);
+
+// interval tree. Requires nodes with the END & MAX_END attributes, where MAX_END is the greatest END in each subtree
+// and is maintained like SIZE. Intervals are closed, [KEY, END], and ordered by KEY. END is compared with the compare
+// of lbt. LinkedBinaryTree_insert adds [key, key]
+enum cl_status LinkedBinaryTree_insert_interval(LinkedBinaryTree * lbt, Node_type(KEY) start, Node_type(END) end, void * value);
+// removes one interval equal to [start, end]. Returns CL_FAILURE if there is none
+enum cl_status LinkedBinaryTree_erase_interval(LinkedBinaryTree * lbt, Node_type(KEY) start, Node_type(END) end);
+// O(log N) per interval found, plus O(log N)
+void LinkedBinaryTreeIntervalIterator_init(LinkedBinaryTreeIntervalIterator * lbt_iter, LinkedBinaryTree * lbt, Node_type(KEY) start, Node_type(END) end);
+// intervals containing point
+void LinkedBinaryTreeIntervalIterator_init_stab(LinkedBinaryTreeIntervalIterator * lbt_iter, LinkedBinaryTree * lbt, Node_type(KEY) point);
+void * LinkedBinaryTreeIntervalIterator_next(LinkedBinaryTreeIntervalIterator * lbt_iter);
+Node * LinkedBinaryTreeIntervalIterator_next_node(LinkedBinaryTreeIntervalIterator * lbt_iter);
+enum iterator_status LinkedBinaryTreeIntervalIterator_stop(LinkedBinaryTreeIntervalIterator * lbt_iter);
+
+//Iterators. next returns the VALUE of each node
+void LinkedBinaryTreeIterator_init(LinkedBinaryTreeIterator * lbt_iter, LinkedBinaryTree * lbt, TREE_FLAG_TYPE order);
+void * LinkedBinaryTreeIterator_next(LinkedBinaryTreeIterator * lbt_iter);
+Node * LinkedBinaryTreeIterator_next_node(LinkedBinaryTreeIterator * lbt_iter);
+enum iterator_status LinkedBinaryTreeIterator_stop(LinkedBinaryTreeIterator * lbt_iter);
+void LinkedBinaryTreeIteratorIterator_init(LinkedBinaryTreeIteratorIterator * lbt_iter_iter, LinkedBinaryTreeIterator * lbt_iter);
+void * LinkedBinaryTreeIteratorIterator_next(LinkedBinaryTreeIteratorIterator * lbt_iter);
+enum iterator_status LinkedBinaryTreeIteratorIterator_stop(LinkedBinaryTreeIteratorIterator * lbt_iter);
 
-#endif // LINKEDBINARYTREE_H
\ No newline at end of file
+#endif // LINKEDBINARYTREE_H
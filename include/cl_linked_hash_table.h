@@ -47,6 +47,7 @@ typedef struct LinkedHashTableKeyIterator {
     NodeAttributes * NA;
     Node * node;
     const void * next_key;
+    size_t remaining; // elements not yet returned
     enum iterator_status stop;
 } LinkedHashTableKeyIterator;
 
@@ -54,6 +55,7 @@ typedef struct LinkedHashTableValueIterator {
     NodeAttributes * NA;
     Node * node;
     void * next_value;
+    size_t remaining; // elements not yet returned
     enum iterator_status stop;
 } LinkedHashTableValueIterator;
 
@@ -61,9 +63,22 @@ typedef struct LinkedHashTableItemIterator {
     NodeAttributes * NA;
     DictItem next_item;
     Node * node;
+    size_t remaining; // elements not yet returned
     enum iterator_status stop;
 } LinkedHashTableItemIterator;
 
+// visits the items bin by bin over a range of bins, so unlike the other iterators the order is not the insertion order.
+// Does not allocate, can be split by ranges of bins for parallel scans and is not deleted by stop
+typedef struct LinkedHashTableBinIterator {
+    NodeAttributes * NA;
+    Node ** bins;
+    size_t bin;     // next bin to visit
+    size_t end;     // bin at which iteration stops
+    Node * node;
+    DictItem next_item;
+    enum iterator_status stop;
+} LinkedHashTableBinIterator, LinkedHashTableBinIteratorIterator;
+
 DictItem * DictItem_new(void * key, void * value);
 void DictItem_init(DictItem * di, void * key, void * value);
 void DictItem_del(DictItem * di);
@@ -72,6 +87,15 @@ LinkedHashTable * LinkedHashTable_new(hash_t (*hash) (const void *, size_t), int
 void LinkedHashTable_init(LinkedHashTable * hash_table, hash_t (*hash) (const void *, size_t), int (*comp) (const void *, const void *), size_t capacity, float max_load_factor, NodeAttributes * NA);
 void LinkedHashTable_del(LinkedHashTable * hash_table);
 int LinkedHashTable_set(LinkedHashTable * hash_table, void * key, void * value);
+// single-probe find-or-insert. Returns the address of the value stored under key, inserting key with a NULL value if it
+// is not present, or NULL if the node cannot be allocated. The address stays valid until key is removed. inserted may be NULL.
+// LinkedHashTable only: use DblLinkedHashTable_upsert for a DblLinkedHashTable
+void ** LinkedHashTable_upsert(LinkedHashTable * hash_table, void * key, bool * inserted);
+// streaming hash aggregation: folds each element of an iterator into the value of its group with one probe per element.
+// key returns the key of an element, which the table keeps so it must outlive the table. accumulate updates the value
+// of the group, which is NULL when its key is first seen. Stops at the first failure of accumulate and returns it.
+// LinkedHashTable only: use DblLinkedHashTable_aggregate for a DblLinkedHashTable
+int LinkedHashTable_aggregate(LinkedHashTable * hash_table, void * iter, void * (*next)(void*), enum iterator_status (*stop)(void*), void * (*key)(void * element, void * ctx), int (*accumulate)(void ** value, void * element, void * ctx), void * ctx);
 //DoubleLinkedHashNode * LinkedHashTable_get_node(LinkedHashTable * hash_table, void * key);
 void * LinkedHashTable_get(LinkedHashTable * hash_table, void * key);
 bool LinkedHashTable_contains(LinkedHashTable * hash_table, void * key);
@@ -97,8 +121,31 @@ void LinkedHashTableItemIterator_del(LinkedHashTableItemIterator * item_iter);
 const void * LinkedHashTableKeyIterator_next(LinkedHashTableKeyIterator * key_iter);
 void * LinkedHashTableValueIterator_next(LinkedHashTableValueIterator * value_iter);
 DictItem * LinkedHashTableItemIterator_next(LinkedHashTableItemIterator * item_iter);
+size_t LinkedHashTableKeyIterator_next_n(LinkedHashTableKeyIterator * key_iter, const void ** out, size_t max);
+size_t LinkedHashTableValueIterator_next_n(LinkedHashTableValueIterator * value_iter, void ** out, size_t max);
 enum iterator_status LinkedHashTableKeyIterator_stop(LinkedHashTableKeyIterator * key_iter);
 enum iterator_status LinkedHashTableValueIterator_stop(LinkedHashTableValueIterator * value_iter);
 enum iterator_status LinkedHashTableItemIterator_stop(LinkedHashTableItemIterator * item_iter);
+// exact
+size_t LinkedHashTableKeyIterator_size_hint(LinkedHashTableKeyIterator * key_iter);
+size_t LinkedHashTableValueIterator_size_hint(LinkedHashTableValueIterator * value_iter);
+size_t LinkedHashTableItemIterator_size_hint(LinkedHashTableItemIterator * item_iter);
+
+void LinkedHashTableBinIterator_init(LinkedHashTableBinIterator * bin_iter, LinkedHashTable * hash_table);
+DictItem * LinkedHashTableBinIterator_next(LinkedHashTableBinIterator * bin_iter);
+enum iterator_status LinkedHashTableBinIterator_stop(LinkedHashTableBinIterator * bin_iter);
+// halves the remaining range of bins. grain is in bins
+bool LinkedHashTableBinIterator_split(LinkedHashTableBinIterator * bin_iter, LinkedHashTableBinIterator * other, size_t grain);
+void LinkedHashTableBinIteratorIterator_init(LinkedHashTableBinIteratorIterator * bin_iter_iter, LinkedHashTableBinIterator * bin_iter);
+DictItem * LinkedHashTableBinIteratorIterator_next(LinkedHashTableBinIteratorIterator * bin_iter);
+enum iterator_status LinkedHashTableBinIteratorIterator_stop(LinkedHashTableBinIteratorIterator * bin_iter);
+
+// result is set to the status of LinkedHashTable_aggregate over an iterable, e.g.
+// group_by(result, hash_table, line_level, count_line, NULL, pvoid, lines, nlines) where lines is an array of char *.
+// LinkedHashTable only, as LinkedHashTable_aggregate
+#define group_by(result, phash_table, key, accumulate, ctx, iterable_type, ...)                                            \
+iterable_type##Iterator UNIQUE_VAR_NAME(iterable_type);                                                                     \
+iterable_type##Iterator_init(&UNIQUE_VAR_NAME(iterable_type), __VA_ARGS__);                                                 \
+result = LinkedHashTable_aggregate(phash_table, &UNIQUE_VAR_NAME(iterable_type), (void* (*)(void*))iterable_type##Iterator_next, (enum iterator_status (*)(void*))iterable_type##Iterator_stop, key, accumulate, ctx)    \
 
 #endif // LINKED_HASH_TABLE_H
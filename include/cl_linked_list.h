@@ -51,6 +51,16 @@ void * LinkedList_remove(LinkedList * ll, size_t loc);
 void * LinkedList_pop_front(LinkedList * ll);
 void * LinkedList_pop_back(LinkedList * ll);
 
+// moves the nodes [first, last) of src in front of dest_pos in dest. dest_pos == NULL moves them to the back of dest and 
+// last == NULL moves through the back of src. dest and src may be the same list if dest_pos is not in [first, last)
+// relinking is O(1) but the predecessors of first and dest_pos must be found from the head
+enum cl_status LinkedList_splice(LinkedList * dest, Node * dest_pos, LinkedList * src, Node * first, Node * last);
+// moves node and all nodes after it in ll to the back of dest
+enum cl_status LinkedList_split_at(LinkedList * ll, Node * node, LinkedList * dest);
+
+// stable merge sort in ascending order of comp. Only the links are rearranged, no allocations
+enum cl_status LinkedList_sort(LinkedList * ll, int (*comp)(void*, void*));
+
 // generally should only use this if the elements are unique in the value or you are sure you only want the first occurrence
 // for all other use cases, the filter functionality is better.
 void * LinkedList_find(LinkedList * ll, void * value, int (*comp)(void*, void*));
@@ -58,6 +68,11 @@ void * LinkedList_find(LinkedList * ll, void * value, int (*comp)(void*, void*))
 //Iterators
 void LinkedListIterator_init(LinkedListIterator * ll_iter, LinkedList * ll);
 void * LinkedListIterator_next(LinkedListIterator * ll_iter);
+size_t LinkedListIterator_next_n(LinkedListIterator * ll_iter, void ** out, size_t max);
+// O(n) without fetching the values
+size_t LinkedListIterator_advance(LinkedListIterator * ll_iter, size_t n);
+// the size of the list, exact until the first element is taken
+size_t LinkedListIterator_size_hint(LinkedListIterator * ll_iter);
 enum iterator_status LinkedListIterator_stop(LinkedListIterator * ll_iter);
 void LinkedListIteratorIterator_init(LinkedListIteratorIterator * ll_iter_iter, LinkedListIterator * ll_iter);
 void * LinkedListIteratorIterator_next(LinkedListIteratorIterator * ll_iter);
@@ -37,13 +37,18 @@ void Node_patch(NodeAttributes * NA, Node * A, int attr_A, Node * B, int attr_B)
 #define NODE_SIZE_TYPE			size_t
 #define NODE_HEIGHT		        8
 #define NODE_HEIGHT_TYPE		size_t
-#define NODE_CHILD			    9
+// pointer-sized attributes come first so that every attribute of a packed node is naturally aligned
+#define NODE_END                9
+#define NODE_END_TYPE           const void*
+#define NODE_MAX_END            10
+#define NODE_MAX_END_TYPE       const void*
+#define NODE_CHILD			    11
 #define NODE_CHILD_TYPE			Node*
-#define NODE_NCHILD             10
+#define NODE_NCHILD             12
 #define NODE_NCHILD_TYPE        unsigned int
-#define NODE_BALANCE	        11
+#define NODE_BALANCE	        13
 #define NODE_BALANCE_TYPE		signed char
-#define NODE_COLOR              12
+#define NODE_COLOR              14
 #define NODE_COLOR_TYPE         signed char
 
 //#define Node_attr(attr_name) NODE_##attr_name##_ATTR
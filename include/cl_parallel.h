@@ -0,0 +1,93 @@
+// parallel for_each and reduce over splittable iterators (see note 5 in cl_iterators.h) on a small pool of POSIX
+// threads. The iterator of a call is split in halves until the parts reach the grain size. Each worker keeps the
+// parts it splits off in its own deque and works through them most recent first, while a worker that runs out of work
+// steals the oldest, and so largest, part of another worker and splits it in turn. Requires linking with -pthread
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "cl_core.h"
+
+#ifndef CL_PARALLEL_H
+#define CL_PARALLEL_H
+
+// maximum number of parts waiting in the deque of a worker. Splitting in halves leaves at most one part per bit of
+// size_t in the deque, beyond that a worker just processes larger parts
+#ifndef PARALLEL_DEQUE_SIZE
+#define PARALLEL_DEQUE_SIZE 64
+#endif
+
+// number of elements fetched per call from iterators with next_n
+#ifndef PARALLEL_BATCH_SIZE
+#define PARALLEL_BATCH_SIZE 64
+#endif
+
+// the functions of an iterator type that can be split. next_n is optional
+typedef struct Splittable {
+    size_t size; // of the iterator object
+    void * (*next)(void *);
+    enum iterator_status (*stop)(void *);
+    bool (*split)(void *, void *, size_t);
+    size_t (*next_n)(void *, void **, size_t);
+} Splittable;
+
+// Splittable * for the iterator of an ITERABLE defining ITERABLEIterator_split
+#define splittable(iterable_type)                                       \
+(&(Splittable) {sizeof(iterable_type##Iterator),                        \
+    (void*(*)(void*)) iterable_type##Iterator_next,                     \
+    (enum iterator_status (*)(void*)) iterable_type##Iterator_stop,     \
+    (bool (*)(void*, void*, size_t)) iterable_type##Iterator_split,     \
+    NULL})
+
+// as splittable for iterators that also define ITERABLEIterator_next_n
+#define splittable_batched(iterable_type)                               \
+(&(Splittable) {sizeof(iterable_type##Iterator),                        \
+    (void*(*)(void*)) iterable_type##Iterator_next,                     \
+    (enum iterator_status (*)(void*)) iterable_type##Iterator_stop,     \
+    (bool (*)(void*, void*, size_t)) iterable_type##Iterator_split,     \
+    (size_t (*)(void*, void**, size_t)) iterable_type##Iterator_next_n})
+
+typedef struct ThreadPool ThreadPool;
+
+typedef struct ThreadPoolWorker {
+    ThreadPool * pool;
+    unsigned int id;
+    pthread_t thread;
+} ThreadPoolWorker;
+
+// the thread calling parallel_for_each or parallel_reduce is worker 0, so nthreads - 1 threads are started. Only one
+// call may run on a pool at a time and calls must not be nested
+struct ThreadPool {
+    ThreadPoolWorker * workers;
+    unsigned int nthreads;
+    pthread_mutex_t lock;
+    pthread_cond_t start;       // a job was posted or the pool is closing
+    pthread_cond_t done;        // the last started thread finished the job
+    unsigned long generation;   // number of jobs posted
+    unsigned int busy;          // started threads still working on the current job
+    bool quit;
+    struct ParallelJob * job;
+};
+
+// nthreads == 0 uses one thread per online processor
+ThreadPool * ThreadPool_new(unsigned int nthreads);
+void ThreadPool_del(ThreadPool * pool);
+unsigned int ThreadPool_size(ThreadPool * pool);
+
+// both functions copy iter, which must not have started, and leave it unchanged. Parts are not split below grain, in
+// the unit of the iterator's split. The elements are visited concurrently and in no particular order. Return
+// CL_MALLOC_FAILURE, without visiting any element, if the working memory cannot be allocated
+
+// calls func(element, ctx) for each element. func must be safe to call from several threads at once
+enum cl_status parallel_for_each(ThreadPool * pool, Splittable * type, void * iter, size_t grain, void (*func)(void *, void *), void * ctx);
+
+// result holds the identity of the reduction on input. Each worker folds elements into its own copy of the identity
+// with accumulate(acc, element, ctx), then the copies are merged into result with combine(result, acc). Since the
+// elements are spread over the workers nondeterministically, both must be associative and commutative
+enum cl_status parallel_reduce(ThreadPool * pool, Splittable * type, void * iter, size_t grain, void * result, size_t result_size, void (*accumulate)(void *, void *, void *), void (*combine)(void *, void *), void * ctx);
+
+// adds the histogram of a radix sort (see cl_algorithms.h) of the num elements of elem_size in arr to hist of hist_len
+// counts, computing it in parts of grain elements with histogram, e.g. size_t_radix_histogram, on the threads of pool
+enum cl_status parallel_radix_histogram(ThreadPool * pool, void * arr, size_t num, size_t elem_size, size_t grain, void (*histogram)(void *, size_t, size_t *), size_t * hist, size_t hist_len);
+
+#endif // CL_PARALLEL_H
@@ -0,0 +1,60 @@
+// d-ary heap with elements stored inline in a contiguous array
+// https://en.wikipedia.org/wiki/D-ary_heap
+// the element at index i has children at arity*i+1 ... arity*i+arity. For arity 2 this is the same implicit layout as
+// ArrayBinaryTree (see array_move_index in cl_tree_utils.h). An arity of 4 halves the depth of the heap and keeps the
+// children of a node adjacent, which is usually faster for large heaps.
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "cl_core.h"
+
+#ifndef CL_PRIORITY_QUEUE_H
+#define CL_PRIORITY_QUEUE_H
+
+#ifndef PRIORITY_QUEUE_DEFAULT_CAPACITY
+#define PRIORITY_QUEUE_DEFAULT_CAPACITY 16
+#endif
+
+#define PRIORITY_QUEUE_REALLOC_FACTOR 2
+
+// identifies an element for as long as it is in the queue. Handles of removed elements are reused
+typedef size_t PriorityQueueHandle;
+
+// the element for which compare is least is at the top
+typedef struct PriorityQueue {
+    unsigned char * data;           // capacity + 1 elements; the last is scratch space for sifting
+    PriorityQueueHandle * handles;  // handle of the element at each index
+    size_t * index;                 // index of the element of each handle. Free handles are chained through it
+    size_t size;
+    size_t capacity;
+    size_t elem_size;
+    size_t next_handle;
+    size_t free_handle;
+    unsigned int arity;
+    int (*compare) (const void *, const void *);
+} PriorityQueue;
+
+PriorityQueue * PriorityQueue_new(size_t capacity, size_t elem_size, unsigned int arity, int (*compare) (const void *, const void *));
+// copies the num elements of arr and builds the heap in O(N)
+PriorityQueue * PriorityQueue_new_from_array(void * arr, size_t num, size_t elem_size, unsigned int arity, int (*compare) (const void *, const void *));
+enum cl_status PriorityQueue_init(PriorityQueue * pq, size_t capacity, size_t elem_size, unsigned int arity, int (*compare) (const void *, const void *));
+void PriorityQueue_del(PriorityQueue * pq);
+void PriorityQueue_clear(PriorityQueue * pq);
+size_t PriorityQueue_size(PriorityQueue * pq);
+bool PriorityQueue_is_empty(PriorityQueue * pq);
+// pointer to the top element or NULL if empty. Invalidated by any modification of the queue
+void * PriorityQueue_peek(PriorityQueue * pq);
+// pointer to the element of handle. Invalidated by any modification of the queue
+void * PriorityQueue_get(PriorityQueue * pq, PriorityQueueHandle handle);
+// O(log N). handle may be NULL if not needed
+enum cl_status PriorityQueue_push(PriorityQueue * pq, void * elem, PriorityQueueHandle * handle);
+// adds num elements of arr. Rebuilds the heap in O(N) when that is cheaper than pushing each. handles may be NULL
+enum cl_status PriorityQueue_extend(PriorityQueue * pq, void * arr, size_t num, PriorityQueueHandle * handles);
+// copies the top element to out, which may be NULL. Returns CL_FAILURE if empty
+enum cl_status PriorityQueue_pop(PriorityQueue * pq, void * out);
+// replaces the element of handle and restores its position, e.g. decrease-key. handle MUST be in the queue
+void PriorityQueue_update(PriorityQueue * pq, PriorityQueueHandle handle, void * elem);
+// copies the element of handle to out, which may be NULL, and removes it. handle MUST be in the queue
+void PriorityQueue_remove(PriorityQueue * pq, PriorityQueueHandle handle, void * out);
+
+#endif // CL_PRIORITY_QUEUE_H
@@ -0,0 +1,121 @@
+// adaptive radix tree (ART) used as an ordered map of C string keys to values
+// https://db.in.tum.de/~leis/papers/ART.pdf
+// each inner node branches on one byte of the key and comes in four sizes, for up to 4, 16, 48 and 256 children, so
+// sparse nodes stay small while dense nodes index their children directly. Chains of nodes with a single child are
+// collapsed into a prefix on the node below. Operations cost O(key length) regardless of the number of keys and, unlike
+// hashing, keys are kept in lexicographic order, which allows prefix queries.
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "cl_core.h"
+#include "cl_tree_utils.h"
+
+#ifndef CL_RADIX_TREE_H
+#define CL_RADIX_TREE_H
+
+// number of prefix bytes stored in an inner node. The rest of a longer prefix is skipped by lookups and checked
+// against the key of the leaf that is reached
+#ifndef RADIX_TREE_MAX_PREFIX
+#define RADIX_TREE_MAX_PREFIX 10
+#endif
+
+// node types
+#define RADIX_TREE_LEAF     0
+#define RADIX_TREE_NODE4    1
+#define RADIX_TREE_NODE16   2
+#define RADIX_TREE_NODE48   3
+#define RADIX_TREE_NODE256  4
+
+typedef struct RadixTreeNode {
+    struct RadixTreeInner * parent;
+    unsigned char type;
+} RadixTreeNode;
+
+// the key is not copied and must outlive the tree
+typedef struct RadixTreeLeaf {
+    RadixTreeNode node;
+    const char * key;
+    size_t key_len;     // including the terminating NUL, so that no key is a prefix of another
+    void * value;
+} RadixTreeLeaf;
+
+// all keys below an inner node share their first depth bytes, the last prefix_len of which are the prefix of the node.
+// The byte at depth selects the child
+typedef struct RadixTreeInner {
+    RadixTreeNode node;
+    unsigned int nchildren;
+    size_t depth;
+    size_t prefix_len;
+    unsigned char prefix[RADIX_TREE_MAX_PREFIX]; // first bytes of the prefix
+} RadixTreeInner;
+
+// keys are sorted
+typedef struct RadixTreeNode4 {
+    RadixTreeInner inner;
+    unsigned char keys[4];
+    RadixTreeNode * children[4];
+} RadixTreeNode4;
+
+typedef struct RadixTreeNode16 {
+    RadixTreeInner inner;
+    unsigned char keys[16];
+    RadixTreeNode * children[16];
+} RadixTreeNode16;
+
+// index holds 1 + the slot in children of each byte, 0 if the byte has no child
+typedef struct RadixTreeNode48 {
+    RadixTreeInner inner;
+    unsigned char index[256];
+    RadixTreeNode * children[48];
+} RadixTreeNode48;
+
+typedef struct RadixTreeNode256 {
+    RadixTreeInner inner;
+    RadixTreeNode * children[256];
+} RadixTreeNode256;
+
+// inserting an existing key fails unless flags include TREE_MOD_UPDATE, in which case the value is replaced
+typedef struct RadixTree {
+    RadixTreeNode * root;
+    size_t size;
+    TREE_FLAG_TYPE flags;
+} RadixTree;
+
+// visits the keys with a given prefix in lexicographic order. Steps between leaves with the parent links of the nodes
+// so no memory is allocated
+typedef struct RadixTreeIterator {
+    RadixTree * rt;
+    RadixTreeNode * top;    // subtree holding all keys with the prefix
+    RadixTreeLeaf * leaf;
+    enum iterator_status stop;
+} RadixTreeIterator, RadixTreeIteratorIterator;
+
+RadixTree * RadixTree_new(TREE_FLAG_TYPE flags);
+void RadixTree_init(RadixTree * rt, TREE_FLAG_TYPE flags);
+void RadixTree_del(RadixTree * rt);
+// removes all elements
+void RadixTree_clear(RadixTree * rt);
+size_t RadixTree_size(RadixTree * rt);
+bool RadixTree_is_empty(RadixTree * rt);
+
+// All O(key length)
+enum cl_status RadixTree_insert(RadixTree * rt, const char * key, void * value);
+void * RadixTree_get(RadixTree * rt, const char * key);
+bool RadixTree_contains(RadixTree * rt, const char * key);
+// returns CL_FAILURE if key is not found
+enum cl_status RadixTree_erase(RadixTree * rt, const char * key);
+// value of the longest key that is a prefix of str. If key is not NULL it is set to that key, or NULL if there is none
+void * RadixTree_longest_prefix(RadixTree * rt, const char * str, const char ** key);
+
+//Iterators. Values are returned in key order
+// iterates over the keys starting with prefix. A NULL or empty prefix visits all keys
+void RadixTreeIterator_init(RadixTreeIterator * rt_iter, RadixTree * rt, const char * prefix);
+void * RadixTreeIterator_next(RadixTreeIterator * rt_iter);
+// key of the element last returned by next
+const char * RadixTreeIterator_key(RadixTreeIterator * rt_iter);
+enum iterator_status RadixTreeIterator_stop(RadixTreeIterator * rt_iter);
+void RadixTreeIteratorIterator_init(RadixTreeIteratorIterator * rt_iter_iter, RadixTreeIterator * rt_iter);
+void * RadixTreeIteratorIterator_next(RadixTreeIteratorIterator * rt_iter);
+enum iterator_status RadixTreeIteratorIterator_stop(RadixTreeIteratorIterator * rt_iter);
+
+#endif // CL_RADIX_TREE_H
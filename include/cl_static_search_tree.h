@@ -0,0 +1,57 @@
+// read-only sorted set of fixed size elements stored inline in Eytzinger (BFS) order
+// https://en.wikipedia.org/wiki/Binary_tree#Arrays
+// the layout is 1-based: the element at index k has children at 2k and 2k+1, unlike the 0-based ArrayBinaryTree with
+// children at 2i+1 and 2i+2. The first levels of the tree, which every search visits, share a few cache lines and the
+// descendants of a node two levels down are adjacent and can be prefetched. Searches do not branch on the result of
+// each comparison.
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "cl_core.h"
+
+#ifndef CL_STATIC_SEARCH_TREE_H
+#define CL_STATIC_SEARCH_TREE_H
+
+#ifndef STATIC_SEARCH_TREE_CACHE_LINE
+#define STATIC_SEARCH_TREE_CACHE_LINE 64
+#endif
+
+typedef struct StaticSearchTree {
+    unsigned char * data;   // data + elem_size is the root, aligned to STATIC_SEARCH_TREE_CACHE_LINE
+    void * alloc;           // allocation holding data
+    size_t size;
+    size_t elem_size;
+    int (*compare) (const void *, const void *);
+} StaticSearchTree;
+
+// iterates over the elements in sorted order
+typedef struct StaticSearchTreeIterator {
+    StaticSearchTree * sst;
+    size_t index;
+    enum iterator_status stop;
+} StaticSearchTreeIterator, StaticSearchTreeIteratorIterator;
+
+// arr MUST BE SORTED by compare. Its num elements of elem_size bytes are copied
+StaticSearchTree * StaticSearchTree_new(void * arr, size_t num, size_t elem_size, int (*compare) (const void *, const void *));
+enum cl_status StaticSearchTree_init(StaticSearchTree * sst, void * arr, size_t num, size_t elem_size, int (*compare) (const void *, const void *));
+void StaticSearchTree_del(StaticSearchTree * sst);
+size_t StaticSearchTree_size(StaticSearchTree * sst);
+bool StaticSearchTree_is_empty(StaticSearchTree * sst);
+
+// All O(log N). key is compared as the second argument of compare. Return pointers into the tree or NULL if not found
+// first element >= key
+void * StaticSearchTree_lower_bound(StaticSearchTree * sst, const void * key);
+// first element > key
+void * StaticSearchTree_upper_bound(StaticSearchTree * sst, const void * key);
+void * StaticSearchTree_find(StaticSearchTree * sst, const void * key);
+bool StaticSearchTree_contains(StaticSearchTree * sst, const void * key);
+
+//Iterators
+void StaticSearchTreeIterator_init(StaticSearchTreeIterator * sst_iter, StaticSearchTree * sst);
+void * StaticSearchTreeIterator_next(StaticSearchTreeIterator * sst_iter);
+enum iterator_status StaticSearchTreeIterator_stop(StaticSearchTreeIterator * sst_iter);
+void StaticSearchTreeIteratorIterator_init(StaticSearchTreeIteratorIterator * sst_iter_iter, StaticSearchTreeIterator * sst_iter);
+void * StaticSearchTreeIteratorIterator_next(StaticSearchTreeIteratorIterator * sst_iter);
+enum iterator_status StaticSearchTreeIteratorIterator_stop(StaticSearchTreeIteratorIterator * sst_iter);
+
+#endif // CL_STATIC_SEARCH_TREE_H
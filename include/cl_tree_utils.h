@@ -15,6 +15,10 @@
 
 #define TREE_FLAG_TYPE unsigned int
 
+// values of the COLOR attribute in red-black trees
+#define TREE_COLOR_BLACK			0
+#define TREE_COLOR_RED				1
+
 #define TREE_ITERATE_ORDER_MASK			0x03
 #define TREE_ITERATE_INORDER			0x00
 #define TREE_ITERATE_PREORDER			0x01
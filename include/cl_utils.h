@@ -138,6 +138,14 @@ enum cl_status cl_reverse_buffered(void *, void *, size_t, void *);
 
 void cl_parray_left_justify(void ** arr, size_t capacity);
 
+// stable merge sort of an array of pointers where comp is applied to the pointers themselves, e.g. the elements of the containers
+// runs of CL_PARRAY_SORT_RUN are insertion sorted before merging. The buffered version requires buf to hold at least num pointers
+#ifndef CL_PARRAY_SORT_RUN
+#define CL_PARRAY_SORT_RUN 16
+#endif // CL_PARRAY_SORT_RUN
+enum cl_status cl_parray_sort(void ** arr, size_t num, int (*comp)(void*, void*));
+void cl_parray_sort_buffered(void ** arr, size_t num, int (*comp)(void*, void*), void ** buf);
+
 /************************* HANDLING SIGNS *************************/
 
 /******************************** COMPARISON *********************************/
@@ -1 +1,63 @@
-//https://en.wikipedia.org/wiki/XOR_linked_list
\ No newline at end of file
+// https://en.wikipedia.org/wiki/XOR_linked_list
+// each node stores a single link that is the XOR of the addresses of its neighbors. Traversal in either
+// direction requires knowing the address of the node you came from, so Nodes cannot be navigated in
+// isolation. Uses the same amount of memory as a LinkedList but can be traversed in both directions.
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "cl_iterators.h"
+#include "cl_node.h"
+
+#ifndef CL_XOR_LINKED_LIST_H
+#define CL_XOR_LINKED_LIST_H
+
+typedef struct XorLinkedList {
+    NodeAttributes * NA;
+    Node * head;
+    Node * tail;
+    size_t size;
+} XorLinkedList;
+
+typedef struct XorLinkedListIterator {
+    XorLinkedList * xll;
+    Node * prev;
+    Node * node;
+    enum iterator_status stop;
+} XorLinkedListIterator, XorLinkedListIteratorIterator;
+
+XorLinkedList * XorLinkedList_new(unsigned int flags, int narg_pairs, ...);
+void XorLinkedList_init(XorLinkedList * xll, NodeAttributes * NA);
+void XorLinkedList_del(XorLinkedList * xll);
+void XorLinkedList_reverse(XorLinkedList * xll);
+size_t XorLinkedList_size(XorLinkedList * xll);
+bool XorLinkedList_is_empty(XorLinkedList * xll);
+bool XorLinkedList_contains(XorLinkedList * xll, void * value, int (*comp)(void*, void*));
+enum cl_status XorLinkedList_extend(XorLinkedList * dest, XorLinkedList * src);
+void * XorLinkedList_peek_front(XorLinkedList * xll);
+void * XorLinkedList_peek_back(XorLinkedList * xll);
+void * XorLinkedList_get(XorLinkedList * xll, size_t index);
+enum cl_status XorLinkedList_insert(XorLinkedList * xll, size_t loc, void * val);
+enum cl_status XorLinkedList_push_front(XorLinkedList * xll, void * val);
+enum cl_status XorLinkedList_push_back(XorLinkedList * xll, void * val);
+void * XorLinkedList_remove(XorLinkedList * xll, size_t loc);
+void * XorLinkedList_pop_front(XorLinkedList * xll);
+void * XorLinkedList_pop_back(XorLinkedList * xll);
+
+// generally should only use this if the elements are unique in the value or you are sure you only want the first occurrence
+// for all other use cases, the filter functionality is better.
+void * XorLinkedList_find(XorLinkedList * xll, void * value, int (*comp)(void*, void*));
+
+//Iterators
+void XorLinkedListIterator_init(XorLinkedListIterator * xll_iter, XorLinkedList * xll);
+void * XorLinkedListIterator_next(XorLinkedListIterator * xll_iter);
+size_t XorLinkedListIterator_next_n(XorLinkedListIterator * xll_iter, void ** out, size_t max);
+// O(n) without fetching the values
+size_t XorLinkedListIterator_advance(XorLinkedListIterator * xll_iter, size_t n);
+// the size of the list, exact until the first element is taken
+size_t XorLinkedListIterator_size_hint(XorLinkedListIterator * xll_iter);
+enum iterator_status XorLinkedListIterator_stop(XorLinkedListIterator * xll_iter);
+void XorLinkedListIteratorIterator_init(XorLinkedListIteratorIterator * xll_iter_iter, XorLinkedListIterator * xll_iter);
+void * XorLinkedListIteratorIterator_next(XorLinkedListIteratorIterator * xll_iter);
+enum iterator_status XorLinkedListIteratorIterator_stop(XorLinkedListIteratorIterator * xll_iter);
+
+#endif // CL_XOR_LINKED_LIST_H
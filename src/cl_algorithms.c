@@ -0,0 +1,87 @@
+#include "cl_algorithms.h"
+
+define_array_algorithms(double, double, CL_LESS)
+define_array_algorithms(float, float, CL_LESS)
+define_array_algorithms(long, long, CL_LESS)
+define_array_algorithms(int, int, CL_LESS)
+define_array_algorithms(size_t, size_t, CL_LESS)
+
+define_array_radix_sort(size_t, size_t, size_t, CL_RADIX_SIZE_T_KEY)
+define_array_radix_sort(long, long, unsigned long, CL_RADIX_LONG_KEY)
+define_array_radix_sort(int, int, unsigned int, CL_RADIX_INT_KEY)
+define_array_radix_sort(pvoid, pvoid, uintptr_t, CL_RADIX_PVOID_KEY)
+
+// the strings of arr share their first depth bytes
+static void cstr_insertion_sort(char ** arr, size_t num, size_t depth) {
+    for (size_t i = 1; i < num; i++) {
+        char * tmp = arr[i];
+        size_t j = i;
+        while (j && strcmp(tmp + depth, arr[j-1] + depth) < 0) {
+            arr[j] = arr[j-1];
+            j--;
+        }
+        arr[j] = tmp;
+    }
+}
+
+// the strings of arr share their first depth bytes. Recurses into all buckets but the largest, which is sorted in the
+// loop, so the recursion is at most log2(num) deep however long the common prefixes are
+static void cstr_radix_sort_range(char ** arr, size_t num, size_t depth, char ** buf) {
+    while (num > CL_SORT_INSERTION) {
+        size_t count[UCHAR_MAX + 1] = {0};
+        for (size_t i = 0; i < num; i++) {
+            count[(unsigned char) arr[i][depth]]++;
+        }
+        size_t start[UCHAR_MAX + 1];
+        size_t offset = 0, largest = 0;
+        for (size_t c = 0; c <= UCHAR_MAX; c++) {
+            start[c] = offset;
+            offset += count[c];
+            if (count[c] > count[largest]) {
+                largest = c;
+            }
+        }
+        if (count[largest] < num) {
+            size_t pos[UCHAR_MAX + 1];
+            memcpy(pos, start, sizeof(pos));
+            for (size_t i = 0; i < num; i++) {
+                buf[pos[(unsigned char) arr[i][depth]]++] = arr[i];
+            }
+            memcpy(arr, buf, sizeof(char*) * num);
+        }
+        // bucket 0 holds the strings that end at depth, which are equal
+        for (size_t c = 1; c <= UCHAR_MAX; c++) {
+            if (c != largest && count[c] > 1) {
+                cstr_radix_sort_range(arr + start[c], count[c], depth + 1, buf);
+            }
+        }
+        if (!largest) {
+            return;
+        }
+        arr += start[largest];
+        num = count[largest];
+        depth++;
+    }
+    cstr_insertion_sort(arr, num, depth);
+}
+
+void cstr_radix_sort_buffered(char ** arr, size_t num, char ** buf) {
+    if (!arr || num < 2) {
+        return;
+    }
+    cstr_radix_sort_range(arr, num, 0, buf);
+}
+
+enum cl_status cstr_radix_sort(char ** arr, size_t num) {
+    if (num <= CL_SORT_INSERTION) { // no buckets necessary
+        cstr_radix_sort_buffered(arr, num, NULL);
+        return CL_SUCCESS;
+    }
+    char ** buf = (char **) CL_MALLOC(sizeof(char*) * num);
+    if (!buf) {
+        return CL_MALLOC_FAILURE;
+    }
+    cstr_radix_sort_buffered(arr, num, buf);
+    CL_FREE(buf);
+    return CL_SUCCESS;
+}
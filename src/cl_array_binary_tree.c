@@ -1,6 +1,8 @@
+#include <stdint.h> // uintptr_t
 #include <stddef.h>
 #include <stdarg.h>
 #include <stdbool.h>
+#include <string.h>
 #include <math.h>
 #include "cl_core.h"
 #include "cl_node.h"
@@ -9,8 +11,6 @@
 #include "cl_tuple.h"
 #include "cl_array_binary_tree.h"
 
-// TODO: need to fix ArrayBinaryTree_path_to when ArrayBinaryTree_traverse is available
- 
 #define DEFAULT_SCALE_FACTOR 2
 
 #define REQUIRED_NODE_FLAGS 0
@@ -21,17 +21,10 @@
 // aliases
 #define move array_move_index
 
-define_Named_Tuple(stsrc_stdest, size_t, src, size_t, dest)
-define_Named_Tuple(treevalue_deque, void*, value, Deque*, deq);
-define_Named_Tuple(max_min_st, size_t, max, size_t, min);
-
-struct ArrayBinaryTree {
-    Node ** nodes;
-    size_t capacity;
-    NodeAttributes * NA;
-    size_t size;
-    int (*compare) (Node_type(KEY), Node_type(KEY));
-};
+// nodes of the block cannot be freed individually
+static inline bool ArrayBinaryTree_in_block(ArrayBinaryTree * abt, Node * node) {
+    return (uintptr_t) node >= (uintptr_t) abt->block && (uintptr_t) node < (uintptr_t) abt->block_end;
+}
 
 void ArrayBinaryTree_init(ArrayBinaryTree * abt, size_t capacity, int (*compare) (Node_type(KEY), Node_type(KEY)), NodeAttributes * NA) {
     for (size_t i = 0; i < capacity; i++) {
@@ -41,6 +34,8 @@ void ArrayBinaryTree_init(ArrayBinaryTree * abt, size_t capacity, int (*compare)
     abt->NA = NA;
     abt->size = 0;
     abt->compare = compare;
+    abt->block = NULL;
+    abt->block_end = NULL;
 }
 ArrayBinaryTree * vArrayBinaryTree_new(size_t capacity, int (*compare) (Node_type(KEY), Node_type(KEY)), unsigned int node_flags, int narg_pairs, va_list args) {
 	ArrayBinaryTree * abt = (ArrayBinaryTree *) CL_MALLOC(sizeof(ArrayBinaryTree));
@@ -84,32 +79,23 @@ ArrayBinaryTree * ArrayBinaryTree_new(size_t capacity, int (*compare) (Node_type
 void ArrayBinaryTree_del(ArrayBinaryTree * abt) {
     for (size_t i = 0; i < abt->capacity; i++) {
         if (abt->nodes[i]) {
-            Node_del(abt->nodes[i]);
+            if (!ArrayBinaryTree_in_block(abt, abt->nodes[i])) {
+                Node_del(abt->nodes[i]);
+            }
             abt->nodes[i] = NULL;
         }
     }
+    CL_FREE(abt->block);
+    abt->block = NULL;
     CL_FREE(abt->nodes);
     abt->nodes = NULL;
     if (abt->NA) { // DEFAULT_NODE_ATTRIBUTES is statically allocated
-        CL_FREE(abt->NA);
+        NodeAttributes_del(abt->NA);
     }
     abt->NA = NULL;
     CL_FREE(abt);
 }
 
-static bool ArrayBinaryTree_is_leaf(ArrayBinaryTree * abt, size_t index) {
-	if (index < abt->size && abt->nodes[index] != NULL) {
-		size_t child = move(index, DIR_LEFT);
-		if (child >= abt->size || abt->nodes[child] == NULL) {
-			child = move(index, DIR_RIGHT);
-			if (child >= abt->size || abt->nodes[child] == NULL) {
-				return true;
-			}
-		}
-	}
-	return false;
-}
-
 size_t ArrayBinaryTree_size(ArrayBinaryTree * abt) {
 	return abt->size;
 }
@@ -192,19 +178,6 @@ size_t ArrayBinaryTree_approx_height(ArrayBinaryTree * abt) {
 	return (size_t) log2(abt->size);
 }
 
-static void ArrayBinaryTree_swap(ArrayBinaryTree * abt, size_t index1, size_t index2) {
-	Node ** temp;
-    cl_swap_buffered(abt->nodes + index1, abt->nodes + index2, sizeof(Node *), temp);
-}
-
-static void ArrayBinaryTree_swap_value(ArrayBinaryTree * abt, size_t index1, size_t index2) {
-    if (!(index1 < abt->size) || !(index2 < abt->size)) {
-        return;
-    }
-    void ** temp;
-    cl_swap_buffered(&Node_get(abt->NA, abt->nodes[index1], VALUE), &Node_get(abt->NA, abt->nodes[index1], VALUE), sizeof(Node_type(VALUE)), temp);
-}
-
 static int ArrayBinaryTree_resize(ArrayBinaryTree * abt, size_t capacity) { 
     capacity = (capacity >= abt->size) ? capacity : abt->size; // do not shrink below current size
     Node ** new_nodes = CL_REALLOC(abt->nodes, sizeof(Node*) * capacity);
@@ -219,252 +192,239 @@ static int ArrayBinaryTree_resize(ArrayBinaryTree * abt, size_t capacity) {
 	return ABT_SUCCESS;
 }
 
-void ArrayBinaryTree_move_subtree(ArrayBinaryTree * abt, size_t root, size_t target) {
-	size_t N = abt->size;
-	if (root >= N || abt->nodes[root] == NULL) {
-		return;
-	}
-	
-	if (target > root) { // shift down or parallel right
-		size_t Ncur = N;
-		size_t init_cap = 2*ArrayBinaryTree_approx_height(abt);
-        Deque * st_visit = Deque_new(init_cap); // holding pair_stsrc_stdest
-		Deque * st_traverse = Deque_new(init_cap); // holding pair_stsrc_stdest
-		Deque_push_back(st_traverse, stsrc_stdest_new(root, target));
-		
-		// find if target is in the left subtree or to the left of root
-		size_t parent = target;
-		size_t left = move(root, DIR_LEFT);
-		size_t rightmost_left_level = next_pow2(left+1)-2;
-		while (parent > rightmost_left_level) {
-			parent = move(parent, DIR_PARENT); // rightmost_left_level can never be root so we do not have to worry about the 0-->SIZE_MAX issue in _move
+// makes index addressable, extending the used extent of the array if needed
+static int ArrayBinaryTree_reserve(ArrayBinaryTree * abt, size_t index) {
+	if (index >= abt->capacity) {
+		size_t capacity = DEFAULT_SCALE_FACTOR * abt->capacity;
+		int status = ArrayBinaryTree_resize(abt, (capacity > index) ? capacity : index + 1);
+		if (status != ABT_SUCCESS) {
+			return status;
 		}
-		int dir_leader = DIR_LEFT;
-		int dir_follower = DIR_RIGHT;
-		if (parent > left) { // target is to the right of the root
-			int dir_leader = DIR_RIGHT;
-			int dir_follower = DIR_LEFT;
-		}
-		while (Deque_size(st_traverse)) {
-			stsrc_stdest * ttail = Deque_peek_back(st_traverse);
-			if (ttail->src < N && abt->nodes[ttail->src]) {
-				Deque_push_back(st_visit, Deque_pop_back(st_traverse));
-				
-				root = move(ttail->src, dir_follower); // move to left child of source
-				target = move(ttail->dest, dir_follower); // move to left child of destination
-				Deque_push_back(st_traverse, stsrc_stdest_new(root, target));
-				
-				root = move(ttail->src, dir_leader); // move to right child of source
-				target = move(ttail->dest, dir_leader); // move to rit child of destination
-				Deque_push_back(st_traverse, stsrc_stdest_new(root, target)); // add right children to traversal stack
-			} else {
-				stsrc_stdest_del(Deque_pop_back(st_traverse));
-				ttail = Deque_peek_back(st_traverse);
-				stsrc_stdest * vtail = Deque_peek_back(st_visit); // might be NULL if empty
-				while (Deque_size(st_visit) && (!Deque_size(st_traverse) || vtail->src > ttail->src)) {
-					vtail = Deque_pop_back(st_visit);
-					if ((vtail->dest) >= Ncur) {
-						// this next line is why I cannot do a traditional traversal, which is stable only if the underlying tree is NOT modified
-						ArrayBinaryTree_resize(abt, vtail->dest + 1);
-						Ncur = abt->size;
-					}
-					ArrayBinaryTree_swap(abt, vtail->src, vtail->dest);
-					stsrc_stdest_del(vtail);
-				}
-			}
+	}
+	if (index >= abt->size) {
+		abt->size = index + 1;
+	}
+	return ABT_SUCCESS;
+}
+
+// number of slots from start up to and including the last node among the width slots of a level
+static size_t ArrayBinaryTree_level_extent(ArrayBinaryTree * abt, size_t start, size_t width) {
+	if (start >= abt->size) {
+		return 0;
+	}
+	size_t end = (abt->size - start < width) ? abt->size : start + width;
+	while (end > start && abt->nodes[end - 1] == NULL) {
+		end--;
+	}
+	return end - start;
+}
+
+// true if index is in the subtree at root
+static bool ArrayBinaryTree_in_subtree(size_t root, size_t index) {
+	while (index > root) {
+		index = move(index, DIR_PARENT);
+	}
+	return index == root;
+}
+
+// level L of the subtree at root is the contiguous run of 2^L slots starting at the leftmost descendant
+// (root+1)*2^L - 1, and it lands on the run at the same level under target. Each level is therefore a single memmove.
+// The subtree at target must be empty apart from nodes of the subtree at root. Slots of the source that are not
+// covered by the destination are left empty.
+int ArrayBinaryTree_move_subtree(ArrayBinaryTree * abt, size_t root, size_t target) {
+	if (root == target || root >= abt->size || abt->nodes[root] == NULL) {
+		return ABT_SUCCESS;
+	}
+
+	// find the depth of the subtree and the extent of the array needed to hold it at target
+	size_t src = root;
+	size_t dest = target;
+	size_t width = 1;
+	size_t extent = 0;
+	size_t count = 0;
+	while ((count = ArrayBinaryTree_level_extent(abt, src, width))) {
+		if (dest + count > extent) {
+			extent = dest + count;
 		}
-        while (Deque_size(st_visit)) {
-            stsrc_stdest_del(Deque_pop_back(st_visit));
-        }
-		Deque_del(st_visit);
-		Deque_del(st_traverse);
-	} else if (target < root) { // shift up or parallel left
-		if (target < 0) {
-			assert(target >= 0);
-			// handle error
+		src = move(src, DIR_LEFT);
+		dest = move(dest, DIR_LEFT);
+		width <<= 1;
+	}
+	int status = ArrayBinaryTree_reserve(abt, extent - 1);
+	if (status != ABT_SUCCESS) {
+		return status;
+	}
+
+	// a level never overlaps the level it moves to: they are either at different depths or in disjoint subtrees. When
+	// moving into its own subtree, the deeper levels must be vacated first; otherwise the shallower ones must.
+	if (ArrayBinaryTree_in_subtree(root, target)) {
+		while (width > 1) {
+			src = move(src, DIR_PARENT);
+			dest = move(dest, DIR_PARENT);
+			width >>= 1;
+			count = ArrayBinaryTree_level_extent(abt, src, width);
+			memmove(abt->nodes + dest, abt->nodes + src, count * sizeof(Node *));
+			memset(abt->nodes + src, 0, count * sizeof(Node *));
 		}
-		
-		// perform a preorder traversal of the tree moving subtree elements at root to subtree rooted at target
-		size_t init_cap = 2*ArrayBinaryTree_approx_height(abt);
-		Deque * st_traverse = Deque_new(init_cap); // holding pair_stsrc_stdest
-		Deque_push_back(st_traverse, stsrc_stdest_new(root, target));
-		while (Deque_size(st_traverse)) {
-			stsrc_stdest * ttail = Deque_pop_front(st_traverse);
-			if (ttail->src < abt->size && abt->nodes[ttail->src] != NULL) {
-				ArrayBinaryTree_swap(abt, ttail->src, ttail->dest); // swap source and destination
-				
-				root = move(ttail->src, DIR_RIGHT); // move to the right child of source
-				target = move(ttail->dest, DIR_RIGHT); // move to the right child of destination
-				Deque_push_back(st_traverse, stsrc_stdest_new(root, target));
-				
-				root = move(ttail->src, DIR_LEFT); // move to the left child of source
-				target = move(ttail->dest, DIR_LEFT); // move to the left child of destination
-				Deque_push_back(st_traverse, stsrc_stdest_new(root, target));
-			}
-			stsrc_stdest_del(ttail);
+	} else {
+		src = root;
+		dest = target;
+		width = 1;
+		while ((count = ArrayBinaryTree_level_extent(abt, src, width))) {
+			memmove(abt->nodes + dest, abt->nodes + src, count * sizeof(Node *));
+			memset(abt->nodes + src, 0, count * sizeof(Node *));
+			src = move(src, DIR_LEFT);
+			dest = move(dest, DIR_LEFT);
+			width <<= 1;
 		}
-		Deque_del(st_traverse); // do not have to dealloc anything since the Deque should be empty to reach this point
 	}
-	// else do nothing and return
+	return ABT_SUCCESS;
 }
 
+// rotating left lifts the right child into index. Each of the three subtrees that change position is moved with
+// ArrayBinaryTree_move_subtree in an order that keeps its destination vacant
 int ArrayBinaryTree_rotate(ArrayBinaryTree * abt, size_t index, int dir) {
-	size_t N = abt->size;
-	if (index >= N || abt->nodes[index] != NULL || !(dir == DIR_LEFT || dir == DIR_RIGHT)) {
-		return CL_SUCCESS; // do nothing because it cannot be rotated. really should be InputError
+	if (index >= abt->size) {
+		return ABT_INDEX_OUT_OF_BOUNDS;
 	}
-	
-	size_t left_child = move(index, DIR_LEFT);
-	size_t right_child = move(index, DIR_RIGHT);
-	
-	if (dir == DIR_LEFT) {
-		if (right_child >= N || abt->nodes[right_child] == NULL) { // cannot rotate left
-			return CL_SUCCESS;
-		}
-		
-		// move index's left child subtree down to its left // down and left move
-		ArrayBinaryTree_move_subtree(abt, left_child, move(left_child, DIR_LEFT));
-		
-		// swap index to its left child position
-		ArrayBinaryTree_swap(abt, index, left_child);
-		
-		// move index's right child's left subtree to index's left child's right subtree // left move
-		ArrayBinaryTree_move_subtree(abt, move(right_child, DIR_LEFT), move(left_child, DIR_RIGHT));
-		
-		// swap index's right child to index
-		ArrayBinaryTree_swap(abt, index, right_child);
-		
-		// move index's right child's right subtree up to index's right subtree // up and left move
-		ArrayBinaryTree_move_subtree(abt, move(right_child, DIR_RIGHT), right_child);
-	} else if (dir == DIR_RIGHT) {
-		if (left_child >= N || abt->nodes[left_child] == NULL) { // cannot rotate right
-			return CL_SUCCESS;
-		}
-		// if rotating right, the swaps require AT LEAST a tree of size right_child + 1
-		if (right_child >= N) {
-			ArrayBinaryTree_resize(abt, right_child+1);
-		}
-		// move index's right child down to its right // down and right move
-		ArrayBinaryTree_move_subtree(abt, right_child, move(right_child, DIR_RIGHT));
-		
-		// swap index to its right child position
-		ArrayBinaryTree_swap(abt, index, right_child);
-		
-		// move index's left child's right subtree to index's right child's left subtree // right move
-        ArrayBinaryTree_move_subtree(abt, move(left_child, DIR_RIGHT), move(right_child, DIR_LEFT));
-		
-		// swap index's left child to index
-        ArrayBinaryTree_swap(abt, index, left_child);
-        
-        // move index's left child's left subtree up to index's left subtree // up and right
-        ArrayBinaryTree_move_subtree(abt, move(left_child, DIR_LEFT), left_child);
+	size_t child = move(index, -dir); // moves up into index
+	size_t other = move(index, dir); // receives index
+	if (abt->nodes[index] == NULL || !(dir == DIR_LEFT || dir == DIR_RIGHT) || child >= abt->size || abt->nodes[child] == NULL) { // cannot rotate
+		return ABT_FAILURE;
 	}
-	
-	return CL_SUCCESS;
+
+	int status = ArrayBinaryTree_move_subtree(abt, other, move(other, dir));
+	if (status == ABT_SUCCESS) {
+		status = ArrayBinaryTree_reserve(abt, other);
+	}
+	if (status != ABT_SUCCESS) {
+		return status;
+	}
+	abt->nodes[other] = abt->nodes[index];
+
+	// inner subtree of child moves across to the inner side of other
+	status = ArrayBinaryTree_move_subtree(abt, move(child, dir), move(other, -dir));
+	if (status != ABT_SUCCESS) {
+		return status;
+	}
+	abt->nodes[index] = abt->nodes[child];
+	abt->nodes[child] = NULL;
+
+	// outer subtree of child moves up into its place
+	return ArrayBinaryTree_move_subtree(abt, move(child, -dir), child);
 }
 
+// double rotation: the grandchild on the inside of the rotation becomes the root of the subtree at index
 int ArrayBinaryTree_split_rotate(ArrayBinaryTree * abt, size_t index, int dir) {
-    size_t N = abt->size;
-    if (index >= N || abt->nodes[index] == NULL) {
-        return CL_SUCCESS; // do nothing because it cannot be rotated or rotating is meaningless
-	}
-    size_t left_child = move(index, DIR_LEFT);
-    size_t right_child = move(index, DIR_RIGHT);
-    
-    if (dir == DIR_LEFT) {
-        size_t grandchild = move(right_child, DIR_LEFT);
-        if (right_child >= N || grandchild >= N || abt->nodes[right_child] == NULL || abt->nodes[grandchild] == NULL) { // cannot rotate left
-            return CL_SUCCESS;
-		}
-        // move left_child to its left subtree // might incur O(N) memory increase and build time
-        ArrayBinaryTree_move_subtree(abt, left_child, move(left_child, DIR_LEFT));
-        
-        // swap index and left_child
-        ArrayBinaryTree_swap(abt, index, left_child);
-        
-        // swap grandchild and index
-        ArrayBinaryTree_swap(abt, index, grandchild);
-        
-        // move grandchild's left subtree to left_child's right subtree
-        ArrayBinaryTree_move_subtree(abt, move(grandchild, DIR_LEFT), move(left_child, DIR_RIGHT));
-        
-        // move granchild's right subtree to right_child's left subtree
-        ArrayBinaryTree_move_subtree(abt, move(grandchild, DIR_RIGHT), move(right_child, DIR_LEFT));
-	} else if (dir == DIR_RIGHT) {
-        size_t grandchild = move(left_child, DIR_RIGHT);
-        if (left_child >= N || grandchild >= N || abt->nodes[left_child] == NULL || abt->nodes[grandchild] == NULL) { // cannot rotate right
-            return CL_SUCCESS;
-		}
-        if (grandchild >= N) {
-            ArrayBinaryTree_resize(abt, grandchild+1);
-		}
-        
-        // move right_child to its right subtree // might incur O(N) memory increase and build time
-        ArrayBinaryTree_move_subtree(abt, right_child, move(right_child, DIR_RIGHT));
-        // swap index and right_child
-        ArrayBinaryTree_swap(abt, index, right_child);
-        // swap grandchild and index
-        ArrayBinaryTree_swap(abt, index, grandchild);
-        // move granchild's right subtree to right_child's left subtree
-        ArrayBinaryTree_move_subtree(abt, move(grandchild, DIR_RIGHT), move(right_child, DIR_LEFT));
-        // move grandchild's left subtree to left_child's right subtree
-        ArrayBinaryTree_move_subtree(abt, move(grandchild, DIR_LEFT), move(left_child, DIR_RIGHT));
-        
-    } else {
-		return CL_FAILURE;
-	}
-    
-    return CL_SUCCESS;
-}
-// check if node has a parent attribute and use a more efficient algorithm
-size_t ArrayBinaryTree_leftmost(ArrayBinaryTree * abt, size_t index, Deque * path) {
-	int destroy = (!path) ? 1 : 0;
-	if (destroy) {
-		path = Deque_new(2*ArrayBinaryTree_approx_height(abt));
+	if (index >= abt->size) {
+		return ABT_INDEX_OUT_OF_BOUNDS;
 	}
-	
-	size_t N = abt->size;
-	while (index < N && abt->nodes[index] != NULL) {
-		size_t * next_ = malloc(sizeof(size_t));
-		*next_ = index;
-		Deque_push_back(path, next_);
-		index = move(index, DIR_LEFT);
+	size_t child = move(index, -dir);
+	size_t grandchild = move(child, dir);
+	size_t other = move(index, dir);
+	if (abt->nodes[index] == NULL || !(dir == DIR_LEFT || dir == DIR_RIGHT) || grandchild >= abt->size || abt->nodes[child] == NULL || abt->nodes[grandchild] == NULL) { // cannot rotate
+		return ABT_FAILURE;
 	}
-	
-	size_t result = *(size_t*)Deque_peek_back(path);
-	
-    while (Deque_size(path)) {
-        CL_FREE(Deque_pop_back(path));
+
+	int status = ArrayBinaryTree_move_subtree(abt, other, move(other, dir));
+	if (status == ABT_SUCCESS) {
+		status = ArrayBinaryTree_reserve(abt, other);
+	}
+	if (status != ABT_SUCCESS) {
+		return status;
+	}
+	abt->nodes[other] = abt->nodes[index];
+	abt->nodes[index] = abt->nodes[grandchild];
+	abt->nodes[grandchild] = NULL;
+
+	status = ArrayBinaryTree_move_subtree(abt, move(grandchild, dir), move(other, -dir));
+	if (status != ABT_SUCCESS) {
+		return status;
+	}
+	return ArrayBinaryTree_move_subtree(abt, move(grandchild, -dir), grandchild);
+}
+
+// nodes in a block are padded so that their pointer and size_t attributes stay aligned
+#define BLOCK_ALIGN (sizeof(void *) > sizeof(size_t) ? sizeof(void *) : sizeof(size_t))
+
+// places the next nodes of the block by an in-order walk of the complete tree. Returns the next unused node
+static unsigned char * ArrayBinaryTree_fill(ArrayBinaryTree * abt, size_t index, unsigned char * node, size_t stride, Node_type(KEY) * keys, void ** values, size_t * next) {
+    if (index >= abt->size) {
+        return node;
     }
-    Deque_del(path);
-	
-	return result;
+    NodeAttributes * NA = abt->NA;
+    node = ArrayBinaryTree_fill(abt, move(index, DIR_LEFT), node, stride, keys, values, next);
+    memcpy(node, NA->defaults, NA->size);
+    if (Node_has(NA, KEY)) {
+        Node_get(NA, node, KEY) = keys[*next]; // the copied default KEY is not a set key
+    }
+    if (Node_has(NA, VALUE)) {
+        Node_set(NA, node, VALUE, values ? values[*next] : NULL);
+    }
+    abt->nodes[index] = node;
+    (*next)++;
+    return ArrayBinaryTree_fill(abt, move(index, DIR_RIGHT), node + stride, stride, keys, values, next);
 }
-// check if node has a parent attribute and use a more efficient algorithm
-size_t ArrayBinaryTree_rightmost(ArrayBinaryTree * abt, size_t index, Deque * path) {
-	if (!path) {
-		path = Deque_new(2*ArrayBinaryTree_approx_height(abt));
+
+// the nodes form a complete tree occupying exactly indices [0, num), allocated in one block
+int ArrayBinaryTree_build_from_sorted(ArrayBinaryTree * abt, Node_type(KEY) * keys, void ** values, size_t num) {
+    if (!abt || (num && !keys)) {
+        return ABT_FAILURE;
+    }
+    size_t stride = (abt->NA->size + BLOCK_ALIGN - 1) / BLOCK_ALIGN * BLOCK_ALIGN;
+    Node * block = NULL;
+    if (num > abt->capacity) {
+        int status = ArrayBinaryTree_resize(abt, num);
+        if (status != ABT_SUCCESS) {
+            return status;
+        }
+    }
+    if (num && !(block = (Node *) CL_MALLOC(num * stride))) {
+        return ABT_ALLOC_FAILURE;
+    }
+    for (size_t i = 0; i < abt->size; i++) {
+        if (abt->nodes[i] && !ArrayBinaryTree_in_block(abt, abt->nodes[i])) {
+            Node_del(abt->nodes[i]);
+        }
+        abt->nodes[i] = NULL;
+    }
+    CL_FREE(abt->block);
+    abt->block = block;
+    abt->block_end = block ? block + num * stride : NULL;
+    abt->size = num;
+    size_t next = 0;
+    ArrayBinaryTree_fill(abt, 0, block, stride, keys, values, &next);
+    return ABT_SUCCESS;
+}
+
+// the path to a node is implied by its index, so no path needs to be recorded on the way down
+size_t ArrayBinaryTree_leftmost(ArrayBinaryTree * abt, size_t index) {
+	if (index >= abt->size || abt->nodes[index] == NULL) {
+		return abt->size;
 	}
-	
-	size_t N = abt->size;
-	while (index < N && abt->nodes[index] != NULL) {
-		size_t * next_ = CL_MALLOC(sizeof(size_t));
-		*next_ = index;
-		Deque_push_back(path, next_);
-		index = move(index, DIR_RIGHT);
+	size_t child = move(index, DIR_LEFT);
+	while (child < abt->size && abt->nodes[child] != NULL) {
+		index = child;
+		child = move(index, DIR_LEFT);
 	}
-	
-	size_t result = *(size_t*)Deque_peek_back(path);
-	
-    while (Deque_size(path)) {
-        CL_FREE(Deque_pop_back(path));
-    }
-    Deque_del(path);
+	return index;
+}
 
-	return result;
+size_t ArrayBinaryTree_rightmost(ArrayBinaryTree * abt, size_t index) {
+	if (index >= abt->size || abt->nodes[index] == NULL) {
+		return abt->size;
+	}
+	size_t child = move(index, DIR_RIGHT);
+	while (child < abt->size && abt->nodes[child] != NULL) {
+		index = child;
+		child = move(index, DIR_RIGHT);
+	}
+	return index;
 }
 
 /* // not called anywhere? Also, the output of this is a little weird. Probably can just replace it with the max_min_st tuple
+define_Named_Tuple(max_min_st, size_t, max, size_t, min);
+
 // max_min_st must be freed by caller
 static max_min_st * ArrayBinaryTree_extremal_paths_to_leaves(ArrayBinaryTree * abt, size_t index) {
 	if (index >= abt->size || abt->nodes[index] == NULL) {
@@ -489,35 +449,33 @@ static max_min_st * ArrayBinaryTree_extremal_paths_to_leaves(ArrayBinaryTree * a
 }
 */
 
-static unsigned char ArrayBinaryTree_path_to_helper(ArrayBinaryTree * abt, size_t index, void * tvd) {
-	if (!abt->compare(Node_get(abt->NA, abt->nodes[index], KEY), ((treevalue_deque*)tvd)->value)) {
-        size_t * el = CL_MALLOC(sizeof(size_t));
-        *el = index;
-        Deque_push_back(((treevalue_deque*)tvd)->deq, el);
-        return TRAVERSE_STOP;
-    }
-	return TRAVERSE_GO;
+size_t ArrayBinaryTree_find(ArrayBinaryTree * abt, Node_type(KEY) key) {
+	size_t index = 0;
+	while (index < abt->size && abt->nodes[index] != NULL) {
+		int comp = abt->compare(key, Node_get(abt->NA, abt->nodes[index], KEY));
+		if (!comp) {
+			return index;
+		}
+		index = move(index, (comp < 0) ? DIR_LEFT : DIR_RIGHT);
+	}
+	return abt->size;
 }
 
-// TODO: need to fix when ArrayBinaryTree_traverse is available
-Deque * ArrayBinaryTree_path_to(ArrayBinaryTree * abt, void * value) {
-	Deque * st_out = Deque_new(ArrayBinaryTree_approx_height(abt));
-	treevalue_deque helper_input = {value, st_out};
-	
-	//ArrayBinaryTree_traverse(abt, ArrayBinaryTree_path_to_helper, &helper_input);
-	
-	if (Deque_size(st_out)) {
-		size_t * top = Deque_peek_back(st_out);
-		size_t parent = move(*top, DIR_PARENT);
-		while (parent < *top) {
-			size_t * el = CL_MALLOC(sizeof(size_t));
-			*el = parent;
-			Deque_push_back(st_out, el);
-			top = el;
-			parent = move(*top, DIR_PARENT);
+// the indices are stored in path as (void*)(uintptr_t) index, root first
+int ArrayBinaryTree_path_to(CircularBuffer * path, ArrayBinaryTree * abt, Node_type(KEY) key) {
+	size_t index = ArrayBinaryTree_find(abt, key);
+	if (index >= abt->size) {
+		return ABT_FAILURE;
+	}
+	size_t parent = move(index, DIR_PARENT);
+	while (true) {
+		if (CircularBuffer_push_front(path, (void *) (uintptr_t) index) != CL_SUCCESS) {
+			return ABT_ALLOC_FAILURE;
+		}
+		if (parent >= index) { // the parent of the root wraps around past every index
+			return ABT_SUCCESS;
 		}
+		index = parent;
+		parent = move(index, DIR_PARENT);
 	}
-	
-	Deque_reverse(st_out);
-	return st_out;
-}
\ No newline at end of file
+}
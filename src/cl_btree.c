@@ -0,0 +1,570 @@
+#include <stddef.h>
+#include <string.h>
+#include "cl_core.h"
+#include "cl_btree.h"
+
+#if BTREE_MAX_KEYS < 4
+#error "BTREE_MAX_KEYS must be at least 4"
+#endif
+
+#define INNER(node) ((BTreeInner *) (node))
+#define LEAF(node) ((BTreeLeaf *) (node))
+
+static BTreeLeaf * BTreeLeaf_new(void) {
+    BTreeLeaf * leaf = (BTreeLeaf *) CL_MALLOC(sizeof(BTreeLeaf));
+    if (!leaf) {
+        return NULL;
+    }
+    leaf->node.nkeys = 0;
+    leaf->node.leaf = true;
+    leaf->prev = NULL;
+    leaf->next = NULL;
+    return leaf;
+}
+
+static BTreeInner * BTreeInner_new(void) {
+    BTreeInner * inner = (BTreeInner *) CL_MALLOC(sizeof(BTreeInner));
+    if (!inner) {
+        return NULL;
+    }
+    inner->node.nkeys = 0;
+    inner->node.leaf = false;
+    return inner;
+}
+
+// recursion depth is the height of the tree, O(log N)
+static void BTreeNode_del(BTreeNode * node) {
+    if (!node->leaf) {
+        for (unsigned int i = 0; i <= node->nkeys; i++) {
+            BTreeNode_del(INNER(node)->children[i]);
+        }
+    }
+    CL_FREE(node);
+}
+
+// first index i such that keys[i] >= key
+static unsigned int BTree_lower_index(BTree * bt, BTreeNode * node, Node_type(KEY) key) {
+    unsigned int lo = 0;
+    unsigned int n = node->nkeys;
+    while (n) {
+        unsigned int half = n / 2;
+        if (bt->compare(node->keys[lo + half], key) < 0) {
+            lo += half + 1;
+            n -= half + 1;
+        } else {
+            n = half;
+        }
+    }
+    return lo;
+}
+
+// first index i such that keys[i] > key. Also the index of the child of an inner node that can hold key
+static unsigned int BTree_upper_index(BTree * bt, BTreeNode * node, Node_type(KEY) key) {
+    unsigned int lo = 0;
+    unsigned int n = node->nkeys;
+    while (n) {
+        unsigned int half = n / 2;
+        if (bt->compare(key, node->keys[lo + half]) < 0) {
+            n = half;
+        } else {
+            lo += half + 1;
+            n -= half + 1;
+        }
+    }
+    return lo;
+}
+
+static BTreeLeaf * BTree_find_leaf(BTree * bt, Node_type(KEY) key) {
+    BTreeNode * node = bt->root;
+    if (!node) {
+        return NULL;
+    }
+    while (!node->leaf) {
+        node = INNER(node)->children[BTree_upper_index(bt, node, key)];
+    }
+    return LEAF(node);
+}
+
+static Node_type(KEY) BTreeNode_min(BTreeNode * node) {
+    while (!node->leaf) {
+        node = INNER(node)->children[0];
+    }
+    return node->keys[0];
+}
+
+BTree * BTree_new(int (*compare) (Node_type(KEY), Node_type(KEY)), TREE_FLAG_TYPE flags) {
+    BTree * bt = (BTree *) CL_MALLOC(sizeof(BTree));
+    if (!bt) {
+        return NULL;
+    }
+    BTree_init(bt, compare, flags);
+    return bt;
+}
+
+void BTree_init(BTree * bt, int (*compare) (Node_type(KEY), Node_type(KEY)), TREE_FLAG_TYPE flags) {
+    if (!bt) {
+        return;
+    }
+    bt->root = NULL;
+    bt->first = NULL;
+    bt->last = NULL;
+    bt->size = 0;
+    bt->height = 0;
+    bt->compare = compare;
+    bt->flags = flags;
+}
+
+void BTree_clear(BTree * bt) {
+    if (bt->root) {
+        BTreeNode_del(bt->root);
+    }
+    bt->root = NULL;
+    bt->first = NULL;
+    bt->last = NULL;
+    bt->size = 0;
+    bt->height = 0;
+}
+
+void BTree_del(BTree * bt) {
+    BTree_clear(bt);
+    CL_FREE(bt);
+}
+
+size_t BTree_size(BTree * bt) {
+    if (!bt) {
+        return 0;
+    }
+    return bt->size;
+}
+
+bool BTree_is_empty(BTree * bt) {
+    return bt->size == 0;
+}
+
+void * BTree_get(BTree * bt, Node_type(KEY) key) {
+    BTreeLeaf * leaf = BTree_find_leaf(bt, key);
+    if (!leaf) {
+        return NULL;
+    }
+    unsigned int pos = BTree_lower_index(bt, &leaf->node, key);
+    if (pos == leaf->node.nkeys || bt->compare(leaf->node.keys[pos], key)) {
+        return NULL;
+    }
+    return leaf->values[pos];
+}
+
+bool BTree_contains(BTree * bt, Node_type(KEY) key) {
+    BTreeLeaf * leaf = BTree_find_leaf(bt, key);
+    if (!leaf) {
+        return false;
+    }
+    unsigned int pos = BTree_lower_index(bt, &leaf->node, key);
+    return pos < leaf->node.nkeys && !bt->compare(leaf->node.keys[pos], key);
+}
+
+Node_type(KEY) BTree_min(BTree * bt) {
+    if (!bt->first) {
+        return NULL;
+    }
+    return bt->first->node.keys[0];
+}
+
+Node_type(KEY) BTree_max(BTree * bt) {
+    if (!bt->last) {
+        return NULL;
+    }
+    return bt->last->node.keys[bt->last->node.nkeys - 1];
+}
+
+/*********************************** INSERT ***********************************/
+
+// a full inner node on the path is split only after the insertion below it has succeeded, so the node for its right
+// half is allocated on the way down. Any allocation failure then happens before the tree is modified
+static enum cl_status BTree_insert_leaf(BTree * bt, BTreeLeaf * leaf, Node_type(KEY) key, void * value, Node_type(KEY) * split_key, BTreeNode ** split_node) {
+    unsigned int pos = BTree_lower_index(bt, &leaf->node, key);
+    if (pos < leaf->node.nkeys && !bt->compare(leaf->node.keys[pos], key)) {
+        if (bt->flags & TREE_MOD_UPDATE) {
+            leaf->values[pos] = value;
+            return CL_SUCCESS;
+        }
+        return CL_FAILURE;
+    }
+
+    BTreeLeaf * target = leaf;
+    BTreeLeaf * right = NULL;
+    if (leaf->node.nkeys == BTREE_MAX_KEYS) {
+        right = BTreeLeaf_new();
+        if (!right) {
+            return CL_MALLOC_FAILURE;
+        }
+        unsigned int mid = BTREE_MAX_KEYS / 2;
+        right->node.nkeys = BTREE_MAX_KEYS - mid;
+        memcpy(right->node.keys, leaf->node.keys + mid, right->node.nkeys * sizeof(Node_type(KEY)));
+        memcpy(right->values, leaf->values + mid, right->node.nkeys * sizeof(void *));
+        leaf->node.nkeys = mid;
+
+        right->prev = leaf;
+        right->next = leaf->next;
+        if (leaf->next) {
+            leaf->next->prev = right;
+        } else {
+            bt->last = right;
+        }
+        leaf->next = right;
+
+        if (pos > mid) {
+            target = right;
+            pos -= mid;
+        }
+    }
+
+    unsigned int n = target->node.nkeys;
+    memmove(target->node.keys + pos + 1, target->node.keys + pos, (n - pos) * sizeof(Node_type(KEY)));
+    memmove(target->values + pos + 1, target->values + pos, (n - pos) * sizeof(void *));
+    target->node.keys[pos] = key;
+    target->values[pos] = value;
+    target->node.nkeys++;
+    bt->size++;
+
+    if (right) {
+        *split_key = right->node.keys[0];
+        *split_node = &right->node;
+    }
+    return CL_SUCCESS;
+}
+
+static enum cl_status BTree_insert_(BTree * bt, BTreeNode * node, Node_type(KEY) key, void * value, Node_type(KEY) * split_key, BTreeNode ** split_node) {
+    if (node->leaf) {
+        return BTree_insert_leaf(bt, LEAF(node), key, value, split_key, split_node);
+    }
+
+    BTreeInner * inner = INNER(node);
+    BTreeInner * right = NULL;
+    if (node->nkeys == BTREE_MAX_KEYS) {
+        right = BTreeInner_new();
+        if (!right) {
+            return CL_MALLOC_FAILURE;
+        }
+    }
+
+    unsigned int i = BTree_upper_index(bt, node, key);
+    Node_type(KEY) child_key = NULL;
+    BTreeNode * child_split = NULL;
+    enum cl_status status = BTree_insert_(bt, inner->children[i], key, value, &child_key, &child_split);
+    if (status != CL_SUCCESS || !child_split) {
+        CL_FREE(right);
+        return status;
+    }
+
+    unsigned int n = node->nkeys;
+    if (n < BTREE_MAX_KEYS) {
+        memmove(node->keys + i + 1, node->keys + i, (n - i) * sizeof(Node_type(KEY)));
+        memmove(inner->children + i + 2, inner->children + i + 1, (n - i) * sizeof(BTreeNode *));
+        node->keys[i] = child_key;
+        inner->children[i + 1] = child_split;
+        node->nkeys++;
+        return CL_SUCCESS;
+    }
+
+    // gather the overfull node, then the middle key moves up and the upper half moves to right
+    Node_type(KEY) keys[BTREE_MAX_KEYS + 1];
+    BTreeNode * children[BTREE_MAX_KEYS + 2];
+    memcpy(keys, node->keys, i * sizeof(Node_type(KEY)));
+    keys[i] = child_key;
+    memcpy(keys + i + 1, node->keys + i, (n - i) * sizeof(Node_type(KEY)));
+    memcpy(children, inner->children, (i + 1) * sizeof(BTreeNode *));
+    children[i + 1] = child_split;
+    memcpy(children + i + 2, inner->children + i + 1, (n - i) * sizeof(BTreeNode *));
+
+    unsigned int mid = (BTREE_MAX_KEYS + 1) / 2;
+    node->nkeys = mid;
+    memcpy(node->keys, keys, mid * sizeof(Node_type(KEY)));
+    memcpy(inner->children, children, (mid + 1) * sizeof(BTreeNode *));
+    right->node.nkeys = BTREE_MAX_KEYS - mid;
+    memcpy(right->node.keys, keys + mid + 1, right->node.nkeys * sizeof(Node_type(KEY)));
+    memcpy(right->children, children + mid + 1, (right->node.nkeys + 1) * sizeof(BTreeNode *));
+
+    *split_key = keys[mid];
+    *split_node = &right->node;
+    return CL_SUCCESS;
+}
+
+enum cl_status BTree_insert(BTree * bt, Node_type(KEY) key, void * value) {
+    if (!bt) {
+        return CL_VALUE_ERROR;
+    }
+    if (!bt->root) {
+        BTreeLeaf * leaf = BTreeLeaf_new();
+        if (!leaf) {
+            return CL_MALLOC_FAILURE;
+        }
+        bt->root = &leaf->node;
+        bt->first = leaf;
+        bt->last = leaf;
+        bt->height = 1;
+    }
+
+    BTreeInner * new_root = NULL;
+    if (bt->root->nkeys == BTREE_MAX_KEYS) {
+        new_root = BTreeInner_new();
+        if (!new_root) {
+            return CL_MALLOC_FAILURE;
+        }
+    }
+
+    Node_type(KEY) split_key = NULL;
+    BTreeNode * split_node = NULL;
+    enum cl_status status = BTree_insert_(bt, bt->root, key, value, &split_key, &split_node);
+    if (!split_node) {
+        CL_FREE(new_root);
+        return status;
+    }
+
+    new_root->node.nkeys = 1;
+    new_root->node.keys[0] = split_key;
+    new_root->children[0] = bt->root;
+    new_root->children[1] = split_node;
+    bt->root = &new_root->node;
+    bt->height++;
+    return status;
+}
+
+/*********************************** ERASE ************************************/
+
+// the child at index i of parent has fallen below BTREE_MIN_KEYS. Borrow from a sibling or merge with one
+static void BTree_rebalance(BTree * bt, BTreeInner * parent, unsigned int i) {
+    BTreeNode * child = parent->children[i];
+    BTreeNode * left = (i > 0) ? parent->children[i - 1] : NULL;
+    BTreeNode * right = (i < parent->node.nkeys) ? parent->children[i + 1] : NULL;
+    unsigned int n = child->nkeys;
+
+    if (left && left->nkeys > BTREE_MIN_KEYS) { // rotate the last element of left into child
+        memmove(child->keys + 1, child->keys, n * sizeof(Node_type(KEY)));
+        if (child->leaf) {
+            memmove(LEAF(child)->values + 1, LEAF(child)->values, n * sizeof(void *));
+            child->keys[0] = left->keys[left->nkeys - 1];
+            LEAF(child)->values[0] = LEAF(left)->values[left->nkeys - 1];
+            parent->node.keys[i - 1] = child->keys[0];
+        } else {
+            memmove(INNER(child)->children + 1, INNER(child)->children, (n + 1) * sizeof(BTreeNode *));
+            child->keys[0] = parent->node.keys[i - 1];
+            INNER(child)->children[0] = INNER(left)->children[left->nkeys];
+            parent->node.keys[i - 1] = left->keys[left->nkeys - 1];
+        }
+        child->nkeys++;
+        left->nkeys--;
+    } else if (right && right->nkeys > BTREE_MIN_KEYS) { // rotate the first element of right into child
+        unsigned int rn = right->nkeys;
+        if (child->leaf) {
+            child->keys[n] = right->keys[0];
+            LEAF(child)->values[n] = LEAF(right)->values[0];
+            memmove(right->keys, right->keys + 1, (rn - 1) * sizeof(Node_type(KEY)));
+            memmove(LEAF(right)->values, LEAF(right)->values + 1, (rn - 1) * sizeof(void *));
+            parent->node.keys[i] = right->keys[0];
+        } else {
+            child->keys[n] = parent->node.keys[i];
+            INNER(child)->children[n + 1] = INNER(right)->children[0];
+            parent->node.keys[i] = right->keys[0];
+            memmove(right->keys, right->keys + 1, (rn - 1) * sizeof(Node_type(KEY)));
+            memmove(INNER(right)->children, INNER(right)->children + 1, rn * sizeof(BTreeNode *));
+        }
+        child->nkeys++;
+        right->nkeys--;
+    } else { // merge the pair of child and a sibling into the left one of the pair
+        if (left) {
+            i--;
+            right = child;
+        } else {
+            left = child;
+        }
+        n = left->nkeys;
+        unsigned int rn = right->nkeys;
+        if (left->leaf) {
+            memcpy(left->keys + n, right->keys, rn * sizeof(Node_type(KEY)));
+            memcpy(LEAF(left)->values + n, LEAF(right)->values, rn * sizeof(void *));
+            left->nkeys = n + rn;
+            LEAF(left)->next = LEAF(right)->next;
+            if (LEAF(right)->next) {
+                LEAF(right)->next->prev = LEAF(left);
+            } else {
+                bt->last = LEAF(left);
+            }
+        } else {
+            left->keys[n] = parent->node.keys[i];
+            memcpy(left->keys + n + 1, right->keys, rn * sizeof(Node_type(KEY)));
+            memcpy(INNER(left)->children + n + 1, INNER(right)->children, (rn + 1) * sizeof(BTreeNode *));
+            left->nkeys = n + 1 + rn;
+        }
+        CL_FREE(right);
+
+        unsigned int pn = parent->node.nkeys;
+        memmove(parent->node.keys + i, parent->node.keys + i + 1, (pn - i - 1) * sizeof(Node_type(KEY)));
+        memmove(parent->children + i + 1, parent->children + i + 2, (pn - i - 1) * sizeof(BTreeNode *));
+        parent->node.nkeys--;
+    }
+}
+
+static enum cl_status BTree_erase_(BTree * bt, BTreeNode * node, Node_type(KEY) key, void ** value) {
+    if (node->leaf) {
+        unsigned int pos = BTree_lower_index(bt, node, key);
+        unsigned int n = node->nkeys;
+        if (pos == n || bt->compare(node->keys[pos], key)) {
+            return CL_FAILURE;
+        }
+        *value = LEAF(node)->values[pos];
+        memmove(node->keys + pos, node->keys + pos + 1, (n - pos - 1) * sizeof(Node_type(KEY)));
+        memmove(LEAF(node)->values + pos, LEAF(node)->values + pos + 1, (n - pos - 1) * sizeof(void *));
+        node->nkeys--;
+        bt->size--;
+        return CL_SUCCESS;
+    }
+
+    BTreeInner * inner = INNER(node);
+    unsigned int i = BTree_upper_index(bt, node, key);
+    enum cl_status status = BTree_erase_(bt, inner->children[i], key, value);
+    if (status != CL_SUCCESS) {
+        return status;
+    }
+    // the key may be owned by the caller so a separator must not outlive it
+    if (i > 0 && !bt->compare(node->keys[i - 1], key)) {
+        node->keys[i - 1] = BTreeNode_min(inner->children[i]);
+    }
+    if (inner->children[i]->nkeys < BTREE_MIN_KEYS) {
+        BTree_rebalance(bt, inner, i);
+    }
+    return CL_SUCCESS;
+}
+
+void * BTree_pop(BTree * bt, Node_type(KEY) key) {
+    if (!bt || !bt->root) {
+        return NULL;
+    }
+    void * value = NULL;
+    if (BTree_erase_(bt, bt->root, key, &value) != CL_SUCCESS) {
+        return NULL;
+    }
+    BTreeNode * root = bt->root;
+    if (!root->nkeys) {
+        if (root->leaf) {
+            bt->root = NULL;
+            bt->first = NULL;
+            bt->last = NULL;
+            bt->height = 0;
+        } else {
+            bt->root = INNER(root)->children[0];
+            bt->height--;
+        }
+        CL_FREE(root);
+    }
+    return value;
+}
+
+enum cl_status BTree_erase(BTree * bt, Node_type(KEY) key) {
+    if (!bt) {
+        return CL_VALUE_ERROR;
+    }
+    size_t size = bt->size;
+    BTree_pop(bt, key);
+    return (bt->size < size) ? CL_SUCCESS : CL_FAILURE;
+}
+
+//Iterators
+void BTreeIterator_init(BTreeIterator * bt_iter, BTree * bt) {
+    BTreeIterator_init_range(bt_iter, bt, NULL, NULL);
+}
+
+void BTreeIterator_init_range(BTreeIterator * bt_iter, BTree * bt, Node_type(KEY) start_key, Node_type(KEY) end_key) {
+    if (!bt_iter) {
+        return;
+    }
+    bt_iter->bt = bt;
+    bt_iter->end_key = end_key;
+    bt_iter->leaf = NULL;
+    bt_iter->index = 0;
+    bt_iter->stop = ITERATOR_STOP;
+    if (!bt || !bt->size) {
+        return;
+    }
+    if (start_key) {
+        bt_iter->leaf = BTree_find_leaf(bt, start_key);
+        bt_iter->index = BTree_lower_index(bt, &bt_iter->leaf->node, start_key);
+        if (bt_iter->index == bt_iter->leaf->node.nkeys) {
+            bt_iter->leaf = bt_iter->leaf->next;
+            bt_iter->index = 0;
+        }
+    } else {
+        bt_iter->leaf = bt->first;
+    }
+    if (bt_iter->leaf && !(end_key && bt->compare(bt_iter->leaf->node.keys[bt_iter->index], end_key) >= 0)) {
+        bt_iter->stop = ITERATOR_PAUSE;
+    }
+}
+
+// moves to the next element and returns whether one is available
+static bool BTreeIterator_advance(BTreeIterator * bt_iter) {
+    if (bt_iter->stop == ITERATOR_STOP) {
+        return false;
+    }
+    if (bt_iter->stop == ITERATOR_PAUSE) {
+        bt_iter->stop = ITERATOR_GO;
+        return true;
+    }
+    if (++bt_iter->index == bt_iter->leaf->node.nkeys) {
+        bt_iter->leaf = bt_iter->leaf->next;
+        bt_iter->index = 0;
+    }
+    if (!bt_iter->leaf || (bt_iter->end_key && bt_iter->bt->compare(bt_iter->leaf->node.keys[bt_iter->index], bt_iter->end_key) >= 0)) {
+        bt_iter->leaf = NULL;
+        bt_iter->stop = ITERATOR_STOP;
+        return false;
+    }
+    return true;
+}
+
+void * BTreeIterator_next(BTreeIterator * bt_iter) {
+    if (!bt_iter || !BTreeIterator_advance(bt_iter)) {
+        return NULL;
+    }
+    return bt_iter->leaf->values[bt_iter->index];
+}
+
+Node_type(KEY) BTreeIterator_key(BTreeIterator * bt_iter) {
+    if (!bt_iter || bt_iter->stop != ITERATOR_GO) {
+        return NULL;
+    }
+    return bt_iter->leaf->node.keys[bt_iter->index];
+}
+
+enum iterator_status BTreeIterator_stop(BTreeIterator * bt_iter) {
+    if (!bt_iter) {
+        return ITERATOR_STOP;
+    }
+    return bt_iter->stop;
+}
+
+void BTreeIteratorIterator_init(BTreeIteratorIterator * bt_iter_iter, BTreeIterator * bt_iter) {
+    BTreeIterator_init(bt_iter_iter, bt_iter->bt);
+}
+
+void * BTreeIteratorIterator_next(BTreeIteratorIterator * bt_iter) {
+    return BTreeIterator_next(bt_iter);
+}
+
+enum iterator_status BTreeIteratorIterator_stop(BTreeIteratorIterator * bt_iter) {
+    return BTreeIterator_stop(bt_iter);
+}
+
+void BTreeKeyIterator_init(BTreeKeyIterator * key_iter, BTree * bt) {
+    BTreeIterator_init(key_iter, bt);
+}
+
+Node_type(KEY) BTreeKeyIterator_next(BTreeKeyIterator * key_iter) {
+    if (!key_iter || !BTreeIterator_advance(key_iter)) {
+        return NULL;
+    }
+    return key_iter->leaf->node.keys[key_iter->index];
+}
+
+enum iterator_status BTreeKeyIterator_stop(BTreeKeyIterator * key_iter) {
+    return BTreeIterator_stop(key_iter);
+}
@@ -3,6 +3,8 @@
 #include "cl_iterators.h"
 #include "cl_circular_buffer.h"
 
+static size_t CircularBuffer_index_map_fwd(CircularBuffer * cb, size_t index);
+
 static size_t CircularBuffer_tail(CircularBuffer * cb) {
 	if (cb->reversed) {
 		return (cb->head < cb->size - 1) ? cb->capacity - (cb->size - 1 - cb->head) : cb->head + 1 - cb->size;
@@ -268,6 +270,59 @@ void * CircularBufferIterator_next(CircularBufferIterator * cb_iter) {
 	return Slice_next(cb_iter);
 }
 
+size_t CircularBufferIterator_next_n(CircularBufferIterator * cb_iter, void ** out, size_t max) {
+	if (!cb_iter || cb_iter->step != 1) { // strided slices of the buffer
+		return Slice_next_n(cb_iter, out, max);
+	}
+	if (!max || cb_iter->stop == ITERATOR_STOP) {
+		return 0;
+	}
+	CircularBuffer * cb = (CircularBuffer *) cb_iter->obj;
+	size_t index = cb_iter->loc + (cb_iter->stop == ITERATOR_GO); // next index to return
+	size_t num = (index < cb_iter->end) ? cb_iter->end - index : 0;
+	if (num > max) {
+		num = max;
+	}
+	if (num) {
+		size_t ptr_index = CircularBuffer_index_map_fwd(cb, index);
+		size_t n = 0;
+		while (n < num) { // at most two runs, split where the buffer wraps around
+			size_t run = cb->reversed ? ptr_index + 1 : cb->capacity - ptr_index;
+			if (run > num - n) {
+				run = num - n;
+			}
+			if (cb->reversed) {
+				for (size_t i = 0; i < run; i++) {
+					out[n + i] = cb->data[ptr_index - i];
+				}
+				ptr_index = cb->capacity - 1;
+			} else {
+				memcpy(out + n, cb->data + ptr_index, sizeof(void*) * run);
+				ptr_index = 0;
+			}
+			n += run;
+		}
+		cb_iter->loc = index + num - 1;
+		cb_iter->stop = ITERATOR_GO;
+	}
+	if (num < max) {
+		cb_iter->stop = ITERATOR_STOP;
+	}
+	return num;
+}
+
+bool CircularBufferIterator_split(CircularBufferIterator * cb_iter, CircularBufferIterator * other, size_t grain) {
+	return Slice_split(cb_iter, other, grain);
+}
+
+size_t CircularBufferIterator_advance(CircularBufferIterator * cb_iter, size_t n) {
+	return Slice_advance(cb_iter, n);
+}
+
+size_t CircularBufferIterator_size_hint(CircularBufferIterator * cb_iter) {
+	return Slice_size_hint(cb_iter);
+}
+
 enum iterator_status CircularBufferIterator_stop(CircularBufferIterator * cb_iter) {
 	return Slice_stop(cb_iter);
 }
@@ -488,4 +543,29 @@ void * CircularBuffer_peek_front(CircularBuffer * cb) {
 
 void * CircularBuffer_peek_back(CircularBuffer * cb) {
     return CircularBuffer_get(cb, cb->size-1);
-}
\ No newline at end of file
+}
+
+// elements are unrolled in order into data[0, size) through a separately allocated buffer, which the merges then use as scratch
+enum cl_status CircularBuffer_sort(CircularBuffer * cb, int (*comp)(void*, void*)) {
+	if (!cb || !comp) {
+		return CL_VALUE_ERROR;
+	}
+	if (cb->size < 2) {
+		return CL_SUCCESS;
+	}
+	void ** buf = (void **) CL_MALLOC(sizeof(void*) * cb->size);
+	if (!buf) {
+		return CL_MALLOC_FAILURE;
+	}
+	for (size_t i = 0; i < cb->size; i++) {
+		size_t ptr_index = CircularBuffer_index_map_fwd(cb, i);
+		buf[i] = cb->data[ptr_index];
+		cb->data[ptr_index] = NULL;
+	}
+	memcpy(cb->data, buf, sizeof(void*) * cb->size);
+	cb->head = 0;
+	cb->reversed = false;
+	cl_parray_sort_buffered(cb->data, cb->size, comp, buf);
+	CL_FREE(buf);
+	return CL_SUCCESS;
+}
@@ -107,21 +107,26 @@ Node * DblLinkedHashTable_get_node(DblLinkedHashTable * hash_table, void * key)
     return LinkedHashTable_get_node(hash_table, key);
 }
 
-int DblLinkedHashTable_set(DblLinkedHashTable * hash_table, void * key, void * value) {
-    Node * node = DblLinkedHashTable_get_node(hash_table, key);
-    // if node is found, overwrite the value
+// as LinkedHashTable_upsert, but a new node is also linked back to the previous tail
+void ** DblLinkedHashTable_upsert(DblLinkedHashTable * hash_table, void * key, bool * inserted) {
+    hash_t bin = hash_table->hash(key, hash_table->capacity);
+    Node * node = hash_table->bins[bin];
+    while (node && hash_table->comp(Node_get(hash_table->NA, node, KEY), key)) {
+        node = Node_get(hash_table->NA, node, NEXT_INHASH);
+    }
+    if (inserted) {
+        *inserted = !node;
+    }
     if (node) {
-        Node_set(hash_table->NA, node, VALUE, value);
-        return CL_SUCCESS;
+        return &Node_get(hash_table->NA, node, VALUE);
     }
 
     // create new node and assign it to bins and linked list
-    hash_t bin = hash_table->hash(key, hash_table->capacity);
     // BUG: this next line should be sufficient rather than default init and set later, but there appears to be a bug in Node_new
-    node = Node_new(hash_table->NA, 4, Node_attr(KEY), key, Node_attr(VALUE), value, Node_attr(NEXT_INHASH), hash_table->bins[bin], Node_attr(PREV_INORDER), hash_table->tail);
+    node = Node_new(hash_table->NA, 4, Node_attr(KEY), key, Node_attr(VALUE), NULL, Node_attr(NEXT_INHASH), hash_table->bins[bin], Node_attr(PREV_INORDER), hash_table->tail);
     
     if (!node) {
-        return CL_MALLOC_FAILURE;
+        return NULL;
     }
     if (!hash_table->tail) {
         hash_table->head = node;
@@ -133,10 +138,34 @@ int DblLinkedHashTable_set(DblLinkedHashTable * hash_table, void * key, void * v
 
     hash_table->size++;
 
+    // resizing relinks the nodes but does not move them, so the returned value address stays valid
     if (((float)hash_table->size) / hash_table->capacity > hash_table->max_load_factor) {
         DblLinkedHashTable_resize(hash_table, next_prime(hash_table->capacity*2));
     }
 
+    return &Node_get(hash_table->NA, node, VALUE);
+}
+
+int DblLinkedHashTable_set(DblLinkedHashTable * hash_table, void * key, void * value) {
+    void ** slot = DblLinkedHashTable_upsert(hash_table, key, NULL);
+    if (!slot) {
+        return CL_MALLOC_FAILURE;
+    }
+    *slot = value;
+    return CL_SUCCESS;
+}
+
+int DblLinkedHashTable_aggregate(DblLinkedHashTable * hash_table, void * iter, void * (*next)(void*), enum iterator_status (*stop)(void*), void * (*key)(void * element, void * ctx), int (*accumulate)(void ** value, void * element, void * ctx), void * ctx) {
+    for (void * element = next(iter); !stop(iter); element = next(iter)) {
+        void ** value = DblLinkedHashTable_upsert(hash_table, key(element, ctx), NULL);
+        if (!value) {
+            return CL_MALLOC_FAILURE;
+        }
+        int result = accumulate(value, element, ctx);
+        if (result != CL_SUCCESS) {
+            return result;
+        }
+    }
     return CL_SUCCESS;
 }
 
@@ -266,11 +295,17 @@ const void * DblLinkedHashTableKeyIterator_next(DblLinkedHashTableKeyIterator *
     return LinkedHashTableKeyIterator_next(key_iter);
 }
 void * DblLinkedHashTableValueIterator_next(DblLinkedHashTableValueIterator * value_iter) {
-    return LinkedHashTableKeyIterator_next(value_iter);
+    return LinkedHashTableValueIterator_next(value_iter);
 }
 DictItem * DblLinkedHashTableItemIterator_next(DblLinkedHashTableItemIterator * item_iter)  {
     return LinkedHashTableItemIterator_next(item_iter);
 }
+size_t DblLinkedHashTableKeyIterator_next_n(DblLinkedHashTableKeyIterator * key_iter, const void ** out, size_t max) {
+    return LinkedHashTableKeyIterator_next_n(key_iter, out, max);
+}
+size_t DblLinkedHashTableValueIterator_next_n(DblLinkedHashTableValueIterator * value_iter, void ** out, size_t max) {
+    return LinkedHashTableValueIterator_next_n(value_iter, out, max);
+}
 enum iterator_status DblLinkedHashTableKeyIterator_stop(DblLinkedHashTableKeyIterator * key_iter) {
     return LinkedHashTableKeyIterator_stop(key_iter);
 }
@@ -280,3 +315,25 @@ enum iterator_status DblLinkedHashTableValueIterator_stop(DblLinkedHashTableValu
 enum iterator_status DblLinkedHashTableItemIterator_stop(DblLinkedHashTableItemIterator * item_iter) {
     return LinkedHashTableItemIterator_stop(item_iter);
 }
+size_t DblLinkedHashTableKeyIterator_size_hint(DblLinkedHashTableKeyIterator * key_iter) {
+    return LinkedHashTableKeyIterator_size_hint(key_iter);
+}
+size_t DblLinkedHashTableValueIterator_size_hint(DblLinkedHashTableValueIterator * value_iter) {
+    return LinkedHashTableValueIterator_size_hint(value_iter);
+}
+size_t DblLinkedHashTableItemIterator_size_hint(DblLinkedHashTableItemIterator * item_iter) {
+    return LinkedHashTableItemIterator_size_hint(item_iter);
+}
+
+void DblLinkedHashTableBinIterator_init(DblLinkedHashTableBinIterator * bin_iter, DblLinkedHashTable * hash_table) {
+    LinkedHashTableBinIterator_init(bin_iter, hash_table);
+}
+DictItem * DblLinkedHashTableBinIterator_next(DblLinkedHashTableBinIterator * bin_iter) {
+    return LinkedHashTableBinIterator_next(bin_iter);
+}
+enum iterator_status DblLinkedHashTableBinIterator_stop(DblLinkedHashTableBinIterator * bin_iter) {
+    return LinkedHashTableBinIterator_stop(bin_iter);
+}
+bool DblLinkedHashTableBinIterator_split(DblLinkedHashTableBinIterator * bin_iter, DblLinkedHashTableBinIterator * other, size_t grain) {
+    return LinkedHashTableBinIterator_split(bin_iter, other, grain);
+}
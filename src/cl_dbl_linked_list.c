@@ -46,7 +46,7 @@ void DblLinkedList_init(DblLinkedList * dll, NodeAttributes * NA) {
     dll->reversed = false;
 }
 
-const void (*DblLinkedList_del)(DblLinkedList * dll) = (void (*)(DblLinkedList *))LinkedList_del;
+void (*DblLinkedList_del)(DblLinkedList * dll) = (void (*)(DblLinkedList *))LinkedList_del;
 
 void DblLinkedList_reverse(DblLinkedList * dll) {
     dll->reversed = !dll->reversed;
@@ -54,6 +54,11 @@ void DblLinkedList_reverse(DblLinkedList * dll) {
 
 // does a full reverse of the list
 static void DblLinkedList_reverse_(DblLinkedList * dll) {
+    if (!dll->ll.head) {
+        DblLinkedList_reverse(dll);
+        return;
+    }
+    dll->tail = dll->ll.head;
     Node * new_head = dll->ll.head;
     Node * next = Node_get(dll->ll.NA, dll->ll.head, NEXT);
     Node_set(dll->ll.NA, new_head, NEXT, NULL);
@@ -69,6 +74,49 @@ static void DblLinkedList_reverse_(DblLinkedList * dll) {
     DblLinkedList_reverse(dll);
 }
 
+// links new_node physically between next and its PREV. next == NULL links it as the new tail
+static void DblLinkedList_link_before(DblLinkedList * dll, Node * next, Node * new_node) {
+    NodeAttributes * NA = dll->ll.NA;
+    Node * prev = next ? Node_get(NA, next, PREV) : dll->tail;
+    Node_set(NA, new_node, PREV, prev);
+    Node_set(NA, new_node, NEXT, next);
+    if (prev) {
+        Node_set(NA, prev, NEXT, new_node);
+    } else {
+        dll->ll.head = new_node;
+    }
+    if (next) {
+        Node_set(NA, next, PREV, new_node);
+    } else {
+        dll->tail = new_node;
+    }
+    dll->ll.size++;
+}
+
+// links new_node physically between prev and its NEXT. prev == NULL links it as the new head
+static void DblLinkedList_link_after(DblLinkedList * dll, Node * prev, Node * new_node) {
+    DblLinkedList_link_before(dll, prev ? Node_get(dll->ll.NA, prev, NEXT) : dll->ll.head, new_node);
+}
+
+// the node following node in the order of the list, accounting for reversal
+static Node * DblLinkedList_next_node(DblLinkedList * dll, Node * node) {
+    if (dll->reversed) {
+        return Node_get(dll->ll.NA, node, PREV);
+    }
+    return Node_get(dll->ll.NA, node, NEXT);
+}
+
+// the node preceding node in the order of the list. node == NULL gives the back of the list
+static Node * DblLinkedList_prev_node(DblLinkedList * dll, Node * node) {
+    if (!node) {
+        return dll->reversed ? dll->ll.head : dll->tail;
+    }
+    if (dll->reversed) {
+        return Node_get(dll->ll.NA, node, NEXT);
+    }
+    return Node_get(dll->ll.NA, node, PREV);
+}
+
 // Use LinkedList methods
 // let's see if these work
 size_t (*DblLinkedList_size)(DblLinkedList *) = (size_t (*)(DblLinkedList *))LinkedList_size; 
@@ -164,7 +212,14 @@ enum cl_status DblLinkedList_insert(DblLinkedList * dll, size_t loc, void * val)
     if (loc > size) {
         return CL_INDEX_OUT_OF_BOUNDS;
     }
-    if ((!dll->reversed && !loc) || (dll->reversed && loc == size)) { // push_front
+    if (!size) { // first node is both head and tail
+        Node * new_node = Node_new(dll->ll.NA, 1, Node_attr(VALUE), val);
+        if (!new_node) {
+            return CL_MALLOC_FAILURE;
+        }
+        dll->ll.head = new_node;
+        dll->tail = new_node;
+    } else if ((!dll->reversed && !loc) || (dll->reversed && loc == size)) { // push_front
         Node * new_node = Node_new(dll->ll.NA, 2, Node_attr(VALUE), val, Node_attr(NEXT), dll->ll.head);
         if (!new_node) {
             return CL_MALLOC_FAILURE;
@@ -210,17 +265,17 @@ void * DblLinkedList_remove_node(DblLinkedList * dll, Node * node) {
         return NULL;
     }
     NodeAttributes * NA = dll->ll.NA;
-    if (node == dll->ll.head) {
-        dll->ll.head = Node_get(NA, node, NEXT);
-        Node_set(NA, dll->ll.head, PREV, NULL);
-    } else if (node == dll->tail) {
-        dll->tail = Node_get(NA, node, PREV);
-        Node_set(NA, dll->tail, NEXT, NULL;)
+    Node * prev = Node_get(NA, node, PREV);
+    Node * next = Node_get(NA, node, NEXT);
+    if (prev) {
+        Node_set(NA, prev, NEXT, next);
+    } else {
+        dll->ll.head = next;
+    }
+    if (next) {
+        Node_set(NA, next, PREV, prev);
     } else {
-        Node * prev = Node_get(dll->ll.NA, node, PREV);
-        Node * next = Node_get(dll->ll.NA, node, NEXT);
-        Node_set(dll->ll.NA, next, PREV, prev);
-        Node_set(dll->ll.NA, prev, NEXT, next);
+        dll->tail = prev;
     }
     void * val = Node_get(NA, node, VALUE);
     Node_del(node);
@@ -247,6 +302,177 @@ void * DblLinkedList_pop_back(DblLinkedList * dll) {
     return DblLinkedList_remove(dll, DblLinkedList_size(dll)-1);
 }
 
+enum cl_status DblLinkedList_splice(DblLinkedList * dest, Node * dest_pos, DblLinkedList * src, Node * first, Node * last) {
+    if (!dest || !src) {
+        return CL_VALUE_ERROR;
+    }
+    size_t count = 0;
+    for (Node * node = first; node && node != last; node = DblLinkedList_next_node(src, node)) {
+        count++;
+    }
+    return DblLinkedList_splice_n(dest, dest_pos, src, first, last, count);
+}
+
+enum cl_status DblLinkedList_splice_n(DblLinkedList * dest, Node * dest_pos, DblLinkedList * src, Node * first, Node * last, size_t count) {
+    if (!dest || !src) {
+        return CL_VALUE_ERROR;
+    }
+    if (!first || !count || (dest == src && (dest_pos == first || dest_pos == last))) {
+        return CL_SUCCESS;
+    }
+    // work in memory order so that [first, last) is contiguous along NEXT in both lists
+    if (src->reversed) {
+        DblLinkedList_reverse_(src);
+    }
+    if (dest->reversed) {
+        DblLinkedList_reverse_(dest);
+    }
+    NodeAttributes * NA = src->ll.NA;
+    Node * back = last ? Node_get(NA, last, PREV) : src->tail;
+    Node * before = Node_get(NA, first, PREV);
+    if (before) {
+        Node_set(NA, before, NEXT, last);
+    } else {
+        src->ll.head = last;
+    }
+    if (last) {
+        Node_set(NA, last, PREV, before);
+    } else {
+        src->tail = before;
+    }
+    src->ll.size -= count;
+
+    // find the insertion point after removing the range in case dest == src
+    before = dest_pos ? Node_get(NA, dest_pos, PREV) : dest->tail;
+    Node_set(NA, first, PREV, before);
+    Node_set(NA, back, NEXT, dest_pos);
+    if (before) {
+        Node_set(NA, before, NEXT, first);
+    } else {
+        dest->ll.head = first;
+    }
+    if (dest_pos) {
+        Node_set(NA, dest_pos, PREV, back);
+    } else {
+        dest->tail = back;
+    }
+    dest->ll.size += count;
+    return CL_SUCCESS;
+}
+
+enum cl_status DblLinkedList_split_at(DblLinkedList * dll, Node * node, DblLinkedList * dest) {
+    return DblLinkedList_splice(dest, NULL, dll, node, NULL);
+}
+
+// sorts the NEXT links with LinkedList_sort and then restores the PREV links and tail in one pass
+enum cl_status DblLinkedList_sort(DblLinkedList * dll, int (*comp)(void*, void*)) {
+    if (!dll || !comp) {
+        return CL_VALUE_ERROR;
+    }
+    if (dll->reversed) {
+        DblLinkedList_reverse_(dll);
+    }
+    enum cl_status status = LinkedList_sort((LinkedList*)dll, comp);
+    if (status != CL_SUCCESS) {
+        return status;
+    }
+    NodeAttributes * NA = dll->ll.NA;
+    Node * prev = NULL;
+    Node * node = dll->ll.head;
+    while (node) {
+        Node_set(NA, node, PREV, prev);
+        prev = node;
+        node = Node_get(NA, node, NEXT);
+    }
+    dll->tail = prev;
+    return CL_SUCCESS;
+}
+
+// Cursor
+void DblLinkedListCursor_init(DblLinkedListCursor * cursor, DblLinkedList * dll, size_t index) {
+    if (!cursor) {
+        return;
+    }
+    size_t size = DblLinkedList_size(dll);
+    cursor->dll = dll;
+    cursor->index = (index > size) ? size : index;
+    cursor->node = DblLinkedList_get_node(dll, cursor->index);
+}
+
+void * DblLinkedListCursor_get(DblLinkedListCursor * cursor) {
+    if (!cursor || !cursor->node) {
+        return NULL;
+    }
+    return Node_get(cursor->dll->ll.NA, cursor->node, VALUE);
+}
+
+size_t DblLinkedListCursor_index(DblLinkedListCursor * cursor) {
+    return cursor->index;
+}
+
+bool DblLinkedListCursor_advance(DblLinkedListCursor * cursor) {
+    if (!cursor || !cursor->node) {
+        return false;
+    }
+    cursor->node = DblLinkedList_next_node(cursor->dll, cursor->node);
+    cursor->index++;
+    return true;
+}
+
+bool DblLinkedListCursor_retreat(DblLinkedListCursor * cursor) {
+    if (!cursor || !cursor->index) {
+        return false;
+    }
+    cursor->node = DblLinkedList_prev_node(cursor->dll, cursor->node);
+    cursor->index--;
+    return true;
+}
+
+enum cl_status DblLinkedListCursor_insert_before(DblLinkedListCursor * cursor, void * val) {
+    if (!cursor || !cursor->dll) {
+        return CL_VALUE_ERROR;
+    }
+    Node * new_node = Node_new(cursor->dll->ll.NA, 1, Node_attr(VALUE), val);
+    if (!new_node) {
+        return CL_MALLOC_FAILURE;
+    }
+    if (cursor->dll->reversed) {
+        DblLinkedList_link_after(cursor->dll, cursor->node, new_node);
+    } else {
+        DblLinkedList_link_before(cursor->dll, cursor->node, new_node);
+    }
+    cursor->index++;
+    return CL_SUCCESS;
+}
+
+enum cl_status DblLinkedListCursor_insert_after(DblLinkedListCursor * cursor, void * val) {
+    if (!cursor || !cursor->dll) {
+        return CL_VALUE_ERROR;
+    }
+    Node * new_node = Node_new(cursor->dll->ll.NA, 1, Node_attr(VALUE), val);
+    if (!new_node) {
+        return CL_MALLOC_FAILURE;
+    }
+    if (cursor->dll->reversed) {
+        DblLinkedList_link_before(cursor->dll, cursor->node, new_node);
+    } else {
+        DblLinkedList_link_after(cursor->dll, cursor->node, new_node);
+    }
+    if (!cursor->node) { // inserted at the front, past the back moves with the size
+        cursor->index++;
+    }
+    return CL_SUCCESS;
+}
+
+void * DblLinkedListCursor_erase(DblLinkedListCursor * cursor) {
+    if (!cursor || !cursor->node) {
+        return NULL;
+    }
+    Node * node = cursor->node;
+    cursor->node = DblLinkedList_next_node(cursor->dll, node);
+    return DblLinkedList_remove_node(cursor->dll, node);
+}
+
 //Iterators
 void DblLinkedListIterator_init(DblLinkedListIterator * dll_iter, DblLinkedList * dll) {
     if (!dll_iter) {
@@ -280,6 +506,52 @@ void * DblLinkedListIterator_next(DblLinkedListIterator * dll_iter) {
     }
     return Node_get(dll_iter->dll->ll.NA, dll_iter->node, VALUE);
 }
+size_t DblLinkedListIterator_next_n(DblLinkedListIterator * dll_iter, void ** out, size_t max) {
+    if (!dll_iter || !max || dll_iter->stop == ITERATOR_STOP) {
+        return 0;
+    }
+    NodeAttributes * NA = dll_iter->dll->ll.NA;
+    bool reversed = dll_iter->dll->reversed;
+    Node * node = dll_iter->node;
+    if (dll_iter->stop == ITERATOR_GO) {
+        node = reversed ? Node_get(NA, node, PREV) : Node_get(NA, node, NEXT);
+    }
+    size_t n = 0;
+    while (node) {
+        out[n++] = Node_get(NA, node, VALUE);
+        if (n == max) {
+            break;
+        }
+        node = reversed ? Node_get(NA, node, PREV) : Node_get(NA, node, NEXT);
+    }
+    dll_iter->node = node;
+    dll_iter->stop = (n < max) ? ITERATOR_STOP : ITERATOR_GO;
+    return n;
+}
+size_t DblLinkedListIterator_advance(DblLinkedListIterator * dll_iter, size_t n) {
+    if (!dll_iter || !n || dll_iter->stop == ITERATOR_STOP) {
+        return 0;
+    }
+    NodeAttributes * NA = dll_iter->dll->ll.NA;
+    bool reversed = dll_iter->dll->reversed;
+    Node * node = dll_iter->node;
+    if (dll_iter->stop == ITERATOR_GO) {
+        node = reversed ? Node_get(NA, node, PREV) : Node_get(NA, node, NEXT);
+    }
+    size_t k = 0;
+    while (node && ++k < n) {
+        node = reversed ? Node_get(NA, node, PREV) : Node_get(NA, node, NEXT);
+    }
+    dll_iter->node = node;
+    dll_iter->stop = node ? ITERATOR_GO : ITERATOR_STOP;
+    return k;
+}
+size_t DblLinkedListIterator_size_hint(DblLinkedListIterator * dll_iter) {
+    if (!dll_iter || dll_iter->stop == ITERATOR_STOP) {
+        return 0;
+    }
+    return dll_iter->dll->ll.size - (dll_iter->stop == ITERATOR_GO);
+}
 enum iterator_status DblLinkedListIterator_stop(DblLinkedListIterator * dll_iter) {
     if (!dll_iter) {
         return ITERATOR_STOP;
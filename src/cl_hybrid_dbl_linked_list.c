@@ -10,7 +10,7 @@ typedef struct HDLLLoc {
 #define REQUIRED_NODE_FLAGS (Node_flag(VALUE) | Node_flag(NEXT) | Node_flag(PREV) | Node_flag(SIZE))
 
 #define DEFAULT_SIZE (sizeof(Node_type(VALUE)) + sizeof(Node_type(NEXT)) + sizeof(Node_type(PREV)) + sizeof(Node_type(SIZE)))
-#define DEFAULT_NODE Node_new(NA, 4, Node_attr(VALUE), NULL, Node_attr(NEXT), NULL, Node_attr(PREV), NULL, , Node_attr(SIZE), 0)
+#define DEFAULT_NODE Node_new(NA, 4, Node_attr(VALUE), NULL, Node_attr(NEXT), NULL, Node_attr(PREV), NULL, Node_attr(SIZE), 0)
 
 static HDLLLoc HybridDblLinkedList_get_loc(HybridDblLinkedList * hdll, size_t index) {
     size_t size = HybridDblLinkedList_size(hdll);
@@ -51,7 +51,7 @@ void HybridDblLinkedList_init(HybridDblLinkedList * hdll, NodeAttributes * NA, s
     if (!hdll || !NA) {
         return;
     }
-    DblLinkedList_init((LinkedList*)hdll, NA);
+    DblLinkedList_init((DblLinkedList*)hdll, NA);
     hdll->max_elements = max_elements;
 }
 
@@ -68,8 +68,26 @@ void HybridDblLinkedList_reverse(HybridDblLinkedList * hdll) {
     DblLinkedList_reverse((DblLinkedList*)hdll);
 }
 
+// does full reversal of memory and alignment of the underlying linked list
 static void HybridDblLinkedList_reverse_(HybridDblLinkedList * hdll) {
-    // does full reversal of memory and alignment of the underlying linked list
+    NodeAttributes * NA = hdll->dll.ll.NA;
+    Node * node = hdll->dll.ll.head;
+    void * buf = NULL;
+    while (node) {
+        Node * next = Node_get(NA, node, NEXT);
+        size_t node_size = Node_get(NA, node, SIZE);
+        if (node_size) {
+            void ** arr = (void **) Node_get(NA, node, VALUE);
+            cl_reverse(arr, arr + node_size - 1, sizeof(void*), &buf);
+        }
+        Node_set(NA, node, NEXT, Node_get(NA, node, PREV));
+        Node_set(NA, node, PREV, next);
+        node = next;
+    }
+    node = hdll->dll.ll.head;
+    hdll->dll.ll.head = hdll->dll.tail;
+    hdll->dll.tail = node;
+    HybridDblLinkedList_reverse(hdll);
 }
 
 size_t HybridDblLinkedList_size(HybridDblLinkedList * hdll) {
@@ -81,7 +99,7 @@ bool HybridDblLinkedList_is_empty(HybridDblLinkedList * hdll) {
 }
 
 bool HybridDblLinkedList_contains(HybridDblLinkedList * hdll, void * value, int (*comp)(void*, void*)) {
-    return HybridBlLinkedList_find(hdll, value, comp, NULL) != NULL; //< HybridDblLinkedList_size(hdll);
+    return HybridDblLinkedList_find(hdll, value, comp, NULL) != NULL; //< HybridDblLinkedList_size(hdll);
 }
 enum cl_status HybridDblLinkedList_extend(HybridDblLinkedList * dest, HybridDblLinkedList * src) {
     return DblLinkedList_extend((DblLinkedList*)dest, (DblLinkedList*)src);
@@ -107,8 +125,9 @@ static Node * HybridDblLinkedList_new_node(HybridDblLinkedList * hdll) {
     if (!new_arr) {
         return NULL;
     }
-    Node * new_node = Node_new(hdll->dll.ll.NA, 4, Node_attr(VALUE), (void*)new_arr);
+    Node * new_node = Node_new(hdll->dll.ll.NA, 1, Node_attr(VALUE), (void*)new_arr);
     if (!new_node) {
+        CL_FREE(new_arr);
         return NULL;
     }
     return new_node;
@@ -134,11 +153,12 @@ enum cl_status HybridDblLinkedList_insert(HybridDblLinkedList * hdll, size_t ind
 
         // special case of push_back where HybridDblLinkedList_get_loc returns an invalid location
         if (index == node_size) {
-            node_loc.index = node_size;
             if (hdll->dll.reversed) {
                 node_loc.node = hdll->dll.ll.head;
+                node_loc.index = 0;
             } else {
                 node_loc.node = hdll->dll.tail;
+                node_loc.index = Node_get(hdll->dll.ll.NA, node_loc.node, SIZE);
             }
         } else {
             node_loc = HybridDblLinkedList_get_loc(hdll, index);
@@ -168,11 +188,14 @@ enum cl_status HybridDblLinkedList_insert(HybridDblLinkedList * hdll, size_t ind
         }
         if (size_next != hdll->max_elements) { // move element towards next
             void ** arr = (void**)Node_get(NA, node_loc.node, VALUE);
-            void * val_to_shift = arr[node_size-1];
-            if (node_loc.index < node_size -1) { // have to shift elements to the right
-                memmove(arr + node_loc.index + 1, arr + node_loc.index, sizeof(void*) * (node_size-1-node_loc.index));
+            void * val_to_shift = val;
+            if (node_loc.index < node_size) { // val goes in this block, displacing its last element
+                val_to_shift = arr[node_size-1];
+                if (node_loc.index < node_size -1) { // have to shift elements to the right
+                    memmove(arr + node_loc.index + 1, arr + node_loc.index, sizeof(void*) * (node_size-1-node_loc.index));
+                }
+                arr[node_loc.index] = val;
             }
-            arr[node_loc.index] = val;
             prev = node_loc.node;
             while (next) {
                 node_size = Node_get(NA, next, SIZE);
@@ -207,11 +230,14 @@ enum cl_status HybridDblLinkedList_insert(HybridDblLinkedList * hdll, size_t ind
             hdll->dll.tail = next;
         } else { // move element towards prev
             void ** arr = (void**)Node_get(NA, node_loc.node, VALUE);
-            void * val_to_shift = arr[0];
-            if (node_loc.index > 0) { // have to shift elements to the left
-                memmove(arr, arr + 1, sizeof(void*) * (node_loc.index));
+            void * val_to_shift = val;
+            if (node_loc.index > 0) { // val goes in this block, displacing its first element
+                val_to_shift = arr[0];
+                if (node_loc.index > 1) { // have to shift elements to the left
+                    memmove(arr, arr + 1, sizeof(void*) * (node_loc.index - 1));
+                }
+                arr[node_loc.index - 1] = val;
             }
-            arr[node_loc.index] = val;
             next = node_loc.node;
             while (prev) {
                 node_size = Node_get(NA, prev, SIZE);
@@ -245,6 +271,7 @@ enum cl_status HybridDblLinkedList_insert(HybridDblLinkedList * hdll, size_t ind
             hdll->dll.ll.head = prev;
         }
     }
+    return CL_SUCCESS;
 }
 enum cl_status HybridDblLinkedList_push_front(HybridDblLinkedList * hdll, void * val) {
     return HybridDblLinkedList_insert(hdll, 0, val);
@@ -253,7 +280,7 @@ enum cl_status HybridDblLinkedList_push_back(HybridDblLinkedList * hdll, void *
     return HybridDblLinkedList_insert(hdll, HybridDblLinkedList_size(hdll), val);
 }
 
-void ** HybridDblLinkedList_remove_node(HybridDblLinkedList * hdll, Node * node) {
+static void HybridDblLinkedList_remove_node(HybridDblLinkedList * hdll, Node * node) {
     CL_FREE((void**)DblLinkedList_remove_node((DblLinkedList*)hdll, node)); // free underlying array
 }
 
@@ -269,11 +296,12 @@ void * HybridDblLinkedList_remove(HybridDblLinkedList * hdll, size_t index) {
         memmove(arr + node_loc.index, arr + node_loc.index + 1, sizeof(void*) * (arr_size - 1 - node_loc.index));
     }
     arr[--arr_size] = NULL;
-    // if the node has been removed, eliminate it
-    if (!--arr_size) {
-        HybridDblLinkedList_remove_node(hdll, node_loc.node); // ignore output
+    // if the node has been emptied, eliminate it. This also accounts for the removed element in the size
+    if (!arr_size) {
+        HybridDblLinkedList_remove_node(hdll, node_loc.node);
     } else {
         Node_set(hdll->dll.ll.NA, node_loc.node, SIZE, arr_size);
+        hdll->dll.ll.size--;
     }
     
     return val;
@@ -282,7 +310,7 @@ void * HybridDblLinkedList_pop_front(HybridDblLinkedList * hdll) {
     return HybridDblLinkedList_remove(hdll, 0);
 }
 void * HybridDblLinkedList_pop_back(HybridDblLinkedList * hdll) {
-    return HybridDblLinkedList_remove(hdll, HybridDblLinkedList_size(hdll));
+    return HybridDblLinkedList_remove(hdll, HybridDblLinkedList_size(hdll)-1);
 }
 
 // generally should only use this if the elements are unique in the value or you are sure you only want the first occurrence
@@ -328,44 +356,266 @@ void * HybridDblLinkedList_find(HybridDblLinkedList * hdll, void * value, int (*
 }
 
 
+// makes index the start of a block by moving the elements at and after index in its block into a new block linked 
+// after it. node is set to the block starting at index or NULL if index is the size of the list. List must not be reversed
+static enum cl_status HybridDblLinkedList_split_block(HybridDblLinkedList * hdll, size_t index, Node ** node) {
+    *node = NULL;
+    if (index >= HybridDblLinkedList_size(hdll)) {
+        return CL_SUCCESS;
+    }
+    HDLLLoc node_loc = HybridDblLinkedList_get_loc(hdll, index);
+    if (!node_loc.index) {
+        *node = node_loc.node;
+        return CL_SUCCESS;
+    }
+    Node * new_node = HybridDblLinkedList_new_node(hdll);
+    if (!new_node) {
+        return CL_MALLOC_FAILURE;
+    }
+    NodeAttributes * NA = hdll->dll.ll.NA;
+    void ** arr = (void **) Node_get(NA, node_loc.node, VALUE);
+    size_t node_size = Node_get(NA, node_loc.node, SIZE);
+    memcpy((void **) Node_get(NA, new_node, VALUE), arr + node_loc.index, sizeof(void*) * (node_size - node_loc.index));
+    Node_set(NA, new_node, SIZE, node_size - node_loc.index);
+    Node_set(NA, node_loc.node, SIZE, node_loc.index);
+
+    Node * next = Node_get(NA, node_loc.node, NEXT);
+    Node_set(NA, new_node, PREV, node_loc.node);
+    Node_set(NA, new_node, NEXT, next);
+    Node_set(NA, node_loc.node, NEXT, new_node);
+    if (next) {
+        Node_set(NA, next, PREV, new_node);
+    } else {
+        hdll->dll.tail = new_node;
+    }
+    *node = new_node;
+    return CL_SUCCESS;
+}
+
+enum cl_status HybridDblLinkedList_splice(HybridDblLinkedList * dest, size_t dest_pos, HybridDblLinkedList * src, size_t first, size_t last) {
+    if (!dest || !src || dest->max_elements != src->max_elements) {
+        return CL_VALUE_ERROR;
+    }
+    if (dest_pos > HybridDblLinkedList_size(dest) || last > HybridDblLinkedList_size(src) || first > last) {
+        return CL_INDEX_OUT_OF_BOUNDS;
+    }
+    if (dest == src && dest_pos > first && dest_pos < last) {
+        return CL_VALUE_ERROR;
+    }
+    if (first == last || (dest == src && (dest_pos == first || dest_pos == last))) {
+        return CL_SUCCESS;
+    }
+    if (src->dll.reversed) {
+        HybridDblLinkedList_reverse_(src);
+    }
+    if (dest->dll.reversed) {
+        HybridDblLinkedList_reverse_(dest);
+    }
+    // splitting only adds blocks after the split point so earlier results remain the start of their index
+    Node * first_node = NULL, * last_node = NULL, * dest_node = NULL;
+    enum cl_status status;
+    if ((status = HybridDblLinkedList_split_block(src, first, &first_node)) != CL_SUCCESS ||
+        (status = HybridDblLinkedList_split_block(src, last, &last_node)) != CL_SUCCESS ||
+        (status = HybridDblLinkedList_split_block(dest, dest_pos, &dest_node)) != CL_SUCCESS) {
+        return status;
+    }
+    // the size of the underlying DblLinkedList counts elements, so splice the blocks with the element count
+    return DblLinkedList_splice_n((DblLinkedList*)dest, dest_node, (DblLinkedList*)src, first_node, last_node, last - first);
+}
+
+enum cl_status HybridDblLinkedList_split_at(HybridDblLinkedList * hdll, size_t index, HybridDblLinkedList * dest) {
+    return HybridDblLinkedList_splice(dest, HybridDblLinkedList_size(dest), hdll, index, HybridDblLinkedList_size(hdll));
+}
+
+// elements are gathered in list order into a contiguous buffer, merge sorted there and scattered back into the same
+// positions so that the block sizes and links are unchanged
+enum cl_status HybridDblLinkedList_sort(HybridDblLinkedList * hdll, int (*comp)(void*, void*)) {
+    if (!hdll || !comp) {
+        return CL_VALUE_ERROR;
+    }
+    size_t size = HybridDblLinkedList_size(hdll);
+    if (size < 2) {
+        return CL_SUCCESS;
+    }
+    void ** buf = (void **) CL_MALLOC(sizeof(void*) * size * 2); // second half is scratch for the merges
+    if (!buf) {
+        return CL_MALLOC_FAILURE;
+    }
+    NodeAttributes * NA = hdll->dll.ll.NA;
+    bool reversed = hdll->dll.reversed;
+    size_t loc = 0;
+    for (Node * node = reversed ? hdll->dll.tail : hdll->dll.ll.head; node; node = reversed ? Node_get(NA, node, PREV) : Node_get(NA, node, NEXT)) {
+        void ** arr = (void **) Node_get(NA, node, VALUE);
+        size_t node_size = Node_get(NA, node, SIZE);
+        for (size_t i = 0; i < node_size; i++) {
+            buf[loc++] = arr[reversed ? node_size - 1 - i : i];
+        }
+    }
+    cl_parray_sort_buffered(buf, size, comp, buf + size);
+    loc = 0;
+    for (Node * node = reversed ? hdll->dll.tail : hdll->dll.ll.head; node; node = reversed ? Node_get(NA, node, PREV) : Node_get(NA, node, NEXT)) {
+        void ** arr = (void **) Node_get(NA, node, VALUE);
+        size_t node_size = Node_get(NA, node, SIZE);
+        for (size_t i = 0; i < node_size; i++) {
+            arr[reversed ? node_size - 1 - i : i] = buf[loc++];
+        }
+    }
+    CL_FREE(buf);
+    return CL_SUCCESS;
+}
+
 //Iterators
+
+// loads the array of node into the element iterator. Returns false if there is no node to load
+static bool HybridDblLinkedListIterator_load(HybridDblLinkedListIterator * hdll_iter, Node * node) {
+    hdll_iter->node = node;
+    if (!node) {
+        hdll_iter->loc = NULL;
+        hdll_iter->remaining = 0;
+        return false;
+    }
+    NodeAttributes * NA = hdll_iter->hdll->dll.ll.NA;
+    hdll_iter->loc = (void **) Node_get(NA, node, VALUE);
+    hdll_iter->remaining = Node_get(NA, node, SIZE);
+    if (hdll_iter->step < 0 && hdll_iter->remaining) {
+        hdll_iter->loc += hdll_iter->remaining - 1;
+    }
+    return true;
+}
+
 void HybridDblLinkedListIterator_init(HybridDblLinkedListIterator * hdll_iter, HybridDblLinkedList * hdll) {
-    if (!hdll_iter || !hdll) {
+    if (!hdll_iter) {
         return;
     }
     hdll_iter->hdll = hdll;
+    hdll_iter->node = NULL;
+    hdll_iter->loc = NULL;
+    hdll_iter->remaining = 0;
+    hdll_iter->step = 1;
+    hdll_iter->end = NULL;
+    if (!hdll || !hdll->dll.ll.size) {
+        hdll_iter->stop = ITERATOR_STOP;
+        return;
+    }
     if (hdll->dll.reversed) {
-        hdll_iter->node = hdll->dll.tail;
-        slice(&hdll_iter->arr_iter, pvoid, (pvoid*)Node_get(hdll->dll.ll.NA, hdll_iter->node, VALUE), Node_get(hdll->dll.ll.NA, hdll_iter->node, SIZE), -1, -1, -1);
+        hdll_iter->step = -1;
+        HybridDblLinkedListIterator_load(hdll_iter, hdll->dll.tail);
     } else {
-        hdll_iter->node = hdll->dll.ll.head;
-        slice(&hdll_iter->arr_iter, pvoid, (pvoid*)Node_get(hdll->dll.ll.NA, hdll_iter->node, VALUE), Node_get(hdll->dll.ll.NA, hdll_iter->node, SIZE));
+        HybridDblLinkedListIterator_load(hdll_iter, hdll->dll.ll.head);
     }
-    hdll_iter->stop = ITERATOR_GO;
+    hdll_iter->stop = ITERATOR_PAUSE;
 }
 void * HybridDblLinkedListIterator_next(HybridDblLinkedListIterator * hdll_iter) {
     if (!hdll_iter || hdll_iter->stop == ITERATOR_STOP) {
         return NULL;
     }
-    if (hdll_iter->arr_iter.stop == ITERATOR_STOP) { // current node's array iterator is expended, try to move to next node
+    hdll_iter->stop = ITERATOR_GO;
+    while (!hdll_iter->remaining) { // current block is expended, move to the next non-empty block
         NodeAttributes * NA = hdll_iter->hdll->dll.ll.NA;
-        if (hdll_iter->hdll->dll.reversed) {
-            hdll_iter->node = Node_get(NA, hdll_iter->node, PREV);
-            if (!hdll_iter->node) {
+        Node * next = (hdll_iter->step < 0) ? Node_get(NA, hdll_iter->node, PREV) : Node_get(NA, hdll_iter->node, NEXT);
+        if (next == hdll_iter->end || !HybridDblLinkedListIterator_load(hdll_iter, next)) {
+            hdll_iter->stop = ITERATOR_STOP;
+            return NULL;
+        }
+    }
+    void * val = *hdll_iter->loc;
+    if (--hdll_iter->remaining) { // do not step off the ends of the array
+        hdll_iter->loc += hdll_iter->step;
+    }
+    return val;
+}
+size_t HybridDblLinkedListIterator_next_n(HybridDblLinkedListIterator * hdll_iter, void ** out, size_t max) {
+    if (!hdll_iter || hdll_iter->stop == ITERATOR_STOP) {
+        return 0;
+    }
+    NodeAttributes * NA = hdll_iter->hdll->dll.ll.NA;
+    size_t n = 0;
+    while (n < max) {
+        while (!hdll_iter->remaining) {
+            Node * next = (hdll_iter->step < 0) ? Node_get(NA, hdll_iter->node, PREV) : Node_get(NA, hdll_iter->node, NEXT);
+            if (next == hdll_iter->end || !HybridDblLinkedListIterator_load(hdll_iter, next)) {
                 hdll_iter->stop = ITERATOR_STOP;
-                return NULL;
+                return n;
             }
-            slice(&hdll_iter->arr_iter, pvoid, (pvoid*)Node_get(NA, hdll_iter->node, VALUE), Node_get(NA, hdll_iter->node, SIZE), -1, -1, -1);
+        }
+        size_t num = hdll_iter->remaining < max - n ? hdll_iter->remaining : max - n;
+        if (hdll_iter->step > 0) {
+            memcpy(out + n, hdll_iter->loc, sizeof(void*) * num);
         } else {
-            hdll_iter->node = Node_get(NA, hdll_iter->node, NEXT);
-            if (!hdll_iter->node) {
+            for (size_t i = 0; i < num; i++) {
+                out[n + i] = *(hdll_iter->loc - i);
+            }
+        }
+        n += num;
+        hdll_iter->stop = ITERATOR_GO;
+        if ((hdll_iter->remaining -= num)) { // do not step off the ends of the array
+            hdll_iter->loc += hdll_iter->step * (ptrdiff_t) num;
+        }
+    }
+    return n;
+}
+// block after node in the direction of iteration
+static Node * HybridDblLinkedListIterator_next_block(HybridDblLinkedListIterator * hdll_iter, Node * node) {
+    NodeAttributes * NA = hdll_iter->hdll->dll.ll.NA;
+    return (hdll_iter->step < 0) ? Node_get(NA, node, PREV) : Node_get(NA, node, NEXT);
+}
+
+bool HybridDblLinkedListIterator_split(HybridDblLinkedListIterator * hdll_iter, HybridDblLinkedListIterator * other, size_t grain) {
+    if (!hdll_iter || !other || hdll_iter->stop != ITERATOR_PAUSE) {
+        return false;
+    }
+    NodeAttributes * NA = hdll_iter->hdll->dll.ll.NA;
+    size_t total = hdll_iter->remaining;
+    for (Node * node = HybridDblLinkedListIterator_next_block(hdll_iter, hdll_iter->node); node != hdll_iter->end; node = HybridDblLinkedListIterator_next_block(hdll_iter, node)) {
+        total += Node_get(NA, node, SIZE);
+    }
+    if (total < 2 || total / 2 < grain) {
+        return false;
+    }
+    // the second part starts at the first block that would take the first part past half of the elements
+    size_t count = hdll_iter->remaining;
+    Node * mid = HybridDblLinkedListIterator_next_block(hdll_iter, hdll_iter->node);
+    while (mid != hdll_iter->end && count + Node_get(NA, mid, SIZE) <= total / 2) {
+        count += Node_get(NA, mid, SIZE);
+        mid = HybridDblLinkedListIterator_next_block(hdll_iter, mid);
+    }
+    if (mid == hdll_iter->end || count < grain || total - count < grain) { // blocks too coarse to split evenly
+        return false;
+    }
+    *other = *hdll_iter;
+    if (!HybridDblLinkedListIterator_load(other, mid)) {
+        return false;
+    }
+    hdll_iter->end = mid;
+    return true;
+}
+size_t HybridDblLinkedListIterator_advance(HybridDblLinkedListIterator * hdll_iter, size_t n) {
+    if (!hdll_iter || hdll_iter->stop == ITERATOR_STOP) {
+        return 0;
+    }
+    size_t skipped = 0;
+    while (skipped < n) {
+        while (!hdll_iter->remaining) {
+            Node * next = HybridDblLinkedListIterator_next_block(hdll_iter, hdll_iter->node);
+            if (next == hdll_iter->end || !HybridDblLinkedListIterator_load(hdll_iter, next)) {
                 hdll_iter->stop = ITERATOR_STOP;
-                return NULL;
+                return skipped;
             }
-            slice(&hdll_iter->arr_iter, pvoid, (pvoid*)Node_get(NA, hdll_iter->node, VALUE), Node_get(NA, hdll_iter->node, SIZE));
+        }
+        size_t num = hdll_iter->remaining < n - skipped ? hdll_iter->remaining : n - skipped;
+        skipped += num;
+        hdll_iter->stop = ITERATOR_GO;
+        if ((hdll_iter->remaining -= num)) { // do not step off the ends of the array
+            hdll_iter->loc += hdll_iter->step * (ptrdiff_t) num;
         }
     }
-    return Slice_next(&hdll_iter->arr_iter);
+    return skipped;
+}
+size_t HybridDblLinkedListIterator_size_hint(HybridDblLinkedListIterator * hdll_iter) {
+    if (!hdll_iter || hdll_iter->stop == ITERATOR_STOP) {
+        return 0;
+    }
+    return hdll_iter->hdll->dll.ll.size - (hdll_iter->stop == ITERATOR_GO);
 }
 enum iterator_status HybridDblLinkedListIterator_stop(HybridDblLinkedListIterator * hdll_iter) {
     if (!hdll_iter) {
@@ -374,11 +624,65 @@ enum iterator_status HybridDblLinkedListIterator_stop(HybridDblLinkedListIterato
     return hdll_iter->stop;
 }
 void HybridDblLinkedListIteratorIterator_init(HybridDblLinkedListIteratorIterator * hdll_iter_iter, HybridDblLinkedListIterator * hdll_iter) {
-    HybridDblLinkedListIterator_init(hdll_iter, hdll_iter->hdll);
+    HybridDblLinkedListIterator_init(hdll_iter_iter, hdll_iter->hdll);
 }
 void * HybridDblLinkedListIteratorIterator_next(HybridDblLinkedListIteratorIterator * hdll_iter) {
     return HybridDblLinkedListIterator_next(hdll_iter);
 }
 enum iterator_status HybridDblLinkedListIteratorIterator_stop(HybridDblLinkedListIteratorIterator * hdll_iter) {
     return HybridDblLinkedListIterator_stop(hdll_iter);
-}
\ No newline at end of file
+}
+
+void HybridDblLinkedListBlockIterator_init(HybridDblLinkedListBlockIterator * blk_iter, HybridDblLinkedList * hdll) {
+    if (!blk_iter) {
+        return;
+    }
+    blk_iter->hdll = hdll;
+    blk_iter->node = NULL;
+    blk_iter->block = (HybridDblLinkedListBlock) {NULL, 0, false};
+    if (!hdll || !hdll->dll.ll.size) {
+        blk_iter->stop = ITERATOR_STOP;
+        return;
+    }
+    blk_iter->block.reversed = hdll->dll.reversed;
+    blk_iter->stop = ITERATOR_PAUSE;
+}
+HybridDblLinkedListBlock * HybridDblLinkedListBlockIterator_next(HybridDblLinkedListBlockIterator * blk_iter) {
+    if (!blk_iter || blk_iter->stop == ITERATOR_STOP) {
+        return NULL;
+    }
+    DblLinkedList * dll = &blk_iter->hdll->dll;
+    NodeAttributes * NA = dll->ll.NA;
+    do { // skip empty blocks, which should only be transient
+        if (blk_iter->stop == ITERATOR_PAUSE) {
+            blk_iter->stop = ITERATOR_GO;
+            blk_iter->node = dll->reversed ? dll->tail : dll->ll.head;
+        } else if (dll->reversed) {
+            blk_iter->node = Node_get(NA, blk_iter->node, PREV);
+        } else {
+            blk_iter->node = Node_get(NA, blk_iter->node, NEXT);
+        }
+        if (!blk_iter->node) {
+            blk_iter->stop = ITERATOR_STOP;
+            return NULL;
+        }
+        blk_iter->block.size = Node_get(NA, blk_iter->node, SIZE);
+    } while (!blk_iter->block.size);
+    blk_iter->block.arr = (void **) Node_get(NA, blk_iter->node, VALUE);
+    return &blk_iter->block;
+}
+enum iterator_status HybridDblLinkedListBlockIterator_stop(HybridDblLinkedListBlockIterator * blk_iter) {
+    if (!blk_iter) {
+        return ITERATOR_STOP;
+    }
+    return blk_iter->stop;
+}
+void HybridDblLinkedListBlockIteratorIterator_init(HybridDblLinkedListBlockIteratorIterator * blk_iter_iter, HybridDblLinkedListBlockIterator * blk_iter) {
+    HybridDblLinkedListBlockIterator_init(blk_iter_iter, blk_iter->hdll);
+}
+HybridDblLinkedListBlock * HybridDblLinkedListBlockIteratorIterator_next(HybridDblLinkedListBlockIteratorIterator * blk_iter) {
+    return HybridDblLinkedListBlockIterator_next(blk_iter);
+}
+enum iterator_status HybridDblLinkedListBlockIteratorIterator_stop(HybridDblLinkedListBlockIteratorIterator * blk_iter) {
+    return HybridDblLinkedListBlockIterator_stop(blk_iter);
+}
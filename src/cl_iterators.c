@@ -9,22 +9,80 @@ define_array_iterable(char)
 define_array_iterable(size_t)
 define_array_iterable(pvoid)
 
+define_array_reductions(double)
+define_array_reductions(float)
+define_array_reductions(long)
+define_array_reductions(int)
+define_array_reductions(size_t)
+
 void Iterator_init(Iterator * iter, void * obj, void * (*next) (void*), enum iterator_status (*stop)(void*)) {
     iter->obj = obj;
     iter->next = next;
     iter->stop = stop;
+    iter->next_n = NULL;
+    iter->advance = NULL;
+    iter->size_hint = NULL;
+}
+
+void Iterator_set_next_n(Iterator * iter, size_t (*next_n)(void*, void**, size_t)) {
+    iter->next_n = next_n;
+}
+
+void Iterator_set_advance(Iterator * iter, size_t (*advance)(void*, size_t)) {
+    iter->advance = advance;
+}
+
+void Iterator_set_size_hint(Iterator * iter, size_t (*size_hint)(void*)) {
+    iter->size_hint = size_hint;
 }
 
 void * Iterator_next(Iterator * iter) {
     return iter->next(iter->obj);
 }
 
+size_t Iterator_next_n(Iterator * iter, void ** out, size_t max) {
+    if (iter->next_n) {
+        return iter->next_n(iter->obj, out, max);
+    }
+    size_t n = 0;
+    while (n < max) {
+        void * next = iter->next(iter->obj);
+        if (iter->stop(iter->obj) != ITERATOR_GO) {
+            break;
+        }
+        out[n++] = next;
+    }
+    return n;
+}
+
+size_t Iterator_advance(Iterator * iter, size_t n) {
+    if (iter->advance) {
+        return iter->advance(iter->obj, n);
+    }
+    size_t k = 0;
+    while (k < n) {
+        iter->next(iter->obj);
+        if (iter->stop(iter->obj) != ITERATOR_GO) {
+            break;
+        }
+        k++;
+    }
+    return k;
+}
+
+size_t Iterator_size_hint(Iterator * iter) {
+    return iter->size_hint ? iter->size_hint(iter->obj) : ITERATOR_SIZE_UNKNOWN;
+}
+
 enum iterator_status Iterator_stop(Iterator * iter) {
     return iter->stop(iter->obj);
 }
 
 void IteratorIterator_init(IteratorIterator * iter_iter, Iterator * iter) {
     Iterator_init(iter_iter, iter->obj, iter->next, iter->stop);
+    Iterator_set_next_n(iter_iter, iter->next_n);
+    Iterator_set_advance(iter_iter, iter->advance);
+    Iterator_set_size_hint(iter_iter, iter->size_hint);
 }
 
 void * IteratorIterator_next(IteratorIterator * iter_iter) {
@@ -79,12 +137,39 @@ void * Filter_next(Filter * filt) {
     return NULL;
 }
 
+size_t Filter_next_n(Filter * filt, void ** out, size_t max) {
+    if (!filt) {
+        return 0;
+    }
+    size_t n = 0;
+    while (n < max) {
+        size_t request = max - n;
+        size_t got = Iterator_next_n((Iterator*) filt, out + n, request);
+        size_t end = n + got;
+        for (size_t i = n; i < end; i++) {
+            if (filt->func(out[i])) {
+                out[n++] = out[i];
+            }
+        }
+        if (got < request) { // underlying iterator is exhausted
+            break;
+        }
+    }
+    return n;
+}
+
 enum iterator_status Filter_stop(Filter * filt) {
     return filt->iter.stop(filt->iter.obj);
 }
 
+size_t Filter_size_hint(Filter * filt) {
+    return Iterator_size_hint(&filt->iter);
+}
+
 void FilterIterator_init(FilterIterator * filt_iter, Filter * filt) {
     Filter_init(filt_iter, filt->func, filt->iter.obj, filt->iter.next, filt->iter.stop);
+    Iterator_set_next_n((Iterator*) filt_iter, filt->iter.next_n);
+    Iterator_set_size_hint((Iterator*) filt_iter, filt->iter.size_hint);
 }
 
 void * FilterIterator_next(FilterIterator * filt_iter) {
@@ -95,9 +180,15 @@ enum iterator_status FilterIterator_stop(FilterIterator * filt_iter) {
     return Filter_stop(filt_iter);
 }
 
+size_t FilterIterator_size_hint(FilterIterator * filt_iter) {
+    return Filter_size_hint(filt_iter);
+}
+
 void Slice_init(Slice * sl, void * obj, void*(*get)(void*, size_t), size_t size, size_t start, size_t stop, long long int step) {
     sl->obj = obj;
     sl->get = get;
+    sl->src = NULL;
+    sl->pos = 0;
     sl->size = size;
     start = (start >= size ? size-1 : start);
     sl->loc = start;
@@ -111,27 +202,99 @@ void Slice_init(Slice * sl, void * obj, void*(*get)(void*, size_t), size_t size,
     }
 }
 
-void * Slice_next(Slice * sl) {
-    if (!sl || sl->stop == ITERATOR_STOP) {
-        return NULL;
+void Slice_init_iterator(Slice * sl, Iterator * src, size_t size, size_t start, size_t stop, long long int step) {
+    Slice_init(sl, NULL, NULL, size, start, stop, step);
+    sl->src = src;
+    if (step <= 0) {
+        sl->stop = ITERATOR_STOP;
     }
+}
+
+// moves loc to the next index in the slice or sets ITERATOR_STOP if there is none
+static bool Slice_step(Slice * sl) {
     if (sl->stop == ITERATOR_PAUSE) {
         sl->stop = ITERATOR_GO;
+        return true;
+    }
+    if (sl->step > 0) {
+        if (sl->end - sl->loc <= sl->step) {
+            sl->stop = ITERATOR_STOP;
+            return false;
+        }
     } else {
-        if (sl->step > 0) {
-            if (sl->end - sl->loc <= sl->step) {
-                sl->stop = ITERATOR_STOP;
-                return NULL;
-            }
-        } else {
-            if (sl->loc - sl->end <= -sl->step) {
-                sl->stop = ITERATOR_STOP;
-                return NULL;
-            }
+        if (sl->loc - sl->end <= -sl->step) {
+            sl->stop = ITERATOR_STOP;
+            return false;
         }
-        sl->loc += sl->step;
     }
-    return sl->get(sl->obj, sl->loc);
+    sl->loc += sl->step;
+    return true;
+}
+
+// element at loc
+static void * Slice_get(Slice * sl) {
+    if (!sl->src) {
+        return sl->get(sl->obj, sl->loc);
+    }
+    Iterator_advance(sl->src, sl->loc - sl->pos);
+    sl->pos = sl->loc + 1;
+    return Iterator_next(sl->src);
+}
+
+void * Slice_next(Slice * sl) {
+    if (!sl || sl->stop == ITERATOR_STOP || !Slice_step(sl)) {
+        return NULL;
+    }
+    return Slice_get(sl);
+}
+
+size_t Slice_next_n(Slice * sl, void ** out, size_t max) {
+    if (!sl || sl->stop == ITERATOR_STOP) {
+        return 0;
+    }
+    size_t n = 0;
+    while (n < max && Slice_step(sl)) {
+        out[n++] = Slice_get(sl);
+    }
+    return n;
+}
+
+bool Slice_split(Slice * sl, Slice * other, size_t grain) {
+    if (!sl || !other || sl->stop != ITERATOR_PAUSE || sl->src) { // parts cannot share src
+        return false;
+    }
+    size_t count = iterator_range_count(sl->loc, sl->end, sl->step);
+    size_t half = count / 2;
+    if (!half || half < grain) {
+        return false;
+    }
+    *other = *sl;
+    other->loc += (count - half) * sl->step;
+    other->start = other->loc;
+    sl->end = other->loc;
+    return true;
+}
+
+size_t Slice_advance(Slice * sl, size_t n) {
+    if (!sl || !n || sl->stop == ITERATOR_STOP) {
+        return 0;
+    }
+    bool started = sl->stop == ITERATOR_GO;
+    size_t remaining = iterator_range_count(sl->loc, sl->end, sl->step) - started;
+    if (n > remaining) {
+        sl->stop = ITERATOR_STOP;
+        return remaining;
+    }
+    sl->loc += (n - !started) * sl->step; // src is only advanced when the next element is fetched
+    sl->stop = ITERATOR_GO;
+    return n;
+}
+
+size_t Slice_size_hint(Slice * sl) {
+    if (!sl || sl->stop == ITERATOR_STOP) {
+        return 0;
+    }
+    return iterator_range_count(sl->loc, sl->end, sl->step) - (sl->stop == ITERATOR_GO);
 }
 
 enum iterator_status Slice_stop(Slice * sl) {
@@ -139,6 +302,11 @@ enum iterator_status Slice_stop(Slice * sl) {
 }
 
 void SliceIterator_init(SliceIterator * sl_iter, Slice * sl) {
+    if (sl->src) {
+        Slice_init_iterator(sl_iter, sl->src, sl->size, sl->start, sl->end, sl->step);
+        sl_iter->pos = sl->pos;
+        return;
+    }
     Slice_init(sl_iter, sl->obj, sl->get, sl->size, sl->start, sl->end, sl->step);
 }
 
@@ -148,4 +316,581 @@ void * SliceIterator_next(SliceIterator * sl_iter) {
 
 enum iterator_status SliceIterator_stop(SliceIterator * sl_iter) {
     return sl_iter->stop;
-}
\ No newline at end of file
+}
+
+size_t SliceIterator_size_hint(SliceIterator * sl_iter) {
+    return Slice_size_hint(sl_iter);
+}
+
+#define PIPELINE_MAP        0
+#define PIPELINE_FILTER     1
+#define PIPELINE_TAKE       2
+#define PIPELINE_SKIP       3
+#define PIPELINE_TAKE_WHILE 4
+#define PIPELINE_DROP_WHILE 5
+
+// results of running an element through the stages
+#define PIPELINE_KEEP 0
+#define PIPELINE_DROP 1
+#define PIPELINE_END  2
+
+void Pipeline_init(Pipeline * pl, void * obj, void * (*next)(void*), enum iterator_status (*stop)(void*)) {
+    if (!pl) {
+        return;
+    }
+    Iterator_init((Iterator*)pl, obj, next, stop);
+    pl->nstages = 0;
+    pl->done = false;
+    pl->stop = ITERATOR_PAUSE;
+}
+
+static enum cl_status Pipeline_add(Pipeline * pl, unsigned char type, void * (*map)(void*), bool (*pred)(void*), size_t count) {
+    if (!pl || pl->nstages == PIPELINE_MAX_STAGES || pl->stop != ITERATOR_PAUSE) {
+        return CL_FAILURE;
+    }
+    pl->stages[pl->nstages++] = (PipelineStage) {type, map, pred, count};
+    return CL_SUCCESS;
+}
+
+enum cl_status Pipeline_map(Pipeline * pl, void * (*func)(void*)) {
+    return func ? Pipeline_add(pl, PIPELINE_MAP, func, NULL, 0) : CL_VALUE_ERROR;
+}
+
+enum cl_status Pipeline_filter(Pipeline * pl, bool (*pred)(void*)) {
+    return pred ? Pipeline_add(pl, PIPELINE_FILTER, NULL, pred, 0) : CL_VALUE_ERROR;
+}
+
+enum cl_status Pipeline_take(Pipeline * pl, size_t num) {
+    return Pipeline_add(pl, PIPELINE_TAKE, NULL, NULL, num);
+}
+
+enum cl_status Pipeline_skip(Pipeline * pl, size_t num) {
+    return Pipeline_add(pl, PIPELINE_SKIP, NULL, NULL, num);
+}
+
+enum cl_status Pipeline_take_while(Pipeline * pl, bool (*pred)(void*)) {
+    return pred ? Pipeline_add(pl, PIPELINE_TAKE_WHILE, NULL, pred, 0) : CL_VALUE_ERROR;
+}
+
+enum cl_status Pipeline_drop_while(Pipeline * pl, bool (*pred)(void*)) {
+    return pred ? Pipeline_add(pl, PIPELINE_DROP_WHILE, NULL, pred, 1) : CL_VALUE_ERROR;
+}
+
+// the fused step. Runs *el through all the stages, replacing it with the mapped element
+static int Pipeline_apply(Pipeline * pl, void ** el) {
+    bool last = false; // a take stage passed its final element, nothing after this one can pass
+    PipelineStage * stage = pl->stages;
+    PipelineStage * end = stage + pl->nstages;
+    for (; stage < end; stage++) {
+        switch (stage->type) {
+            case PIPELINE_MAP: {
+                *el = stage->map(*el);
+                break;
+            }
+            case PIPELINE_FILTER: {
+                if (!stage->pred(*el)) {
+                    return last ? PIPELINE_END : PIPELINE_DROP;
+                }
+                break;
+            }
+            case PIPELINE_TAKE: {
+                if (!stage->count) {
+                    return PIPELINE_END;
+                }
+                if (!--stage->count) {
+                    last = true;
+                }
+                break;
+            }
+            case PIPELINE_SKIP: {
+                if (stage->count) {
+                    stage->count--;
+                    return last ? PIPELINE_END : PIPELINE_DROP;
+                }
+                break;
+            }
+            case PIPELINE_TAKE_WHILE: {
+                if (!stage->pred(*el)) {
+                    return PIPELINE_END;
+                }
+                break;
+            }
+            case PIPELINE_DROP_WHILE: {
+                if (stage->count) {
+                    if (stage->pred(*el)) {
+                        return last ? PIPELINE_END : PIPELINE_DROP;
+                    }
+                    stage->count = 0;
+                }
+                break;
+            }
+        }
+    }
+    pl->done = last;
+    return PIPELINE_KEEP;
+}
+
+void * Pipeline_next(Pipeline * pl) {
+    if (!pl || pl->stop == ITERATOR_STOP) {
+        return NULL;
+    }
+    Iterator * iter = (Iterator*) pl;
+    while (!pl->done) {
+        void * el = iter->next(iter->obj);
+        if (iter->stop(iter->obj) != ITERATOR_GO) {
+            break;
+        }
+        int result = Pipeline_apply(pl, &el);
+        if (result == PIPELINE_KEEP) {
+            pl->stop = ITERATOR_GO;
+            return el;
+        } else if (result == PIPELINE_END) {
+            break;
+        }
+    }
+    pl->stop = ITERATOR_STOP;
+    return NULL;
+}
+
+size_t Pipeline_next_n(Pipeline * pl, void ** out, size_t max) {
+    if (!pl || pl->stop == ITERATOR_STOP) {
+        return 0;
+    }
+    size_t n = 0;
+    while (n < max) {
+        if (pl->done) {
+            pl->stop = ITERATOR_STOP;
+            return n;
+        }
+        size_t request = max - n;
+        size_t got = Iterator_next_n((Iterator*) pl, out + n, request);
+        size_t end = n + got;
+        for (size_t i = n; i < end; i++) {
+            void * el = out[i];
+            int result = Pipeline_apply(pl, &el);
+            if (result == PIPELINE_KEEP) {
+                out[n++] = el;
+                if (pl->done) {
+                    break;
+                }
+            } else if (result == PIPELINE_END) {
+                pl->stop = ITERATOR_STOP;
+                return n;
+            }
+        }
+        if (got < request) {
+            pl->stop = ITERATOR_STOP;
+            return n;
+        }
+    }
+    if (n) {
+        pl->stop = ITERATOR_GO;
+    }
+    return n;
+}
+
+enum iterator_status Pipeline_stop(Pipeline * pl) {
+    if (!pl) {
+        return ITERATOR_STOP;
+    }
+    return pl->stop;
+}
+
+void PipelineIterator_init(PipelineIterator * pl_iter, Pipeline * pl) {
+    *pl_iter = *pl;
+}
+
+void * PipelineIterator_next(PipelineIterator * pl_iter) {
+    return Pipeline_next(pl_iter);
+}
+
+size_t PipelineIterator_next_n(PipelineIterator * pl_iter, void ** out, size_t max) {
+    return Pipeline_next_n(pl_iter, out, max);
+}
+
+enum iterator_status PipelineIterator_stop(PipelineIterator * pl_iter) {
+    return Pipeline_stop(pl_iter);
+}
+
+void Zip_init(Zip * zip, Iterator * iters, void ** items, size_t num) {
+    if (!zip) {
+        return;
+    }
+    zip->iters = iters;
+    zip->items = items;
+    zip->num = num;
+    zip->stop = (num && iters && items) ? ITERATOR_PAUSE : ITERATOR_STOP;
+}
+
+void ** Zip_next(Zip * zip) {
+    if (!zip || zip->stop == ITERATOR_STOP) {
+        return NULL;
+    }
+    for (size_t i = 0; i < zip->num; i++) {
+        Iterator * iter = zip->iters + i;
+        zip->items[i] = iter->next(iter->obj);
+        if (iter->stop(iter->obj) != ITERATOR_GO) {
+            zip->stop = ITERATOR_STOP;
+            return NULL;
+        }
+    }
+    zip->stop = ITERATOR_GO;
+    return zip->items;
+}
+
+enum iterator_status Zip_stop(Zip * zip) {
+    if (!zip) {
+        return ITERATOR_STOP;
+    }
+    return zip->stop;
+}
+
+void ZipIterator_init(ZipIterator * zip_iter, Zip * zip) {
+    Zip_init(zip_iter, zip->iters, zip->items, zip->num);
+}
+
+void ** ZipIterator_next(ZipIterator * zip_iter) {
+    return Zip_next(zip_iter);
+}
+
+enum iterator_status ZipIterator_stop(ZipIterator * zip_iter) {
+    return Zip_stop(zip_iter);
+}
+
+void Chain_init(Chain * chain, Iterator * iters, size_t num) {
+    if (!chain) {
+        return;
+    }
+    chain->iters = iters;
+    chain->num = iters ? num : 0;
+    chain->cur = 0;
+    chain->stop = chain->num ? ITERATOR_PAUSE : ITERATOR_STOP;
+}
+
+void * Chain_next(Chain * chain) {
+    if (!chain || chain->stop == ITERATOR_STOP) {
+        return NULL;
+    }
+    while (chain->cur < chain->num) {
+        Iterator * iter = chain->iters + chain->cur;
+        void * el = iter->next(iter->obj);
+        if (iter->stop(iter->obj) == ITERATOR_GO) {
+            chain->stop = ITERATOR_GO;
+            return el;
+        }
+        chain->cur++;
+    }
+    chain->stop = ITERATOR_STOP;
+    return NULL;
+}
+
+size_t Chain_next_n(Chain * chain, void ** out, size_t max) {
+    if (!chain || chain->stop == ITERATOR_STOP) {
+        return 0;
+    }
+    size_t n = 0;
+    while (n < max) {
+        if (chain->cur == chain->num) {
+            chain->stop = ITERATOR_STOP;
+            return n;
+        }
+        size_t request = max - n;
+        size_t got = Iterator_next_n(chain->iters + chain->cur, out + n, request);
+        n += got;
+        if (got < request) {
+            chain->cur++;
+        }
+    }
+    if (n) {
+        chain->stop = ITERATOR_GO;
+    }
+    return n;
+}
+
+enum iterator_status Chain_stop(Chain * chain) {
+    if (!chain) {
+        return ITERATOR_STOP;
+    }
+    return chain->stop;
+}
+
+void ChainIterator_init(ChainIterator * chain_iter, Chain * chain) {
+    Chain_init(chain_iter, chain->iters, chain->num);
+}
+
+void * ChainIterator_next(ChainIterator * chain_iter) {
+    return Chain_next(chain_iter);
+}
+
+size_t ChainIterator_next_n(ChainIterator * chain_iter, void ** out, size_t max) {
+    return Chain_next_n(chain_iter, out, max);
+}
+
+enum iterator_status ChainIterator_stop(ChainIterator * chain_iter) {
+    return Chain_stop(chain_iter);
+}
+
+void Chunked_init(Chunked * ch, void ** buf, size_t size, void * obj, void * (*next)(void*), enum iterator_status (*stop)(void*)) {
+    if (!ch) {
+        return;
+    }
+    Iterator_init((Iterator*)ch, obj, next, stop);
+    ch->chunk.arr = buf;
+    ch->chunk.size = 0;
+    ch->size = size;
+    ch->stop = (buf && size) ? ITERATOR_PAUSE : ITERATOR_STOP;
+}
+
+Chunk * Chunked_next(Chunked * ch) {
+    if (!ch || ch->stop == ITERATOR_STOP) {
+        return NULL;
+    }
+    // a short chunk means the source ran out
+    if (ch->stop == ITERATOR_GO && ch->chunk.size < ch->size) {
+        ch->stop = ITERATOR_STOP;
+        return NULL;
+    }
+    ch->chunk.size = Iterator_next_n((Iterator*)ch, ch->chunk.arr, ch->size);
+    if (!ch->chunk.size) {
+        ch->stop = ITERATOR_STOP;
+        return NULL;
+    }
+    ch->stop = ITERATOR_GO;
+    return &ch->chunk;
+}
+
+enum iterator_status Chunked_stop(Chunked * ch) {
+    if (!ch) {
+        return ITERATOR_STOP;
+    }
+    return ch->stop;
+}
+
+void ChunkedIterator_init(ChunkedIterator * ch_iter, Chunked * ch) {
+    Chunked_init(ch_iter, ch->chunk.arr, ch->size, ch->iter.obj, ch->iter.next, ch->iter.stop);
+    Iterator_set_next_n((Iterator*) ch_iter, ch->iter.next_n);
+}
+
+Chunk * ChunkedIterator_next(ChunkedIterator * ch_iter) {
+    return Chunked_next(ch_iter);
+}
+
+enum iterator_status ChunkedIterator_stop(ChunkedIterator * ch_iter) {
+    return Chunked_stop(ch_iter);
+}
+
+void Permutations_init(Permutations * perm, size_t * buf, size_t n) {
+    if (!perm) {
+        return;
+    }
+    perm->idx = buf;
+    perm->count = buf ? buf + n : NULL;
+    perm->n = n;
+    perm->i = 1;
+    perm->swapped[0] = perm->swapped[1] = 0;
+    perm->stop = (buf || !n) ? ITERATOR_PAUSE : ITERATOR_STOP;
+    for (size_t j = 0; perm->stop == ITERATOR_PAUSE && j < n; j++) {
+        perm->idx[j] = j;
+        perm->count[j] = 0;
+    }
+}
+
+// iterative Heap's algorithm. count[i] counts the swaps done at level i; a level is done after i swaps
+size_t * Permutations_next(Permutations * perm) {
+    if (!perm || perm->stop == ITERATOR_STOP) {
+        return NULL;
+    }
+    if (perm->stop == ITERATOR_PAUSE) {
+        perm->stop = ITERATOR_GO;
+        return perm->idx;
+    }
+    while (perm->i < perm->n) {
+        size_t i = perm->i;
+        if (perm->count[i] < i) {
+            size_t j = (i & 1) ? perm->count[i] : 0;
+            size_t tmp = perm->idx[j];
+            perm->idx[j] = perm->idx[i];
+            perm->idx[i] = tmp;
+            perm->swapped[0] = j;
+            perm->swapped[1] = i;
+            perm->count[i]++;
+            perm->i = 1;
+            return perm->idx;
+        }
+        perm->count[i] = 0;
+        perm->i++;
+    }
+    perm->stop = ITERATOR_STOP;
+    return NULL;
+}
+
+enum iterator_status Permutations_stop(Permutations * perm) {
+    if (!perm) {
+        return ITERATOR_STOP;
+    }
+    return perm->stop;
+}
+
+void PermutationsIterator_init(PermutationsIterator * perm_iter, Permutations * perm) {
+    Permutations_init(perm_iter, perm->idx, perm->n);
+}
+
+size_t * PermutationsIterator_next(PermutationsIterator * perm_iter) {
+    return Permutations_next(perm_iter);
+}
+
+enum iterator_status PermutationsIterator_stop(PermutationsIterator * perm_iter) {
+    return Permutations_stop(perm_iter);
+}
+
+void Combinations_init(Combinations * comb, size_t * buf, size_t n, size_t k) {
+    if (!comb) {
+        return;
+    }
+    comb->idx = buf;
+    comb->n = n;
+    comb->k = k;
+    comb->out = comb->in = 0;
+    comb->stop = (buf && k <= n) ? ITERATOR_PAUSE : ITERATOR_STOP;
+    if (comb->stop == ITERATOR_PAUSE) {
+        for (size_t j = 0; j < k; j++) {
+            buf[j] = j;
+        }
+        buf[k] = n;
+    }
+}
+
+// Knuth's algorithm R (TAOCP 7.2.1.3) with c_j stored in idx[j-1] and the sentinel c_{k+1} = n in idx[k]
+size_t * Combinations_next(Combinations * comb) {
+    if (!comb || comb->stop == ITERATOR_STOP) {
+        return NULL;
+    }
+    if (comb->stop == ITERATOR_PAUSE) {
+        comb->stop = ITERATOR_GO;
+        return comb->idx;
+    }
+    size_t * c = comb->idx;
+    size_t k = comb->k;
+    if (!k) {
+        comb->stop = ITERATOR_STOP;
+        return NULL;
+    }
+    // easy case, move c_1
+    bool decrease;
+    if (k & 1) {
+        if (c[0] + 1 < c[1]) {
+            comb->out = c[0];
+            comb->in = ++c[0];
+            return c;
+        }
+        decrease = true;
+    } else {
+        if (c[0] > 0) {
+            comb->out = c[0];
+            comb->in = --c[0];
+            return c;
+        }
+        decrease = false;
+    }
+    for (size_t j = 2; j <= k; j++) {
+        // try to decrease c_j, here c_j = c_{j-1} + 1
+        if (decrease) {
+            if (c[j-1] >= j) {
+                comb->out = c[j-1];
+                comb->in = j - 2;
+                c[j-1] = c[j-2];
+                c[j-2] = j - 2;
+                return c;
+            }
+            if (++j > k) {
+                break;
+            }
+        }
+        // try to increase c_j, here c_{j-1} = j - 2
+        if (c[j-1] + 1 < c[j]) {
+            comb->out = c[j-2];
+            comb->in = c[j-1] + 1;
+            c[j-2] = c[j-1];
+            c[j-1]++;
+            return c;
+        }
+        decrease = true;
+    }
+    comb->stop = ITERATOR_STOP;
+    return NULL;
+}
+
+enum iterator_status Combinations_stop(Combinations * comb) {
+    if (!comb) {
+        return ITERATOR_STOP;
+    }
+    return comb->stop;
+}
+
+void CombinationsIterator_init(CombinationsIterator * comb_iter, Combinations * comb) {
+    Combinations_init(comb_iter, comb->idx, comb->n, comb->k);
+}
+
+size_t * CombinationsIterator_next(CombinationsIterator * comb_iter) {
+    return Combinations_next(comb_iter);
+}
+
+enum iterator_status CombinationsIterator_stop(CombinationsIterator * comb_iter) {
+    return Combinations_stop(comb_iter);
+}
+
+void CombinationsWithReplacement_init(CombinationsWithReplacement * comb, size_t * buf, size_t n, size_t k) {
+    if (!comb) {
+        return;
+    }
+    comb->idx = buf;
+    comb->n = n;
+    comb->k = k;
+    comb->stop = ((buf || !k) && (n || !k)) ? ITERATOR_PAUSE : ITERATOR_STOP;
+    for (size_t j = 0; comb->stop == ITERATOR_PAUSE && j < k; j++) {
+        buf[j] = 0;
+    }
+}
+
+size_t * CombinationsWithReplacement_next(CombinationsWithReplacement * comb) {
+    if (!comb || comb->stop == ITERATOR_STOP) {
+        return NULL;
+    }
+    if (comb->stop == ITERATOR_PAUSE) {
+        comb->stop = ITERATOR_GO;
+        return comb->idx;
+    }
+    // bump the last index below n - 1 and reset the ones after it to the same value
+    size_t i = comb->k;
+    while (i && comb->idx[i-1] == comb->n - 1) {
+        i--;
+    }
+    if (!i) {
+        comb->stop = ITERATOR_STOP;
+        return NULL;
+    }
+    size_t val = comb->idx[i-1] + 1;
+    for (size_t j = i - 1; j < comb->k; j++) {
+        comb->idx[j] = val;
+    }
+    return comb->idx;
+}
+
+enum iterator_status CombinationsWithReplacement_stop(CombinationsWithReplacement * comb) {
+    if (!comb) {
+        return ITERATOR_STOP;
+    }
+    return comb->stop;
+}
+
+void CombinationsWithReplacementIterator_init(CombinationsWithReplacementIterator * comb_iter, CombinationsWithReplacement * comb) {
+    CombinationsWithReplacement_init(comb_iter, comb->idx, comb->n, comb->k);
+}
+
+size_t * CombinationsWithReplacementIterator_next(CombinationsWithReplacementIterator * comb_iter) {
+    return CombinationsWithReplacement_next(comb_iter);
+}
+
+enum iterator_status CombinationsWithReplacementIterator_stop(CombinationsWithReplacementIterator * comb_iter) {
+    return CombinationsWithReplacement_stop(comb_iter);
+}
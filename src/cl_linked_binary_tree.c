@@ -1,37 +1,101 @@
+#include <stdint.h> // uintptr_t
 #include <stddef.h>
+#include <string.h>
 #include "cl_core.h"
 #include "cl_circular_buffer.h"
 #include "cl_node.h"
 #include "cl_tree_utils.h"
 #include "cl_linked_binary_tree.h"
 
-#define REQUIRED_NODE_FLAGS Node_flag(LEFT) | Node_flag(RIGHT))
-
-#define DEFAULT_NODE Node_new(NA, 3, Node_attr(VALUE), NULL, Node_attr(RIGHT), NULL, Node_attr(LEFT), NULL)
+#define REQUIRED_NODE_FLAGS (Node_flag(VALUE) | Node_flag(KEY) | Node_flag(LEFT) | Node_flag(RIGHT) | Node_flag(PARENT) | Node_flag(COLOR) | Node_flag(SIZE))
 
+#define DEFAULT_NODE Node_new(NA, 5, Node_attr(VALUE), NULL, Node_attr(KEY), NULL, Node_attr(LEFT), NULL, Node_attr(RIGHT), NULL, Node_attr(PARENT), NULL)
 
 static Node * move(NodeAttributes * NA, Node * node, int dir) {
 	if (dir == DIR_LEFT) {
 		return Node_get(NA, node, LEFT);
 	} else if (dir == DIR_RIGHT) {
 		return Node_get(NA, node, RIGHT);
+	} else if (dir == DIR_PARENT) {
+		return Node_get(NA, node, PARENT);
 	}
 	return NULL;
 }
 
-void LinkedBinaryTree_init(LinkedBinaryTree * lbt, NodeAttributes * NA) {
+static inline bool is_red(NodeAttributes * NA, Node * node) {
+	return node && Node_get(NA, node, COLOR) == TREE_COLOR_RED;
+}
+
+static inline void set_color(NodeAttributes * NA, Node * node, signed char color) {
+	if (node) {
+		Node_set(NA, node, COLOR, color);
+	}
+}
+
+static inline size_t get_size(NodeAttributes * NA, Node * node) {
+	return node ? Node_get(NA, node, SIZE) : 0;
+}
+
+static inline void update_size(NodeAttributes * NA, Node * node) {
+	Node_set(NA, node, SIZE, get_size(NA, Node_get(NA, node, LEFT)) + get_size(NA, Node_get(NA, node, RIGHT)) + 1);
+}
+
+// MAX_END is the greatest END in the subtree of an interval tree
+static inline void update_max_end(LinkedBinaryTree * lbt, Node * node) {
+	NodeAttributes * NA = lbt->NA;
+	Node_type(MAX_END) max_end = Node_get(NA, node, END);
+	Node * left = Node_get(NA, node, LEFT);
+	Node * right = Node_get(NA, node, RIGHT);
+	if (left && lbt->compare(Node_get(NA, left, MAX_END), max_end) > 0) {
+		max_end = Node_get(NA, left, MAX_END);
+	}
+	if (right && lbt->compare(Node_get(NA, right, MAX_END), max_end) > 0) {
+		max_end = Node_get(NA, right, MAX_END);
+	}
+	Node_set(NA, node, MAX_END, max_end);
+}
+
+// recomputes the subtree attributes of node from its children
+static inline void update_node(LinkedBinaryTree * lbt, Node * node) {
+	update_size(lbt->NA, node);
+	if (Node_has(lbt->NA, MAX_END)) {
+		update_max_end(lbt, node);
+	}
+}
+
+// recomputes the subtree attributes from node up to the root after the subtree at node changed
+static void update_to_root(LinkedBinaryTree * lbt, Node * node) {
+	while (node) {
+		update_node(lbt, node);
+		node = Node_get(lbt->NA, node, PARENT);
+	}
+}
+
+// nodes of the block cannot be freed individually
+static inline bool LinkedBinaryTree_in_block(LinkedBinaryTree * lbt, Node * node) {
+	return (uintptr_t) node >= (uintptr_t) lbt->block && (uintptr_t) node < (uintptr_t) lbt->block_end;
+}
+
+void LinkedBinaryTree_init(LinkedBinaryTree * lbt, int (*compare) (Node_type(KEY), Node_type(KEY)), TREE_FLAG_TYPE flags, NodeAttributes * NA) {
+	if (!lbt || !NA) {
+		return;
+	}
     lbt->root = NULL;
     lbt->NA = NA;
     lbt->size = 0;
+	lbt->block = NULL;
+	lbt->block_end = NULL;
+	lbt->compare = compare;
+	lbt->flags = flags;
 }
 
-LinkedBinaryTree * vLinkedBinaryTree_new(unsigned int node_flags, int narg_pairs, va_list args) {
+LinkedBinaryTree * vLinkedBinaryTree_new(int (*compare) (Node_type(KEY), Node_type(KEY)), TREE_FLAG_TYPE flags, unsigned int node_flags, int narg_pairs, va_list args) {
     LinkedBinaryTree * lbt = (LinkedBinaryTree *) CL_MALLOC(sizeof(LinkedBinaryTree));
     if (!lbt) {
         return NULL;
     }
 
-    node_flags |= Node_flag(VALUE); // must have at least the value component
+    node_flags |= REQUIRED_NODE_FLAGS; // must have these flag minimum
     NodeAttributes * NA = vNodeAttributes_new(node_flags, narg_pairs, args);
 
     if (!NA) {
@@ -45,181 +109,985 @@ LinkedBinaryTree * vLinkedBinaryTree_new(unsigned int node_flags, int narg_pairs
         NA->default_alloc = true;
     }
 
-    LinkedBinaryTree_init(lbt, NA);
+    LinkedBinaryTree_init(lbt, compare, flags, NA);
 
     return lbt;
 }
 
-LinkedBinaryTree * LinkedBinaryTree_new(unsigned int node_flags, int narg_pairs, ...) {
+LinkedBinaryTree * LinkedBinaryTree_new(int (*compare) (Node_type(KEY), Node_type(KEY)), TREE_FLAG_TYPE flags, unsigned int node_flags, int narg_pairs, ...) {
     va_list args;
     va_start(args, narg_pairs);
-    LinkedBinaryTree * lbt = vLinkedBinaryTree_new(node_flags, narg_pairs, args);
+    LinkedBinaryTree * lbt = vLinkedBinaryTree_new(compare, flags, node_flags, narg_pairs, args);
     va_end(args);
+	return lbt;
 }
 
-void Node_del_recursive(NodeAttributes * NA, Node * node) {
-	Node_del_recursive(NA, Node_get(NA, node, LEFT));
-	Node_set(NA, node, LEFT, NULL);
-	Node_del_recursive(NA, Node_get(NA, node, RIGHT));
-	Node_set(NA, node, RIGHT, NULL);
-	Node_del(node);
+// recursion depth is bounded by the height of the tree, O(log N)
+static void Node_del_recursive(LinkedBinaryTree * lbt, Node * node) {
+	if (!node) {
+		return;
+	}
+	Node_del_recursive(lbt, Node_get(lbt->NA, node, LEFT));
+	Node_del_recursive(lbt, Node_get(lbt->NA, node, RIGHT));
+	if (!LinkedBinaryTree_in_block(lbt, node)) {
+		Node_del(node);
+	}
+}
+
+void LinkedBinaryTree_clear(LinkedBinaryTree * lbt) {
+	Node_del_recursive(lbt, lbt->root);
+	CL_FREE(lbt->block);
+	lbt->block = NULL;
+	lbt->block_end = NULL;
+	lbt->root = NULL;
+	lbt->size = 0;
 }
 
 void LinkedBinaryTree_del(LinkedBinaryTree * lbt) {
-    Node_del_recursive(lbt->NA, lbt->root);
-    lbt->root = NULL;
-    if (lbt->NA) { // DEFAULT_NODE_ATTRIBUTES is statically allocated
-        CL_FREE(lbt->NA);
-    }
+    LinkedBinaryTree_clear(lbt);
+    NodeAttributes_del(lbt->NA);
     lbt->NA = NULL;
     CL_FREE(lbt);
 }
 
-static bool LinkedBinaryTree_is_leaf(LinkedBinaryTree * lbt, Node * node) {
-	if (node) {
-		Node * child = move(lbt->NA, node, DIR_LEFT);
-		if (!child) {
-			child = move(lbt->NA, node, DIR_RIGHT);
-			if (!child) {
-				return true;
-			}
-		}
-	}
-	return false;
-}
-
 size_t LinkedBinaryTree_size(LinkedBinaryTree * lbt) {
 	return lbt->size;
 }
 
+bool LinkedBinaryTree_is_empty(LinkedBinaryTree * lbt) {
+	return lbt->size == 0;
+}
+
 size_t LinkedBinaryTree_subtree_size(LinkedBinaryTree * lbt, Node * node) {
-	if (node == lbt->root) {
-		return lbt->size;
-	}
-	if (node) {
-		return 1 + LinkedBinaryTree_subtree_size(lbt, move(lbt->NA, node, DIR_LEFT)) + LinkedBinaryTree_subtree_size(lbt, move(lbt->NA, node, DIR_RIGHT));
-	}
-	return 0;
+	return get_size(lbt->NA, node);
 }
 
-// TODO:
 int LinkedBinaryTree_path_to(CircularBuffer * path, LinkedBinaryTree * lbt, Node * node) {
-	// try to do this without heap allocation of the CircularBuffer
+	while (node) {
+		int status = CircularBuffer_push_front(path, node);
+		if (status != CL_SUCCESS) {
+			return status;
+		}
+		node = move(lbt->NA, node, DIR_PARENT);
+	}
+	return CL_SUCCESS;
+}
+
+// replaces the link from the parent of old_child (or root) with new_child
+static void LinkedBinaryTree_replace_child(LinkedBinaryTree * lbt, Node * parent, Node * old_child, Node * new_child) {
+	if (!parent) {
+		lbt->root = new_child;
+	} else if (Node_get(lbt->NA, parent, LEFT) == old_child) {
+		Node_set(lbt->NA, parent, LEFT, new_child);
+	} else {
+		Node_set(lbt->NA, parent, RIGHT, new_child);
+	}
+	if (new_child) {
+		Node_set(lbt->NA, new_child, PARENT, parent);
+	}
 }
 
 int LinkedBinaryTree_rotate(LinkedBinaryTree * lbt, Node * node, int dir) {
 	if (!node || !(dir == DIR_LEFT || dir == DIR_RIGHT)) {
-		return CL_SUCCESS; // do nothing because it cannot be rotated. really should be InputError
+		return CL_VALUE_ERROR;
 	}
-	
+	NodeAttributes * NA = lbt->NA;
+	Node * parent = Node_get(NA, node, PARENT);
 	Node * old_child = NULL;
-	Node * parent = NULL;
 	Node * new_child = NULL;
-	bool has_parent = Node_has(lbt->NA, PARENT);
-	if (has_parent) {
-		parent = Node_get(lbt->NA, node, PARENT);
-	} else {
-		// TODO: traverse down to find node while keeping track of parent
-	}
 	
 	if (dir == DIR_LEFT) {
-		old_child = Node_get(lbt->NA, node, RIGHT);
+		old_child = Node_get(NA, node, RIGHT);
 		if (!old_child) { // cannot rotate left
-			return CL_SUCCESS; // should probably be InputError
+			return CL_VALUE_ERROR;
 		}
-		
-		new_child = Node_get(lbt->NA, old_child, LEFT);
-		Node_set(lbt->NA, node, RIGHT, new_child);
-		Node_set(lbt->NA, old_child, LEFT, node);
-		if (Node_get(lbt->NA, parent, LEFT) == node) {
-			Node_set(lbt->NA, parent, LEFT, old_child);
+		new_child = Node_get(NA, old_child, LEFT);
+		Node_set(NA, node, RIGHT, new_child);
+		Node_set(NA, old_child, LEFT, node);
+	} else {
+		old_child = Node_get(NA, node, LEFT);
+		if (!old_child) { // cannot rotate right
+			return CL_VALUE_ERROR;
+		}
+		new_child = Node_get(NA, old_child, RIGHT);
+		Node_set(NA, node, LEFT, new_child);
+		Node_set(NA, old_child, RIGHT, node);
+	}
+	if (new_child) {
+		Node_set(NA, new_child, PARENT, node);
+	}
+	Node_set(NA, node, PARENT, old_child);
+	LinkedBinaryTree_replace_child(lbt, parent, node, old_child);
+	// only node and old_child have different subtrees. old_child now holds the nodes that node held
+	Node_set(NA, old_child, SIZE, get_size(NA, node));
+	if (Node_has(NA, MAX_END)) {
+		Node_set(NA, old_child, MAX_END, Node_get(NA, node, MAX_END));
+	}
+	update_node(lbt, node);
+	
+	return CL_SUCCESS;
+}
+
+// double rotation: the grandchild on the inside of the rotation becomes the root of the subtree
+int LinkedBinaryTree_split_rotate(LinkedBinaryTree * lbt, Node * node, int dir) {
+	if (!node || !(dir == DIR_LEFT || dir == DIR_RIGHT)) {
+		return CL_VALUE_ERROR;
+	}
+	Node * child = move(lbt->NA, node, -dir);
+	if (!child || !move(lbt->NA, child, dir)) {
+		return CL_VALUE_ERROR;
+	}
+	LinkedBinaryTree_rotate(lbt, child, -dir);
+	return LinkedBinaryTree_rotate(lbt, node, dir);
+}
+
+/******************************** ORDERED MAP *********************************/
+
+static Node * LinkedBinaryTree_leftmost(NodeAttributes * NA, Node * node) {
+	Node * left = NULL;
+	while (node && (left = Node_get(NA, node, LEFT))) {
+		node = left;
+	}
+	return node;
+}
+
+static Node * LinkedBinaryTree_rightmost(NodeAttributes * NA, Node * node) {
+	Node * right = NULL;
+	while (node && (right = Node_get(NA, node, RIGHT))) {
+		node = right;
+	}
+	return node;
+}
+
+Node * LinkedBinaryTree_min(LinkedBinaryTree * lbt) {
+	return LinkedBinaryTree_leftmost(lbt->NA, lbt->root);
+}
+
+Node * LinkedBinaryTree_max(LinkedBinaryTree * lbt) {
+	return LinkedBinaryTree_rightmost(lbt->NA, lbt->root);
+}
+
+Node * LinkedBinaryTree_next(LinkedBinaryTree * lbt, Node * node) {
+	if (!node) {
+		return NULL;
+	}
+	NodeAttributes * NA = lbt->NA;
+	Node * right = Node_get(NA, node, RIGHT);
+	if (right) {
+		return LinkedBinaryTree_leftmost(NA, right);
+	}
+	Node * parent = Node_get(NA, node, PARENT);
+	while (parent && Node_get(NA, parent, RIGHT) == node) {
+		node = parent;
+		parent = Node_get(NA, node, PARENT);
+	}
+	return parent;
+}
+
+Node * LinkedBinaryTree_prev(LinkedBinaryTree * lbt, Node * node) {
+	if (!node) {
+		return NULL;
+	}
+	NodeAttributes * NA = lbt->NA;
+	Node * left = Node_get(NA, node, LEFT);
+	if (left) {
+		return LinkedBinaryTree_rightmost(NA, left);
+	}
+	Node * parent = Node_get(NA, node, PARENT);
+	while (parent && Node_get(NA, parent, LEFT) == node) {
+		node = parent;
+		parent = Node_get(NA, node, PARENT);
+	}
+	return parent;
+}
+
+Node * LinkedBinaryTree_lower_bound(LinkedBinaryTree * lbt, Node_type(KEY) key) {
+	NodeAttributes * NA = lbt->NA;
+	Node * bound = NULL;
+	Node * node = lbt->root;
+	while (node) {
+		if (lbt->compare(Node_get(NA, node, KEY), key) < 0) {
+			node = Node_get(NA, node, RIGHT);
+		} else {
+			bound = node;
+			node = Node_get(NA, node, LEFT);
+		}
+	}
+	return bound;
+}
+
+Node * LinkedBinaryTree_upper_bound(LinkedBinaryTree * lbt, Node_type(KEY) key) {
+	NodeAttributes * NA = lbt->NA;
+	Node * bound = NULL;
+	Node * node = lbt->root;
+	while (node) {
+		if (lbt->compare(key, Node_get(NA, node, KEY)) < 0) {
+			bound = node;
+			node = Node_get(NA, node, LEFT);
 		} else {
-			Node_set(lbt->NA, parent, RIGHT, old_child);
+			node = Node_get(NA, node, RIGHT);
 		}
+	}
+	return bound;
+}
 
-		if (has_parent) {
-			Node_set(lbt->NA, new_child, PARENT, node);
-			Node_set(lbt->NA, node, PARENT, old_child);
-			Node_set(lbt->NA, old_child, PARENT, parent);
+Node * LinkedBinaryTree_find(LinkedBinaryTree * lbt, Node_type(KEY) key) {
+	NodeAttributes * NA = lbt->NA;
+	Node * node = NULL;
+	switch (lbt->flags & TREE_MOD_ORDER_MASK) {
+		case TREE_MOD_FIRST_INORDER: {
+			node = LinkedBinaryTree_lower_bound(lbt, key);
+			break;
 		}
-	} else if (dir == DIR_RIGHT) {
-		old_child = Node_get(lbt->NA, node, LEFT);
-		if (!old_child) { // cannot rotate right
-			return CL_SUCCESS; // should probably be InputError
+		case TREE_MOD_LAST_INORDER: {
+			node = LinkedBinaryTree_upper_bound(lbt, key);
+			node = node ? LinkedBinaryTree_prev(lbt, node) : LinkedBinaryTree_max(lbt);
+			break;
 		}
-		
-		new_child = Node_get(lbt->NA, old_child, RIGHT);
-		Node_set(lbt->NA, node, LEFT, new_child);
-		Node_set(lbt->NA, old_child, RIGHT, node);
-		if (Node_get(lbt->NA, parent, LEFT) == node) {
-			Node_set(lbt->NA, parent, LEFT, old_child);
+		default: { // TREE_MOD_FIRST_LEVELORDER: the first match on the path from the root
+			node = lbt->root;
+			while (node) {
+				int comp = lbt->compare(key, Node_get(NA, node, KEY));
+				if (!comp) {
+					return node;
+				}
+				node = (comp < 0) ? Node_get(NA, node, LEFT) : Node_get(NA, node, RIGHT);
+			}
+			return NULL;
+		}
+	}
+	if (node && lbt->compare(key, Node_get(NA, node, KEY))) {
+		return NULL;
+	}
+	return node;
+}
+
+void * LinkedBinaryTree_get(LinkedBinaryTree * lbt, Node_type(KEY) key) {
+	Node * node = LinkedBinaryTree_find(lbt, key);
+	if (!node) {
+		return NULL;
+	}
+	return Node_get(lbt->NA, node, VALUE);
+}
+
+bool LinkedBinaryTree_contains(LinkedBinaryTree * lbt, Node_type(KEY) key) {
+	return LinkedBinaryTree_find(lbt, key) != NULL;
+}
+
+static void LinkedBinaryTree_insert_fixup(LinkedBinaryTree * lbt, Node * node) {
+	NodeAttributes * NA = lbt->NA;
+	Node * parent = NULL;
+	while ((parent = Node_get(NA, node, PARENT)) && is_red(NA, parent)) {
+		Node * grandparent = Node_get(NA, parent, PARENT); // parent is red so it is not the root
+		int dir = (Node_get(NA, grandparent, LEFT) == parent) ? DIR_LEFT : DIR_RIGHT; // side of parent
+		Node * uncle = move(NA, grandparent, -dir);
+		if (is_red(NA, uncle)) {
+			set_color(NA, parent, TREE_COLOR_BLACK);
+			set_color(NA, uncle, TREE_COLOR_BLACK);
+			set_color(NA, grandparent, TREE_COLOR_RED);
+			node = grandparent;
 		} else {
-			Node_set(lbt->NA, parent, RIGHT, old_child);
+			if (node == move(NA, parent, -dir)) { // inside grandchild, straighten first
+				node = parent;
+				LinkedBinaryTree_rotate(lbt, node, dir);
+				parent = Node_get(NA, node, PARENT);
+			}
+			set_color(NA, parent, TREE_COLOR_BLACK);
+			set_color(NA, grandparent, TREE_COLOR_RED);
+			LinkedBinaryTree_rotate(lbt, grandparent, -dir);
 		}
+	}
+	set_color(NA, lbt->root, TREE_COLOR_BLACK);
+}
 
-		if (has_parent) {
-			Node_set(lbt->NA, new_child, PARENT, node);
-			Node_set(lbt->NA, node, PARENT, old_child);
-			Node_set(lbt->NA, old_child, PARENT, parent);
+// end is only used by interval trees
+static enum cl_status LinkedBinaryTree_insert_node(LinkedBinaryTree * lbt, Node_type(KEY) key, Node_type(END) end, void * value) {
+	NodeAttributes * NA = lbt->NA;
+	Node * parent = NULL;
+	Node * node = lbt->root;
+	int dir = DIR_LEFT;
+	while (node) {
+		int comp = lbt->compare(key, Node_get(NA, node, KEY));
+		if (!comp && (lbt->flags & TREE_MOD_UNIQUE)) {
+			if (lbt->flags & TREE_MOD_UPDATE) {
+				Node_set(NA, node, VALUE, value);
+				return CL_SUCCESS;
+			}
+			return CL_FAILURE;
 		}
+		parent = node;
+		// equal keys go after existing ones unless they are to be found first in order
+		dir = (comp < 0 || (!comp && (lbt->flags & TREE_MOD_ORDER_MASK) == TREE_MOD_FIRST_INORDER)) ? DIR_LEFT : DIR_RIGHT;
+		node = move(NA, node, dir);
 	}
-	
-	return lbt;
+	node = Node_new(NA, 5, Node_attr(VALUE), value, Node_attr(KEY), key, Node_attr(LEFT), NULL, Node_attr(RIGHT), NULL, Node_attr(PARENT), parent);
+	if (!node) {
+		return CL_MALLOC_FAILURE;
+	}
+	Node_set(NA, node, COLOR, TREE_COLOR_RED);
+	Node_set(NA, node, SIZE, 1);
+	if (Node_has(NA, MAX_END)) {
+		Node_set(NA, node, END, end);
+		Node_set(NA, node, MAX_END, end);
+	}
+	if (!parent) {
+		lbt->root = node;
+	} else if (dir == DIR_LEFT) {
+		Node_set(NA, parent, LEFT, node);
+	} else {
+		Node_set(NA, parent, RIGHT, node);
+	}
+	lbt->size++;
+	update_to_root(lbt, parent);
+	LinkedBinaryTree_insert_fixup(lbt, node);
+	return CL_SUCCESS;
 }
 
-LinkedBinaryTree * LinkedBinaryTree_split_rotate(LinkedBinaryTree * lbt, size_t index, int dir) {
-    size_t N = lbt->size;
-    if (index >= N || lbt->nodes[index] == NULL) {
-        return lbt; // do nothing because it cannot be rotated or rotating is meaningless
-	}
-    size_t left_child = move(index, DIR_LEFT);
-    size_t right_child = move(index, DIR_RIGHT);
-    
-    if (dir == DIR_LEFT) {
-        size_t grandchild = move(right_child, DIR_LEFT);
-        if (right_child >= N || grandchild >= N || lbt->nodes[right_child] == NULL || lbt->nodes[grandchild] == NULL) { // cannot rotate left
-            return lbt;
-		}
-        // move left_child to its left subtree // might incur O(N) memory increase and build time
-        LinkedBinaryTree_move_subtree(lbt, left_child, move(left_child, DIR_LEFT));
-        
-        // swap index and left_child
-        LinkedBinaryTree_swap(lbt, index, left_child);
-        
-        // swap grandchild and index
-        LinkedBinaryTree_swap(lbt, index, grandchild);
-        
-        // move grandchild's left subtree to left_child's right subtree
-        LinkedBinaryTree_move_subtree(lbt, move(grandchild, DIR_LEFT), move(left_child, DIR_RIGHT));
-        
-        // move granchild's right subtree to right_child's left subtree
-        LinkedBinaryTree_move_subtree(lbt, move(grandchild, DIR_RIGHT), move(right_child, DIR_LEFT));
-	} else if (dir == DIR_RIGHT) {
-        size_t grandchild = move(left_child, DIR_RIGHT);
-        if (left_child >= N || grandchild >= N || lbt->nodes[left_child] == NULL || lbt->nodes[grandchild] == NULL) { // cannot rotate right
-            return lbt;
-		}
-        if (grandchild >= N) {
-            LinkedBinaryTree_resize(lbt, grandchild+1);
-		}
-        
-        // move right_child to its right subtree // might incur O(N) memory increase and build time
-        LinkedBinaryTree_move_subtree(lbt, right_child, move(right_child, DIR_RIGHT));
-        // swap index and right_child
-        LinkedBinaryTree_swap(lbt, index, right_child);
-        // swap grandchild and index
-        LinkedBinaryTree_swap(lbt, index, grandchild);
-        // move granchild's right subtree to right_child's left subtree
-        LinkedBinaryTree_move_subtree(lbt, move(grandchild, DIR_RIGHT), move(right_child, DIR_LEFT));
-        // move grandchild's left subtree to left_child's right subtree
-        LinkedBinaryTree_move_subtree(lbt, move(grandchild, DIR_LEFT), move(left_child, DIR_RIGHT));
-        
-    } else {
-		assert(dir == DIR_LEFT || dir == DIR_RIGHT);
-        // handle error
-	}
-    
-    return lbt;
+// in an interval tree key is inserted as the interval [key, key]
+enum cl_status LinkedBinaryTree_insert(LinkedBinaryTree * lbt, Node_type(KEY) key, void * value) {
+	if (!lbt) {
+		return CL_VALUE_ERROR;
+	}
+	return LinkedBinaryTree_insert_node(lbt, key, key, value);
+}
+
+// node took the place of a removed black node and is "doubly black". node may be NULL so its parent is passed separately
+static void LinkedBinaryTree_remove_fixup(LinkedBinaryTree * lbt, Node * node, Node * parent) {
+	NodeAttributes * NA = lbt->NA;
+	while (node != lbt->root && !is_red(NA, node)) {
+		int dir = (Node_get(NA, parent, LEFT) == node) ? DIR_LEFT : DIR_RIGHT; // side of node
+		Node * sibling = move(NA, parent, -dir); // cannot be NULL since the black height on its side is >= 1
+		if (is_red(NA, sibling)) {
+			set_color(NA, sibling, TREE_COLOR_BLACK);
+			set_color(NA, parent, TREE_COLOR_RED);
+			LinkedBinaryTree_rotate(lbt, parent, dir);
+			sibling = move(NA, parent, -dir);
+		}
+		if (!is_red(NA, move(NA, sibling, DIR_LEFT)) && !is_red(NA, move(NA, sibling, DIR_RIGHT))) {
+			set_color(NA, sibling, TREE_COLOR_RED);
+			node = parent;
+			parent = Node_get(NA, node, PARENT);
+		} else {
+			if (!is_red(NA, move(NA, sibling, -dir))) { // only inside nephew is red, straighten first
+				set_color(NA, move(NA, sibling, dir), TREE_COLOR_BLACK);
+				set_color(NA, sibling, TREE_COLOR_RED);
+				LinkedBinaryTree_rotate(lbt, sibling, -dir);
+				sibling = move(NA, parent, -dir);
+			}
+			set_color(NA, sibling, Node_get(NA, parent, COLOR));
+			set_color(NA, parent, TREE_COLOR_BLACK);
+			set_color(NA, move(NA, sibling, -dir), TREE_COLOR_BLACK);
+			LinkedBinaryTree_rotate(lbt, parent, dir);
+			node = lbt->root;
+		}
+	}
+	set_color(NA, node, TREE_COLOR_BLACK);
+}
+
+// nodes are relinked rather than having their contents swapped because KEY cannot be overwritten with Node_set
+void * LinkedBinaryTree_remove_node(LinkedBinaryTree * lbt, Node * node) {
+	if (!lbt || !node) {
+		return NULL;
+	}
+	NodeAttributes * NA = lbt->NA;
+	Node * left = Node_get(NA, node, LEFT);
+	Node * right = Node_get(NA, node, RIGHT);
+	Node * child = NULL;	// node that moves into the position vacated in the tree
+	Node * parent = NULL;	// parent of child after the move
+	signed char removed_color = Node_get(NA, node, COLOR);
+	if (!left || !right) {
+		child = left ? left : right;
+		parent = Node_get(NA, node, PARENT);
+		LinkedBinaryTree_replace_child(lbt, parent, node, child);
+	} else { // successor takes the place of node
+		Node * successor = LinkedBinaryTree_leftmost(NA, right);
+		removed_color = Node_get(NA, successor, COLOR);
+		child = Node_get(NA, successor, RIGHT);
+		if (successor == right) {
+			parent = successor;
+		} else {
+			parent = Node_get(NA, successor, PARENT);
+			LinkedBinaryTree_replace_child(lbt, parent, successor, child);
+			Node_set(NA, successor, RIGHT, right);
+			Node_set(NA, right, PARENT, successor);
+		}
+		LinkedBinaryTree_replace_child(lbt, Node_get(NA, node, PARENT), node, successor);
+		Node_set(NA, successor, LEFT, left);
+		Node_set(NA, left, PARENT, successor);
+		set_color(NA, successor, Node_get(NA, node, COLOR));
+	}
+	update_to_root(lbt, parent);
+	if (removed_color == TREE_COLOR_BLACK) {
+		LinkedBinaryTree_remove_fixup(lbt, child, parent);
+	}
+	void * value = Node_get(NA, node, VALUE);
+	if (!LinkedBinaryTree_in_block(lbt, node)) {
+		Node_del(node);
+	}
+	lbt->size--;
+	return value;
+}
+
+enum cl_status LinkedBinaryTree_erase(LinkedBinaryTree * lbt, Node_type(KEY) key) {
+	if (!lbt) {
+		return CL_VALUE_ERROR;
+	}
+	Node * node = LinkedBinaryTree_find(lbt, key);
+	if (!node) {
+		return CL_FAILURE;
+	}
+	LinkedBinaryTree_remove_node(lbt, node);
+	return CL_SUCCESS;
+}
+
+/***************************** ORDER STATISTICS *******************************/
+
+Node * LinkedBinaryTree_select(LinkedBinaryTree * lbt, size_t k) {
+	if (!lbt || k >= lbt->size) {
+		return NULL;
+	}
+	NodeAttributes * NA = lbt->NA;
+	Node * node = lbt->root;
+	while (node) {
+		size_t left_size = get_size(NA, Node_get(NA, node, LEFT));
+		if (k < left_size) {
+			node = Node_get(NA, node, LEFT);
+		} else if (k == left_size) {
+			return node;
+		} else {
+			k -= left_size + 1;
+			node = Node_get(NA, node, RIGHT);
+		}
+	}
+	return NULL;
+}
+
+size_t LinkedBinaryTree_rank(LinkedBinaryTree * lbt, Node_type(KEY) key) {
+	NodeAttributes * NA = lbt->NA;
+	size_t rank = 0;
+	Node * node = lbt->root;
+	while (node) {
+		if (lbt->compare(Node_get(NA, node, KEY), key) < 0) {
+			rank += get_size(NA, Node_get(NA, node, LEFT)) + 1;
+			node = Node_get(NA, node, RIGHT);
+		} else {
+			node = Node_get(NA, node, LEFT);
+		}
+	}
+	return rank;
+}
+
+size_t LinkedBinaryTree_node_rank(LinkedBinaryTree * lbt, Node * node) {
+	NodeAttributes * NA = lbt->NA;
+	size_t rank = get_size(NA, Node_get(NA, node, LEFT));
+	Node * parent = NULL;
+	while ((parent = Node_get(NA, node, PARENT))) {
+		if (Node_get(NA, parent, RIGHT) == node) {
+			rank += get_size(NA, Node_get(NA, parent, LEFT)) + 1;
+		}
+		node = parent;
+	}
+	return rank;
+}
+
+size_t LinkedBinaryTree_count_range(LinkedBinaryTree * lbt, Node_type(KEY) start_key, Node_type(KEY) end_key) {
+	size_t start = LinkedBinaryTree_rank(lbt, start_key);
+	size_t end = LinkedBinaryTree_rank(lbt, end_key);
+	return (end > start) ? end - start : 0;
+}
+
+/***************************** BULK CONSTRUCTION ******************************/
+
+// nodes in a block are padded so that their pointer and size_t attributes stay aligned
+#define BLOCK_ALIGN (sizeof(void *) > sizeof(size_t) ? sizeof(void *) : sizeof(size_t))
+
+#define MERGE_UNION         0
+#define MERGE_INTERSECTION  1
+#define MERGE_DIFFERENCE    2
+
+// a sorted sequence of keys and values, consumed in order by the builder. next returns false when it is exhausted
+typedef struct SortedSource {
+	bool (*next) (struct SortedSource * src, Node_type(KEY) * key, void ** value);
+	Node_type(KEY) * keys;
+	void ** values;
+	size_t index;
+	LinkedBinaryTree * a;
+	LinkedBinaryTree * b;
+	Node * node_a;
+	Node * node_b;
+	int op;
+} SortedSource;
+
+typedef struct TreeBuilder {
+	LinkedBinaryTree * lbt;
+	SortedSource * src;
+	unsigned char * next_node; // next unused node in the block
+	size_t stride;
+	size_t red_depth;
+} TreeBuilder;
+
+static bool SortedSource_next_array(SortedSource * src, Node_type(KEY) * key, void ** value) {
+	*key = src->keys[src->index];
+	*value = src->values ? src->values[src->index] : NULL;
+	src->index++;
+	return true;
+}
+
+// merges the in-order walks of a and b, keeping what op selects
+static bool SortedSource_next_merge(SortedSource * src, Node_type(KEY) * key, void ** value) {
+	NodeAttributes * NA_a = src->a->NA;
+	NodeAttributes * NA_b = src->b->NA;
+	while (src->node_a || src->node_b) {
+		int comp = 0;
+		if (!src->node_a) {
+			comp = 1;
+		} else if (!src->node_b) {
+			comp = -1;
+		} else {
+			comp = src->a->compare(Node_get(NA_a, src->node_a, KEY), Node_get(NA_b, src->node_b, KEY));
+		}
+		Node * out = NULL;
+		NodeAttributes * NA = NA_a;
+		if (comp < 0) {
+			if (src->op != MERGE_INTERSECTION) {
+				out = src->node_a;
+			}
+			src->node_a = LinkedBinaryTree_next(src->a, src->node_a);
+		} else if (comp > 0) {
+			if (src->op == MERGE_UNION) {
+				out = src->node_b;
+				NA = NA_b;
+			}
+			src->node_b = LinkedBinaryTree_next(src->b, src->node_b);
+		} else {
+			if (src->op != MERGE_DIFFERENCE) {
+				out = src->node_a;
+			}
+			src->node_a = LinkedBinaryTree_next(src->a, src->node_a);
+			src->node_b = LinkedBinaryTree_next(src->b, src->node_b);
+		}
+		if (out) {
+			*key = Node_get(NA, out, KEY);
+			*value = Node_get(NA, out, VALUE);
+			return true;
+		}
+	}
+	return false;
+}
+
+// builds the subtree of the next num elements of the source. Subtree sizes differ by at most one so only the deepest
+// level can be incomplete; coloring it red and everything else black gives equal black heights
+static Node * LinkedBinaryTree_build(TreeBuilder * builder, Node * parent, size_t num, size_t depth) {
+	if (!num) {
+		return NULL;
+	}
+	NodeAttributes * NA = builder->lbt->NA;
+	size_t left_num = num / 2;
+	Node * left = LinkedBinaryTree_build(builder, NULL, left_num, depth + 1);
+
+	Node * node = builder->next_node;
+	builder->next_node += builder->stride;
+	memcpy(node, NA->defaults, NA->size);
+	Node_type(KEY) key = NULL;
+	void * value = NULL;
+	builder->src->next(builder->src, &key, &value);
+	Node_get(NA, node, KEY) = key; // the copied default KEY is not a set key
+	Node_set(NA, node, VALUE, value);
+	Node_set(NA, node, PARENT, parent);
+	Node_set(NA, node, LEFT, left);
+	if (left) {
+		Node_set(NA, left, PARENT, node);
+	}
+	Node * right = LinkedBinaryTree_build(builder, node, num - left_num - 1, depth + 1);
+	Node_set(NA, node, RIGHT, right);
+	Node_set(NA, node, COLOR, (depth == builder->red_depth) ? TREE_COLOR_RED : TREE_COLOR_BLACK);
+	Node_set(NA, node, SIZE, num);
+	if (Node_has(NA, HEIGHT)) {
+		size_t height = 0;
+		if (left) {
+			height = Node_get(NA, left, HEIGHT);
+		}
+		if (right && Node_get(NA, right, HEIGHT) > height) {
+			height = Node_get(NA, right, HEIGHT);
+		}
+		Node_set(NA, node, HEIGHT, height + 1);
+	}
+	return node;
+}
+
+// the sources carry no END so interval trees cannot be built in bulk
+static enum cl_status LinkedBinaryTree_build_from_source(LinkedBinaryTree * lbt, SortedSource * src, size_t num) {
+	if (Node_has(lbt->NA, MAX_END)) {
+		return CL_VALUE_ERROR;
+	}
+	size_t stride = (lbt->NA->size + BLOCK_ALIGN - 1) / BLOCK_ALIGN * BLOCK_ALIGN;
+	Node * block = NULL;
+	if (num) {
+		if (!(block = (Node *) CL_MALLOC(num * stride))) {
+			return CL_MALLOC_FAILURE;
+		}
+	}
+	LinkedBinaryTree_clear(lbt);
+	lbt->block = block;
+	lbt->block_end = block ? block + num * stride : NULL;
+
+	TreeBuilder builder = {lbt, src, block, stride, 0};
+	while (num >> (builder.red_depth + 1)) { // floor(log2(num)), the depth of the last level
+		builder.red_depth++;
+	}
+	lbt->root = LinkedBinaryTree_build(&builder, NULL, num, 0);
+	set_color(lbt->NA, lbt->root, TREE_COLOR_BLACK);
+	lbt->size = num;
+	return CL_SUCCESS;
+}
+
+enum cl_status LinkedBinaryTree_build_from_sorted(LinkedBinaryTree * lbt, Node_type(KEY) * keys, void ** values, size_t num) {
+	if (!lbt || (num && !keys)) {
+		return CL_VALUE_ERROR;
+	}
+	SortedSource src = {SortedSource_next_array, keys, values, 0, NULL, NULL, NULL, NULL, 0};
+	return LinkedBinaryTree_build_from_source(lbt, &src, num);
+}
+
+// the merge runs twice, first to size the block and then to fill it
+static enum cl_status LinkedBinaryTree_merge(LinkedBinaryTree * dest, LinkedBinaryTree * a, LinkedBinaryTree * b, int op) {
+	if (!dest || !a || !b || dest == a || dest == b) {
+		return CL_VALUE_ERROR;
+	}
+	SortedSource src = {SortedSource_next_merge, NULL, NULL, 0, a, b, LinkedBinaryTree_min(a), LinkedBinaryTree_min(b), op};
+	SortedSource counter = src;
+	Node_type(KEY) key = NULL;
+	void * value = NULL;
+	size_t num = 0;
+	while (counter.next(&counter, &key, &value)) {
+		num++;
+	}
+	return LinkedBinaryTree_build_from_source(dest, &src, num);
+}
+
+enum cl_status LinkedBinaryTree_union(LinkedBinaryTree * dest, LinkedBinaryTree * a, LinkedBinaryTree * b) {
+	return LinkedBinaryTree_merge(dest, a, b, MERGE_UNION);
+}
+
+enum cl_status LinkedBinaryTree_intersection(LinkedBinaryTree * dest, LinkedBinaryTree * a, LinkedBinaryTree * b) {
+	return LinkedBinaryTree_merge(dest, a, b, MERGE_INTERSECTION);
+}
+
+enum cl_status LinkedBinaryTree_difference(LinkedBinaryTree * dest, LinkedBinaryTree * a, LinkedBinaryTree * b) {
+	return LinkedBinaryTree_merge(dest, a, b, MERGE_DIFFERENCE);
+}
+
+/******************************* INTERVAL TREE ********************************/
+
+enum cl_status LinkedBinaryTree_insert_interval(LinkedBinaryTree * lbt, Node_type(KEY) start, Node_type(END) end, void * value) {
+	if (!lbt || !Node_has(lbt->NA, MAX_END)) {
+		return CL_VALUE_ERROR;
+	}
+	return LinkedBinaryTree_insert_node(lbt, start, end, value);
+}
+
+enum cl_status LinkedBinaryTree_erase_interval(LinkedBinaryTree * lbt, Node_type(KEY) start, Node_type(END) end) {
+	if (!lbt || !Node_has(lbt->NA, MAX_END)) {
+		return CL_VALUE_ERROR;
+	}
+	NodeAttributes * NA = lbt->NA;
+	Node * node = LinkedBinaryTree_lower_bound(lbt, start);
+	while (node && !lbt->compare(Node_get(NA, node, KEY), start)) {
+		if (!lbt->compare(Node_get(NA, node, END), end)) {
+			LinkedBinaryTree_remove_node(lbt, node);
+			return CL_SUCCESS;
+		}
+		node = LinkedBinaryTree_next(lbt, node);
+	}
+	return CL_FAILURE;
+}
+
+// the intervals overlapping [start, end] are those in key order with END >= start, up to the first with key > end.
+// Subtrees whose MAX_END < start hold none of them and are skipped
+
+// leftmost node in the subtree at node with END >= start
+static Node * LinkedBinaryTree_first_ending_after(LinkedBinaryTree * lbt, Node * node, Node_type(KEY) start) {
+	NodeAttributes * NA = lbt->NA;
+	while (node && lbt->compare(Node_get(NA, node, MAX_END), start) >= 0) {
+		Node * left = Node_get(NA, node, LEFT);
+		if (left && lbt->compare(Node_get(NA, left, MAX_END), start) >= 0) {
+			node = left;
+		} else if (lbt->compare(Node_get(NA, node, END), start) >= 0) {
+			return node;
+		} else {
+			node = Node_get(NA, node, RIGHT);
+		}
+	}
+	return NULL;
+}
+
+// next node in key order after node with END >= start
+static Node * LinkedBinaryTree_next_ending_after(LinkedBinaryTree * lbt, Node * node, Node_type(KEY) start) {
+	NodeAttributes * NA = lbt->NA;
+	Node * next = LinkedBinaryTree_first_ending_after(lbt, Node_get(NA, node, RIGHT), start);
+	Node * parent = NULL;
+	while (!next && (parent = Node_get(NA, node, PARENT))) {
+		if (Node_get(NA, parent, LEFT) == node) {
+			if (lbt->compare(Node_get(NA, parent, END), start) >= 0) {
+				return parent;
+			}
+			next = LinkedBinaryTree_first_ending_after(lbt, Node_get(NA, parent, RIGHT), start);
+		}
+		node = parent;
+	}
+	return next;
+}
+
+void LinkedBinaryTreeIntervalIterator_init(LinkedBinaryTreeIntervalIterator * lbt_iter, LinkedBinaryTree * lbt, Node_type(KEY) start, Node_type(END) end) {
+	if (!lbt_iter) {
+		return;
+	}
+	lbt_iter->lbt = lbt;
+	lbt_iter->node = NULL;
+	lbt_iter->start = start;
+	lbt_iter->end = end;
+	lbt_iter->stop = (lbt && Node_has(lbt->NA, MAX_END)) ? ITERATOR_PAUSE : ITERATOR_STOP;
+}
+
+void LinkedBinaryTreeIntervalIterator_init_stab(LinkedBinaryTreeIntervalIterator * lbt_iter, LinkedBinaryTree * lbt, Node_type(KEY) point) {
+	LinkedBinaryTreeIntervalIterator_init(lbt_iter, lbt, point, point);
+}
+
+Node * LinkedBinaryTreeIntervalIterator_next_node(LinkedBinaryTreeIntervalIterator * lbt_iter) {
+	if (!lbt_iter || lbt_iter->stop == ITERATOR_STOP) {
+		return NULL;
+	}
+	LinkedBinaryTree * lbt = lbt_iter->lbt;
+	Node * node = NULL;
+	if (lbt_iter->stop == ITERATOR_PAUSE) {
+		lbt_iter->stop = ITERATOR_GO;
+		node = LinkedBinaryTree_first_ending_after(lbt, lbt->root, lbt_iter->start);
+	} else {
+		node = LinkedBinaryTree_next_ending_after(lbt, lbt_iter->node, lbt_iter->start);
+	}
+	if (!node || lbt->compare(Node_get(lbt->NA, node, KEY), lbt_iter->end) > 0) {
+		node = NULL;
+		lbt_iter->stop = ITERATOR_STOP;
+	}
+	lbt_iter->node = node;
+	return node;
+}
+
+void * LinkedBinaryTreeIntervalIterator_next(LinkedBinaryTreeIntervalIterator * lbt_iter) {
+	Node * node = LinkedBinaryTreeIntervalIterator_next_node(lbt_iter);
+	return node ? Node_get(lbt_iter->lbt->NA, node, VALUE) : NULL;
+}
+
+enum iterator_status LinkedBinaryTreeIntervalIterator_stop(LinkedBinaryTreeIntervalIterator * lbt_iter) {
+	if (!lbt_iter) {
+		return ITERATOR_STOP;
+	}
+	return lbt_iter->stop;
+}
+
+/********************************* ITERATORS **********************************/
+
+// all orders step between nodes with the LEFT/RIGHT/PARENT links alone so iteration allocates nothing. dir is the
+// side visited first, which TREE_ITERATE_REVERSE switches to RIGHT
+
+// node furthest along dir from node
+static Node * LinkedBinaryTree_extreme(NodeAttributes * NA, Node * node, int dir) {
+	Node * child = NULL;
+	while ((child = move(NA, node, dir))) {
+		node = child;
+	}
+	return node;
+}
+
+// first node in post-order of the subtree at node
+static Node * LinkedBinaryTree_first_leaf(NodeAttributes * NA, Node * node, int dir) {
+	Node * child = NULL;
+	while ((child = move(NA, node, dir)) || (child = move(NA, node, -dir))) {
+		node = child;
+	}
+	return node;
+}
+
+// first node depth levels below root in level order. Walks the subtree in pre-order without going below depth
+static Node * LinkedBinaryTree_first_at_depth(NodeAttributes * NA, Node * root, size_t depth, int dir) {
+	Node * node = root;
+	size_t d = 0;
+	while (d < depth) {
+		Node * child = move(NA, node, dir);
+		if (child || (child = move(NA, node, -dir))) {
+			node = child;
+			d++;
+			continue;
+		}
+		// climb until there is an unvisited sibling on the second side
+		while (true) {
+			if (node == root) {
+				return NULL;
+			}
+			Node * parent = Node_get(NA, node, PARENT);
+			Node * sibling = move(NA, parent, -dir);
+			if (sibling && sibling != node) {
+				node = sibling;
+				break;
+			}
+			node = parent;
+			d--;
+		}
+	}
+	return node;
+}
+
+static Node * LinkedBinaryTree_inorder_next(NodeAttributes * NA, Node * node, int dir) {
+	Node * child = move(NA, node, -dir);
+	if (child) {
+		return LinkedBinaryTree_extreme(NA, child, dir);
+	}
+	Node * parent = Node_get(NA, node, PARENT);
+	while (parent && move(NA, parent, -dir) == node) {
+		node = parent;
+		parent = Node_get(NA, node, PARENT);
+	}
+	return parent;
+}
+
+static Node * LinkedBinaryTree_preorder_next(NodeAttributes * NA, Node * node, int dir) {
+	Node * child = move(NA, node, dir);
+	if (child || (child = move(NA, node, -dir))) {
+		return child;
+	}
+	Node * parent = NULL;
+	while ((parent = Node_get(NA, node, PARENT))) {
+		Node * sibling = move(NA, parent, -dir);
+		if (sibling && sibling != node) {
+			return sibling;
+		}
+		node = parent;
+	}
+	return NULL;
+}
+
+static Node * LinkedBinaryTree_postorder_next(NodeAttributes * NA, Node * node, int dir) {
+	Node * parent = Node_get(NA, node, PARENT);
+	if (!parent) {
+		return NULL;
+	}
+	Node * sibling = move(NA, parent, -dir);
+	if (sibling && sibling != node) {
+		return LinkedBinaryTree_first_leaf(NA, sibling, dir);
+	}
+	return parent;
+}
+
+// next node at the same depth, otherwise the first node one level down. Each step re-descends from a common
+// ancestor, so a full traversal costs O(N log N) on a balanced tree in exchange for no queue
+static Node * LinkedBinaryTree_levelorder_next(LinkedBinaryTreeIterator * lbt_iter) {
+	NodeAttributes * NA = lbt_iter->lbt->NA;
+	int dir = lbt_iter->dir;
+	Node * node = lbt_iter->node;
+	Node * parent = NULL;
+	size_t up = 0;
+	while ((parent = Node_get(NA, node, PARENT))) {
+		up++;
+		Node * sibling = move(NA, parent, -dir);
+		if (sibling && sibling != node) {
+			Node * next = LinkedBinaryTree_first_at_depth(NA, sibling, up - 1, dir);
+			if (next) {
+				return next;
+			}
+		}
+		node = parent;
+	}
+	lbt_iter->depth++;
+	return LinkedBinaryTree_first_at_depth(NA, node, lbt_iter->depth, dir);
+}
+
+void LinkedBinaryTreeIterator_init(LinkedBinaryTreeIterator * lbt_iter, LinkedBinaryTree * lbt, TREE_FLAG_TYPE order) {
+	if (!lbt_iter) {
+		return;
+	}
+	lbt_iter->lbt = lbt;
+	lbt_iter->node = NULL;
+	lbt_iter->depth = 0;
+	lbt_iter->order = order;
+	lbt_iter->dir = (order & TREE_ITERATE_REVERSE) ? DIR_RIGHT : DIR_LEFT;
+	lbt_iter->stop = ITERATOR_STOP;
+	if (!lbt || !lbt->root) {
+		return;
+	}
+	NodeAttributes * NA = lbt->NA;
+	switch (order & TREE_ITERATE_ORDER_MASK) {
+		case TREE_ITERATE_INORDER: {
+			lbt_iter->node = LinkedBinaryTree_extreme(NA, lbt->root, lbt_iter->dir);
+			break;
+		}
+		case TREE_ITERATE_POSTORDER: {
+			lbt_iter->node = LinkedBinaryTree_first_leaf(NA, lbt->root, lbt_iter->dir);
+			break;
+		}
+		default: { // TREE_ITERATE_PREORDER & TREE_ITERATE_LEVELORDER
+			lbt_iter->node = lbt->root;
+		}
+	}
+	lbt_iter->stop = ITERATOR_PAUSE;
+}
+
+Node * LinkedBinaryTreeIterator_next_node(LinkedBinaryTreeIterator * lbt_iter) {
+	if (!lbt_iter || lbt_iter->stop == ITERATOR_STOP) {
+		return NULL;
+	}
+	if (lbt_iter->stop == ITERATOR_PAUSE) {
+		lbt_iter->stop = ITERATOR_GO;
+		return lbt_iter->node;
+	}
+	NodeAttributes * NA = lbt_iter->lbt->NA;
+	switch (lbt_iter->order & TREE_ITERATE_ORDER_MASK) {
+		case TREE_ITERATE_INORDER: {
+			lbt_iter->node = LinkedBinaryTree_inorder_next(NA, lbt_iter->node, lbt_iter->dir);
+			break;
+		}
+		case TREE_ITERATE_PREORDER: {
+			lbt_iter->node = LinkedBinaryTree_preorder_next(NA, lbt_iter->node, lbt_iter->dir);
+			break;
+		}
+		case TREE_ITERATE_POSTORDER: {
+			lbt_iter->node = LinkedBinaryTree_postorder_next(NA, lbt_iter->node, lbt_iter->dir);
+			break;
+		}
+		default: { // TREE_ITERATE_LEVELORDER
+			lbt_iter->node = LinkedBinaryTree_levelorder_next(lbt_iter);
+		}
+	}
+	if (!lbt_iter->node) {
+		lbt_iter->stop = ITERATOR_STOP;
+	}
+	return lbt_iter->node;
+}
+
+void * LinkedBinaryTreeIterator_next(LinkedBinaryTreeIterator * lbt_iter) {
+	Node * node = LinkedBinaryTreeIterator_next_node(lbt_iter);
+	if (!node) {
+		return NULL;
+	}
+	return Node_get(lbt_iter->lbt->NA, node, VALUE);
+}
+
+enum iterator_status LinkedBinaryTreeIterator_stop(LinkedBinaryTreeIterator * lbt_iter) {
+	if (!lbt_iter) {
+		return ITERATOR_STOP;
+	}
+	return lbt_iter->stop;
+}
+
+void LinkedBinaryTreeIteratorIterator_init(LinkedBinaryTreeIteratorIterator * lbt_iter_iter, LinkedBinaryTreeIterator * lbt_iter) {
+	LinkedBinaryTreeIterator_init(lbt_iter_iter, lbt_iter->lbt, lbt_iter->order);
+}
+
+void * LinkedBinaryTreeIteratorIterator_next(LinkedBinaryTreeIteratorIterator * lbt_iter) {
+	return LinkedBinaryTreeIterator_next(lbt_iter);
+}
+
+enum iterator_status LinkedBinaryTreeIteratorIterator_stop(LinkedBinaryTreeIteratorIterator * lbt_iter) {
+	return LinkedBinaryTreeIterator_stop(lbt_iter);
 }
 
 /*
@@ -411,156 +1279,6 @@ void * lBT_remove(lBTNode * node) {
 	lBTNode_delete(node, 0); 
 }
 
-// *************************************************** TRAVERSALS & ASSOCIATED FUNCTIONS
-
-size_t lBT_preorder(lBTNode * root, int (*func)(void *, void *), void * func_input) {
-	if (!root) {
-		return 0;
-	}
-	// for a Binary Tree of height h, should not have to allocate more space than 2*height + 1 (largest height both children + 1 extra) since this is DFS
-	// the CircularBuffer only needs to satisfy the conditions for a Stack
-	// Stack based on underlying CircularBuffer would not actually save any memory
-	CircularBuffer * deq = CircularBuffer_create(root->subTreeSize/2);
-	size_t count = 0;
-	CircularBuffer_push_back(deq, (void *) root);
-	int cont = 1;
-	while (cont && !CircularBuffer_is_empty(deq)) {
-		lBTNode * node = (lBTNode *) CircularBuffer_pop_back(deq);
-		count++;
-		cont = !func(func_input, (void *)node);
-		if (node->right) {
-			CircularBuffer_push_back(deq, (void *) node->right);
-		}
-		if (node->left) {
-			CircularBuffer_push_back(deq, (void *) node->left);
-		}
-	}
-	
-	CircularBuffer_destroy(deq, 0); // destroy the CircularBuffer but not its contents
-	
-	return count;
-}
-
-// make generic for paired values
-define_Named_Tuple(BTN_visited,lBTNode, *node, int, val)
-
-size_t lBT_postorder(lBTNode * root, int (*func)(void *, void *), void * func_input) {
-	if (!root) {
-		return 0;
-	}
-	
-	// algorithm outline...
-	// CircularBuffer of a pair (lBTNode *node, int val)
-	// node is not null and value is 0 or 1:
-	// if value is 1, node's children already added so visit node
-	// if value is 0, push it back on Stack with a 1 and add right child then left child with 0s
-	CircularBuffer * nodes = CircularBuffer_create(root->subTreeSize/2);
-	
-	BTN_visited * pair = (BTN_visited *) malloc(sizeof(BTN_visited));
-	*pair = (BTN_visited) {root, 0};
-	BTN_visited * node;
-	
-	CircularBuffer_push_back(nodes, (void *) pair);
-	
-	size_t count = 0;
-	int cont = 1;
-	while (cont && !CircularBuffer_is_empty(nodes)) {
-		node = (BTN_visited *) CircularBuffer_pop_back(nodes);
-		if (node->val) {
-			cont = !func(func_input, (void *)node->node);
-			count++;
-			free(node);
-		} else {
-			node->val = 1;
-			CircularBuffer_push_back(nodes, (void *) node);
-			if (node->node->right) {
-				pair = (BTN_visited *) malloc(sizeof(BTN_visited));
-				*pair = (BTN_visited) {node->node->right, 0};
-				CircularBuffer_push_back(nodes, (void *) pair);
-			}
-			if (node->node->left) {
-				pair = (BTN_visited *) malloc(sizeof(BTN_visited));
-				*pair = (BTN_visited) {node->node->left, 0};
-				CircularBuffer_push_back(nodes, (void *) pair);
-			}
-		}
-	}
-	
-	CircularBuffer_destroy(nodes, 1); // destroy all nodes and free their contents
-	
-	return count;
-}
-
-size_t lBT_inorder(lBTNode * root, int (*func)(void *, void *), void * func_input) {
-	if (!root) {
-		return 0;
-	}
-	
-	// algorithm outine...
-	// CircularBuffer of a pair (lBTNode *node, int val)
-	// node is not null and value is 0 or 1:
-	// if value is 1, node's children already added so visit node
-	// if value is 0, push it back on Stack with a 1 and add right child then left child with 0s
-	CircularBuffer * nodes = CircularBuffer_create(root->subTreeSize/2);
-	
-	BTN_visited * pair = (BTN_visited *) malloc(sizeof(BTN_visited));
-	*pair = (BTN_visited) {root, 0};
-	BTN_visited * node;
-	
-	CircularBuffer_push_back(nodes, (void *) pair);
-	
-	size_t count = 0;
-	int cont = 1;
-	while (cont && !CircularBuffer_is_empty(nodes)) {
-		node = (BTN_visited *) CircularBuffer_pop_back(nodes);
-		if (node->val) {
-			cont = !func(func_input, (void *)node->node);
-			count++;
-			free(node);
-		} else {
-			node->val = 1;
-			if (node->node->right) {
-				pair = (BTN_visited *) malloc(sizeof(BTN_visited));
-				*pair = (BTN_visited) {node->node->right, 0};
-				CircularBuffer_push_back(nodes, (void *) pair);
-			}
-			CircularBuffer_push_back(nodes, (void *) node);
-			if (node->node->left) {
-				pair = (BTN_visited *) malloc(sizeof(BTN_visited));
-				*pair = (BTN_visited) {node->node->left, 0};
-				CircularBuffer_push_back(nodes, (void *) pair);
-			}
-		}
-	}
-	
-	CircularBuffer_destroy(nodes, 1); // destroy all BTN_visited nodes and free their contents
-	
-	return count;
-}
-
-size_t lBT_level_order(lBTNode * root, int (*func)(void *, void *), void * func_input) {
-	CircularBuffer * nodes = CircularBuffer_create(root->subTreeSize/2);
-	
-	CircularBuffer_push_back(nodes, (void *) root);
-	
-	size_t count = 0;
-	int cont = 1;
-	while (cont && !CircularBuffer_is_empty(nodes)) {
-		lBTNode * node = (lBTNode *) CircularBuffer_pop_front(nodes);
-		if (node->left) {
-			CircularBuffer_push_back(nodes, (void *) node->left);
-		}
-		if (node->right) {
-			CircularBuffer_push_back(nodes, (void *) node->right);
-		}
-		count++;
-		cont = !func(func_input, (void *)node);
-	}
-	
-	CircularBuffer_destroy(nodes, 0); // destroy the CircularBuffer but not its contents
-	return count;
-}
-
 // TODO need to test...move to lHeap
 // TODO I am pretty sure there's a bug here. When the final level is full, this will just return NULL. Yeah, I did this incorrectly...I need to check the rightmost side first on tree_height-1
 lBTNode * lCompleteBinTree_get_end_parent(lBTNode * root, unsigned int tree_height) {
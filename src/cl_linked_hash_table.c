@@ -148,6 +148,7 @@ LinkedHashTable * LinkedHashTable_new(hash_t (*hash) (const void *, size_t), int
 void LinkedHashTable_init(LinkedHashTable * hash_table, hash_t (*hash) (const void *, size_t), int (*comp) (const void *, const void *), size_t capacity, float max_load_factor, NodeAttributes * NA) {
     hash_table->NA = NA;
     hash_table->head = NULL;
+    hash_table->tail = NULL;
     //hash_table->tail_inorder = NULL;
     hash_table->capacity = capacity;
     hash_table->size = 0;
@@ -184,21 +185,26 @@ Node * LinkedHashTable_get_node(LinkedHashTable * hash_table, void * key) {
     return node;
 }
 
-int LinkedHashTable_set(LinkedHashTable * hash_table, void * key, void * value) {
-    Node * node = LinkedHashTable_get_node(hash_table, key);
-    // if node is found, overwrite the value
+// hashes the key once: the bin found while looking for the key is the one a new node goes into
+void ** LinkedHashTable_upsert(LinkedHashTable * hash_table, void * key, bool * inserted) {
+    hash_t bin = hash_table->hash(key, hash_table->capacity);
+    Node * node = hash_table->bins[bin];
+    while (node && hash_table->comp(Node_get(hash_table->NA, node, KEY), key)) {
+        node = Node_get(hash_table->NA, node, NEXT_INHASH);
+    }
+    if (inserted) {
+        *inserted = !node;
+    }
     if (node) {
-        Node_set(hash_table->NA, node, VALUE, value);
-        return CL_SUCCESS;
+        return &Node_get(hash_table->NA, node, VALUE);
     }
 
     // create new node and assign it to bins and linked list
-    hash_t bin = hash_table->hash(key, hash_table->capacity);
     // BUG: this next line should be sufficient rather than default init and set later, but there appears to be a bug in Node_new
-    node = Node_new(hash_table->NA, 3, Node_attr(KEY), key, Node_attr(VALUE), value, Node_attr(NEXT_INHASH), hash_table->bins[bin]);
+    node = Node_new(hash_table->NA, 3, Node_attr(KEY), key, Node_attr(VALUE), NULL, Node_attr(NEXT_INHASH), hash_table->bins[bin]);
     
     if (!node) {
-        return CL_MALLOC_FAILURE;
+        return NULL;
     }
     if (!hash_table->size) {
         hash_table->head = node;
@@ -211,10 +217,34 @@ int LinkedHashTable_set(LinkedHashTable * hash_table, void * key, void * value)
 
     hash_table->size++;
 
+    // resizing relinks the nodes but does not move them, so the returned value address stays valid
     if (((float)hash_table->size) / hash_table->capacity > hash_table->max_load_factor) {
         LinkedHashTable_resize(hash_table, next_prime(hash_table->capacity*2));
     }
 
+    return &Node_get(hash_table->NA, node, VALUE);
+}
+
+int LinkedHashTable_set(LinkedHashTable * hash_table, void * key, void * value) {
+    void ** slot = LinkedHashTable_upsert(hash_table, key, NULL);
+    if (!slot) {
+        return CL_MALLOC_FAILURE;
+    }
+    *slot = value;
+    return CL_SUCCESS;
+}
+
+int LinkedHashTable_aggregate(LinkedHashTable * hash_table, void * iter, void * (*next)(void*), enum iterator_status (*stop)(void*), void * (*key)(void * element, void * ctx), int (*accumulate)(void ** value, void * element, void * ctx), void * ctx) {
+    for (void * element = next(iter); !stop(iter); element = next(iter)) {
+        void ** value = LinkedHashTable_upsert(hash_table, key(element, ctx), NULL);
+        if (!value) {
+            return CL_MALLOC_FAILURE;
+        }
+        int result = accumulate(value, element, ctx);
+        if (result != CL_SUCCESS) {
+            return result;
+        }
+    }
     return CL_SUCCESS;
 }
 
@@ -342,18 +372,21 @@ void LinkedHashTableKeyIterator_init(LinkedHashTableKeyIterator * key_iter, Link
     key_iter->next_key = NULL;
     key_iter->node = hash_table->head;
     key_iter->NA = hash_table->NA;
+    key_iter->remaining = hash_table->size;
     key_iter->stop = ITERATOR_GO;
 }
 void LinkedHashTableValueIterator_init(LinkedHashTableValueIterator * value_iter, LinkedHashTable * hash_table) {
     value_iter->next_value = NULL;
     value_iter->node = hash_table->head;
     value_iter->NA = hash_table->NA;
+    value_iter->remaining = hash_table->size;
     value_iter->stop = ITERATOR_GO;
 }
 void LinkedHashTableItemIterator_init(LinkedHashTableItemIterator * item_iter, LinkedHashTable * hash_table) {
     DictItem_init(&item_iter->next_item, NULL, NULL);
     item_iter->node = hash_table->head;
     item_iter->NA = hash_table->NA;
+    item_iter->remaining = hash_table->size;
     item_iter->stop = ITERATOR_GO;
 }
 void LinkedHashTableKeyIterator_del(LinkedHashTableKeyIterator * key_iter) {
@@ -384,6 +417,7 @@ const void * LinkedHashTableKeyIterator_next(LinkedHashTableKeyIterator * key_it
     }
     key_iter->next_key = Node_get(key_iter->NA, key_iter->node, KEY);
     key_iter->node = Node_get(key_iter->NA, key_iter->node, NEXT_INORDER);
+    key_iter->remaining--;
     return key_iter->next_key;
 }
 void * LinkedHashTableValueIterator_next(LinkedHashTableValueIterator * value_iter) {
@@ -396,6 +430,7 @@ void * LinkedHashTableValueIterator_next(LinkedHashTableValueIterator * value_it
     }
     value_iter->next_value = Node_get(value_iter->NA, value_iter->node, VALUE);
     value_iter->node = Node_get(value_iter->NA, value_iter->node, NEXT_INORDER);
+    value_iter->remaining--;
     return value_iter->next_value;
 }
 DictItem * LinkedHashTableItemIterator_next(LinkedHashTableItemIterator * item_iter)  {
@@ -409,8 +444,49 @@ DictItem * LinkedHashTableItemIterator_next(LinkedHashTableItemIterator * item_i
     item_iter->next_item.key = Node_get(item_iter->NA, item_iter->node, KEY);
     item_iter->next_item.value = Node_get(item_iter->NA, item_iter->node, VALUE);
     item_iter->node = Node_get(item_iter->NA, item_iter->node, NEXT_INORDER);
+    item_iter->remaining--;
     return &item_iter->next_item;
 }
+size_t LinkedHashTableKeyIterator_next_n(LinkedHashTableKeyIterator * key_iter, const void ** out, size_t max) {
+    if (!key_iter) {
+        return 0;
+    }
+    size_t n = 0;
+    Node * node = key_iter->node;
+    while (n < max && node) {
+        out[n++] = Node_get(key_iter->NA, node, KEY);
+        node = Node_get(key_iter->NA, node, NEXT_INORDER);
+    }
+    if (n) {
+        key_iter->next_key = out[n-1];
+    }
+    key_iter->node = node;
+    key_iter->remaining -= n;
+    if (n < max) {
+        key_iter->stop = ITERATOR_STOP;
+    }
+    return n;
+}
+size_t LinkedHashTableValueIterator_next_n(LinkedHashTableValueIterator * value_iter, void ** out, size_t max) {
+    if (!value_iter) {
+        return 0;
+    }
+    size_t n = 0;
+    Node * node = value_iter->node;
+    while (n < max && node) {
+        out[n++] = Node_get(value_iter->NA, node, VALUE);
+        node = Node_get(value_iter->NA, node, NEXT_INORDER);
+    }
+    if (n) {
+        value_iter->next_value = out[n-1];
+    }
+    value_iter->node = node;
+    value_iter->remaining -= n;
+    if (n < max) {
+        value_iter->stop = ITERATOR_STOP;
+    }
+    return n;
+}
 enum iterator_status LinkedHashTableKeyIterator_stop(LinkedHashTableKeyIterator * key_iter) {
     if (!key_iter) {
         return ITERATOR_STOP;
@@ -441,3 +517,72 @@ enum iterator_status LinkedHashTableItemIterator_stop(LinkedHashTableItemIterato
     }
     return item_iter->stop;
 }
+size_t LinkedHashTableKeyIterator_size_hint(LinkedHashTableKeyIterator * key_iter) {
+    return key_iter ? key_iter->remaining : 0;
+}
+size_t LinkedHashTableValueIterator_size_hint(LinkedHashTableValueIterator * value_iter) {
+    return value_iter ? value_iter->remaining : 0;
+}
+size_t LinkedHashTableItemIterator_size_hint(LinkedHashTableItemIterator * item_iter) {
+    return item_iter ? item_iter->remaining : 0;
+}
+
+void LinkedHashTableBinIterator_init(LinkedHashTableBinIterator * bin_iter, LinkedHashTable * hash_table) {
+    if (!bin_iter) {
+        return;
+    }
+    bin_iter->NA = hash_table->NA;
+    bin_iter->bins = hash_table->bins;
+    bin_iter->bin = 0;
+    bin_iter->end = hash_table->capacity;
+    bin_iter->node = NULL;
+    bin_iter->next_item = (DictItem) {NULL, NULL};
+    bin_iter->stop = hash_table->size ? ITERATOR_PAUSE : ITERATOR_STOP;
+}
+DictItem * LinkedHashTableBinIterator_next(LinkedHashTableBinIterator * bin_iter) {
+    if (!bin_iter || bin_iter->stop == ITERATOR_STOP) {
+        return NULL;
+    }
+    if (bin_iter->node) {
+        bin_iter->node = Node_get(bin_iter->NA, bin_iter->node, NEXT_INHASH);
+    }
+    while (!bin_iter->node && bin_iter->bin < bin_iter->end) {
+        bin_iter->node = bin_iter->bins[bin_iter->bin++];
+    }
+    if (!bin_iter->node) {
+        bin_iter->stop = ITERATOR_STOP;
+        return NULL;
+    }
+    bin_iter->stop = ITERATOR_GO;
+    bin_iter->next_item.key = Node_get(bin_iter->NA, bin_iter->node, KEY);
+    bin_iter->next_item.value = Node_get(bin_iter->NA, bin_iter->node, VALUE);
+    return &bin_iter->next_item;
+}
+enum iterator_status LinkedHashTableBinIterator_stop(LinkedHashTableBinIterator * bin_iter) {
+    if (!bin_iter) {
+        return ITERATOR_STOP;
+    }
+    return bin_iter->stop;
+}
+bool LinkedHashTableBinIterator_split(LinkedHashTableBinIterator * bin_iter, LinkedHashTableBinIterator * other, size_t grain) {
+    if (!bin_iter || !other || bin_iter->stop != ITERATOR_PAUSE) {
+        return false;
+    }
+    size_t half = (bin_iter->end - bin_iter->bin) / 2;
+    if (!half || half < grain) {
+        return false;
+    }
+    *other = *bin_iter;
+    other->bin = bin_iter->end - half;
+    bin_iter->end = other->bin;
+    return true;
+}
+void LinkedHashTableBinIteratorIterator_init(LinkedHashTableBinIteratorIterator * bin_iter_iter, LinkedHashTableBinIterator * bin_iter) {
+    *bin_iter_iter = *bin_iter;
+}
+DictItem * LinkedHashTableBinIteratorIterator_next(LinkedHashTableBinIteratorIterator * bin_iter) {
+    return LinkedHashTableBinIterator_next(bin_iter);
+}
+enum iterator_status LinkedHashTableBinIteratorIterator_stop(LinkedHashTableBinIteratorIterator * bin_iter) {
+    return LinkedHashTableBinIterator_stop(bin_iter);
+}
@@ -195,6 +195,109 @@ void * LinkedList_pop_back(LinkedList * ll) {
     return LinkedList_remove(ll, ll->size-1);
 }
 
+// returns the node whose NEXT is node. node == NULL finds the last node. Returns NULL if node is the head
+static Node * LinkedList_get_prev_node(LinkedList * ll, Node * node) {
+    Node * prev = NULL;
+    Node * cur = ll->head;
+    while (cur != node) {
+        prev = cur;
+        cur = Node_get(ll->NA, cur, NEXT);
+    }
+    return prev;
+}
+
+enum cl_status LinkedList_splice(LinkedList * dest, Node * dest_pos, LinkedList * src, Node * first, Node * last) {
+    if (!dest || !src) {
+        return CL_VALUE_ERROR;
+    }
+    if (!first || first == last || (dest == src && (dest_pos == first || dest_pos == last))) {
+        return CL_SUCCESS;
+    }
+    NodeAttributes * NA = src->NA;
+    // find the last node in the range and count the range
+    size_t count = 1;
+    Node * back = first;
+    Node * next = Node_get(NA, back, NEXT);
+    while (next != last) {
+        back = next;
+        next = Node_get(NA, back, NEXT);
+        count++;
+    }
+    Node * before = LinkedList_get_prev_node(src, first);
+    if (before) {
+        Node_set(NA, before, NEXT, last);
+    } else {
+        src->head = last;
+    }
+    src->size -= count;
+    
+    // find the insertion point after removing the range in case dest == src
+    before = LinkedList_get_prev_node(dest, dest_pos);
+    Node_set(NA, back, NEXT, dest_pos);
+    if (before) {
+        Node_set(NA, before, NEXT, first);
+    } else {
+        dest->head = first;
+    }
+    dest->size += count;
+    return CL_SUCCESS;
+}
+
+enum cl_status LinkedList_split_at(LinkedList * ll, Node * node, LinkedList * dest) {
+    return LinkedList_splice(dest, NULL, ll, node, NULL);
+}
+
+// bottom-up merge sort on the NEXT links. Runs of width are merged in pairs until a single run remains
+// https://www.chiark.greenend.org.uk/~sgtatham/algorithms/listsort.html
+enum cl_status LinkedList_sort(LinkedList * ll, int (*comp)(void*, void*)) {
+    if (!ll || !comp) {
+        return CL_VALUE_ERROR;
+    }
+    if (ll->size < 2) {
+        return CL_SUCCESS;
+    }
+    NodeAttributes * NA = ll->NA;
+    Node * list = ll->head;
+    for (size_t width = 1; width < ll->size; width <<= 1) {
+        Node * left = list;
+        Node * tail = NULL;
+        list = NULL;
+        while (left) {
+            // find the start of the right run
+            Node * right = left;
+            size_t nleft = 0;
+            while (nleft < width && right) {
+                right = Node_get(NA, right, NEXT);
+                nleft++;
+            }
+            size_t nright = width;
+            while (nleft || (nright && right)) {
+                Node * node = NULL;
+                // ties are taken from the left run to keep the sort stable
+                if (nleft && (!nright || !right || comp(Node_get(NA, right, VALUE), Node_get(NA, left, VALUE)) >= 0)) {
+                    node = left;
+                    left = Node_get(NA, left, NEXT);
+                    nleft--;
+                } else {
+                    node = right;
+                    right = Node_get(NA, right, NEXT);
+                    nright--;
+                }
+                if (tail) {
+                    Node_set(NA, tail, NEXT, node);
+                } else {
+                    list = node;
+                }
+                tail = node;
+            }
+            left = right;
+        }
+        Node_set(NA, tail, NEXT, NULL);
+    }
+    ll->head = list;
+    return CL_SUCCESS;
+}
+
 void * LinkedList_find(LinkedList * ll, void * value, int (*comp)(void*, void*)) {
     if (!ll || !value || !comp) {
         return NULL;
@@ -234,7 +337,7 @@ void * LinkedListIterator_next(LinkedListIterator * ll_iter) {
         return NULL;
     }
     if (ll_iter->stop == ITERATOR_PAUSE) {
-        ll_iter->stop == ITERATOR_GO;
+        ll_iter->stop = ITERATOR_GO;
         return Node_get(ll_iter->ll->NA, ll_iter->node, VALUE);
     }
     ll_iter->node = Node_get(ll_iter->ll->NA, ll_iter->node, NEXT);
@@ -245,6 +348,52 @@ void * LinkedListIterator_next(LinkedListIterator * ll_iter) {
     return Node_get(ll_iter->ll->NA, ll_iter->node, VALUE);
 }
 
+size_t LinkedListIterator_next_n(LinkedListIterator * ll_iter, void ** out, size_t max) {
+    if (!ll_iter || !max || ll_iter->stop == ITERATOR_STOP) {
+        return 0;
+    }
+    NodeAttributes * NA = ll_iter->ll->NA;
+    Node * node = ll_iter->node;
+    if (ll_iter->stop == ITERATOR_GO) {
+        node = Node_get(NA, node, NEXT);
+    }
+    size_t n = 0;
+    while (node) {
+        out[n++] = Node_get(NA, node, VALUE);
+        if (n == max) {
+            break;
+        }
+        node = Node_get(NA, node, NEXT);
+    }
+    ll_iter->node = node;
+    ll_iter->stop = (n < max) ? ITERATOR_STOP : ITERATOR_GO;
+    return n;
+}
+
+size_t LinkedListIterator_advance(LinkedListIterator * ll_iter, size_t n) {
+    if (!ll_iter || !n || ll_iter->stop == ITERATOR_STOP) {
+        return 0;
+    }
+    NodeAttributes * NA = ll_iter->ll->NA;
+    Node * node = ll_iter->node;
+    if (ll_iter->stop == ITERATOR_GO) {
+        node = Node_get(NA, node, NEXT);
+    }
+    size_t k = 0;
+    while (node && ++k < n) {
+        node = Node_get(NA, node, NEXT);
+    }
+    ll_iter->node = node;
+    ll_iter->stop = node ? ITERATOR_GO : ITERATOR_STOP;
+    return k;
+}
+size_t LinkedListIterator_size_hint(LinkedListIterator * ll_iter) {
+    if (!ll_iter || ll_iter->stop == ITERATOR_STOP) {
+        return 0;
+    }
+    return ll_iter->ll->size - (ll_iter->stop == ITERATOR_GO);
+}
+
 enum iterator_status LinkedListIterator_stop(LinkedListIterator * ll_iter) {
     if (!ll_iter) {
         return ITERATOR_STOP;
@@ -26,11 +26,13 @@ size_t attr_bytes[NODE_N_ATTR] = {sizeof(NODE_VALUE_TYPE),
                                   sizeof(NODE_NEXT_TYPE),
                                   sizeof(NODE_PARENT_TYPE),
                                   sizeof(NODE_SIZE_TYPE),
-                                  sizeof(NODE_BALANCE_TYPE),
                                   sizeof(NODE_HEIGHT_TYPE),
-                                  sizeof(NODE_COLOR_TYPE),
+                                  sizeof(NODE_END_TYPE),
+                                  sizeof(NODE_MAX_END_TYPE),
                                   sizeof(NODE_CHILD_TYPE),
-                                  sizeof(NODE_NCHILD_TYPE)};
+                                  sizeof(NODE_NCHILD_TYPE),
+                                  sizeof(NODE_BALANCE_TYPE),
+                                  sizeof(NODE_COLOR_TYPE)};
 
 void vNode_init(NodeAttributes * NA, Node * node, int narg_pairs, va_list args) {
     int flags = NA->flags;
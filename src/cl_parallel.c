@@ -0,0 +1,368 @@
+#define _POSIX_C_SOURCE 200809L // sysconf, sched_yield
+#include <unistd.h>
+#include <sched.h>
+#include "cl_parallel.h"
+
+// parts split off by a worker. The owner pushes and pops at the back, thieves take from the front
+typedef struct ParallelDeque {
+    pthread_mutex_t lock;
+    unsigned char * parts; // PARALLEL_DEQUE_SIZE iterators
+    size_t front;
+    size_t back;
+} ParallelDeque;
+
+typedef struct ParallelJob {
+    Splittable * type;
+    size_t grain;
+    void (*func)(void *, void *);
+    void (*accumulate)(void *, void *, void *);
+    void * ctx;
+    unsigned char * accs;       // accumulator of each worker, NULL for for_each
+    size_t acc_size;
+    unsigned char * scratch;    // per worker, the part being processed and the part being split off
+    ParallelDeque * deques;
+    unsigned int nworkers;
+    pthread_mutex_t lock;
+    size_t pending;             // parts pushed but not finished, including those being processed
+} ParallelJob;
+
+// only called by the owner, so the room cannot shrink before the push
+static bool ParallelDeque_has_room(ParallelDeque * dq) {
+    pthread_mutex_lock(&dq->lock);
+    bool room = dq->back - dq->front < PARALLEL_DEQUE_SIZE;
+    pthread_mutex_unlock(&dq->lock);
+    return room;
+}
+
+static void ParallelDeque_push(ParallelDeque * dq, void * part, size_t size) {
+    pthread_mutex_lock(&dq->lock);
+    if (dq->back == PARALLEL_DEQUE_SIZE) { // shift the parts left by thieves to the start
+        memmove(dq->parts, dq->parts + dq->front * size, (dq->back - dq->front) * size);
+        dq->back -= dq->front;
+        dq->front = 0;
+    }
+    memcpy(dq->parts + dq->back++ * size, part, size);
+    pthread_mutex_unlock(&dq->lock);
+}
+
+static bool ParallelDeque_pop(ParallelDeque * dq, void * part, size_t size, bool steal) {
+    pthread_mutex_lock(&dq->lock);
+    bool found = dq->front < dq->back;
+    if (found) {
+        memcpy(part, dq->parts + (steal ? dq->front++ : --dq->back) * size, size);
+        if (dq->front == dq->back) {
+            dq->front = dq->back = 0;
+        }
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return found;
+}
+
+static void ParallelJob_process(ParallelJob * job, unsigned int id, void * part) {
+    Splittable * type = job->type;
+    ParallelDeque * dq = job->deques + id;
+    void * half = job->scratch + (2 * id + 1) * type->size;
+    // keep the first half and offer the second to thieves until the part reaches the grain
+    while (ParallelDeque_has_room(dq) && type->split(part, half, job->grain)) {
+        pthread_mutex_lock(&job->lock);
+        job->pending++;
+        pthread_mutex_unlock(&job->lock);
+        ParallelDeque_push(dq, half, type->size);
+    }
+
+    void * acc = job->accs ? job->accs + id * job->acc_size : NULL;
+    if (type->next_n) {
+        void * batch[PARALLEL_BATCH_SIZE];
+        size_t n;
+        do {
+            n = type->next_n(part, batch, PARALLEL_BATCH_SIZE);
+            for (size_t i = 0; i < n; i++) {
+                if (acc) {
+                    job->accumulate(acc, batch[i], job->ctx);
+                } else {
+                    job->func(batch[i], job->ctx);
+                }
+            }
+        } while (n == PARALLEL_BATCH_SIZE);
+    } else {
+        for (void * el = type->next(part); type->stop(part) != ITERATOR_STOP; el = type->next(part)) {
+            if (acc) {
+                job->accumulate(acc, el, job->ctx);
+            } else {
+                job->func(el, job->ctx);
+            }
+        }
+    }
+
+    pthread_mutex_lock(&job->lock);
+    job->pending--;
+    pthread_mutex_unlock(&job->lock);
+}
+
+static void ParallelJob_run(ParallelJob * job, unsigned int id) {
+    void * part = job->scratch + 2 * id * job->type->size;
+    while (true) {
+        bool found = ParallelDeque_pop(job->deques + id, part, job->type->size, false);
+        for (unsigned int i = 1; !found && i < job->nworkers; i++) {
+            found = ParallelDeque_pop(job->deques + (id + i) % job->nworkers, part, job->type->size, true);
+        }
+        if (found) {
+            ParallelJob_process(job, id, part);
+            continue;
+        }
+        pthread_mutex_lock(&job->lock);
+        bool done = !job->pending;
+        pthread_mutex_unlock(&job->lock);
+        if (done) {
+            return;
+        }
+        sched_yield(); // parts are still being processed and may yet be split
+    }
+}
+
+static enum cl_status ParallelJob_init(ParallelJob * job, ThreadPool * pool, Splittable * type, void * iter, size_t grain) {
+    job->type = type;
+    job->grain = grain;
+    job->func = NULL;
+    job->accumulate = NULL;
+    job->ctx = NULL;
+    job->accs = NULL;
+    job->acc_size = 0;
+    job->nworkers = pool->nthreads;
+    job->deques = (ParallelDeque *) CL_MALLOC(sizeof(ParallelDeque) * job->nworkers);
+    job->scratch = (unsigned char *) CL_MALLOC(type->size * (PARALLEL_DEQUE_SIZE + 2) * job->nworkers);
+    if (!job->deques || !job->scratch) {
+        CL_FREE(job->deques);
+        CL_FREE(job->scratch);
+        return CL_MALLOC_FAILURE;
+    }
+    unsigned char * parts = job->scratch + 2 * type->size * job->nworkers;
+    for (unsigned int i = 0; i < job->nworkers; i++) {
+        pthread_mutex_init(&job->deques[i].lock, NULL);
+        job->deques[i].parts = parts + i * PARALLEL_DEQUE_SIZE * type->size;
+        job->deques[i].front = job->deques[i].back = 0;
+    }
+    pthread_mutex_init(&job->lock, NULL);
+    job->pending = 1;
+    ParallelDeque_push(job->deques, iter, type->size);
+    return CL_SUCCESS;
+}
+
+static void ParallelJob_clear(ParallelJob * job) {
+    for (unsigned int i = 0; i < job->nworkers; i++) {
+        pthread_mutex_destroy(&job->deques[i].lock);
+    }
+    pthread_mutex_destroy(&job->lock);
+    CL_FREE(job->deques);
+    CL_FREE(job->scratch);
+    CL_FREE(job->accs);
+}
+
+static void * ThreadPoolWorker_run(void * arg) {
+    ThreadPoolWorker * worker = (ThreadPoolWorker *) arg;
+    ThreadPool * pool = worker->pool;
+    unsigned long seen = 0;
+    pthread_mutex_lock(&pool->lock);
+    while (true) {
+        while (!pool->quit && pool->generation == seen) {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        if (pool->quit) {
+            break;
+        }
+        seen = pool->generation;
+        ParallelJob * job = pool->job;
+        pthread_mutex_unlock(&pool->lock);
+
+        ParallelJob_run(job, worker->id);
+
+        pthread_mutex_lock(&pool->lock);
+        if (!--pool->busy) {
+            pthread_cond_signal(&pool->done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+// stops and joins the first nstarted threads
+static void ThreadPool_stop(ThreadPool * pool, unsigned int nstarted) {
+    pthread_mutex_lock(&pool->lock);
+    pool->quit = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    for (unsigned int i = 0; i < nstarted; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+    pthread_cond_destroy(&pool->start);
+    pthread_cond_destroy(&pool->done);
+    pthread_mutex_destroy(&pool->lock);
+    CL_FREE(pool->workers);
+}
+
+ThreadPool * ThreadPool_new(unsigned int nthreads) {
+    if (!nthreads) {
+        long nproc = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = nproc > 0 ? (unsigned int) nproc : 1;
+    }
+    ThreadPool * pool = (ThreadPool *) CL_MALLOC(sizeof(ThreadPool));
+    if (!pool) {
+        return NULL;
+    }
+    pool->workers = (ThreadPoolWorker *) CL_MALLOC(sizeof(ThreadPoolWorker) * nthreads);
+    if (!pool->workers) {
+        CL_FREE(pool);
+        return NULL;
+    }
+    pool->nthreads = nthreads;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    pool->generation = 0;
+    pool->busy = 0;
+    pool->quit = false;
+    pool->job = NULL;
+    // workers[i] runs as worker i + 1
+    for (unsigned int i = 0; i < nthreads - 1; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].id = i + 1;
+        if (pthread_create(&pool->workers[i].thread, NULL, ThreadPoolWorker_run, pool->workers + i)) {
+            ThreadPool_stop(pool, i);
+            CL_FREE(pool);
+            return NULL;
+        }
+    }
+    return pool;
+}
+
+void ThreadPool_del(ThreadPool * pool) {
+    if (!pool) {
+        return;
+    }
+    ThreadPool_stop(pool, pool->nthreads - 1);
+    CL_FREE(pool);
+}
+
+unsigned int ThreadPool_size(ThreadPool * pool) {
+    if (!pool) {
+        return 0;
+    }
+    return pool->nthreads;
+}
+
+static void ThreadPool_run(ThreadPool * pool, ParallelJob * job) {
+    pthread_mutex_lock(&pool->lock);
+    pool->job = job;
+    pool->busy = pool->nthreads - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    ParallelJob_run(job, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->busy) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pool->job = NULL;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+enum cl_status parallel_for_each(ThreadPool * pool, Splittable * type, void * iter, size_t grain, void (*func)(void *, void *), void * ctx) {
+    if (!pool || !type || !iter || !func) {
+        return CL_VALUE_ERROR;
+    }
+    ParallelJob job;
+    if (ParallelJob_init(&job, pool, type, iter, grain) != CL_SUCCESS) {
+        return CL_MALLOC_FAILURE;
+    }
+    job.func = func;
+    job.ctx = ctx;
+    ThreadPool_run(pool, &job);
+    ParallelJob_clear(&job);
+    return CL_SUCCESS;
+}
+
+enum cl_status parallel_reduce(ThreadPool * pool, Splittable * type, void * iter, size_t grain, void * result, size_t result_size, void (*accumulate)(void *, void *, void *), void (*combine)(void *, void *), void * ctx) {
+    if (!pool || !type || !iter || !result || !accumulate || !combine) {
+        return CL_VALUE_ERROR;
+    }
+    ParallelJob job;
+    if (ParallelJob_init(&job, pool, type, iter, grain) != CL_SUCCESS) {
+        return CL_MALLOC_FAILURE;
+    }
+    job.accs = (unsigned char *) CL_MALLOC(result_size * job.nworkers);
+    if (!job.accs) {
+        ParallelJob_clear(&job);
+        return CL_MALLOC_FAILURE;
+    }
+    for (unsigned int i = 0; i < job.nworkers; i++) {
+        memcpy(job.accs + i * result_size, result, result_size);
+    }
+    job.accumulate = accumulate;
+    job.acc_size = result_size;
+    job.ctx = ctx;
+    ThreadPool_run(pool, &job);
+    for (unsigned int i = 0; i < job.nworkers; i++) {
+        combine(result, job.accs + i * result_size);
+    }
+    ParallelJob_clear(&job);
+    return CL_SUCCESS;
+}
+
+typedef struct RadixHistogramJob {
+    unsigned char * arr;
+    size_t num;
+    size_t elem_size;
+    size_t grain;
+    void (*histogram)(void *, size_t, size_t *);
+} RadixHistogramJob;
+
+// the accumulators hold the number of counts followed by the counts, since combine gets no context
+static void radix_histogram_accumulate(void * acc, void * part, void * ctx) {
+    RadixHistogramJob * job = (RadixHistogramJob *) ctx;
+    size_t lo = *(size_t *) part * job->grain;
+    size_t n = job->num - lo < job->grain ? job->num - lo : job->grain;
+    job->histogram(job->arr + lo * job->elem_size, n, (size_t *) acc + 1);
+}
+
+static void radix_histogram_combine(void * result, void * acc) {
+    size_t * res = (size_t *) result, * counts = (size_t *) acc;
+    for (size_t i = 1; i <= res[0]; i++) {
+        res[i] += counts[i];
+    }
+}
+
+enum cl_status parallel_radix_histogram(ThreadPool * pool, void * arr, size_t num, size_t elem_size, size_t grain, void (*histogram)(void *, size_t, size_t *), size_t * hist, size_t hist_len) {
+    if (!pool || !arr || !histogram || !hist || !grain) {
+        return CL_VALUE_ERROR;
+    }
+    if (!num) {
+        return CL_SUCCESS;
+    }
+    size_t nparts = (num + grain - 1) / grain;
+    size_t * parts = (size_t *) CL_MALLOC(sizeof(size_t) * nparts);
+    size_t * result = (size_t *) CL_MALLOC(sizeof(size_t) * (hist_len + 1));
+    if (!parts || !result) {
+        CL_FREE(parts);
+        CL_FREE(result);
+        return CL_MALLOC_FAILURE;
+    }
+    for (size_t i = 0; i < nparts; i++) {
+        parts[i] = i;
+    }
+    result[0] = hist_len;
+    memset(result + 1, 0, sizeof(size_t) * hist_len);
+    RadixHistogramJob job = {(unsigned char *) arr, num, elem_size, grain, histogram};
+    size_tIterator it;
+    size_tIterator_init(&it, parts, nparts);
+    enum cl_status status = parallel_reduce(pool, splittable(size_t), &it, 1, result, sizeof(size_t) * (hist_len + 1), radix_histogram_accumulate, radix_histogram_combine, &job);
+    if (status == CL_SUCCESS) {
+        for (size_t i = 0; i < hist_len; i++) {
+            hist[i] += result[i + 1];
+        }
+    }
+    CL_FREE(parts);
+    CL_FREE(result);
+    return status;
+}
@@ -0,0 +1,303 @@
+#include <stdint.h> // SIZE_MAX
+#include <stddef.h>
+#include <string.h>
+#include "cl_core.h"
+#include "cl_priority_queue.h"
+
+#define NO_HANDLE SIZE_MAX
+
+#define ELEM(pq, i) ((pq)->data + (i) * (pq)->elem_size)
+#define SCRATCH(pq) ELEM(pq, (pq)->capacity)
+
+static void * PriorityQueue_realloc(void * ptr, size_t old_bytes, size_t new_bytes) {
+#ifdef CL_REALLOC
+    (void) old_bytes;
+    return CL_REALLOC(ptr, new_bytes);
+#else
+    void * new_ptr = CL_MALLOC(new_bytes);
+    if (new_ptr) {
+        memcpy(new_ptr, ptr, old_bytes);
+        CL_FREE(ptr);
+    }
+    return new_ptr;
+#endif
+}
+
+static enum cl_status PriorityQueue_reserve(PriorityQueue * pq, size_t capacity) {
+    if (capacity <= pq->capacity) {
+        return CL_SUCCESS;
+    }
+    // the scratch element is not part of the heap so it does not need to be preserved
+    unsigned char * data = (unsigned char *) PriorityQueue_realloc(pq->data, pq->capacity * pq->elem_size, (capacity + 1) * pq->elem_size);
+    if (!data) {
+        return CL_REALLOC_FAILURE;
+    }
+    pq->data = data;
+    PriorityQueueHandle * handles = (PriorityQueueHandle *) PriorityQueue_realloc(pq->handles, pq->capacity * sizeof(PriorityQueueHandle), capacity * sizeof(PriorityQueueHandle));
+    if (!handles) {
+        return CL_REALLOC_FAILURE;
+    }
+    pq->handles = handles;
+    size_t * index = (size_t *) PriorityQueue_realloc(pq->index, pq->capacity * sizeof(size_t), capacity * sizeof(size_t));
+    if (!index) {
+        return CL_REALLOC_FAILURE;
+    }
+    pq->index = index;
+    pq->capacity = capacity;
+    return CL_SUCCESS;
+}
+
+static enum cl_status PriorityQueue_grow(PriorityQueue * pq, size_t num) {
+    if (pq->size + num <= pq->capacity) {
+        return CL_SUCCESS;
+    }
+    size_t capacity = pq->capacity * PRIORITY_QUEUE_REALLOC_FACTOR;
+    if (capacity < pq->size + num) {
+        capacity = pq->size + num;
+    }
+    return PriorityQueue_reserve(pq, capacity);
+}
+
+static PriorityQueueHandle PriorityQueue_new_handle(PriorityQueue * pq) {
+    PriorityQueueHandle handle = pq->free_handle;
+    if (handle == NO_HANDLE) {
+        return pq->next_handle++;
+    }
+    pq->free_handle = pq->index[handle];
+    return handle;
+}
+
+static void PriorityQueue_free_handle(PriorityQueue * pq, PriorityQueueHandle handle) {
+    pq->index[handle] = pq->free_handle;
+    pq->free_handle = handle;
+}
+
+static inline void PriorityQueue_place(PriorityQueue * pq, size_t i, void * elem, PriorityQueueHandle handle) {
+    memcpy(ELEM(pq, i), elem, pq->elem_size);
+    pq->handles[i] = handle;
+    pq->index[handle] = i;
+}
+
+// the element at i is lifted out and the elements above it are moved down into the hole until its place is found
+static void PriorityQueue_sift_up(PriorityQueue * pq, size_t i) {
+    void * elem = SCRATCH(pq);
+    PriorityQueueHandle handle = pq->handles[i];
+    memcpy(elem, ELEM(pq, i), pq->elem_size);
+    while (i) {
+        size_t parent = (i - 1) / pq->arity;
+        if (pq->compare(elem, ELEM(pq, parent)) >= 0) {
+            break;
+        }
+        PriorityQueue_place(pq, i, ELEM(pq, parent), pq->handles[parent]);
+        i = parent;
+    }
+    PriorityQueue_place(pq, i, elem, handle);
+}
+
+static void PriorityQueue_sift_down(PriorityQueue * pq, size_t i) {
+    void * elem = SCRATCH(pq);
+    PriorityQueueHandle handle = pq->handles[i];
+    memcpy(elem, ELEM(pq, i), pq->elem_size);
+    size_t child = 0;
+    while ((child = pq->arity * i + 1) < pq->size) {
+        size_t end = child + pq->arity;
+        if (end > pq->size) {
+            end = pq->size;
+        }
+        size_t best = child;
+        while (++child < end) {
+            if (pq->compare(ELEM(pq, child), ELEM(pq, best)) < 0) {
+                best = child;
+            }
+        }
+        if (pq->compare(ELEM(pq, best), elem) >= 0) {
+            break;
+        }
+        PriorityQueue_place(pq, i, ELEM(pq, best), pq->handles[best]);
+        i = best;
+    }
+    PriorityQueue_place(pq, i, elem, handle);
+}
+
+static void PriorityQueue_sift(PriorityQueue * pq, size_t i) {
+    if (i && pq->compare(ELEM(pq, i), ELEM(pq, (i - 1) / pq->arity)) < 0) {
+        PriorityQueue_sift_up(pq, i);
+    } else {
+        PriorityQueue_sift_down(pq, i);
+    }
+}
+
+// Floyd's bottom-up construction. O(N)
+static void PriorityQueue_heapify(PriorityQueue * pq) {
+    if (pq->size < 2) {
+        return;
+    }
+    size_t i = (pq->size - 2) / pq->arity + 1; // one past the last node with a child
+    while (i--) {
+        PriorityQueue_sift_down(pq, i);
+    }
+}
+
+enum cl_status PriorityQueue_init(PriorityQueue * pq, size_t capacity, size_t elem_size, unsigned int arity, int (*compare) (const void *, const void *)) {
+    if (!pq || !elem_size || arity < 2 || !compare) {
+        return CL_VALUE_ERROR;
+    }
+    if (!capacity) {
+        capacity = PRIORITY_QUEUE_DEFAULT_CAPACITY;
+    }
+    pq->data = NULL;
+    pq->handles = NULL;
+    pq->index = NULL;
+    pq->size = 0;
+    pq->capacity = 0;
+    pq->elem_size = elem_size;
+    pq->next_handle = 0;
+    pq->free_handle = NO_HANDLE;
+    pq->arity = arity;
+    pq->compare = compare;
+
+    pq->data = (unsigned char *) CL_MALLOC((capacity + 1) * elem_size);
+    pq->handles = (PriorityQueueHandle *) CL_MALLOC(capacity * sizeof(PriorityQueueHandle));
+    pq->index = (size_t *) CL_MALLOC(capacity * sizeof(size_t));
+    if (!pq->data || !pq->handles || !pq->index) {
+        CL_FREE(pq->data);
+        CL_FREE(pq->handles);
+        CL_FREE(pq->index);
+        pq->data = NULL;
+        pq->handles = NULL;
+        pq->index = NULL;
+        return CL_MALLOC_FAILURE;
+    }
+    pq->capacity = capacity;
+    return CL_SUCCESS;
+}
+
+PriorityQueue * PriorityQueue_new(size_t capacity, size_t elem_size, unsigned int arity, int (*compare) (const void *, const void *)) {
+    PriorityQueue * pq = (PriorityQueue *) CL_MALLOC(sizeof(PriorityQueue));
+    if (!pq) {
+        return NULL;
+    }
+    if (PriorityQueue_init(pq, capacity, elem_size, arity, compare) != CL_SUCCESS) {
+        CL_FREE(pq);
+        return NULL;
+    }
+    return pq;
+}
+
+PriorityQueue * PriorityQueue_new_from_array(void * arr, size_t num, size_t elem_size, unsigned int arity, int (*compare) (const void *, const void *)) {
+    PriorityQueue * pq = PriorityQueue_new(num, elem_size, arity, compare);
+    if (!pq) {
+        return NULL;
+    }
+    if (PriorityQueue_extend(pq, arr, num, NULL) != CL_SUCCESS) {
+        PriorityQueue_del(pq);
+        return NULL;
+    }
+    return pq;
+}
+
+void PriorityQueue_del(PriorityQueue * pq) {
+    CL_FREE(pq->data);
+    CL_FREE(pq->handles);
+    CL_FREE(pq->index);
+    CL_FREE(pq);
+}
+
+void PriorityQueue_clear(PriorityQueue * pq) {
+    pq->size = 0;
+    pq->next_handle = 0;
+    pq->free_handle = NO_HANDLE;
+}
+
+size_t PriorityQueue_size(PriorityQueue * pq) {
+    if (!pq) {
+        return 0;
+    }
+    return pq->size;
+}
+
+bool PriorityQueue_is_empty(PriorityQueue * pq) {
+    return pq->size == 0;
+}
+
+void * PriorityQueue_peek(PriorityQueue * pq) {
+    if (!pq || !pq->size) {
+        return NULL;
+    }
+    return ELEM(pq, 0);
+}
+
+void * PriorityQueue_get(PriorityQueue * pq, PriorityQueueHandle handle) {
+    return ELEM(pq, pq->index[handle]);
+}
+
+enum cl_status PriorityQueue_push(PriorityQueue * pq, void * elem, PriorityQueueHandle * handle) {
+    if (!pq || !elem) {
+        return CL_VALUE_ERROR;
+    }
+    enum cl_status status = PriorityQueue_grow(pq, 1);
+    if (status != CL_SUCCESS) {
+        return status;
+    }
+    PriorityQueueHandle new_handle = PriorityQueue_new_handle(pq);
+    PriorityQueue_place(pq, pq->size, elem, new_handle);
+    PriorityQueue_sift_up(pq, pq->size++);
+    if (handle) {
+        *handle = new_handle;
+    }
+    return CL_SUCCESS;
+}
+
+enum cl_status PriorityQueue_extend(PriorityQueue * pq, void * arr, size_t num, PriorityQueueHandle * handles) {
+    if (!pq || (num && !arr)) {
+        return CL_VALUE_ERROR;
+    }
+    enum cl_status status = PriorityQueue_grow(pq, num);
+    if (status != CL_SUCCESS) {
+        return status;
+    }
+    size_t start = pq->size;
+    for (size_t i = 0; i < num; i++) {
+        PriorityQueueHandle new_handle = PriorityQueue_new_handle(pq);
+        PriorityQueue_place(pq, start + i, (unsigned char *) arr + i * pq->elem_size, new_handle);
+        if (handles) {
+            handles[i] = new_handle;
+        }
+    }
+    pq->size += num;
+    // pushing each costs O(num log N) against O(N) for rebuilding
+    if (num > start) {
+        PriorityQueue_heapify(pq);
+    } else {
+        for (size_t i = start; i < pq->size; i++) {
+            PriorityQueue_sift_up(pq, i);
+        }
+    }
+    return CL_SUCCESS;
+}
+
+void PriorityQueue_remove(PriorityQueue * pq, PriorityQueueHandle handle, void * out) {
+    size_t i = pq->index[handle];
+    if (out) {
+        memcpy(out, ELEM(pq, i), pq->elem_size);
+    }
+    PriorityQueue_free_handle(pq, handle);
+    if (i < --pq->size) {
+        PriorityQueue_place(pq, i, ELEM(pq, pq->size), pq->handles[pq->size]);
+        PriorityQueue_sift(pq, i);
+    }
+}
+
+enum cl_status PriorityQueue_pop(PriorityQueue * pq, void * out) {
+    if (!pq || !pq->size) {
+        return CL_FAILURE;
+    }
+    PriorityQueue_remove(pq, pq->handles[0], out);
+    return CL_SUCCESS;
+}
+
+void PriorityQueue_update(PriorityQueue * pq, PriorityQueueHandle handle, void * elem) {
+    size_t i = pq->index[handle];
+    memcpy(ELEM(pq, i), elem, pq->elem_size);
+    PriorityQueue_sift(pq, i);
+}
@@ -0,0 +1,688 @@
+#include <stddef.h>
+#include <string.h>
+#include "cl_core.h"
+#include "cl_radix_tree.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define LEAF(node) ((RadixTreeLeaf *) (node))
+#define INNER(node) ((RadixTreeInner *) (node))
+#define NODE4(node) ((RadixTreeNode4 *) (node))
+#define NODE16(node) ((RadixTreeNode16 *) (node))
+#define NODE48(node) ((RadixTreeNode48 *) (node))
+#define NODE256(node) ((RadixTreeNode256 *) (node))
+
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+
+// a node shrinks to the next smaller type when its children drop to these counts
+#define NODE16_SHRINK 3
+#define NODE48_SHRINK 12
+#define NODE256_SHRINK 37
+
+static RadixTreeLeaf * RadixTreeLeaf_new(RadixTreeInner * parent, const char * key, size_t key_len, void * value) {
+    RadixTreeLeaf * leaf = (RadixTreeLeaf *) CL_MALLOC(sizeof(RadixTreeLeaf));
+    if (!leaf) {
+        return NULL;
+    }
+    leaf->node.parent = parent;
+    leaf->node.type = RADIX_TREE_LEAF;
+    leaf->key = key;
+    leaf->key_len = key_len;
+    leaf->value = value;
+    return leaf;
+}
+
+static RadixTreeInner * RadixTreeInner_new(unsigned char type) {
+    size_t size = 0;
+    switch (type) {
+        case RADIX_TREE_NODE4:
+            size = sizeof(RadixTreeNode4);
+            break;
+        case RADIX_TREE_NODE16:
+            size = sizeof(RadixTreeNode16);
+            break;
+        case RADIX_TREE_NODE48:
+            size = sizeof(RadixTreeNode48);
+            break;
+        default:
+            size = sizeof(RadixTreeNode256);
+    }
+    RadixTreeInner * inner = (RadixTreeInner *) CL_MALLOC(size);
+    if (!inner) {
+        return NULL;
+    }
+    memset(inner, 0, size);
+    inner->node.type = type;
+    return inner;
+}
+
+// recursion depth is bounded by the length of the longest key
+static void RadixTreeNode_del(RadixTreeNode * node) {
+    switch (node->type) {
+        case RADIX_TREE_NODE4:
+            for (unsigned int i = 0; i < INNER(node)->nchildren; i++) {
+                RadixTreeNode_del(NODE4(node)->children[i]);
+            }
+            break;
+        case RADIX_TREE_NODE16:
+            for (unsigned int i = 0; i < INNER(node)->nchildren; i++) {
+                RadixTreeNode_del(NODE16(node)->children[i]);
+            }
+            break;
+        case RADIX_TREE_NODE48:
+            for (unsigned int i = 0; i < 48; i++) {
+                if (NODE48(node)->children[i]) {
+                    RadixTreeNode_del(NODE48(node)->children[i]);
+                }
+            }
+            break;
+        case RADIX_TREE_NODE256:
+            for (unsigned int i = 0; i < 256; i++) {
+                if (NODE256(node)->children[i]) {
+                    RadixTreeNode_del(NODE256(node)->children[i]);
+                }
+            }
+            break;
+    }
+    CL_FREE(node);
+}
+
+RadixTree * RadixTree_new(TREE_FLAG_TYPE flags) {
+    RadixTree * rt = (RadixTree *) CL_MALLOC(sizeof(RadixTree));
+    if (!rt) {
+        return NULL;
+    }
+    RadixTree_init(rt, flags);
+    return rt;
+}
+
+void RadixTree_init(RadixTree * rt, TREE_FLAG_TYPE flags) {
+    if (!rt) {
+        return;
+    }
+    rt->root = NULL;
+    rt->size = 0;
+    rt->flags = flags;
+}
+
+void RadixTree_clear(RadixTree * rt) {
+    if (rt->root) {
+        RadixTreeNode_del(rt->root);
+    }
+    rt->root = NULL;
+    rt->size = 0;
+}
+
+void RadixTree_del(RadixTree * rt) {
+    RadixTree_clear(rt);
+    CL_FREE(rt);
+}
+
+size_t RadixTree_size(RadixTree * rt) {
+    if (!rt) {
+        return 0;
+    }
+    return rt->size;
+}
+
+bool RadixTree_is_empty(RadixTree * rt) {
+    return rt->size == 0;
+}
+
+/********************************* CHILDREN ***********************************/
+
+// slot holding the child of node for byte c, NULL if there is none
+static RadixTreeNode ** RadixTreeInner_find_child(RadixTreeInner * node, unsigned char c) {
+    switch (node->node.type) {
+        case RADIX_TREE_NODE4:
+            for (unsigned int i = 0; i < node->nchildren; i++) {
+                if (NODE4(node)->keys[i] == c) {
+                    return &NODE4(node)->children[i];
+                }
+            }
+            return NULL;
+        case RADIX_TREE_NODE16: {
+#if defined(__SSE2__)
+            // compares all 16 keys at once
+            __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8((char) c), _mm_loadu_si128((__m128i *) NODE16(node)->keys));
+            unsigned int mask = (unsigned int) _mm_movemask_epi8(cmp) & ((1u << node->nchildren) - 1);
+            return mask ? &NODE16(node)->children[__builtin_ctz(mask)] : NULL;
+#else
+            for (unsigned int i = 0; i < node->nchildren; i++) {
+                if (NODE16(node)->keys[i] == c) {
+                    return &NODE16(node)->children[i];
+                }
+            }
+            return NULL;
+#endif
+        }
+        case RADIX_TREE_NODE48:
+            return NODE48(node)->index[c] ? &NODE48(node)->children[NODE48(node)->index[c] - 1] : NULL;
+        default:
+            return NODE256(node)->children[c] ? &NODE256(node)->children[c] : NULL;
+    }
+}
+
+// first child of node for a byte greater than c, or the first child at all if first is true. NULL if there is none
+static RadixTreeNode * RadixTreeInner_next_child(RadixTreeInner * node, unsigned int c, bool first) {
+    unsigned int start = first ? 0 : c + 1;
+    switch (node->node.type) {
+        case RADIX_TREE_NODE4:
+            for (unsigned int i = 0; i < node->nchildren; i++) {
+                if (NODE4(node)->keys[i] >= start) {
+                    return NODE4(node)->children[i];
+                }
+            }
+            return NULL;
+        case RADIX_TREE_NODE16:
+            for (unsigned int i = 0; i < node->nchildren; i++) {
+                if (NODE16(node)->keys[i] >= start) {
+                    return NODE16(node)->children[i];
+                }
+            }
+            return NULL;
+        case RADIX_TREE_NODE48:
+            for (unsigned int i = start; i < 256; i++) {
+                if (NODE48(node)->index[i]) {
+                    return NODE48(node)->children[NODE48(node)->index[i] - 1];
+                }
+            }
+            return NULL;
+        default:
+            for (unsigned int i = start; i < 256; i++) {
+                if (NODE256(node)->children[i]) {
+                    return NODE256(node)->children[i];
+                }
+            }
+            return NULL;
+    }
+}
+
+static RadixTreeLeaf * RadixTreeNode_min_leaf(RadixTreeNode * node) {
+    while (node->type != RADIX_TREE_LEAF) {
+        node = RadixTreeInner_next_child(INNER(node), 0, true);
+    }
+    return LEAF(node);
+}
+
+// copies the header of old_node into new_node, which replaces it at ref, and points the children at it
+static void RadixTreeInner_replace(RadixTreeNode ** ref, RadixTreeInner * old_node, RadixTreeInner * new_node) {
+    unsigned char type = new_node->node.type;
+    *new_node = *old_node;
+    new_node->node.type = type;
+    RadixTreeNode ** children = NULL;
+    unsigned int n = 0;
+    switch (type) {
+        case RADIX_TREE_NODE4:
+            children = NODE4(new_node)->children;
+            n = new_node->nchildren;
+            break;
+        case RADIX_TREE_NODE16:
+            children = NODE16(new_node)->children;
+            n = new_node->nchildren;
+            break;
+        case RADIX_TREE_NODE48:
+            children = NODE48(new_node)->children;
+            n = 48;
+            break;
+        default:
+            children = NODE256(new_node)->children;
+            n = 256;
+    }
+    for (unsigned int i = 0; i < n; i++) {
+        if (children[i]) {
+            children[i]->parent = new_node;
+        }
+    }
+    *ref = (RadixTreeNode *) new_node;
+    CL_FREE(old_node);
+}
+
+// inserts child for byte c into the sorted key and child arrays of a Node4 or Node16 with room left
+static void RadixTree_insert_sorted(unsigned char * keys, RadixTreeNode ** children, unsigned int n, unsigned char c, RadixTreeNode * child) {
+    unsigned int i = 0;
+    while (i < n && keys[i] < c) {
+        i++;
+    }
+    memmove(keys + i + 1, keys + i, n - i);
+    memmove(children + i + 1, children + i, (n - i) * sizeof(RadixTreeNode *));
+    keys[i] = c;
+    children[i] = child;
+}
+
+// adds child for byte c, which node does not have yet. node is replaced by a larger node at ref if it is full
+static enum cl_status RadixTreeInner_add_child(RadixTreeNode ** ref, RadixTreeInner * node, unsigned char c, RadixTreeNode * child) {
+    RadixTreeInner * grown = NULL;
+    switch (node->node.type) {
+        case RADIX_TREE_NODE4:
+            if (node->nchildren < 4) {
+                RadixTree_insert_sorted(NODE4(node)->keys, NODE4(node)->children, node->nchildren, c, child);
+                break;
+            }
+            if (!(grown = RadixTreeInner_new(RADIX_TREE_NODE16))) {
+                return CL_MALLOC_FAILURE;
+            }
+            memcpy(NODE16(grown)->keys, NODE4(node)->keys, 4);
+            memcpy(NODE16(grown)->children, NODE4(node)->children, 4 * sizeof(RadixTreeNode *));
+            RadixTreeInner_replace(ref, node, grown);
+            return RadixTreeInner_add_child(ref, grown, c, child);
+        case RADIX_TREE_NODE16:
+            if (node->nchildren < 16) {
+                RadixTree_insert_sorted(NODE16(node)->keys, NODE16(node)->children, node->nchildren, c, child);
+                break;
+            }
+            if (!(grown = RadixTreeInner_new(RADIX_TREE_NODE48))) {
+                return CL_MALLOC_FAILURE;
+            }
+            for (unsigned int i = 0; i < 16; i++) {
+                NODE48(grown)->index[NODE16(node)->keys[i]] = (unsigned char) (i + 1);
+                NODE48(grown)->children[i] = NODE16(node)->children[i];
+            }
+            RadixTreeInner_replace(ref, node, grown);
+            return RadixTreeInner_add_child(ref, grown, c, child);
+        case RADIX_TREE_NODE48:
+            if (node->nchildren < 48) {
+                unsigned int slot = 0;
+                while (NODE48(node)->children[slot]) {
+                    slot++;
+                }
+                NODE48(node)->children[slot] = child;
+                NODE48(node)->index[c] = (unsigned char) (slot + 1);
+                break;
+            }
+            if (!(grown = RadixTreeInner_new(RADIX_TREE_NODE256))) {
+                return CL_MALLOC_FAILURE;
+            }
+            for (unsigned int i = 0; i < 256; i++) {
+                if (NODE48(node)->index[i]) {
+                    NODE256(grown)->children[i] = NODE48(node)->children[NODE48(node)->index[i] - 1];
+                }
+            }
+            RadixTreeInner_replace(ref, node, grown);
+            return RadixTreeInner_add_child(ref, grown, c, child);
+        default:
+            NODE256(node)->children[c] = child;
+    }
+    node->nchildren++;
+    child->parent = node;
+    return CL_SUCCESS;
+}
+
+// removes the child for byte c and shrinks node to a smaller type, or merges it into its only child, when it becomes
+// sparse. Shrinking cannot fail; if the smaller node cannot be allocated node is left as it is
+static void RadixTreeInner_remove_child(RadixTreeNode ** ref, RadixTreeInner * node, unsigned char c) {
+    RadixTreeInner * shrunk = NULL;
+    switch (node->node.type) {
+        case RADIX_TREE_NODE4:
+        case RADIX_TREE_NODE16: {
+            unsigned char * keys = (node->node.type == RADIX_TREE_NODE4) ? NODE4(node)->keys : NODE16(node)->keys;
+            RadixTreeNode ** children = (node->node.type == RADIX_TREE_NODE4) ? NODE4(node)->children : NODE16(node)->children;
+            unsigned int i = 0;
+            while (keys[i] != c) {
+                i++;
+            }
+            memmove(keys + i, keys + i + 1, node->nchildren - i - 1);
+            memmove(children + i, children + i + 1, (node->nchildren - i - 1) * sizeof(RadixTreeNode *));
+            node->nchildren--;
+            if (node->node.type == RADIX_TREE_NODE16 && node->nchildren == NODE16_SHRINK && (shrunk = RadixTreeInner_new(RADIX_TREE_NODE4))) {
+                memcpy(NODE4(shrunk)->keys, keys, NODE16_SHRINK);
+                memcpy(NODE4(shrunk)->children, children, NODE16_SHRINK * sizeof(RadixTreeNode *));
+                RadixTreeInner_replace(ref, node, shrunk);
+            } else if (node->node.type == RADIX_TREE_NODE4 && node->nchildren == 1) {
+                // the prefix of node, the byte of the child and the prefix of the child become the prefix of the child
+                RadixTreeNode * child = children[0];
+                if (child->type != RADIX_TREE_LEAF) {
+                    size_t len = MIN(node->prefix_len, RADIX_TREE_MAX_PREFIX);
+                    unsigned char prefix[RADIX_TREE_MAX_PREFIX];
+                    memcpy(prefix, node->prefix, len);
+                    if (len < RADIX_TREE_MAX_PREFIX) {
+                        prefix[len++] = keys[0];
+                    }
+                    size_t child_len = MIN(INNER(child)->prefix_len, RADIX_TREE_MAX_PREFIX - len);
+                    memcpy(prefix + len, INNER(child)->prefix, child_len);
+                    memcpy(INNER(child)->prefix, prefix, len + child_len);
+                    INNER(child)->prefix_len += node->prefix_len + 1;
+                }
+                child->parent = node->node.parent;
+                *ref = child;
+                CL_FREE(node);
+            }
+            return;
+        }
+        case RADIX_TREE_NODE48:
+            NODE48(node)->children[NODE48(node)->index[c] - 1] = NULL;
+            NODE48(node)->index[c] = 0;
+            node->nchildren--;
+            if (node->nchildren == NODE48_SHRINK && (shrunk = RadixTreeInner_new(RADIX_TREE_NODE16))) {
+                unsigned int n = 0;
+                for (unsigned int i = 0; i < 256; i++) {
+                    if (NODE48(node)->index[i]) {
+                        NODE16(shrunk)->keys[n] = (unsigned char) i;
+                        NODE16(shrunk)->children[n++] = NODE48(node)->children[NODE48(node)->index[i] - 1];
+                    }
+                }
+                RadixTreeInner_replace(ref, node, shrunk);
+            }
+            return;
+        default:
+            NODE256(node)->children[c] = NULL;
+            node->nchildren--;
+            if (node->nchildren == NODE256_SHRINK && (shrunk = RadixTreeInner_new(RADIX_TREE_NODE48))) {
+                unsigned int n = 0;
+                for (unsigned int i = 0; i < 256; i++) {
+                    if (NODE256(node)->children[i]) {
+                        NODE48(shrunk)->index[i] = (unsigned char) (n + 1);
+                        NODE48(shrunk)->children[n++] = NODE256(node)->children[i];
+                    }
+                }
+                RadixTreeInner_replace(ref, node, shrunk);
+            }
+    }
+}
+
+// slot of the tree holding node
+static RadixTreeNode ** RadixTree_ref(RadixTree * rt, RadixTreeNode * node, const char * key) {
+    RadixTreeInner * parent = node->parent;
+    if (!parent) {
+        return &rt->root;
+    }
+    return RadixTreeInner_find_child(parent, (unsigned char) key[parent->depth]);
+}
+
+/******************************** ORDERED MAP *********************************/
+
+// number of bytes of the prefix of node that key matches starting at depth, the start of the prefix. Bytes past the
+// stored prefix are compared against a leaf below node. A NUL in key always mismatches since no prefix contains one
+static size_t RadixTreeInner_prefix_match(RadixTreeInner * node, const char * key, size_t depth) {
+    size_t stored = MIN(node->prefix_len, RADIX_TREE_MAX_PREFIX);
+    size_t i = 0;
+    for (; i < stored; i++) {
+        if ((unsigned char) key[depth + i] != node->prefix[i]) {
+            return i;
+        }
+    }
+    if (i < node->prefix_len) {
+        RadixTreeLeaf * leaf = RadixTreeNode_min_leaf((RadixTreeNode *) node);
+        for (; i < node->prefix_len; i++) {
+            if (key[depth + i] != leaf->key[depth + i]) {
+                return i;
+            }
+        }
+    }
+    return i;
+}
+
+// descends by the byte at the depth of each inner node and compares the whole key at the leaf, checking only the
+// stored prefixes on the way to give up early on a miss
+static RadixTreeLeaf * RadixTree_find_leaf(RadixTree * rt, const char * key, size_t key_len) {
+    RadixTreeNode * node = rt->root;
+    while (node && node->type != RADIX_TREE_LEAF) {
+        RadixTreeInner * inner = INNER(node);
+        if (inner->depth >= key_len) {
+            return NULL;
+        }
+        size_t depth = inner->depth - inner->prefix_len;
+        size_t stored = MIN(inner->prefix_len, RADIX_TREE_MAX_PREFIX);
+        if (memcmp(key + depth, inner->prefix, stored)) {
+            return NULL;
+        }
+        RadixTreeNode ** child = RadixTreeInner_find_child(inner, (unsigned char) key[inner->depth]);
+        node = child ? *child : NULL;
+    }
+    if (node && LEAF(node)->key_len == key_len && !memcmp(LEAF(node)->key, key, key_len)) {
+        return LEAF(node);
+    }
+    return NULL;
+}
+
+enum cl_status RadixTree_insert(RadixTree * rt, const char * key, void * value) {
+    if (!rt || !key) {
+        return CL_VALUE_ERROR;
+    }
+    size_t key_len = strlen(key) + 1;
+    RadixTreeNode ** ref = &rt->root;
+    RadixTreeInner * parent = NULL;
+    size_t depth = 0;
+    while (*ref) {
+        RadixTreeNode * node = *ref;
+        RadixTreeInner * split = NULL;
+        if (node->type == RADIX_TREE_LEAF) {
+            RadixTreeLeaf * leaf = LEAF(node);
+            if (leaf->key_len == key_len && !memcmp(leaf->key, key, key_len)) {
+                if (rt->flags & TREE_MOD_UPDATE) {
+                    leaf->value = value;
+                    return CL_SUCCESS;
+                }
+                return CL_FAILURE;
+            }
+            // the two keys differ before either ends
+            size_t common = 0;
+            while (leaf->key[depth + common] == key[depth + common]) {
+                common++;
+            }
+            if (!(split = RadixTreeInner_new(RADIX_TREE_NODE4))) {
+                return CL_MALLOC_FAILURE;
+            }
+            split->prefix_len = common;
+            memcpy(split->prefix, key + depth, MIN(common, RADIX_TREE_MAX_PREFIX));
+        } else {
+            RadixTreeInner * inner = INNER(node);
+            size_t match = RadixTreeInner_prefix_match(inner, key, depth);
+            if (match == inner->prefix_len) {
+                RadixTreeNode ** child = RadixTreeInner_find_child(inner, (unsigned char) key[inner->depth]);
+                if (child) {
+                    ref = child;
+                    parent = inner;
+                    depth = inner->depth + 1;
+                    continue;
+                }
+                RadixTreeLeaf * leaf = RadixTreeLeaf_new(inner, key, key_len, value);
+                if (!leaf) {
+                    return CL_MALLOC_FAILURE;
+                }
+                enum cl_status status = RadixTreeInner_add_child(ref, inner, (unsigned char) key[inner->depth], (RadixTreeNode *) leaf);
+                if (status != CL_SUCCESS) {
+                    CL_FREE(leaf);
+                    return status;
+                }
+                rt->size++;
+                return CL_SUCCESS;
+            }
+            // key leaves the prefix of node at match. node keeps the part of its prefix after the mismatching byte
+            if (!(split = RadixTreeInner_new(RADIX_TREE_NODE4))) {
+                return CL_MALLOC_FAILURE;
+            }
+            split->prefix_len = match;
+            memcpy(split->prefix, inner->prefix, MIN(match, RADIX_TREE_MAX_PREFIX));
+        }
+        RadixTreeLeaf * leaf = RadixTreeLeaf_new(split, key, key_len, value);
+        if (!leaf) {
+            CL_FREE(split);
+            return CL_MALLOC_FAILURE;
+        }
+        split->node.parent = parent;
+        split->depth = depth + split->prefix_len;
+        unsigned char c = (unsigned char) RadixTreeNode_min_leaf(node)->key[split->depth];
+        if (node->type != RADIX_TREE_LEAF) {
+            RadixTreeInner * inner = INNER(node);
+            size_t shift = split->prefix_len + 1;
+            inner->prefix_len -= shift;
+            if (inner->prefix_len + shift <= RADIX_TREE_MAX_PREFIX) {
+                memmove(inner->prefix, inner->prefix + shift, inner->prefix_len);
+            } else {
+                memcpy(inner->prefix, RadixTreeNode_min_leaf(node)->key + split->depth + 1, MIN(inner->prefix_len, RADIX_TREE_MAX_PREFIX));
+            }
+        }
+        *ref = (RadixTreeNode *) split;
+        RadixTreeInner_add_child(ref, split, c, node);
+        RadixTreeInner_add_child(ref, split, (unsigned char) key[split->depth], (RadixTreeNode *) leaf);
+        rt->size++;
+        return CL_SUCCESS;
+    }
+    if (!(*ref = (RadixTreeNode *) RadixTreeLeaf_new(parent, key, key_len, value))) {
+        return CL_MALLOC_FAILURE;
+    }
+    rt->size++;
+    return CL_SUCCESS;
+}
+
+void * RadixTree_get(RadixTree * rt, const char * key) {
+    if (!rt || !key) {
+        return NULL;
+    }
+    RadixTreeLeaf * leaf = RadixTree_find_leaf(rt, key, strlen(key) + 1);
+    return leaf ? leaf->value : NULL;
+}
+
+bool RadixTree_contains(RadixTree * rt, const char * key) {
+    if (!rt || !key) {
+        return false;
+    }
+    return RadixTree_find_leaf(rt, key, strlen(key) + 1) != NULL;
+}
+
+enum cl_status RadixTree_erase(RadixTree * rt, const char * key) {
+    if (!rt || !key) {
+        return CL_VALUE_ERROR;
+    }
+    RadixTreeLeaf * leaf = RadixTree_find_leaf(rt, key, strlen(key) + 1);
+    if (!leaf) {
+        return CL_FAILURE;
+    }
+    RadixTreeInner * parent = leaf->node.parent;
+    if (!parent) {
+        rt->root = NULL;
+    } else {
+        RadixTreeInner_remove_child(RadixTree_ref(rt, (RadixTreeNode *) parent, key), parent, (unsigned char) key[parent->depth]);
+    }
+    CL_FREE(leaf);
+    rt->size--;
+    return CL_SUCCESS;
+}
+
+// a key ending at an inner node is the leaf under the NUL byte of that node
+void * RadixTree_longest_prefix(RadixTree * rt, const char * str, const char ** key) {
+    RadixTreeLeaf * best = NULL;
+    RadixTreeNode * node = rt ? rt->root : NULL;
+    size_t len = str ? strlen(str) : 0;
+    while (node && str) {
+        RadixTreeLeaf * leaf = NULL;
+        RadixTreeInner * inner = NULL;
+        if (node->type == RADIX_TREE_LEAF) {
+            leaf = LEAF(node);
+        } else {
+            inner = INNER(node);
+            if (inner->depth > len) {
+                break;
+            }
+            RadixTreeNode ** child = RadixTreeInner_find_child(inner, 0);
+            leaf = child ? LEAF(*child) : NULL;
+        }
+        // only the stored prefixes were checked on the way down
+        if (leaf && leaf->key_len - 1 <= len && !memcmp(leaf->key, str, leaf->key_len - 1)) {
+            best = leaf;
+        }
+        if (!inner || inner->depth == len) {
+            break;
+        }
+        size_t depth = inner->depth - inner->prefix_len;
+        if (memcmp(str + depth, inner->prefix, MIN(inner->prefix_len, RADIX_TREE_MAX_PREFIX))) {
+            break;
+        }
+        RadixTreeNode ** child = RadixTreeInner_find_child(inner, (unsigned char) str[inner->depth]);
+        node = child ? *child : NULL;
+    }
+    if (key) {
+        *key = best ? best->key : NULL;
+    }
+    return best ? best->value : NULL;
+}
+
+/********************************* ITERATORS **********************************/
+
+// all keys below an inner node share its first depth bytes, so the subtree of keys with the prefix is found by the
+// bytes of the prefix alone and checked once against one of its leaves
+void RadixTreeIterator_init(RadixTreeIterator * rt_iter, RadixTree * rt, const char * prefix) {
+    if (!rt_iter) {
+        return;
+    }
+    rt_iter->rt = rt;
+    rt_iter->top = NULL;
+    rt_iter->leaf = NULL;
+    rt_iter->stop = ITERATOR_STOP;
+    if (!rt || !rt->root) {
+        return;
+    }
+    size_t len = prefix ? strlen(prefix) : 0;
+    RadixTreeNode * node = rt->root;
+    while (node->type != RADIX_TREE_LEAF && INNER(node)->depth < len) {
+        RadixTreeNode ** child = RadixTreeInner_find_child(INNER(node), (unsigned char) prefix[INNER(node)->depth]);
+        if (!child) {
+            return;
+        }
+        node = *child;
+    }
+    if (len && strncmp(RadixTreeNode_min_leaf(node)->key, prefix, len)) {
+        return;
+    }
+    rt_iter->top = node;
+    rt_iter->stop = ITERATOR_PAUSE;
+}
+
+void * RadixTreeIterator_next(RadixTreeIterator * rt_iter) {
+    if (!rt_iter || rt_iter->stop == ITERATOR_STOP) {
+        return NULL;
+    }
+    if (rt_iter->stop == ITERATOR_PAUSE) {
+        rt_iter->stop = ITERATOR_GO;
+        rt_iter->leaf = RadixTreeNode_min_leaf(rt_iter->top);
+        return rt_iter->leaf->value;
+    }
+    // climb until a node has a child after the one holding the current leaf
+    RadixTreeLeaf * leaf = rt_iter->leaf;
+    RadixTreeNode * node = (RadixTreeNode *) leaf;
+    while (node != rt_iter->top) {
+        RadixTreeInner * parent = node->parent;
+        RadixTreeNode * next = RadixTreeInner_next_child(parent, (unsigned char) leaf->key[parent->depth], false);
+        if (next) {
+            rt_iter->leaf = RadixTreeNode_min_leaf(next);
+            return rt_iter->leaf->value;
+        }
+        node = (RadixTreeNode *) parent;
+    }
+    rt_iter->leaf = NULL;
+    rt_iter->stop = ITERATOR_STOP;
+    return NULL;
+}
+
+const char * RadixTreeIterator_key(RadixTreeIterator * rt_iter) {
+    if (!rt_iter || !rt_iter->leaf) {
+        return NULL;
+    }
+    return rt_iter->leaf->key;
+}
+
+enum iterator_status RadixTreeIterator_stop(RadixTreeIterator * rt_iter) {
+    if (!rt_iter) {
+        return ITERATOR_STOP;
+    }
+    return rt_iter->stop;
+}
+
+// restarts over the same prefix
+void RadixTreeIteratorIterator_init(RadixTreeIteratorIterator * rt_iter_iter, RadixTreeIterator * rt_iter) {
+    rt_iter_iter->rt = rt_iter->rt;
+    rt_iter_iter->top = rt_iter->top;
+    rt_iter_iter->leaf = NULL;
+    rt_iter_iter->stop = rt_iter->top ? ITERATOR_PAUSE : ITERATOR_STOP;
+}
+
+void * RadixTreeIteratorIterator_next(RadixTreeIteratorIterator * rt_iter) {
+    return RadixTreeIterator_next(rt_iter);
+}
+
+enum iterator_status RadixTreeIteratorIterator_stop(RadixTreeIteratorIterator * rt_iter) {
+    return RadixTreeIterator_stop(rt_iter);
+}
@@ -0,0 +1,182 @@
+#include <stdint.h> // uintptr_t
+#include <stddef.h>
+#include <string.h>
+#include "cl_core.h"
+#include "cl_static_search_tree.h"
+
+#define ELEM(sst, k) ((sst)->data + (k) * (sst)->elem_size)
+
+#if defined(__GNUC__)
+#define PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define PREFETCH(addr) do {} while (0)
+#endif
+
+// strips the trailing 1 bits and the 0 above them. Undoes the right turns taken after the last left turn of a search
+static inline size_t StaticSearchTree_unwind(size_t k) {
+#if defined(__GNUC__)
+    return k >> (__builtin_ctzll(~(unsigned long long) k) + 1);
+#else
+    while (k & 1) {
+        k >>= 1;
+    }
+    return k >> 1;
+#endif
+}
+
+// places the sorted elements of src by an in-order walk of the implicit tree. Returns the next element of src
+static size_t StaticSearchTree_fill(StaticSearchTree * sst, unsigned char * src, size_t i, size_t k) {
+    if (k <= sst->size) {
+        i = StaticSearchTree_fill(sst, src, i, 2 * k);
+        memcpy(ELEM(sst, k), src + i * sst->elem_size, sst->elem_size);
+        i = StaticSearchTree_fill(sst, src, i + 1, 2 * k + 1);
+    }
+    return i;
+}
+
+enum cl_status StaticSearchTree_init(StaticSearchTree * sst, void * arr, size_t num, size_t elem_size, int (*compare) (const void *, const void *)) {
+    if (!sst || !elem_size || !compare || (num && !arr)) {
+        return CL_VALUE_ERROR;
+    }
+    sst->size = num;
+    sst->elem_size = elem_size;
+    sst->compare = compare;
+    // index 0 is unused. Pad so that the root starts a cache line
+    sst->alloc = CL_MALLOC((num + 1) * elem_size + STATIC_SEARCH_TREE_CACHE_LINE);
+    if (!sst->alloc) {
+        sst->data = NULL;
+        sst->size = 0;
+        return CL_MALLOC_FAILURE;
+    }
+    uintptr_t root = (uintptr_t) sst->alloc + elem_size;
+    root += (STATIC_SEARCH_TREE_CACHE_LINE - root % STATIC_SEARCH_TREE_CACHE_LINE) % STATIC_SEARCH_TREE_CACHE_LINE;
+    sst->data = (unsigned char *) (root - elem_size);
+    StaticSearchTree_fill(sst, (unsigned char *) arr, 0, 1);
+    return CL_SUCCESS;
+}
+
+StaticSearchTree * StaticSearchTree_new(void * arr, size_t num, size_t elem_size, int (*compare) (const void *, const void *)) {
+    StaticSearchTree * sst = (StaticSearchTree *) CL_MALLOC(sizeof(StaticSearchTree));
+    if (!sst) {
+        return NULL;
+    }
+    if (StaticSearchTree_init(sst, arr, num, elem_size, compare) != CL_SUCCESS) {
+        CL_FREE(sst);
+        return NULL;
+    }
+    return sst;
+}
+
+void StaticSearchTree_del(StaticSearchTree * sst) {
+    CL_FREE(sst->alloc);
+    CL_FREE(sst);
+}
+
+size_t StaticSearchTree_size(StaticSearchTree * sst) {
+    if (!sst) {
+        return 0;
+    }
+    return sst->size;
+}
+
+bool StaticSearchTree_is_empty(StaticSearchTree * sst) {
+    return sst->size == 0;
+}
+
+// the comparison only selects the next index so the loop has no data dependent branch. The four descendants two levels
+// down are adjacent and fetched while the current comparison runs
+void * StaticSearchTree_lower_bound(StaticSearchTree * sst, const void * key) {
+    size_t n = sst->size;
+    size_t k = 1;
+    while (k <= n) {
+        PREFETCH(ELEM(sst, 4 * k));
+        k = 2 * k + (sst->compare(ELEM(sst, k), key) < 0);
+    }
+    k = StaticSearchTree_unwind(k);
+    return k ? ELEM(sst, k) : NULL;
+}
+
+void * StaticSearchTree_upper_bound(StaticSearchTree * sst, const void * key) {
+    size_t n = sst->size;
+    size_t k = 1;
+    while (k <= n) {
+        PREFETCH(ELEM(sst, 4 * k));
+        k = 2 * k + (sst->compare(ELEM(sst, k), key) <= 0);
+    }
+    k = StaticSearchTree_unwind(k);
+    return k ? ELEM(sst, k) : NULL;
+}
+
+void * StaticSearchTree_find(StaticSearchTree * sst, const void * key) {
+    void * elem = StaticSearchTree_lower_bound(sst, key);
+    if (!elem || sst->compare(elem, key)) {
+        return NULL;
+    }
+    return elem;
+}
+
+bool StaticSearchTree_contains(StaticSearchTree * sst, const void * key) {
+    return StaticSearchTree_find(sst, key) != NULL;
+}
+
+//Iterators
+void StaticSearchTreeIterator_init(StaticSearchTreeIterator * sst_iter, StaticSearchTree * sst) {
+    if (!sst_iter) {
+        return;
+    }
+    sst_iter->sst = sst;
+    sst_iter->index = 0;
+    if (!sst || !sst->size) {
+        sst_iter->stop = ITERATOR_STOP;
+        return;
+    }
+    // leftmost node
+    size_t k = 1;
+    while (2 * k <= sst->size) {
+        k *= 2;
+    }
+    sst_iter->index = k;
+    sst_iter->stop = ITERATOR_PAUSE;
+}
+
+void * StaticSearchTreeIterator_next(StaticSearchTreeIterator * sst_iter) {
+    if (!sst_iter || sst_iter->stop == ITERATOR_STOP) {
+        return NULL;
+    }
+    size_t k = sst_iter->index;
+    if (sst_iter->stop == ITERATOR_PAUSE) {
+        sst_iter->stop = ITERATOR_GO;
+    } else if (2 * k + 1 <= sst_iter->sst->size) { // leftmost node of the right subtree
+        k = 2 * k + 1;
+        while (2 * k <= sst_iter->sst->size) {
+            k *= 2;
+        }
+    } else { // climb out of right subtrees, then up once more
+        k = StaticSearchTree_unwind(k);
+    }
+    sst_iter->index = k;
+    if (!k) {
+        sst_iter->stop = ITERATOR_STOP;
+        return NULL;
+    }
+    return ELEM(sst_iter->sst, k);
+}
+
+enum iterator_status StaticSearchTreeIterator_stop(StaticSearchTreeIterator * sst_iter) {
+    if (!sst_iter) {
+        return ITERATOR_STOP;
+    }
+    return sst_iter->stop;
+}
+
+void StaticSearchTreeIteratorIterator_init(StaticSearchTreeIteratorIterator * sst_iter_iter, StaticSearchTreeIterator * sst_iter) {
+    StaticSearchTreeIterator_init(sst_iter_iter, sst_iter->sst);
+}
+
+void * StaticSearchTreeIteratorIterator_next(StaticSearchTreeIteratorIterator * sst_iter) {
+    return StaticSearchTreeIterator_next(sst_iter);
+}
+
+enum iterator_status StaticSearchTreeIteratorIterator_stop(StaticSearchTreeIteratorIterator * sst_iter) {
+    return StaticSearchTreeIterator_stop(sst_iter);
+}
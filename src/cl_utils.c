@@ -101,6 +101,73 @@ void cl_parray_left_justify(void ** arr, size_t capacity) {
     }
 }
 
+// stable insertion sort of arr[lo, hi)
+static void cl_parray_insertion_sort(void ** arr, size_t lo, size_t hi, int (*comp)(void*, void*)) {
+	for (size_t i = lo + 1; i < hi; i++) {
+		void * val = arr[i];
+		size_t j = i;
+		while (j > lo && comp(arr[j-1], val) > 0) {
+			arr[j] = arr[j-1];
+			j--;
+		}
+		arr[j] = val;
+	}
+}
+
+// merge sorted src[lo, mid) and src[mid, hi) into dest[lo, hi). Ties are taken from the left to keep the merge stable
+static void cl_parray_merge(void ** src, size_t lo, size_t mid, size_t hi, void ** dest, int (*comp)(void*, void*)) {
+	size_t i = lo, j = mid, k = lo;
+	while (i < mid && j < hi) {
+		dest[k++] = (comp(src[j], src[i]) < 0) ? src[j++] : src[i++];
+	}
+	while (i < mid) {
+		dest[k++] = src[i++];
+	}
+	while (j < hi) {
+		dest[k++] = src[j++];
+	}
+}
+
+// buf must at least be as long as num pointers
+void cl_parray_sort_buffered(void ** arr, size_t num, int (*comp)(void*, void*), void ** buf) {
+	if (!arr || num < 2 || !comp) {
+		return;
+	}
+	for (size_t lo = 0; lo < num; lo += CL_PARRAY_SORT_RUN) {
+		cl_parray_insertion_sort(arr, lo, (num - lo > CL_PARRAY_SORT_RUN) ? lo + CL_PARRAY_SORT_RUN : num, comp);
+	}
+	// bottom-up merges alternating between arr and buf
+	void ** src = arr, ** dest = buf;
+	for (size_t width = CL_PARRAY_SORT_RUN; width < num; width <<= 1) {
+		for (size_t lo = 0; lo < num; lo += 2*width) {
+			size_t mid = (num - lo > width) ? lo + width : num;
+			size_t hi = (num - mid > width) ? mid + width : num;
+			cl_parray_merge(src, lo, mid, hi, dest, comp);
+		}
+		void ** temp = src;
+		src = dest;
+		dest = temp;
+	}
+	if (src != arr) {
+		memcpy(arr, src, sizeof(void*) * num);
+	}
+}
+
+// DISCOURAGED temporary buffer is malloc'd internally and memory monitoring is bypassed
+enum cl_status cl_parray_sort(void ** arr, size_t num, int (*comp)(void*, void*)) {
+	if (num <= CL_PARRAY_SORT_RUN) { // no merging necessary
+		cl_parray_sort_buffered(arr, num, comp, NULL);
+		return CL_SUCCESS;
+	}
+	void ** buf = (void **) CL_MALLOC(sizeof(void*) * num);
+	if (!buf) {
+		return CL_MALLOC_FAILURE;
+	}
+	cl_parray_sort_buffered(arr, num, comp, buf);
+	CL_FREE(buf);
+	return CL_SUCCESS;
+}
+
 /******************************** COMPARISON *********************************/
 
 /********************************* NUMERICS **********************************/
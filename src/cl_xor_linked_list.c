@@ -0,0 +1,378 @@
+#include <stdint.h> // uintptr_t
+#include "cl_iterators.h"
+#include "cl_xor_linked_list.h"
+
+// the combined link of PREV ^ NEXT is stored in the NEXT attribute so that nodes are the same size as a LinkedList
+#define XOR_LINK NEXT
+
+#define REQUIRED_NODE_FLAGS (Node_flag(VALUE) | Node_flag(XOR_LINK))
+
+// manually construct static allocations of defaults. Reduce heap load
+#define DEFAULT_SIZE (sizeof(Node_type(VALUE)) + sizeof(Node_type(XOR_LINK)))
+#define DEFAULT_NODE Node_new(NA, 2, Node_attr(VALUE), NULL, Node_attr(XOR_LINK), NULL)
+
+typedef struct XLLLoc {
+    Node * prev;
+    Node * node;
+} XLLLoc;
+
+static inline Node * xor_nodes(Node * a, Node * b) {
+    return (Node *) ((uintptr_t) a ^ (uintptr_t) b);
+}
+
+// given that node was reached from prev, return the node on the other side of node
+static inline Node * XorLinkedList_step(NodeAttributes * NA, Node * prev, Node * node) {
+    return xor_nodes(Node_get(NA, node, XOR_LINK), prev);
+}
+
+// replace the neighbor old_neighbor of node with new_neighbor
+static inline void XorLinkedList_relink(NodeAttributes * NA, Node * node, Node * old_neighbor, Node * new_neighbor) {
+    Node_set(NA, node, XOR_LINK, xor_nodes(Node_get(NA, node, XOR_LINK), xor_nodes(old_neighbor, new_neighbor)));
+}
+
+// finds the node at index along with its predecessor. Searches from whichever end is closer
+static XLLLoc XorLinkedList_get_loc(XorLinkedList * xll, size_t index) {
+    if (!xll || index >= xll->size) {
+        return (XLLLoc) {NULL, NULL};
+    }
+    NodeAttributes * NA = xll->NA;
+    Node * prev = NULL;
+    Node * node = NULL;
+    if (index < xll->size / 2) {
+        node = xll->head;
+        while (index--) {
+            Node * next = XorLinkedList_step(NA, prev, node);
+            prev = node;
+            node = next;
+        }
+    } else { // walk backwards from the tail, then recover the predecessor in the forward direction
+        Node * next = NULL;
+        node = xll->tail;
+        index = xll->size - 1 - index;
+        while (index--) {
+            Node * back = XorLinkedList_step(NA, next, node);
+            next = node;
+            node = back;
+        }
+        prev = XorLinkedList_step(NA, next, node);
+    }
+    return (XLLLoc) {prev, node};
+}
+
+XorLinkedList * XorLinkedList_new(unsigned int flags, int narg_pairs, ...) {
+    XorLinkedList * xll = (XorLinkedList *) CL_MALLOC(sizeof(XorLinkedList));
+    if (!xll) {
+        return NULL;
+    }
+
+    flags |= REQUIRED_NODE_FLAGS; // must have these flag minimum
+    va_list args;
+    va_start(args, narg_pairs);
+    NodeAttributes * NA = vNodeAttributes_new(flags, narg_pairs, args);
+    va_end(args);
+
+    if (!NA) {
+        CL_FREE(xll);
+        return NULL;
+    }
+
+    if (!narg_pairs) { // if default fails, not necessarily a problem
+        NodeAttributes_set_default_node(NA, DEFAULT_NODE);
+        NA->default_alloc = true;
+    }
+
+    XorLinkedList_init(xll, NA);
+
+    return xll;
+}
+
+void XorLinkedList_init(XorLinkedList * xll, NodeAttributes * NA) {
+    if (!xll || !NA) {
+        return;
+    }
+    xll->NA = NA;
+    xll->head = NULL;
+    xll->tail = NULL;
+    xll->size = 0;
+}
+
+void XorLinkedList_del(XorLinkedList * xll) {
+    Node * prev = NULL;
+    Node * node = xll->head;
+    while (node) {
+        Node * next = XorLinkedList_step(xll->NA, prev, node);
+        if (prev) {
+            Node_del(prev);
+        }
+        prev = node;
+        node = next;
+    }
+    if (prev) {
+        Node_del(prev);
+    }
+    NodeAttributes_del(xll->NA);
+    CL_FREE(xll);
+}
+
+// the links are symmetric so exchanging the ends is a full reversal
+void XorLinkedList_reverse(XorLinkedList * xll) {
+    Node * temp = xll->head;
+    xll->head = xll->tail;
+    xll->tail = temp;
+}
+
+size_t XorLinkedList_size(XorLinkedList * xll) {
+    if (!xll) {
+        return 0;
+    }
+    return xll->size;
+}
+
+bool XorLinkedList_is_empty(XorLinkedList * xll) {
+    return xll->size == 0;
+}
+
+bool XorLinkedList_contains(XorLinkedList * xll, void * value, int (*comp)(void*, void*)) {
+    return XorLinkedList_find(xll, value, comp) != NULL;
+}
+
+// nodes of src are moved to the end of dest. src is left empty
+enum cl_status XorLinkedList_extend(XorLinkedList * dest, XorLinkedList * src) {
+    // TODO: if there's a way to compare NodeAttributes, should to that first
+    if (!dest) {
+        return CL_VALUE_ERROR;
+    }
+    if (!src || !src->head) {
+        return CL_SUCCESS;
+    }
+    if (!dest->head) {
+        dest->head = src->head;
+    } else {
+        XorLinkedList_relink(dest->NA, dest->tail, NULL, src->head);
+        XorLinkedList_relink(dest->NA, src->head, NULL, dest->tail);
+    }
+    dest->tail = src->tail;
+    dest->size += src->size;
+    src->head = NULL;
+    src->tail = NULL;
+    src->size = 0;
+    return CL_SUCCESS;
+}
+
+void * XorLinkedList_peek_front(XorLinkedList * xll) {
+    if (!xll || !xll->head) {
+        return NULL;
+    }
+    return Node_get(xll->NA, xll->head, VALUE);
+}
+
+void * XorLinkedList_peek_back(XorLinkedList * xll) {
+    if (!xll || !xll->tail) {
+        return NULL;
+    }
+    return Node_get(xll->NA, xll->tail, VALUE);
+}
+
+void * XorLinkedList_get(XorLinkedList * xll, size_t index) {
+    Node * node = XorLinkedList_get_loc(xll, index).node;
+    if (!node) {
+        return NULL;
+    }
+    return Node_get(xll->NA, node, VALUE);
+}
+
+enum cl_status XorLinkedList_insert(XorLinkedList * xll, size_t loc, void * val) {
+    if (!xll) {
+        return CL_VALUE_ERROR;
+    }
+    if (loc > xll->size) {
+        return CL_INDEX_OUT_OF_BOUNDS;
+    }
+    NodeAttributes * NA = xll->NA;
+    Node * prev = NULL;
+    Node * next = NULL;
+    if (loc == xll->size) {
+        prev = xll->tail;
+    } else {
+        XLLLoc node_loc = XorLinkedList_get_loc(xll, loc);
+        prev = node_loc.prev;
+        next = node_loc.node;
+    }
+    Node * new_node = Node_new(NA, 2, Node_attr(VALUE), val, Node_attr(XOR_LINK), xor_nodes(prev, next));
+    if (!new_node) {
+        return CL_MALLOC_FAILURE;
+    }
+    if (prev) {
+        XorLinkedList_relink(NA, prev, next, new_node);
+    } else {
+        xll->head = new_node;
+    }
+    if (next) {
+        XorLinkedList_relink(NA, next, prev, new_node);
+    } else {
+        xll->tail = new_node;
+    }
+    xll->size++;
+    return CL_SUCCESS;
+}
+
+enum cl_status XorLinkedList_push_front(XorLinkedList * xll, void * val) {
+    return XorLinkedList_insert(xll, 0, val);
+}
+
+enum cl_status XorLinkedList_push_back(XorLinkedList * xll, void * val) {
+    return XorLinkedList_insert(xll, XorLinkedList_size(xll), val);
+}
+
+void * XorLinkedList_remove(XorLinkedList * xll, size_t loc) {
+    if (!xll || loc >= xll->size) {
+        return NULL;
+    }
+    NodeAttributes * NA = xll->NA;
+    XLLLoc node_loc = XorLinkedList_get_loc(xll, loc);
+    Node * next = XorLinkedList_step(NA, node_loc.prev, node_loc.node);
+    if (node_loc.prev) {
+        XorLinkedList_relink(NA, node_loc.prev, node_loc.node, next);
+    } else {
+        xll->head = next;
+    }
+    if (next) {
+        XorLinkedList_relink(NA, next, node_loc.node, node_loc.prev);
+    } else {
+        xll->tail = node_loc.prev;
+    }
+    void * val = Node_get(NA, node_loc.node, VALUE);
+    Node_del(node_loc.node);
+    xll->size--;
+    return val;
+}
+
+void * XorLinkedList_pop_front(XorLinkedList * xll) {
+    return XorLinkedList_remove(xll, 0);
+}
+
+void * XorLinkedList_pop_back(XorLinkedList * xll) {
+    return XorLinkedList_remove(xll, XorLinkedList_size(xll)-1);
+}
+
+void * XorLinkedList_find(XorLinkedList * xll, void * value, int (*comp)(void*, void*)) {
+    if (!xll || !comp) {
+        return NULL;
+    }
+    Node * prev = NULL;
+    Node * node = xll->head;
+    while (node) {
+        void * result = Node_get(xll->NA, node, VALUE);
+        if (!comp(result, value)) {
+            return result;
+        }
+        Node * next = XorLinkedList_step(xll->NA, prev, node);
+        prev = node;
+        node = next;
+    }
+    return NULL;
+}
+
+//Iterators
+void XorLinkedListIterator_init(XorLinkedListIterator * xll_iter, XorLinkedList * xll) {
+    if (!xll_iter) {
+        return;
+    }
+    xll_iter->xll = xll;
+    xll_iter->prev = NULL;
+    xll_iter->node = NULL;
+    if (!xll || !xll->size) {
+        xll_iter->stop = ITERATOR_STOP;
+    } else {
+        xll_iter->node = xll->head;
+        xll_iter->stop = ITERATOR_PAUSE;
+    }
+}
+void * XorLinkedListIterator_next(XorLinkedListIterator * xll_iter) {
+    if (!xll_iter || xll_iter->stop == ITERATOR_STOP) {
+        return NULL;
+    }
+    if (xll_iter->stop == ITERATOR_PAUSE) {
+        xll_iter->stop = ITERATOR_GO;
+    } else {
+        Node * next = XorLinkedList_step(xll_iter->xll->NA, xll_iter->prev, xll_iter->node);
+        xll_iter->prev = xll_iter->node;
+        xll_iter->node = next;
+    }
+    if (!xll_iter->node) {
+        xll_iter->stop = ITERATOR_STOP;
+        return NULL;
+    }
+    return Node_get(xll_iter->xll->NA, xll_iter->node, VALUE);
+}
+size_t XorLinkedListIterator_next_n(XorLinkedListIterator * xll_iter, void ** out, size_t max) {
+    if (!xll_iter || !max || xll_iter->stop == ITERATOR_STOP) {
+        return 0;
+    }
+    NodeAttributes * NA = xll_iter->xll->NA;
+    Node * prev = xll_iter->prev;
+    Node * node = xll_iter->node;
+    if (xll_iter->stop == ITERATOR_GO) {
+        Node * next = XorLinkedList_step(NA, prev, node);
+        prev = node;
+        node = next;
+    }
+    size_t n = 0;
+    while (node) {
+        out[n++] = Node_get(NA, node, VALUE);
+        if (n == max) {
+            break;
+        }
+        Node * next = XorLinkedList_step(NA, prev, node);
+        prev = node;
+        node = next;
+    }
+    xll_iter->prev = prev;
+    xll_iter->node = node;
+    xll_iter->stop = (n < max) ? ITERATOR_STOP : ITERATOR_GO;
+    return n;
+}
+size_t XorLinkedListIterator_advance(XorLinkedListIterator * xll_iter, size_t n) {
+    if (!xll_iter || !n || xll_iter->stop == ITERATOR_STOP) {
+        return 0;
+    }
+    NodeAttributes * NA = xll_iter->xll->NA;
+    Node * prev = xll_iter->prev;
+    Node * node = xll_iter->node;
+    if (xll_iter->stop == ITERATOR_GO) {
+        Node * next = XorLinkedList_step(NA, prev, node);
+        prev = node;
+        node = next;
+    }
+    size_t k = 0;
+    while (node && ++k < n) {
+        Node * next = XorLinkedList_step(NA, prev, node);
+        prev = node;
+        node = next;
+    }
+    xll_iter->prev = prev;
+    xll_iter->node = node;
+    xll_iter->stop = node ? ITERATOR_GO : ITERATOR_STOP;
+    return k;
+}
+size_t XorLinkedListIterator_size_hint(XorLinkedListIterator * xll_iter) {
+    if (!xll_iter || xll_iter->stop == ITERATOR_STOP) {
+        return 0;
+    }
+    return xll_iter->xll->size - (xll_iter->stop == ITERATOR_GO);
+}
+enum iterator_status XorLinkedListIterator_stop(XorLinkedListIterator * xll_iter) {
+    if (!xll_iter) {
+        return ITERATOR_STOP;
+    }
+    return xll_iter->stop;
+}
+void XorLinkedListIteratorIterator_init(XorLinkedListIteratorIterator * xll_iter_iter, XorLinkedListIterator * xll_iter) {
+    XorLinkedListIterator_init(xll_iter_iter, xll_iter->xll);
+}
+void * XorLinkedListIteratorIterator_next(XorLinkedListIteratorIterator * xll_iter) {
+    return XorLinkedListIterator_next(xll_iter);
+}
+enum iterator_status XorLinkedListIteratorIterator_stop(XorLinkedListIteratorIterator * xll_iter) {
+    return XorLinkedListIterator_stop(xll_iter);
+}
@@ -0,0 +1,243 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "cl_algorithms.h"
+
+#define TEST_N 3000
+
+// larger than CL_SORT_BRANCHLESS_SIZE so that the swapping partition is used
+typedef struct Record {
+    long key;
+    size_t index;
+    char payload[24];
+} Record;
+
+#define RECORD_KEY_LESS(a, b) ((a)->key < (b)->key)
+
+declare_array_algorithms(Record_by_key, Record)
+define_array_algorithms(Record_by_key, Record, RECORD_KEY_LESS)
+
+#define RECORD_RADIX_KEY(a) CL_RADIX_SIGNED_KEY(unsigned long, &(a)->key)
+
+declare_array_radix_sort(Record_by_key, Record)
+define_array_radix_sort(Record_by_key, Record, unsigned long, RECORD_RADIX_KEY)
+
+static long arr[TEST_N];
+static long ref[TEST_N];
+static Record records[TEST_N];
+
+static size_t sarr[TEST_N];
+static int iarr[TEST_N];
+static pvoid parr[TEST_N];
+static char strings[TEST_N][12];
+static char * strs[TEST_N];
+static char * str_ref[TEST_N];
+
+static int compare_cstr(const void * a, const void * b) {
+    return strcmp(*(char * const *) a, *(char * const *) b);
+}
+
+static int compare_long(const void * a, const void * b) {
+    long x = *(const long *) a, y = *(const long *) b;
+    return (x > y) - (x < y);
+}
+
+static unsigned long test_seed = 12345;
+static long test_rand(void) {
+    test_seed = test_seed * 6364136223846793005UL + 1442695040888963407UL;
+    return (long) (test_seed >> 33);
+}
+
+#define NPATTERNS 6
+// fills arr and ref with a pattern of N values
+static void test_fill(size_t N, int pattern) {
+    for (size_t i = 0; i < N; i++) {
+        switch (pattern) {
+            case 0: arr[i] = test_rand(); break;            // random
+            case 1: arr[i] = (long) i; break;               // sorted
+            case 2: arr[i] = (long) (N - i); break;         // reversed
+            case 3: arr[i] = 7; break;                      // all equal
+            case 4: arr[i] = test_rand() % 5; break;        // few distinct
+            default: arr[i] = (long) (i < N / 2 ? i : N - i); // organ pipe
+        }
+        ref[i] = arr[i];
+    }
+    qsort(ref, N, sizeof(long), compare_long);
+}
+
+static size_t test_sizes[] = {0, 1, 2, 3, 10, 24, 25, 100, 129, 1000, TEST_N};
+#define NSIZES (sizeof(test_sizes)/sizeof(test_sizes[0]))
+
+int test_sort(void) {
+    printf("Testing sort and stable_sort...");
+    for (size_t s = 0; s < NSIZES; s++) {
+        size_t N = test_sizes[s];
+        for (int pattern = 0; pattern < NPATTERNS; pattern++) {
+            test_fill(N, pattern);
+            long_sort(arr, N);
+            for (size_t i = 0; i < N; i++) {
+                ASSERT(arr[i] == ref[i], "\nfound wrong element %zu of %zu with pattern %d in test_sort. Found: %ld, expected: %ld", i, N, pattern, arr[i], ref[i]);
+            }
+
+            test_fill(N, pattern);
+            ASSERT(long_stable_sort(arr, N) == CL_SUCCESS, "\nfailed to allocate in test_sort");
+            for (size_t i = 0; i < N; i++) {
+                ASSERT(arr[i] == ref[i], "\nfound wrong element %zu of %zu with pattern %d after stable_sort in test_sort. Found: %ld, expected: %ld", i, N, pattern, arr[i], ref[i]);
+            }
+
+            // the records carry their original position to check stability
+            test_fill(N, pattern);
+            for (size_t i = 0; i < N; i++) {
+                records[i] = (Record) {arr[i], i, {0}};
+            }
+            Record_by_key_stable_sort(records, N);
+            for (size_t i = 0; i < N; i++) {
+                ASSERT(records[i].key == ref[i], "\nfound wrong record %zu of %zu with pattern %d after stable_sort in test_sort", i, N, pattern);
+                ASSERT(!i || records[i-1].key < records[i].key || records[i-1].index < records[i].index, "\nfound equal records out of order at %zu of %zu with pattern %d in test_sort", i, N, pattern);
+            }
+
+            for (size_t i = 0; i < N; i++) {
+                records[i] = (Record) {arr[i], i, {0}};
+            }
+            Record_by_key_sort(records, N);
+            ASSERT(Record_by_key_is_sorted(records, N), "\nfound records not sorted, %zu with pattern %d in test_sort", N, pattern);
+            for (size_t i = 0; i < N; i++) {
+                ASSERT(records[i].key == ref[i], "\nfound wrong record %zu of %zu with pattern %d in test_sort", i, N, pattern);
+            }
+        }
+    }
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_nth_element(void) {
+    printf("Testing nth_element and partial_sort...");
+    for (size_t s = 0; s < NSIZES; s++) {
+        size_t N = test_sizes[s];
+        for (int pattern = 0; pattern < NPATTERNS; pattern++) {
+            size_t nths[] = {0, N / 3, N / 2, N ? N - 1 : 0};
+            for (size_t t = 0; t < sizeof(nths)/sizeof(nths[0]); t++) {
+                size_t nth = nths[t];
+                test_fill(N, pattern);
+                long * found = long_nth_element(arr, nth, N);
+                if (!N) {
+                    ASSERT(!found, "\nfound an element in an empty array in test_nth_element");
+                    continue;
+                }
+                ASSERT(found == arr + nth && *found == ref[nth], "\nfound wrong element %zu of %zu with pattern %d in test_nth_element", nth, N, pattern);
+                for (size_t i = 0; i < N; i++) {
+                    ASSERT(i < nth ? arr[i] <= *found : arr[i] >= *found, "\nfound element %zu on the wrong side of %zu of %zu with pattern %d in test_nth_element", i, nth, N, pattern);
+                }
+
+                size_t k = nth + 1;
+                test_fill(N, pattern);
+                long_partial_sort(arr, k, N);
+                for (size_t i = 0; i < k; i++) {
+                    ASSERT(arr[i] == ref[i], "\nfound wrong element %zu of the %zu smallest of %zu with pattern %d in test_nth_element", i, k, N, pattern);
+                }
+            }
+        }
+    }
+    long one = 1;
+    ASSERT(!long_nth_element(&one, 1, 1), "\nfound an element past the end in test_nth_element");
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_binary_search(void) {
+    printf("Testing lower_bound, upper_bound and binary_search...");
+    for (int pattern = 0; pattern < NPATTERNS; pattern++) {
+        for (size_t s = 0; s < NSIZES; s++) {
+            size_t N = test_sizes[s];
+            test_fill(N, pattern);
+            long_sort(arr, N);
+            long values[] = {-1, 0, 3, 7, N ? arr[N / 2] : 0, N ? arr[N - 1] : 0, N ? arr[N - 1] + 1 : 1};
+            for (size_t v = 0; v < sizeof(values)/sizeof(values[0]); v++) {
+                size_t lower = 0, upper = 0;
+                while (lower < N && arr[lower] < values[v]) {
+                    lower++;
+                }
+                while (upper < N && arr[upper] <= values[v]) {
+                    upper++;
+                }
+                long * lb = long_lower_bound(arr, N, &values[v]);
+                long * ub = long_upper_bound(arr, N, &values[v]);
+                long * found = long_binary_search(arr, N, &values[v]);
+                ASSERT(lb == arr + lower, "\nfound wrong lower_bound of %ld in %zu with pattern %d. Found: %td, expected: %zu", values[v], N, pattern, lb - arr, lower);
+                ASSERT(ub == arr + upper, "\nfound wrong upper_bound of %ld in %zu with pattern %d. Found: %td, expected: %zu", values[v], N, pattern, ub - arr, upper);
+                ASSERT(found == (lower < upper ? arr + lower : NULL), "\nfound wrong binary_search result for %ld in %zu with pattern %d", values[v], N, pattern);
+            }
+        }
+    }
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_radix_sort(void) {
+    printf("Testing radix sorts...");
+    for (size_t s = 0; s < NSIZES; s++) {
+        size_t N = test_sizes[s];
+        for (int pattern = 0; pattern < NPATTERNS; pattern++) {
+            // negative keys check the order of the signed types
+            test_fill(N, pattern);
+            for (size_t i = 0; i < N; i++) {
+                arr[i] -= 1L << 30;
+                ref[i] -= 1L << 30;
+                records[i] = (Record) {arr[i], i, {0}};
+            }
+            ASSERT(long_radix_sort(arr, N) == CL_SUCCESS, "\nfailed to allocate in test_radix_sort");
+            for (size_t i = 0; i < N; i++) {
+                ASSERT(arr[i] == ref[i], "\nfound wrong long %zu of %zu with pattern %d in test_radix_sort. Found: %ld, expected: %ld", i, N, pattern, arr[i], ref[i]);
+            }
+            Record_by_key_radix_sort(records, N);
+            for (size_t i = 0; i < N; i++) {
+                ASSERT(records[i].key == ref[i], "\nfound wrong record %zu of %zu with pattern %d in test_radix_sort", i, N, pattern);
+                ASSERT(!i || records[i-1].key < records[i].key || records[i-1].index < records[i].index, "\nfound equal records out of order at %zu of %zu with pattern %d in test_radix_sort", i, N, pattern);
+            }
+
+            test_fill(N, pattern);
+            for (size_t i = 0; i < N; i++) {
+                sarr[i] = (size_t) arr[i] * 2654435761u;
+                iarr[i] = (int) (arr[i] % 100000) - 50000;
+                parr[i] = strings[0] + sarr[i] % TEST_N;
+            }
+            size_t_radix_sort(sarr, N);
+            int_radix_sort(iarr, N);
+            pvoid_radix_sort(parr, N);
+            for (size_t i = 1; i < N; i++) {
+                ASSERT(sarr[i-1] <= sarr[i], "\nfound size_t out of order at %zu of %zu with pattern %d in test_radix_sort", i, N, pattern);
+                ASSERT(iarr[i-1] <= iarr[i], "\nfound int out of order at %zu of %zu with pattern %d in test_radix_sort", i, N, pattern);
+                ASSERT((uintptr_t) parr[i-1] <= (uintptr_t) parr[i], "\nfound pointer out of order at %zu of %zu with pattern %d in test_radix_sort", i, N, pattern);
+            }
+        }
+    }
+
+    // strings with long shared prefixes, empty strings and prefixes of each other
+    for (size_t s = 0; s < NSIZES; s++) {
+        size_t N = test_sizes[s];
+        for (size_t i = 0; i < N; i++) {
+            long r = test_rand();
+            size_t len = (size_t) (r % 11);
+            for (size_t j = 0; j < len; j++) {
+                strings[i][j] = (char) (j < 6 ? 'a' : 'a' + (r >> (4 * j)) % 3 - (j == len - 1 ? 64 : 0));
+            }
+            strings[i][len] = '\0';
+            strs[i] = str_ref[i] = strings[i];
+        }
+        qsort(str_ref, N, sizeof(char*), compare_cstr);
+        ASSERT(cstr_radix_sort(strs, N) == CL_SUCCESS, "\nfailed to allocate in test_radix_sort");
+        for (size_t i = 0; i < N; i++) {
+            ASSERT(!strcmp(strs[i], str_ref[i]), "\nfound wrong string %zu of %zu in test_radix_sort. Found: %s, expected: %s", i, N, strs[i], str_ref[i]);
+        }
+    }
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int main(void) {
+    test_sort();
+    test_nth_element();
+    test_binary_search();
+    test_radix_sort();
+    return 0;
+}
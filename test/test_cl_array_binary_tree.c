@@ -0,0 +1,146 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "cl_core.h"
+#include "cl_array_binary_tree.h"
+
+#define NKEYS 31
+#define MAX_HEIGHT 12
+
+int long_key_comp(const void * a, const void * b) {
+    return (*(long*)a > *(long*)b) - (*(long*)a < *(long*)b);
+}
+
+static unsigned long test_seed = 12345;
+static size_t test_rand(void) {
+    test_seed = test_seed * 6364136223846793005UL + 1442695040888963407UL;
+    return (size_t) (test_seed >> 33);
+}
+
+// writes the keys of the subtree at index to keys in order. Returns the number written
+static size_t inorder_keys(ArrayBinaryTree * abt, size_t index, long * keys) {
+    if (index >= abt->size || !abt->nodes[index]) {
+        return 0;
+    }
+    size_t n = inorder_keys(abt, 2 * index + 1, keys);
+    keys[n++] = *(const long *) Node_get(abt->NA, abt->nodes[index], KEY);
+    return n + inorder_keys(abt, 2 * index + 2, keys + n);
+}
+
+// checks that the nodes are in key order, that every node hangs from a parent and that no slot past size is used
+static void check_tree(ArrayBinaryTree * abt, long * keys, size_t num, char * test_name) {
+    long found[NKEYS];
+    size_t count = 0;
+    ASSERT(inorder_keys(abt, 0, found) == num, "\nfound wrong number of nodes in order in %s", test_name);
+    for (size_t i = 0; i < num; i++) {
+        ASSERT(found[i] == keys[i], "\nfound wrong key %zu in order in %s. Found: %ld, expected: %ld", i, test_name, found[i], keys[i]);
+    }
+    for (size_t i = 0; i < abt->capacity; i++) {
+        if (abt->nodes[i]) {
+            ASSERT(i < abt->size, "\nfound node at %zu past the size %zu in %s", i, abt->size, test_name);
+            ASSERT(!i || abt->nodes[(i - 1) / 2], "\nfound node at %zu left behind without a parent in %s", i, test_name);
+            count++;
+        }
+    }
+    ASSERT(count == num, "\nfound %zu nodes in the array in %s, expected: %zu", count, test_name, num);
+}
+
+int test_rotate(void) {
+    printf("Testing ArrayBinaryTree rotate and split_rotate...");
+    long keys[NKEYS];
+    const void * pkeys[NKEYS];
+    for (size_t i = 0; i < NKEYS; i++) {
+        keys[i] = (long) (3 * i);
+        pkeys[i] = &keys[i];
+    }
+    ArrayBinaryTree * abt = ArrayBinaryTree_new(1, long_key_comp, Node_flag(KEY) | Node_flag(VALUE), 0);
+    ASSERT(abt, "\nfailed to allocate a new ArrayBinaryTree in test_rotate");
+    ASSERT(ArrayBinaryTree_rotate(abt, 0, DIR_LEFT) == ABT_INDEX_OUT_OF_BOUNDS, "\nfailed to reject rotating an empty tree in test_rotate");
+    ASSERT(ArrayBinaryTree_build_from_sorted(abt, pkeys, NULL, NKEYS) == ABT_SUCCESS, "\nfailed to build in test_rotate");
+    ASSERT(ArrayBinaryTree_rotate(abt, NKEYS / 2, DIR_LEFT) == ABT_FAILURE, "\nfailed to reject rotating a leaf in test_rotate");
+
+    size_t rotations = 0;
+    for (size_t op = 0; op < 4000; op++) {
+        size_t index = 0, skip = test_rand() % NKEYS; // a random node
+        while (!abt->nodes[index] || skip--) {
+            index++;
+        }
+        int dir = (test_rand() & 1) ? DIR_LEFT : DIR_RIGHT;
+        int status = (test_rand() & 1) ? ArrayBinaryTree_rotate(abt, index, dir) : ArrayBinaryTree_split_rotate(abt, index, dir);
+        ASSERT(status == ABT_SUCCESS || status == ABT_FAILURE, "\nfound unexpected status %d in test_rotate", status);
+        rotations += status == ABT_SUCCESS;
+        check_tree(abt, keys, NKEYS, "test_rotate");
+        // each rotation changes the height by at most one, so this bounds the array at 2^(MAX_HEIGHT + 1) slots
+        if (ArrayBinaryTree_height(abt, 0) > MAX_HEIGHT) {
+            ArrayBinaryTree_build_from_sorted(abt, pkeys, NULL, NKEYS);
+        }
+    }
+    ASSERT(rotations > 1000, "\nfound only %zu successful rotations in test_rotate", rotations);
+    ArrayBinaryTree_del(abt);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_build_from_sorted(void) {
+    printf("Testing ArrayBinaryTree_build_from_sorted...");
+    long keys[NKEYS];
+    const void * pkeys[NKEYS];
+    void * values[NKEYS];
+    for (size_t i = 0; i < NKEYS; i++) {
+        keys[i] = (long) (3 * i);
+        pkeys[i] = &keys[i];
+        values[i] = &keys[NKEYS - 1 - i];
+    }
+    ArrayBinaryTree * abt = ArrayBinaryTree_new(1, long_key_comp, Node_flag(KEY) | Node_flag(VALUE), 0);
+    ASSERT(abt, "\nfailed to allocate a new ArrayBinaryTree in test_build_from_sorted");
+    CircularBuffer * path = CircularBuffer_new(8);
+    size_t sizes[] = {0, 1, 2, 3, 7, 10, NKEYS, 5}; // rebuilding over a larger tree frees its block
+    for (size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++) {
+        size_t N = sizes[s];
+        ASSERT(ArrayBinaryTree_build_from_sorted(abt, pkeys, values, N) == ABT_SUCCESS, "\nfailed to build %zu keys in test_build_from_sorted", N);
+        // a complete tree occupies exactly [0, N), every node in the block
+        ASSERT(ArrayBinaryTree_size(abt) == N, "\nfound wrong size in test_build_from_sorted. Found: %zu, expected: %zu", ArrayBinaryTree_size(abt), N);
+        for (size_t i = 0; i < abt->capacity; i++) {
+            ASSERT(i < N ? abt->nodes[i] != NULL : abt->nodes[i] == NULL, "\nfound slot %zu of %zu keys %s in test_build_from_sorted", i, N, i < N ? "empty" : "used");
+            ASSERT(i >= N || (abt->nodes[i] >= abt->block && abt->nodes[i] < abt->block_end), "\nfound node %zu outside the block in test_build_from_sorted", i);
+        }
+        check_tree(abt, keys, N, "test_build_from_sorted");
+        ASSERT(!N || ArrayBinaryTree_leftmost(abt, 0) < N, "\nfailed to find leftmost in test_build_from_sorted");
+        for (size_t i = 0; i < N; i++) {
+            size_t index = ArrayBinaryTree_find(abt, &keys[i]);
+            ASSERT(index < N && Node_get(abt->NA, abt->nodes[index], VALUE) == values[i], "\nfound wrong value for key %ld in test_build_from_sorted", keys[i]);
+            ASSERT(ArrayBinaryTree_path_to(path, abt, &keys[i]) == ABT_SUCCESS, "\nfailed to find path to key %ld in test_build_from_sorted", keys[i]);
+            ASSERT(CircularBuffer_size(path) == ArrayBinaryTree_depth(abt, index) + 1, "\nfound wrong path length to key %ld in test_build_from_sorted", keys[i]);
+            ASSERT(!(uintptr_t) CircularBuffer_peek_front(path) && (uintptr_t) CircularBuffer_peek_back(path) == index, "\nfound wrong path ends to key %ld in test_build_from_sorted", keys[i]);
+            while (CircularBuffer_size(path)) {
+                CircularBuffer_pop_back(path);
+            }
+        }
+        long missing = 1;
+        ASSERT(ArrayBinaryTree_find(abt, &missing) == N && ArrayBinaryTree_path_to(path, abt, &missing) == ABT_FAILURE, "\nfound a missing key in test_build_from_sorted");
+    }
+    CircularBuffer_del(path);
+
+    // a node allocated on its own below the block nodes must be freed by del, which must not free the block nodes
+    long smallest = -1;
+    size_t leftmost = ArrayBinaryTree_leftmost(abt, 0);
+    size_t slot = 2 * leftmost + 1;
+    ASSERT(slot < abt->capacity && !abt->nodes[slot], "\nfound no free slot below the leftmost node in test_build_from_sorted");
+    abt->nodes[slot] = (Node *) CL_MALLOC(abt->NA->size);
+    ASSERT(abt->nodes[slot], "\nfailed to allocate a node in test_build_from_sorted");
+    memset(abt->nodes[slot], 0, abt->NA->size);
+    Node_get(abt->NA, abt->nodes[slot], KEY) = &smallest;
+    abt->size = slot + 1;
+    ASSERT(ArrayBinaryTree_leftmost(abt, 0) == slot, "\nfailed to find the new leftmost node in test_build_from_sorted");
+    ArrayBinaryTree_del(abt);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int main(void) {
+    test_build_from_sorted();
+    test_rotate();
+    return 0;
+}
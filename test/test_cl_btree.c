@@ -0,0 +1,173 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "cl_core.h"
+#include "cl_btree.h"
+
+#define NKEYS 20000
+
+int long_key_comp(const void * a, const void * b) {
+    return (*(long*)a > *(long*)b) - (*(long*)a < *(long*)b);
+}
+
+static long keys[NKEYS];
+static bool present[NKEYS];
+
+// checks key order, node occupancy, that separators are the minimum of the subtree to their right and that all leaves
+// are at the same depth. Returns the number of keys in the subtree
+static size_t check_node(BTree * bt, BTreeNode * node, size_t depth, char * test_name) {
+    if (node != bt->root) {
+        ASSERT(node->nkeys >= BTREE_MIN_KEYS, "\nfound underfull node in %s. Found: %u keys", test_name, node->nkeys);
+    }
+    for (unsigned int i = 1; i < node->nkeys; i++) {
+        ASSERT(bt->compare(node->keys[i-1], node->keys[i]) < 0, "\nfound out of order keys in a node in %s", test_name);
+    }
+    if (node->leaf) {
+        ASSERT(depth == bt->height, "\nfound leaf at incorrect depth in %s. Found: %zu, expected: %zu", test_name, depth, bt->height);
+        return node->nkeys;
+    }
+    size_t count = 0;
+    for (unsigned int i = 0; i <= node->nkeys; i++) {
+        BTreeNode * child = ((BTreeInner *) node)->children[i];
+        if (i > 0) {
+            BTreeNode * leftmost = child;
+            while (!leftmost->leaf) {
+                leftmost = ((BTreeInner *) leftmost)->children[0];
+            }
+            ASSERT(node->keys[i-1] == leftmost->keys[0], "\nfound separator that is not the minimum of its right subtree in %s", test_name);
+        }
+        count += check_node(bt, child, depth + 1, test_name);
+    }
+    return count;
+}
+
+static void check_tree(BTree * bt, char * test_name) {
+    if (!bt->root) {
+        ASSERT(!bt->size && !bt->first && !bt->last, "\nfound elements in tree without root in %s", test_name);
+        return;
+    }
+    size_t count = check_node(bt, bt->root, 1, test_name);
+    ASSERT(count == BTree_size(bt), "\nfound incorrect size in %s. Found: %zu, expected: %zu", test_name, BTree_size(bt), count);
+    count = 0;
+    BTreeLeaf * prev = NULL;
+    for (BTreeLeaf * leaf = bt->first; leaf; leaf = leaf->next) {
+        ASSERT(leaf->prev == prev, "\nfound broken leaf links in %s", test_name);
+        count += leaf->node.nkeys;
+        prev = leaf;
+    }
+    ASSERT(prev == bt->last, "\nfound incorrect last leaf in %s", test_name);
+    ASSERT(count == BTree_size(bt), "\nleaf chain does not hold every key in %s. Found: %zu, expected: %zu", test_name, count, BTree_size(bt));
+}
+
+int test_insert_get_erase(void) {
+    printf("Testing BTree_insert, BTree_get & BTree_erase...");
+    BTree * bt = BTree_new(long_key_comp, 0);
+
+    srand(54321);
+    for (size_t i = 0; i < 4 * NKEYS; i++) {
+        long k = rand() % NKEYS;
+        if (rand() % 3) {
+            enum cl_status status = BTree_insert(bt, &keys[k], &keys[k]);
+            ASSERT((status == CL_SUCCESS) == !present[k], "\nunexpected status on insert in test_insert_get_erase. Found: %d for key %ld", status, k);
+            present[k] = true;
+        } else {
+            enum cl_status status = BTree_erase(bt, &keys[k]);
+            ASSERT((status == CL_SUCCESS) == present[k], "\nunexpected status on erase in test_insert_get_erase. Found: %d for key %ld", status, k);
+            present[k] = false;
+        }
+        if (!(i % 1024)) {
+            check_tree(bt, "test_insert_get_erase");
+        }
+    }
+    check_tree(bt, "test_insert_get_erase");
+
+    for (long k = 0; k < NKEYS; k++) {
+        ASSERT(BTree_contains(bt, &keys[k]) == present[k], "\nfailed to find key in test_insert_get_erase: %ld", k);
+        if (present[k]) {
+            long retrieved = *(long*)BTree_get(bt, &keys[k]);
+            ASSERT(retrieved == k, "\nretrieved incorrect value in test_insert_get_erase. Found: %ld, expected: %ld", retrieved, k);
+        }
+    }
+
+    long replacement = -1;
+    long k = *(long*)BTree_min(bt);
+    ASSERT(BTree_insert(bt, &keys[k], &replacement) == CL_FAILURE, "\nfailed to reject existing key in test_insert_get_erase: %ld", k);
+    bt->flags |= TREE_MOD_UPDATE;
+    BTree_insert(bt, &keys[k], &replacement);
+    long retrieved = *(long*)BTree_pop(bt, &keys[k]);
+    ASSERT(retrieved == replacement, "\nfailed to update value in test_insert_get_erase. Found: %ld, expected: %ld", retrieved, replacement);
+    present[k] = false;
+
+    for (k = 0; k < NKEYS; k++) {
+        if (present[k]) {
+            BTree_erase(bt, &keys[k]);
+            present[k] = false;
+        }
+    }
+    check_tree(bt, "test_insert_get_erase");
+    ASSERT(BTree_is_empty(bt), "\nfailed to empty tree in test_insert_get_erase. Found: %zu elements", BTree_size(bt));
+
+    BTree_del(bt);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_iterators(void) {
+    printf("Testing BTreeIterator...");
+    BTree * bt = BTree_new(long_key_comp, 0);
+
+    // insert even keys in descending order
+    for (long k = NKEYS - 2; k >= 0; k -= 2) {
+        BTree_insert(bt, &keys[k], &keys[k]);
+    }
+    check_tree(bt, "test_iterators");
+
+    BTreeIterator bt_iter;
+    BTreeIterator_init(&bt_iter, bt);
+    long expected = 0;
+    for (long * value = BTreeIterator_next(&bt_iter); value; value = BTreeIterator_next(&bt_iter)) {
+        ASSERT(*value == expected, "\nfound incorrect value in full iteration in test_iterators. Found: %ld, expected: %ld", *value, expected);
+        ASSERT(*(long*)BTreeIterator_key(&bt_iter) == expected, "\nfound incorrect key in full iteration in test_iterators. Found: %ld, expected: %ld", *(long*)BTreeIterator_key(&bt_iter), expected);
+        expected += 2;
+    }
+    ASSERT(expected == NKEYS, "\nfailed to iterate over all values in test_iterators. Found: %ld, expected: %d", expected, NKEYS);
+    ASSERT(BTreeIterator_stop(&bt_iter) == ITERATOR_STOP, "\nfailed to stop iterator in test_iterators");
+
+    // odd bounds are not in the tree
+    BTreeIterator_init_range(&bt_iter, bt, &keys[101], &keys[301]);
+    expected = 102;
+    while (BTreeIterator_stop(&bt_iter) != ITERATOR_STOP) {
+        long * value = BTreeIterator_next(&bt_iter);
+        if (value) {
+            ASSERT(*value == expected, "\nfound incorrect value in range iteration in test_iterators. Found: %ld, expected: %ld", *value, expected);
+            expected += 2;
+        }
+    }
+    ASSERT(expected == 302, "\nfailed to stop range iteration at end key in test_iterators. Found: %ld, expected: %d", expected, 302);
+
+    BTreeIterator_init_range(&bt_iter, bt, &keys[NKEYS - 1], NULL);
+    ASSERT(!BTreeIterator_next(&bt_iter), "\nfound value past the last key in test_iterators");
+
+    BTreeKeyIterator key_iter;
+    BTreeKeyIterator_init(&key_iter, bt);
+    expected = 0;
+    for (const void * key = BTreeKeyIterator_next(&key_iter); key; key = BTreeKeyIterator_next(&key_iter)) {
+        ASSERT(*(long*)key == expected, "\nfound incorrect key in key iteration in test_iterators. Found: %ld, expected: %ld", *(long*)key, expected);
+        expected += 2;
+    }
+
+    BTree_del(bt);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int main(void) {
+    for (long i = 0; i < NKEYS; i++) {
+        keys[i] = i;
+    }
+    test_insert_get_erase();
+    test_iterators();
+    return 0;
+}
@@ -126,8 +126,97 @@ int test_dynamic_push_pop_peek(void) {
     return CL_SUCCESS;
 }
 
+int long_comp(void * a, void * b) {
+    return (*(long*)a > *(long*)b) - (*(long*)a < *(long*)b);
+}
+
+int test_sort(void) {
+	printf("Testing CircularBuffer_sort...");
+	long arr[] = {567890, 42, 2039784, 123456, 7, 493583, 1843985, 234567, 42, 1230987, 345678};
+	size_t arr_size = sizeof(arr)/sizeof(arr[0]);
+
+    void * data[16];
+
+    CircularBuffer deq;
+    CircularBuffer_init(&deq, data, 16);
+
+    // alternate ends so that the elements wrap around the end of the array
+    for (size_t i = 0; i < arr_size; i++) {
+        if (i & 1) {
+            CircularBuffer_push_front(&deq, &arr[i]);
+        } else {
+            CircularBuffer_push_back(&deq, &arr[i]);
+        }
+    }
+    CircularBuffer_reverse(&deq);
+
+    CircularBuffer_sort(&deq, long_comp);
+    ASSERT(CircularBuffer_size(&deq) == arr_size, "\nsize changed after sorting in test_sort. Found: %zu, expected: %zu", CircularBuffer_size(&deq), arr_size);
+    for (size_t i = 1; i < arr_size; i++) {
+        long prev = *(long*)CircularBuffer_get(&deq, i-1);
+        long retrieved = *(long*)CircularBuffer_get(&deq, i);
+        ASSERT(retrieved >= prev, "\nfound out of order elements after sorting in test_sort. Found: %ld after %ld", retrieved, prev);
+    }
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_next_n(void) {
+    printf("Testing CircularBufferIterator_next_n...");
+    long arr[] = {0, 1, 2, 3, 4, 5, 6, 7};
+    size_t arr_size = sizeof(arr)/sizeof(arr[0]);
+    void * data[8];
+    void * buf[5];
+
+    CircularBuffer cb;
+    CircularBuffer_init(&cb, data, 8);
+    // start with a head in the middle of the array so that the buffer wraps around
+    for (size_t i = 0; i < 3; i++) {
+        CircularBuffer_push_back(&cb, &arr[i]);
+    }
+    for (size_t i = 0; i < 3; i++) {
+        CircularBuffer_pop_front(&cb);
+    }
+    for (size_t i = 0; i < arr_size; i++) {
+        CircularBuffer_push_back(&cb, &arr[i]);
+    }
+
+    for (int reversed = 0; reversed < 2; reversed++) {
+        for (size_t batch = 1; batch <= 5; batch++) {
+            CircularBufferIterator cb_iter;
+            CircularBufferIterator_init(&cb_iter, &cb);
+            size_t i = 0, n;
+            do {
+                n = CircularBufferIterator_next_n(&cb_iter, buf, batch);
+                for (size_t j = 0; j < n; j++, i++) {
+                    long expected = reversed ? arr[arr_size - 1 - i] : arr[i];
+                    ASSERT(*(long*)buf[j] == expected, "\nfound wrong element %zu in test_next_n. Found: %ld, expected: %ld", i, *(long*)buf[j], expected);
+                }
+            } while (n == batch);
+            ASSERT(i == arr_size, "\nfound wrong number of elements in test_next_n. Found: %zu, expected: %zu", i, arr_size);
+            ASSERT(CircularBufferIterator_stop(&cb_iter) == ITERATOR_STOP, "\nfound iterator not stopped after short batch in test_next_n");
+        }
+        CircularBuffer_reverse(&cb);
+    }
+
+    // mixed with next
+    CircularBufferIterator cb_iter;
+    CircularBufferIterator_init(&cb_iter, &cb);
+    long * l = CircularBufferIterator_next(&cb_iter);
+    size_t n = CircularBufferIterator_next_n(&cb_iter, buf, 3);
+    ASSERT(*l == 0 && n == 3 && *(long*)buf[0] == 1 && *(long*)buf[2] == 3, "\nfound wrong elements mixing next and next_n in test_next_n");
+    l = CircularBufferIterator_next(&cb_iter);
+    ASSERT(*l == 4, "\nfound wrong element after next_n in test_next_n. Found: %ld, expected: %d", *l, 4);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
 int main(void) {
     test_static_push_pop_peek();
     test_dynamic_push_pop_peek();
+    test_sort();
+    test_next_n();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,351 @@
+#include <stddef.h>
+#include <stdio.h>
+#include "cl_core.h"
+#include "cl_linked_list.h"
+#include "cl_dbl_linked_list.h"
+
+typedef struct Record {
+    long key;
+    size_t order; // insertion order to check stability
+} Record;
+
+int record_comp(void * a, void * b) {
+    return (((Record*)a)->key > ((Record*)b)->key) - (((Record*)a)->key < ((Record*)b)->key);
+}
+
+static Record records[] = {{5, 0}, {3, 1}, {9, 2}, {3, 3}, {1, 4}, {7, 5}, {5, 6}, {2, 7}, {9, 8}, {0, 9}, {3, 10}, {8, 11}, {4, 12}};
+static const size_t nrecords = sizeof(records)/sizeof(records[0]);
+
+// returns the number of elements visited. Fails if any are out of order or if equal keys are not in insertion order
+static size_t check_sorted(Record * prev, Record * rec, bool reversed) {
+    if (!prev) {
+        return 1;
+    }
+    ASSERT(prev->key <= rec->key, "\nfound out of order elements after sorting. Found: %ld after %ld", rec->key, prev->key);
+    if (prev->key == rec->key) {
+        ASSERT(reversed ^ (prev->order < rec->order), "\nsort was not stable. Found order %zu after %zu for key %ld", rec->order, prev->order, rec->key);
+    }
+    return 1;
+}
+
+int test_linked_list_sort(void) {
+    printf("Testing LinkedList_sort...");
+    LinkedList * ll = LinkedList_new(0, 0);
+    for (size_t i = 0; i < nrecords; i++) {
+        LinkedList_push_back(ll, &records[i]);
+    }
+
+    LinkedList_sort(ll, record_comp);
+    ASSERT(LinkedList_size(ll) == nrecords, "\nsize changed after sorting in test_linked_list_sort. Found: %zu, expected: %zu", LinkedList_size(ll), nrecords);
+
+    Record * prev = NULL;
+    size_t count = 0;
+    for_each(Record, rec, LinkedList, ll) {
+        count += check_sorted(prev, rec, false);
+        prev = rec;
+    }
+    ASSERT(count == nrecords, "\nfailed to iterate over all elements after sorting in test_linked_list_sort. Found: %zu, expected: %zu", count, nrecords);
+
+    LinkedList_del(ll);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_dbl_linked_list_sort(void) {
+    printf("Testing DblLinkedList_sort...");
+    DblLinkedList * dll = DblLinkedList_new(0, 0);
+    for (size_t i = 0; i < nrecords; i++) {
+        DblLinkedList_push_back(dll, &records[i]);
+    }
+
+    // sort the reversed list. Equal keys keep the order they had in the reversed list
+    DblLinkedList_reverse(dll);
+    DblLinkedList_sort(dll, record_comp);
+    ASSERT(DblLinkedList_size(dll) == nrecords, "\nsize changed after sorting in test_dbl_linked_list_sort. Found: %zu, expected: %zu", DblLinkedList_size(dll), nrecords);
+
+    Record * prev = NULL;
+    size_t count = 0;
+    for_each(Record, rec, DblLinkedList, dll) {
+        count += check_sorted(prev, rec, true);
+        prev = rec;
+    }
+    ASSERT(count == nrecords, "\nfailed to iterate over all elements after sorting in test_dbl_linked_list_sort. Found: %zu, expected: %zu", count, nrecords);
+
+    // the backward links must be consistent with the forward links
+    DblLinkedList_reverse(dll);
+    prev = NULL;
+    count = 0;
+    for_each(Record, rec, DblLinkedList, dll) {
+        ASSERT(!prev || prev->key >= rec->key, "\nbackward links inconsistent after sorting in test_dbl_linked_list_sort. Found: %ld after %ld", rec->key, prev->key);
+        prev = rec;
+        count++;
+    }
+    ASSERT(count == nrecords, "\nfailed to iterate backward over all elements after sorting in test_dbl_linked_list_sort. Found: %zu, expected: %zu", count, nrecords);
+    ASSERT(((Record *) DblLinkedList_peek_back(dll))->key == 0, "\nfailed to find smallest element at the back of the reversed list in test_dbl_linked_list_sort. Found: %ld", ((Record *) DblLinkedList_peek_back(dll))->key);
+
+    DblLinkedList_del(dll);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+// checks the contents of dll against expected in order, both through the iterator and through get
+static void check_contents(DblLinkedList * dll, long * expected, size_t n, char * test_name) {
+    ASSERT(DblLinkedList_size(dll) == n, "\nwrong size in %s. Found: %zu, expected: %zu", test_name, DblLinkedList_size(dll), n);
+    size_t i = 0;
+    for_each(long, val, DblLinkedList, dll) {
+        ASSERT(*val == expected[i], "\nwrong element at index %zu in %s. Found: %ld, expected: %ld", i, test_name, *val, expected[i]);
+        i++;
+    }
+    ASSERT(i == n, "\nfailed to iterate over all elements in %s. Found: %zu, expected: %zu", test_name, i, n);
+    for (i = 0; i < n; i++) {
+        long retrieved = *(long*)DblLinkedList_get(dll, i);
+        ASSERT(retrieved == expected[i], "\nwrong element from get at index %zu in %s. Found: %ld, expected: %ld", i, test_name, retrieved, expected[i]);
+    }
+}
+
+int test_cursor(void) {
+    printf("Testing DblLinkedListCursor...");
+    long arr[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    for (int reversed = 0; reversed < 2; reversed++) {
+        DblLinkedList * dll = DblLinkedList_new(0, 0);
+        if (reversed) {
+            DblLinkedList_reverse(dll);
+        }
+        DblLinkedListCursor cursor;
+        DblLinkedListCursor_init(&cursor, dll, 0);
+        ASSERT(!DblLinkedListCursor_get(&cursor), "\nfound element at cursor in empty list in test_cursor");
+        ASSERT(!DblLinkedListCursor_retreat(&cursor), "\nretreated cursor in empty list in test_cursor");
+
+        // insert_before past the back is a push_back
+        for (size_t i = 2; i < 6; i++) {
+            DblLinkedListCursor_insert_before(&cursor, &arr[i]);
+        }
+        ASSERT(DblLinkedListCursor_index(&cursor) == 4, "\ncursor index not updated by insert_before in test_cursor. Found: %zu, expected: 4", DblLinkedListCursor_index(&cursor));
+        // insert_after past the back is a push_front
+        DblLinkedListCursor_insert_after(&cursor, &arr[0]);
+        check_contents(dll, (long[]){0, 2, 3, 4, 5}, 5, "test_cursor after inserts at the ends");
+
+        // walk back to 2 and edit around it
+        while (!DblLinkedListCursor_get(&cursor) || *(long*)DblLinkedListCursor_get(&cursor) != 2) {
+            DblLinkedListCursor_retreat(&cursor);
+        }
+        ASSERT(DblLinkedListCursor_index(&cursor) == 1, "\ncursor index wrong after retreat in test_cursor. Found: %zu, expected: 1", DblLinkedListCursor_index(&cursor));
+        DblLinkedListCursor_insert_before(&cursor, &arr[1]);
+        DblLinkedListCursor_insert_after(&cursor, &arr[9]);
+        check_contents(dll, (long[]){0, 1, 2, 9, 3, 4, 5}, 7, "test_cursor after inserts around the cursor");
+
+        DblLinkedListCursor_advance(&cursor);
+        long erased = *(long*)DblLinkedListCursor_erase(&cursor);
+        ASSERT(erased == 9, "\nerased wrong element in test_cursor. Found: %ld, expected: 9", erased);
+        ASSERT(*(long*)DblLinkedListCursor_get(&cursor) == 3, "\ncursor did not move to the next element after erase in test_cursor");
+        while (DblLinkedListCursor_advance(&cursor)) {
+        }
+        ASSERT(DblLinkedListCursor_index(&cursor) == 6, "\ncursor index wrong past the back in test_cursor. Found: %zu, expected: 6", DblLinkedListCursor_index(&cursor));
+        DblLinkedListCursor_retreat(&cursor);
+        DblLinkedListCursor_erase(&cursor);
+        ASSERT(!DblLinkedListCursor_get(&cursor), "\ncursor not past the back after erasing the back in test_cursor");
+        check_contents(dll, (long[]){0, 1, 2, 3, 4}, 5, "test_cursor after erase");
+
+        DblLinkedList_reverse(dll);
+        check_contents(dll, (long[]){4, 3, 2, 1, 0}, 5, "test_cursor after reversing the list");
+
+        DblLinkedList_del(dll);
+    }
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_splice(void) {
+    printf("Testing LinkedList_splice & DblLinkedList_splice...");
+    long arr[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    LinkedList * lla = LinkedList_new(0, 0);
+    LinkedList * llb = LinkedList_new(0, 0);
+    for (size_t i = 0; i < 5; i++) {
+        LinkedList_push_back(lla, &arr[i]);
+        LinkedList_push_back(llb, &arr[i+5]);
+    }
+    // move {6, 7} in front of 2, then split off from 3
+    Node * first = llb->head;
+    first = Node_get(llb->NA, first, NEXT);
+    Node * last = Node_get(llb->NA, Node_get(llb->NA, first, NEXT), NEXT);
+    Node * pos = Node_get(lla->NA, Node_get(lla->NA, lla->head, NEXT), NEXT);
+    LinkedList_splice(lla, pos, llb, first, last);
+    ASSERT(LinkedList_size(lla) == 7 && LinkedList_size(llb) == 3, "\nwrong sizes after LinkedList_splice in test_splice. Found: %zu & %zu, expected: 7 & 3", LinkedList_size(lla), LinkedList_size(llb));
+    long expected_a[] = {0, 1, 6, 7, 2, 3, 4};
+    long expected_b[] = {5, 8, 9};
+    for (size_t i = 0; i < 7; i++) {
+        ASSERT(*(long*)LinkedList_get(lla, i) == expected_a[i], "\nwrong element at %zu after LinkedList_splice in test_splice. Found: %ld, expected: %ld", i, *(long*)LinkedList_get(lla, i), expected_a[i]);
+    }
+    for (size_t i = 0; i < 3; i++) {
+        ASSERT(*(long*)LinkedList_get(llb, i) == expected_b[i], "\nwrong element at %zu after LinkedList_splice in test_splice. Found: %ld, expected: %ld", i, *(long*)LinkedList_get(llb, i), expected_b[i]);
+    }
+    LinkedList_split_at(lla, pos, llb);
+    ASSERT(LinkedList_size(lla) == 4 && LinkedList_size(llb) == 6, "\nwrong sizes after LinkedList_split_at in test_splice. Found: %zu & %zu, expected: 4 & 6", LinkedList_size(lla), LinkedList_size(llb));
+    ASSERT(*(long*)LinkedList_peek_back(llb) == 4, "\nwrong back element after LinkedList_split_at in test_splice. Found: %ld, expected: 4", *(long*)LinkedList_peek_back(llb));
+    LinkedList_del(lla);
+    LinkedList_del(llb);
+
+    // DblLinkedList with cursors to locate the nodes and a reversed source
+    DblLinkedList * dlla = DblLinkedList_new(0, 0);
+    DblLinkedList * dllb = DblLinkedList_new(0, 0);
+    for (size_t i = 0; i < 5; i++) {
+        DblLinkedList_push_back(dlla, &arr[i]);
+        DblLinkedList_push_front(dllb, &arr[i+5]);
+    }
+    DblLinkedList_reverse(dllb); // {5, 6, 7, 8, 9}
+    DblLinkedListCursor cfirst, clast, cpos;
+    DblLinkedListCursor_init(&cfirst, dllb, 1);
+    DblLinkedListCursor_init(&clast, dllb, 3);
+    DblLinkedListCursor_init(&cpos, dlla, 2);
+    DblLinkedList_splice(dlla, cpos.node, dllb, cfirst.node, clast.node);
+    check_contents(dlla, expected_a, 7, "test_splice after DblLinkedList_splice");
+    check_contents(dllb, expected_b, 3, "test_splice after DblLinkedList_splice");
+
+    // move within the same list: {6, 7} to the back
+    DblLinkedList_splice_n(dlla, NULL, dlla, cfirst.node, cpos.node, 2);
+    check_contents(dlla, (long[]){0, 1, 2, 3, 4, 6, 7}, 7, "test_splice after DblLinkedList_splice_n in the same list");
+
+    DblLinkedList_split_at(dlla, cpos.node, dllb);
+    check_contents(dlla, (long[]){0, 1}, 2, "test_splice after DblLinkedList_split_at");
+    check_contents(dllb, (long[]){5, 8, 9, 2, 3, 4, 6, 7}, 8, "test_splice after DblLinkedList_split_at");
+    DblLinkedList_reverse(dllb);
+    check_contents(dllb, (long[]){7, 6, 4, 3, 2, 9, 8, 5}, 8, "test_splice after reversing the split list");
+
+    DblLinkedList_del(dlla);
+    DblLinkedList_del(dllb);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_next_n(void) {
+    printf("Testing LinkedListIterator_next_n & DblLinkedListIterator_next_n...");
+    void * buf[4];
+    LinkedList * ll = LinkedList_new(0, 0);
+    DblLinkedList * dll = DblLinkedList_new(0, 0);
+    for (size_t i = 0; i < nrecords; i++) {
+        LinkedList_push_back(ll, &records[i]);
+        DblLinkedList_push_back(dll, &records[i]);
+    }
+
+    for (size_t batch = 1; batch <= 4; batch++) {
+        LinkedListIterator ll_iter;
+        LinkedListIterator_init(&ll_iter, ll);
+        size_t i = 0, n;
+        do {
+            n = LinkedListIterator_next_n(&ll_iter, buf, batch);
+            for (size_t j = 0; j < n; j++, i++) {
+                ASSERT(buf[j] == &records[i], "\nfound wrong element %zu from LinkedList in test_next_n", i);
+            }
+        } while (n == batch);
+        ASSERT(i == nrecords && LinkedListIterator_stop(&ll_iter) == ITERATOR_STOP, "\nfound wrong number of elements from LinkedList in test_next_n. Found: %zu, expected: %zu", i, nrecords);
+
+        for (int reversed = 0; reversed < 2; reversed++) {
+            DblLinkedListIterator dll_iter;
+            DblLinkedListIterator_init(&dll_iter, dll);
+            DblLinkedListIterator_next(&dll_iter); // mixed with next
+            i = 1;
+            do {
+                n = DblLinkedListIterator_next_n(&dll_iter, buf, batch);
+                for (size_t j = 0; j < n; j++, i++) {
+                    ASSERT(buf[j] == &records[reversed ? nrecords - 1 - i : i], "\nfound wrong element %zu from DblLinkedList in test_next_n", i);
+                }
+            } while (n == batch);
+            ASSERT(i == nrecords && DblLinkedListIterator_stop(&dll_iter) == ITERATOR_STOP, "\nfound wrong number of elements from DblLinkedList in test_next_n. Found: %zu, expected: %zu", i, nrecords);
+            DblLinkedList_reverse(dll);
+        }
+    }
+
+    LinkedList_del(ll);
+    DblLinkedList_del(dll);
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_advance(void) {
+    printf("Testing LinkedListIterator_advance, DblLinkedListIterator_advance & slice_iterator...");
+    LinkedList * ll = LinkedList_new(0, 0);
+    DblLinkedList * dll = DblLinkedList_new(0, 0);
+    for (size_t i = 0; i < nrecords; i++) {
+        LinkedList_push_back(ll, &records[i]);
+        DblLinkedList_push_back(dll, &records[i]);
+    }
+
+    for (size_t k = 0; k <= nrecords; k++) {
+        size_t expected = k < nrecords - 1 ? k : nrecords - 1; // one element taken by next
+        LinkedListIterator ll_iter;
+        LinkedListIterator_init(&ll_iter, ll);
+        ASSERT(LinkedListIterator_size_hint(&ll_iter) == nrecords, "\nfound wrong size_hint of new LinkedListIterator in test_advance");
+        LinkedListIterator_next(&ll_iter);
+        ASSERT(LinkedListIterator_size_hint(&ll_iter) == nrecords - 1, "\nfound wrong size_hint of started LinkedListIterator in test_advance");
+        size_t skipped = LinkedListIterator_advance(&ll_iter, k);
+        ASSERT(skipped == expected, "\nfound wrong number of skipped elements from LinkedList in test_advance. Found: %zu, expected: %zu", skipped, expected);
+        void * next = LinkedListIterator_next(&ll_iter);
+        if (1 + k < nrecords) {
+            ASSERT(next == &records[1 + k], "\nfound wrong element after advancing %zu in LinkedList in test_advance", k);
+        } else {
+            ASSERT(!next && LinkedListIterator_stop(&ll_iter) == ITERATOR_STOP, "\nfound element past the end after advancing %zu in LinkedList in test_advance", k);
+        }
+
+        LinkedListIterator_init(&ll_iter, ll);
+        skipped = LinkedListIterator_advance(&ll_iter, k);
+        ASSERT(skipped == k, "\nfound wrong number of skipped elements from new LinkedListIterator in test_advance. Found: %zu, expected: %zu", skipped, k);
+
+        for (int reversed = 0; reversed < 2; reversed++) {
+            DblLinkedListIterator dll_iter;
+            DblLinkedListIterator_init(&dll_iter, dll);
+            DblLinkedListIterator_next(&dll_iter);
+            skipped = DblLinkedListIterator_advance(&dll_iter, k);
+            ASSERT(skipped == expected, "\nfound wrong number of skipped elements from DblLinkedList in test_advance. Found: %zu, expected: %zu", skipped, expected);
+            next = DblLinkedListIterator_next(&dll_iter);
+            if (1 + k < nrecords) {
+                ASSERT(next == &records[reversed ? nrecords - 2 - k : 1 + k], "\nfound wrong element after advancing %zu in DblLinkedList in test_advance", k);
+            } else {
+                ASSERT(!next && DblLinkedListIterator_stop(&dll_iter) == ITERATOR_STOP, "\nfound element past the end after advancing %zu in DblLinkedList in test_advance", k);
+            }
+            DblLinkedList_reverse(dll);
+        }
+    }
+
+    Slice sl;
+    slice_iterator(&sl, DblLinkedList, dll, 2, 11, 3);
+    size_t i = 2;
+    for (Record * r = Slice_next(&sl); Slice_stop(&sl) != ITERATOR_STOP; r = Slice_next(&sl)) {
+        ASSERT(r == &records[i], "\nfound wrong element %zu in slice of DblLinkedList in test_advance", i);
+        i += 3;
+    }
+    ASSERT(i == 11, "\nfound wrong number of elements in slice of DblLinkedList in test_advance. Found: %zu, expected: 3", (i - 2) / 3);
+
+    Slice lsl;
+    slice_iterator(&lsl, LinkedList, ll, -4, nrecords, 1);
+    i = nrecords - 4;
+    for_each(Record, r, Slice, &lsl) {
+        ASSERT(r == &records[i], "\nfound wrong element %zu in slice of LinkedList in test_advance", i);
+        i++;
+    }
+    ASSERT(i == nrecords, "\nfound wrong number of elements in slice of LinkedList in test_advance. Found: %zu, expected: 4", i - (nrecords - 4));
+    Slice lsl_adv;
+    slice_iterator(&lsl_adv, LinkedList, ll, -4, nrecords, 1);
+    Slice_advance(&lsl_adv, 2);
+    ASSERT(Slice_next(&lsl_adv) == &records[nrecords - 2], "\nfound wrong element after advancing slice of LinkedList in test_advance");
+
+    LinkedList_del(ll);
+    DblLinkedList_del(dll);
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int main(void) {
+    test_linked_list_sort();
+    test_dbl_linked_list_sort();
+    test_cursor();
+    test_splice();
+    test_next_n();
+    test_advance();
+    return 0;
+}
@@ -0,0 +1,279 @@
+#include <stddef.h>
+#include <stdio.h>
+#include "cl_core.h"
+#include "cl_hybrid_dbl_linked_list.h"
+
+#define TEST_BLOCK_SIZE 4
+
+static void test_hybrid_init(HybridDblLinkedList * hdll) {
+    NodeAttributes * NA = NodeAttributes_new(Node_flag(VALUE) | Node_flag(NEXT) | Node_flag(PREV) | Node_flag(SIZE), 0);
+    HybridDblLinkedList_init(hdll, NA, TEST_BLOCK_SIZE);
+}
+
+static void test_hybrid_clear(HybridDblLinkedList * hdll) {
+    while (HybridDblLinkedList_size(hdll)) {
+        HybridDblLinkedList_pop_front(hdll);
+    }
+    NodeAttributes_del(hdll->dll.ll.NA);
+}
+
+int test_iterator(void) {
+    printf("Testing HybridDblLinkedListIterator...");
+    long arr[] = {123456, 234567, 345678, 456789, 567890, 2039784, 1230987, 493583, 1843985, 42, 7};
+    size_t arr_size = sizeof(arr)/sizeof(arr[0]);
+
+    HybridDblLinkedList hdll;
+    test_hybrid_init(&hdll);
+
+    size_t i = 0;
+    for_each(long, el, HybridDblLinkedList, &hdll) {
+        (void) el;
+        i++;
+    }
+    ASSERT(i == 0, "\nfound elements in empty HybridDblLinkedList in test_iterator. Found: %zu, expected: 0", i);
+
+    for (i = 0; i < arr_size; i++) {
+        HybridDblLinkedList_push_back(&hdll, &arr[i]);
+    }
+    ASSERT(HybridDblLinkedList_size(&hdll) == arr_size, "\nfailed to push back all elements in test_iterator. Found: %zu, expected: %zu", HybridDblLinkedList_size(&hdll), arr_size);
+
+    i = 0;
+    for_each(long, val, HybridDblLinkedList, &hdll) {
+        ASSERT(i < arr_size, "\nfound too many elements in test_iterator. Found: %zu, expected: %zu", i, arr_size);
+        ASSERT(*val == arr[i], "\nfailed to retrieve the %zu-th element in test_iterator. Found: %ld, expected: %ld", i, *val, arr[i]);
+        i++;
+    }
+    ASSERT(i == arr_size, "\nfailed to iterate over all elements in test_iterator. Found: %zu, expected: %zu", i, arr_size);
+
+    HybridDblLinkedList_reverse(&hdll);
+    i = arr_size;
+    for_each(long, rval, HybridDblLinkedList, &hdll) {
+        ASSERT(i > 0, "\nfound too many elements in reversed test_iterator");
+        i--;
+        ASSERT(*rval == arr[i], "\nfailed to retrieve the %zu-th element in reversed test_iterator. Found: %ld, expected: %ld", i, *rval, arr[i]);
+    }
+    ASSERT(i == 0, "\nfailed to iterate over all elements in reversed test_iterator. %zu remaining", i);
+    HybridDblLinkedList_reverse(&hdll);
+
+    test_hybrid_clear(&hdll);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_next_n(void) {
+    printf("Testing HybridDblLinkedListIterator_next_n...");
+    long arr[] = {123456, 234567, 345678, 456789, 567890, 2039784, 1230987, 493583, 1843985, 42, 7};
+    size_t arr_size = sizeof(arr)/sizeof(arr[0]);
+    void * buf[2*TEST_BLOCK_SIZE+1];
+
+    HybridDblLinkedList hdll;
+    test_hybrid_init(&hdll);
+    for (size_t i = 0; i < arr_size; i++) {
+        HybridDblLinkedList_push_back(&hdll, &arr[i]);
+    }
+    HybridDblLinkedList_remove(&hdll, 5); // leave a partially filled block in the middle
+    HybridDblLinkedList_insert(&hdll, 5, &arr[5]);
+
+    for (int reversed = 0; reversed < 2; reversed++) {
+        for (size_t batch = 1; batch <= 2*TEST_BLOCK_SIZE+1; batch++) {
+            HybridDblLinkedListIterator hdll_iter;
+            HybridDblLinkedListIterator_init(&hdll_iter, &hdll);
+            size_t i = 0, n;
+            do {
+                n = HybridDblLinkedListIterator_next_n(&hdll_iter, buf, batch);
+                for (size_t j = 0; j < n; j++, i++) {
+                    long expected = reversed ? arr[arr_size - 1 - i] : arr[i];
+                    ASSERT(*(long*)buf[j] == expected, "\nfound wrong element %zu in test_next_n. Found: %ld, expected: %ld", i, *(long*)buf[j], expected);
+                }
+            } while (n == batch);
+            ASSERT(i == arr_size, "\nfound wrong number of elements in test_next_n. Found: %zu, expected: %zu", i, arr_size);
+            ASSERT(HybridDblLinkedListIterator_stop(&hdll_iter) == ITERATOR_STOP, "\nfound iterator not stopped after short batch in test_next_n");
+        }
+        HybridDblLinkedList_reverse(&hdll);
+    }
+
+    HybridDblLinkedListIterator hdll_iter;
+    HybridDblLinkedListIterator_init(&hdll_iter, &hdll);
+    long * l = HybridDblLinkedListIterator_next(&hdll_iter);
+    size_t n = HybridDblLinkedListIterator_next_n(&hdll_iter, buf, 5);
+    ASSERT(*l == arr[0] && n == 5 && *(long*)buf[0] == arr[1] && *(long*)buf[4] == arr[5], "\nfound wrong elements mixing next and next_n in test_next_n");
+    l = HybridDblLinkedListIterator_next(&hdll_iter);
+    ASSERT(*l == arr[6], "\nfound wrong element after next_n in test_next_n. Found: %ld, expected: %ld", *l, arr[6]);
+
+    test_hybrid_clear(&hdll);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_block_iterator(void) {
+    printf("Testing HybridDblLinkedListBlockIterator...");
+    long arr[] = {123456, 234567, 345678, 456789, 567890, 2039784, 1230987, 493583, 1843985, 42, 7};
+    size_t arr_size = sizeof(arr)/sizeof(arr[0]);
+
+    HybridDblLinkedList hdll;
+    test_hybrid_init(&hdll);
+    for (size_t i = 0; i < arr_size; i++) {
+        HybridDblLinkedList_push_back(&hdll, &arr[i]);
+    }
+
+    size_t i = 0;
+    size_t nblocks = 0;
+    for_each(HybridDblLinkedListBlock, blk, HybridDblLinkedListBlock, &hdll) {
+        ASSERT(blk->size && blk->size <= TEST_BLOCK_SIZE, "\nfound a block with invalid size in test_block_iterator. Found: %zu", blk->size);
+        ASSERT(!blk->reversed, "\nfound a reversed block in a forward HybridDblLinkedList in test_block_iterator");
+        for (size_t j = 0; j < blk->size; j++, i++) {
+            ASSERT(*(long*)blk->arr[j] == arr[i], "\nfailed to retrieve the %zu-th element from blocks in test_block_iterator. Found: %ld, expected: %ld", i, *(long*)blk->arr[j], arr[i]);
+        }
+        nblocks++;
+    }
+    ASSERT(i == arr_size, "\nfailed to iterate over all elements in test_block_iterator. Found: %zu, expected: %zu", i, arr_size);
+    ASSERT(nblocks == (arr_size + TEST_BLOCK_SIZE - 1) / TEST_BLOCK_SIZE, "\nfailed to find the expected number of blocks in test_block_iterator. Found: %zu, expected: %zu", nblocks, (arr_size + TEST_BLOCK_SIZE - 1) / TEST_BLOCK_SIZE);
+
+    HybridDblLinkedList_reverse(&hdll);
+    i = arr_size;
+    for_each(HybridDblLinkedListBlock, rblk, HybridDblLinkedListBlock, &hdll) {
+        ASSERT(rblk->reversed, "\nfound a forward block in a reversed HybridDblLinkedList in test_block_iterator");
+        for (size_t j = rblk->size; j > 0; j--) {
+            i--;
+            ASSERT(*(long*)rblk->arr[j-1] == arr[i], "\nfailed to retrieve the %zu-th element from reversed blocks in test_block_iterator. Found: %ld, expected: %ld", i, *(long*)rblk->arr[j-1], arr[i]);
+        }
+    }
+    ASSERT(i == 0, "\nfailed to iterate over all elements in reversed test_block_iterator. %zu remaining", i);
+    HybridDblLinkedList_reverse(&hdll);
+
+    test_hybrid_clear(&hdll);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int long_comp(void * a, void * b) {
+    return (*(long*)a > *(long*)b) - (*(long*)a < *(long*)b);
+}
+
+int test_sort(void) {
+    printf("Testing HybridDblLinkedList_sort...");
+    long arr[] = {567890, 42, 2039784, 123456, 7, 493583, 1843985, 234567, 42, 1230987, 345678};
+    size_t arr_size = sizeof(arr)/sizeof(arr[0]);
+
+    HybridDblLinkedList hdll;
+    test_hybrid_init(&hdll);
+    for (size_t i = 0; i < arr_size; i++) {
+        HybridDblLinkedList_push_back(&hdll, &arr[i]);
+    }
+
+    for (int pass = 0; pass < 2; pass++) { // second pass sorts a reversed list
+        HybridDblLinkedList_sort(&hdll, long_comp);
+        ASSERT(HybridDblLinkedList_size(&hdll) == arr_size, "\nsize changed after sorting in test_sort. Found: %zu, expected: %zu", HybridDblLinkedList_size(&hdll), arr_size);
+        long last = 0;
+        for_each(long, val, HybridDblLinkedList, &hdll) {
+            ASSERT(*val >= last, "\nfound out of order elements after sorting in test_sort. Found: %ld after %ld", *val, last);
+            last = *val;
+        }
+        HybridDblLinkedList_reverse(&hdll);
+    }
+
+    test_hybrid_clear(&hdll);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+static void check_hybrid_contents(HybridDblLinkedList * hdll, long * expected, size_t n, char * test_name) {
+    ASSERT(HybridDblLinkedList_size(hdll) == n, "\nwrong size in %s. Found: %zu, expected: %zu", test_name, HybridDblLinkedList_size(hdll), n);
+    size_t i = 0;
+    for_each(long, val, HybridDblLinkedList, hdll) {
+        ASSERT(*val == expected[i], "\nwrong element at index %zu in %s. Found: %ld, expected: %ld", i, test_name, *val, expected[i]);
+        i++;
+    }
+    ASSERT(i == n, "\nfailed to iterate over all elements in %s. Found: %zu, expected: %zu", test_name, i, n);
+    for (i = 0; i < n; i++) {
+        long retrieved = *(long*)HybridDblLinkedList_get(hdll, i);
+        ASSERT(retrieved == expected[i], "\nwrong element from get at index %zu in %s. Found: %ld, expected: %ld", i, test_name, retrieved, expected[i]);
+    }
+}
+
+int test_splice(void) {
+    printf("Testing HybridDblLinkedList_splice & HybridDblLinkedList_split_at...");
+    long arr[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+
+    HybridDblLinkedList a, b;
+    test_hybrid_init(&a);
+    test_hybrid_init(&b);
+    for (size_t i = 0; i < 10; i++) {
+        HybridDblLinkedList_push_back(&a, &arr[i]);
+        HybridDblLinkedList_push_front(&b, &arr[19-i]);
+    }
+    HybridDblLinkedList_reverse(&b);
+    HybridDblLinkedList_reverse(&b); // physical order differs from a list built only with push_back
+
+    // block boundaries at 4 are split at 3, 9 and 6
+    HybridDblLinkedList_splice(&a, 6, &b, 3, 9);
+    check_hybrid_contents(&a, (long[]){0, 1, 2, 3, 4, 5, 13, 14, 15, 16, 17, 18, 6, 7, 8, 9}, 16, "test_splice after HybridDblLinkedList_splice");
+    check_hybrid_contents(&b, (long[]){10, 11, 12, 19}, 4, "test_splice after HybridDblLinkedList_splice");
+
+    // insertion after splicing must still find space in the partial blocks
+    HybridDblLinkedList_insert(&a, 6, &arr[19]);
+    HybridDblLinkedList_remove(&a, 6);
+
+    HybridDblLinkedList_reverse(&a);
+    HybridDblLinkedList_split_at(&a, 10, &b);
+    check_hybrid_contents(&a, (long[]){9, 8, 7, 6, 18, 17, 16, 15, 14, 13}, 10, "test_splice after HybridDblLinkedList_split_at of reversed list");
+    check_hybrid_contents(&b, (long[]){10, 11, 12, 19, 5, 4, 3, 2, 1, 0}, 10, "test_splice after HybridDblLinkedList_split_at of reversed list");
+
+    test_hybrid_clear(&a);
+    test_hybrid_clear(&b);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_advance(void) {
+    printf("Testing HybridDblLinkedListIterator_advance...");
+    long arr[] = {123456, 234567, 345678, 456789, 567890, 2039784, 1230987, 493583, 1843985, 42, 7};
+    size_t arr_size = sizeof(arr)/sizeof(arr[0]);
+
+    HybridDblLinkedList hdll;
+    test_hybrid_init(&hdll);
+    for (size_t i = 0; i < arr_size; i++) {
+        HybridDblLinkedList_push_back(&hdll, &arr[i]);
+    }
+
+    for (int reversed = 0; reversed < 2; reversed++) {
+        for (size_t first = 0; first < 3; first++) { // elements taken by next before advancing
+            for (size_t k = 0; k <= arr_size; k++) {
+                HybridDblLinkedListIterator hdll_iter;
+                HybridDblLinkedListIterator_init(&hdll_iter, &hdll);
+                for (size_t i = 0; i < first; i++) {
+                    HybridDblLinkedListIterator_next(&hdll_iter);
+                }
+                size_t expected = first + k < arr_size ? k : arr_size - first;
+                size_t skipped = HybridDblLinkedListIterator_advance(&hdll_iter, k);
+                ASSERT(skipped == expected, "\nfound wrong number of skipped elements in test_advance. Found: %zu, expected: %zu", skipped, expected);
+                size_t i = first + k;
+                for (long * val = HybridDblLinkedListIterator_next(&hdll_iter); HybridDblLinkedListIterator_stop(&hdll_iter) != ITERATOR_STOP; val = HybridDblLinkedListIterator_next(&hdll_iter), i++) {
+                    long exp = arr[reversed ? arr_size - 1 - i : i];
+                    ASSERT(*val == exp, "\nfound wrong element %zu after advancing %zu from %zu in test_advance. Found: %ld, expected: %ld", i, k, first, *val, exp);
+                }
+                ASSERT(i >= arr_size, "\nfound wrong number of elements after advancing %zu from %zu in test_advance. Found: %zu, expected: %zu", k, first, i, arr_size);
+            }
+        }
+        HybridDblLinkedList_reverse(&hdll);
+    }
+
+    test_hybrid_clear(&hdll);
+    printf("PASS\n");
+    return 0;
+}
+
+int main(void) {
+    test_iterator();
+    test_next_n();
+    test_advance();
+    test_block_iterator();
+    test_sort();
+    test_splice();
+    return 0;
+}
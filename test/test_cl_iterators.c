@@ -224,6 +224,71 @@ int test_array_comprehension(void) {
     return CL_SUCCESS;
 }
 
+int test_sized_array_comprehension(void) {
+    printf("Testing sized array comprehension...");
+    long arr[] = {123456, 234567, 345678, 456789, 567890, 2039784, 1230987, 493583, 1843985};
+    long div2arr[] = {123456, 345678, 567890, 2039784};
+    size_t N = 9, div2arr_size = 4;
+
+    longIterator liter;
+    longIterator_init(&liter, arr, N);
+    for (size_t i = 0; i <= N; i++) {
+        ASSERT(longIterator_size_hint(&liter) == N - i, "\nfound wrong size_hint of longIterator after %zu elements in test_sized_array_comprehension. Found: %zu, expected: %zu", i, longIterator_size_hint(&liter), N - i);
+        longIterator_next(&liter);
+    }
+    ASSERT(longIterator_size_hint(&liter) == 0, "\nfound non-zero size_hint of stopped longIterator in test_sized_array_comprehension");
+
+    // exact hint, a single allocation
+    sized_array_comprehension(long, copy, COPY_ELEMENT, long, long, arr, N);
+    ASSERT(copy_capacity == N, "\nfailed at comparing size of copy. Found: %zu, expected: %zu", copy_capacity, N);
+    for (size_t i = 0; i < N; i++) {
+        ASSERT(copy[i] == arr[i], "\nfailed in copy at index %zu. Found: %ld, expected: %ld", i, copy[i], arr[i]);
+    }
+    CL_FREE(copy);
+
+    Slice sl;
+    slice(&sl, long, arr, N, 1, N, 2);
+    ASSERT(Slice_size_hint(&sl) == 4, "\nfound wrong size_hint of Slice in test_sized_array_comprehension. Found: %zu, expected: 4", Slice_size_hint(&sl));
+    sized_array_comprehension(long, odd, COPY_ELEMENT, long, Slice, &sl);
+    ASSERT(odd_capacity == 4, "\nfailed at comparing size of slice copy. Found: %zu, expected: 4", odd_capacity);
+    for (size_t i = 0; i < odd_capacity; i++) {
+        ASSERT(odd[i] == arr[2*i + 1], "\nfailed in slice copy at index %zu. Found: %ld, expected: %ld", i, odd[i], arr[2*i + 1]);
+    }
+    CL_FREE(odd);
+
+    // a Filter bounds its output by the hint of the filtered iterator and shrinks once at the end
+    for (int hinted = 0; hinted < 2; hinted++) {
+        Filter div2;
+        filter(&div2, long_divisible_by_2, long, arr, N);
+        if (hinted) {
+            Iterator_set_size_hint((Iterator*) &div2, (size_t (*)(void*)) longIterator_size_hint);
+        }
+        ASSERT(Filter_size_hint(&div2) == (hinted ? N : ITERATOR_SIZE_UNKNOWN), "\nfound wrong size_hint of Filter in test_sized_array_comprehension");
+        sized_array_comprehension(long, new_arr, COPY_ELEMENT, long, Filter, &div2);
+        ASSERT(new_arr_capacity == div2arr_size, "\nfailed at comparing size of filtered array. Found: %zu, expected: %zu", new_arr_capacity, div2arr_size);
+        for (size_t i = 0; i < new_arr_capacity; i++) {
+            ASSERT(new_arr[i] == div2arr[i], "\nfailed in filtered array at index %zu. Found: %ld, expected: %ld", i, new_arr[i], div2arr[i]);
+        }
+        CL_FREE(new_arr);
+    }
+
+    // caller-provided buffers
+    long buf[16];
+    Filter div2;
+    filter(&div2, long_divisible_by_2, long, arr, N);
+    array_comprehension_into(long, buf, 16, nbuf, COPY_ELEMENT, long, Filter, &div2);
+    ASSERT(nbuf == div2arr_size, "\nfound wrong number of elements written to buffer. Found: %zu, expected: %zu", nbuf, div2arr_size);
+    for (size_t i = 0; i < nbuf; i++) {
+        ASSERT(buf[i] == div2arr[i], "\nfailed in buffer at index %zu. Found: %ld, expected: %ld", i, buf[i], div2arr[i]);
+    }
+    long small[3];
+    array_comprehension_into(long, small, 3, nsmall, COPY_ELEMENT, long, long, arr, N);
+    ASSERT(nsmall == 3 && small[0] == arr[0] && small[2] == arr[2], "\nfailed to fill a buffer smaller than the input. Found %zu elements", nsmall);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
 int test_array_clear(void) {
     printf("Testing clearing array of pointers...");
     pvoid* arr = (pvoid*) CL_MALLOC(sizeof(pvoid) * 10);
@@ -341,12 +406,482 @@ int test_array_iterator(void) {
     return CL_SUCCESS;
 }
 
+// drains iter in batches of batch, checking the elements against arr
+static size_t drain_next_n(void * iter, size_t (*next_n)(void*, void**, size_t), size_t batch, long * arr) {
+    void * buf[8];
+    size_t i = 0, n;
+    do {
+        n = next_n(iter, buf, batch);
+        for (size_t j = 0; j < n; j++, i++) {
+            ASSERT(*(long*)buf[j] == arr[i], "\nfound wrong element %zu in test_next_n. Found: %ld, expected: %ld", i, *(long*)buf[j], arr[i]);
+        }
+    } while (n == batch);
+    ASSERT(Iterator_stop((Iterator*)iter) == ITERATOR_STOP, "\nfound iterator not stopped after a short batch in test_next_n");
+    return i;
+}
+
+int test_next_n(void) {
+    printf("Testing batched next_n...");
+    long arr[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
+    size_t N = sizeof(arr)/sizeof(arr[0]);
+    long div2arr[] = {0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20};
+    size_t div2arr_size = 11;
+
+    for (size_t batch = 1; batch <= 8; batch++) {
+        // native
+        Iterator iter;
+        iterate_batched(&iter, long, arr, N);
+        size_t n = drain_next_n(&iter, (size_t (*)(void*, void**, size_t))Iterator_next_n, batch, arr);
+        ASSERT(n == N, "\nfound wrong number of elements from batched array iterator in test_next_n. Found: %zu, expected: %zu", n, N);
+
+        // fallback through next and stop
+        Iterator fiter;
+        iterate(&fiter, long, arr, N);
+        n = drain_next_n(&fiter, (size_t (*)(void*, void**, size_t))Iterator_next_n, batch, arr);
+        ASSERT(n == N, "\nfound wrong number of elements from fallback iterator in test_next_n. Found: %zu, expected: %zu", n, N);
+
+        Filter div2;
+        filter_batched(&div2, long_divisible_by_2, long, arr, N);
+        n = drain_next_n(&div2, (size_t (*)(void*, void**, size_t))Filter_next_n, batch, div2arr);
+        ASSERT(n == div2arr_size, "\nfound wrong number of elements from batched filter in test_next_n. Found: %zu, expected: %zu", n, div2arr_size);
+
+        Filter div7;
+        filter(&div7, long_divisible_by_7, long, arr, N);
+        void * buf[8];
+        n = Filter_next_n(&div7, buf, batch);
+        ASSERT(n == batch || n == 3, "\nfound wrong number of elements divisible by 7 in test_next_n. Found: %zu", n);
+        ASSERT(*(long*)buf[n-1] == 7 * (long)(n-1), "\nfound wrong last element divisible by 7 in test_next_n. Found: %ld, expected: %ld", *(long*)buf[n-1], 7 * (long)(n-1));
+
+        Slice sl;
+        slice(&sl, long, arr, N, 1, N, 3);
+        size_t i = 0;
+        do {
+            n = Slice_next_n(&sl, buf, batch);
+            for (size_t j = 0; j < n; j++, i++) {
+                ASSERT(*(long*)buf[j] == arr[1 + 3*i], "\nfound wrong element %zu from batched slice in test_next_n. Found: %ld, expected: %ld", i, *(long*)buf[j], arr[1 + 3*i]);
+            }
+        } while (n == batch);
+        ASSERT(i == 7, "\nfound wrong number of elements from batched slice in test_next_n. Found: %zu, expected: %d", i, 7);
+    }
+
+    // mixing next and next_n
+    longIterator liter;
+    longIterator_init(&liter, arr, N);
+    long * lbuf[4];
+    long * l = longIterator_next(&liter);
+    size_t n = longIterator_next_n(&liter, lbuf, 4);
+    ASSERT(*l == 0 && n == 4 && *lbuf[0] == 1 && *lbuf[3] == 4, "\nfound wrong elements mixing next and next_n in test_next_n");
+    l = longIterator_next(&liter);
+    ASSERT(*l == 5, "\nfound wrong element after next_n in test_next_n. Found: %ld, expected: %d", *l, 5);
+    ASSERT(longIterator_next_n(&liter, lbuf, 0) == 0 && longIterator_stop(&liter) == ITERATOR_GO, "\nfound state change on empty batch in test_next_n");
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+static long squares[21];
+void * long_square(void * pl) {
+    long l = *(long*)pl;
+    squares[l] = l * l;
+    return &squares[l];
+}
+bool long_less_than_100(void * pl) {
+    return *(long*)pl < 100;
+}
+bool long_less_than_5(void * pl) {
+    return *(long*)pl < 5;
+}
+
+int test_pipeline(void) {
+    printf("Testing Pipeline...");
+    long arr[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
+    size_t N = sizeof(arr)/sizeof(arr[0]);
+    // drop_while(< 5), skip 1, filter(even), map(square), take_while(< 100), take(3)
+    long expected[] = {36, 64};
+    size_t nexpected = 2;
+    long expected_take[] = {36, 64, 100};
+    void * buf[8];
+
+    Pipeline pl;
+    pipeline(&pl, long, arr, N);
+    ASSERT(Pipeline_drop_while(&pl, long_less_than_5) == CL_SUCCESS, "\nfailed to add drop_while stage in test_pipeline");
+    Pipeline_skip(&pl, 1);
+    Pipeline_filter(&pl, long_divisible_by_2);
+    Pipeline_map(&pl, long_square);
+    PipelineIterator copy;
+    PipelineIterator_init(&copy, &pl);
+    Pipeline_take_while(&pl, long_less_than_100);
+    Pipeline_take(&pl, 3);
+    size_t i = 0;
+    for_each(long, l, Pipeline, &pl) {
+        ASSERT(i < nexpected, "\nfound too many elements in test_pipeline. Found: %zu, expected: %zu", i + 1, nexpected);
+        ASSERT(*l == expected[i], "\nfound wrong element %zu in test_pipeline. Found: %ld, expected: %ld", i, *l, expected[i]);
+        i++;
+    }
+    ASSERT(i == nexpected, "\nfound wrong number of elements in test_pipeline. Found: %zu, expected: %zu", i, nexpected);
+    // for_each iterates over a copy sharing the source, which is now exhausted
+    ASSERT(!Pipeline_next(&pl) && Pipeline_map(&pl, long_square) == CL_FAILURE, "\nfailed to reject adding a stage after iteration in test_pipeline");
+
+    // same stages without take_while, batched with take stopping mid-batch
+    for (size_t batch = 1; batch <= 8; batch++) {
+        Pipeline bpl;
+        pipeline_batched(&bpl, long, arr, N);
+        Pipeline_drop_while(&bpl, long_less_than_5);
+        Pipeline_skip(&bpl, 1);
+        Pipeline_filter(&bpl, long_divisible_by_2);
+        Pipeline_map(&bpl, long_square);
+        Pipeline_take(&bpl, 3);
+        size_t n;
+        i = 0;
+        do {
+            n = Pipeline_next_n(&bpl, buf, batch);
+            for (size_t j = 0; j < n; j++, i++) {
+                ASSERT(i < 3 && *(long*)buf[j] == expected_take[i], "\nfound wrong element %zu from batched pipeline in test_pipeline", i);
+            }
+        } while (n == batch);
+        ASSERT(i == 3 && Pipeline_stop(&bpl) == ITERATOR_STOP, "\nfound wrong number of elements from batched pipeline in test_pipeline. Found: %zu, expected: %d", i, 3);
+    }
+
+    // the copy was made before take_while and take were added
+    ASSERT(copy.nstages == 4 && pl.nstages == 6, "\nfound wrong number of stages in copied pipeline in test_pipeline. Found: %u, expected: %d", copy.nstages, 4);
+
+    // pipelines are iterable and can be stacked with the other adaptors
+    Pipeline inner;
+    pipeline(&inner, long, arr, N);
+    Pipeline_take(&inner, 10);
+    Filter outer;
+    filter(&outer, long_divisible_by_3, Pipeline, &inner);
+    i = 0;
+    for_each(long, l3, Filter, &outer) {
+        ASSERT(*l3 == 3 * (long)i, "\nfound wrong element from filtered pipeline in test_pipeline. Found: %ld, expected: %ld", *l3, 3 * (long)i);
+        i++;
+    }
+    ASSERT(i == 4, "\nfound wrong number of elements from filtered pipeline in test_pipeline. Found: %zu, expected: %d", i, 4);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_zip_chain(void) {
+    printf("Testing Zip & Chain...");
+    long larr[] = {0, 1, 2, 3, 4, 5, 6};
+    char carr[] = "abcd";
+    Iterator iters[2];
+    iterate(&iters[0], long, larr, 7);
+    iterate(&iters[1], char, carr, 4);
+    void * items[2];
+    size_t i = 0;
+    Zip zip;
+    Zip_init(&zip, iters, items, 2);
+    for_each(void*, tpl, Zip, &zip) {
+        ASSERT(*(long*)tpl[0] == larr[i] && *(char*)tpl[1] == carr[i], "\nfound wrong items %zu in test_zip_chain", i);
+        i++;
+    }
+    ASSERT(i == 4, "\nfailed to stop with the shortest iterator in test_zip_chain. Found: %zu, expected: %d", i, 4);
+
+    long larr2[] = {7, 8, 9, 10};
+    void * buf[3];
+    for (size_t batch = 1; batch <= 3; batch++) {
+        Iterator chained[3];
+        iterate(&chained[0], long, larr, 7);
+        iterate(&chained[1], long, larr, 0);
+        iterate_batched(&chained[2], long, larr2, 4);
+        Chain chain;
+        Chain_init(&chain, chained, 3);
+        size_t n;
+        i = 0;
+        do {
+            n = Chain_next_n(&chain, buf, batch);
+            for (size_t j = 0; j < n; j++, i++) {
+                ASSERT(*(long*)buf[j] == (long)i, "\nfound wrong element %zu from batched chain in test_zip_chain. Found: %ld", i, *(long*)buf[j]);
+            }
+        } while (n == batch);
+        ASSERT(i == 11 && Chain_stop(&chain) == ITERATOR_STOP, "\nfound wrong number of elements from batched chain in test_zip_chain. Found: %zu, expected: %d", i, 11);
+    }
+
+    Iterator chained[2];
+    iterate(&chained[0], long, larr, 7);
+    iterate(&chained[1], long, larr2, 4);
+    i = 0;
+    Chain chain;
+    Chain_init(&chain, chained, 2);
+    for_each(long, l, Chain, &chain) {
+        ASSERT(*l == (long)i, "\nfound wrong element %zu from chain in test_zip_chain. Found: %ld", i, *l);
+        i++;
+    }
+    ASSERT(i == 11, "\nfound wrong number of elements from chain in test_zip_chain. Found: %zu, expected: %d", i, 11);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+static void check_chunks(Chunked * ch, size_t size, long * arr, size_t N) {
+    size_t i = 0, nchunks = 0;
+    for_each(Chunk, chunk, Chunked, ch) {
+        ASSERT(chunk->size == size || (chunk->size == N % size && i + chunk->size == N), "\nfound chunk of wrong size in test_chunked. Found: %zu, expected: %zu", chunk->size, size);
+        for (size_t j = 0; j < chunk->size; j++, i++) {
+            ASSERT(*(long*)chunk->arr[j] == arr[i], "\nfound wrong element %zu in test_chunked. Found: %ld", i, *(long*)chunk->arr[j]);
+        }
+        nchunks++;
+    }
+    ASSERT(i == N && nchunks == (N + size - 1) / size, "\nfound wrong number of elements or chunks in test_chunked. Found: %zu, %zu", i, nchunks);
+}
+
+int test_chunked(void) {
+    printf("Testing Chunked...");
+    long arr[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    size_t N = sizeof(arr)/sizeof(arr[0]);
+    void * buf[4];
+    for (size_t size = 1; size <= 4; size++) {
+        Chunked ch;
+        chunked(&ch, buf, size, long, arr, N);
+        check_chunks(&ch, size, arr, N);
+        Chunked bch;
+        chunked_batched(&bch, buf, size, long, arr, N);
+        check_chunks(&bch, size, arr, N);
+    }
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_reductions(void) {
+    printf("Testing array reductions...");
+    long larr[37];
+    double darr[37];
+    size_t N = sizeof(larr)/sizeof(larr[0]);
+    long lsum = 0;
+    for (size_t i = 0; i < N; i++) {
+        larr[i] = (long) ((i * 7919) % 101) - 50; // mixed signs, no order
+        darr[i] = 0.5 * (double) larr[i];
+        lsum += larr[i];
+    }
+    for (size_t n = 0; n <= N; n++) { // every remainder of the lanes
+        long expected = 0;
+        long * lmin = n ? larr : NULL, * lmax = n ? larr : NULL;
+        for (size_t i = 0; i < n; i++) {
+            expected += larr[i];
+            if (larr[i] < *lmin) {
+                lmin = larr + i;
+            }
+            if (larr[i] > *lmax) {
+                lmax = larr + i;
+            }
+        }
+        ASSERT(long_sum(larr, n) == expected, "\nfound wrong long_sum of %zu elements in test_reductions. Found: %ld, expected: %ld", n, long_sum(larr, n), expected);
+        ASSERT(double_sum(darr, n) == 0.5 * expected, "\nfound wrong double_sum of %zu elements in test_reductions. Found: %f, expected: %f", n, double_sum(darr, n), 0.5 * expected);
+        ASSERT(long_min(larr, n) == lmin, "\nfound wrong long_min of %zu elements in test_reductions", n);
+        ASSERT(long_max(larr, n) == lmax, "\nfound wrong long_max of %zu elements in test_reductions", n);
+    }
+
+    long dot = 0;
+    for (size_t i = 0; i < N; i++) {
+        dot += larr[i] * larr[i];
+    }
+    ASSERT(long_dot(larr, larr, N) == dot, "\nfound wrong long_dot in test_reductions. Found: %ld, expected: %ld", long_dot(larr, larr, N), dot);
+
+    int iarr[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    ASSERT(int_product(iarr, 10) == 3628800, "\nfound wrong int_product in test_reductions. Found: %d, expected: 3628800", int_product(iarr, 10));
+    ASSERT(int_product(iarr, 0) == 1, "\nfound wrong empty int_product in test_reductions. Found: %d, expected: 1", int_product(iarr, 0));
+
+    // iterator versions consume the remaining elements
+    longIterator liter;
+    longIterator_init(&liter, larr, N);
+    long * first = longIterator_next(&liter);
+    ASSERT(longIterator_sum(&liter) == lsum - *first, "\nfound wrong longIterator_sum after next in test_reductions. Found: %ld, expected: %ld", longIterator_sum(&liter), lsum - *first);
+    ASSERT(longIterator_stop(&liter) == ITERATOR_STOP && !longIterator_next(&liter), "\nfailed to consume iterator in longIterator_sum in test_reductions");
+    ASSERT(longIterator_sum(&liter) == 0 && !longIterator_min(&liter), "\nfound elements in consumed iterator in test_reductions");
+
+    longIterator_init(&liter, larr, N);
+    longIterator other;
+    longIterator_split(&liter, &other, 1);
+    ASSERT(longIterator_sum(&liter) + longIterator_sum(&other) == lsum, "\nfound wrong sum of split longIterators in test_reductions");
+
+    // strided iterators fall back to a loop over the elements
+    longIterator_init(&liter, larr, N);
+    liter.step = 3;
+    long strided = 0;
+    long * smax = larr;
+    for (size_t i = 0; i < N; i += 3) {
+        strided += larr[i];
+        if (larr[i] > *smax) {
+            smax = larr + i;
+        }
+    }
+    ASSERT(longIterator_sum(&liter) == strided, "\nfound wrong strided longIterator_sum in test_reductions");
+    longIterator_init(&liter, larr, N);
+    liter.step = 3;
+    ASSERT(longIterator_max(&liter) == smax, "\nfound wrong strided longIterator_max in test_reductions");
+
+    longIterator_init(&liter, larr, N);
+    longIterator_init(&other, larr, N - 5);
+    ASSERT(longIterator_dot(&liter, &other) == long_dot(larr, larr, N - 5), "\nfound wrong longIterator_dot in test_reductions");
+
+    printf("PASS\n");
+    return 0;
+}
+
+int test_advance(void) {
+    printf("Testing advance...");
+    long arr[] = {123456, 234567, 345678, 456789, 567890, 2039784, 1230987, 493583, 1843985};
+    size_t N = sizeof(arr)/sizeof(arr[0]);
+
+    for (size_t k = 0; k <= N; k++) {
+        longIterator liter;
+        longIterator_init(&liter, arr, N);
+        size_t skipped = longIterator_advance(&liter, k);
+        ASSERT(skipped == (k < N ? k : N), "\nfound wrong number of skipped elements of new longIterator in test_advance. Found: %zu, expected: %zu", skipped, k < N ? k : N);
+        long * l = longIterator_next(&liter);
+        ASSERT(k < N ? l == arr + k : !l, "\nfound wrong element after advancing new longIterator by %zu in test_advance", k);
+        skipped = longIterator_advance(&liter, 1);
+        ASSERT(skipped == (k + 1 < N), "\nfound wrong number of skipped elements of started longIterator in test_advance");
+        l = longIterator_next(&liter);
+        ASSERT(k + 2 < N ? l == arr + k + 2 : !l, "\nfound wrong element after advancing started longIterator in test_advance");
+
+        // generic Iterator, with and without an advance function
+        for (int native = 0; native < 2; native++) {
+            Iterator iter;
+            iterate(&iter, long, arr, N);
+            if (native) {
+                Iterator_set_advance(&iter, (size_t (*)(void*, size_t)) longIterator_advance);
+            }
+            Iterator_next(&iter);
+            skipped = Iterator_advance(&iter, k);
+            ASSERT(skipped == (k < N - 1 ? k : N - 1), "\nfound wrong number of skipped elements of Iterator in test_advance. Found: %zu, expected: %zu", skipped, k < N - 1 ? k : N - 1);
+            l = Iterator_next(&iter);
+            ASSERT(k + 1 < N ? l == arr + k + 1 : Iterator_stop(&iter) == ITERATOR_STOP, "\nfound wrong element after advancing Iterator by %zu in test_advance", k);
+        }
+    }
+
+    // slices index the elements of the slice, not of the sliced object
+    Slice sl;
+    slice(&sl, long, arr, N, N - 1, 0, -2); // 8, 6, 4, 2
+    ASSERT(Slice_advance(&sl, 2) == 2, "\nfound wrong number of skipped elements of Slice in test_advance");
+    long * l = Slice_next(&sl);
+    ASSERT(l == arr + 4, "\nfound wrong element after advancing Slice in test_advance");
+    ASSERT(Slice_advance(&sl, 5) == 1 && Slice_stop(&sl) == ITERATOR_STOP, "\nfailed to stop Slice at the end in test_advance");
+
+    printf("PASS\n");
+    return 0;
+}
+
+static bool combinatorics_seen[46656]; // 6^6, indexed by the indices read as digits in base n
+
+// encodes n indices in base n, or as a bit set when set is true
+static size_t combinatorics_code(size_t * idx, size_t k, size_t n, bool set) {
+    size_t code = 0;
+    for (size_t j = 0; j < k; j++) {
+        code = set ? code | ((size_t) 1 << idx[j]) : code * n + idx[j];
+    }
+    return code;
+}
+
+int test_combinatorics(void) {
+    printf("Testing Permutations, Combinations and CombinationsWithReplacement...");
+    size_t buf[24], prev[12];
+    for (size_t n = 0; n <= 6; n++) {
+        memset(combinatorics_seen, 0, sizeof(combinatorics_seen));
+        size_t count = 0, expected = 1;
+        for (size_t j = 2; j <= n; j++) {
+            expected *= j;
+        }
+        Permutations perm;
+        Permutations_init(&perm, buf, n);
+        for (size_t * idx = Permutations_next(&perm); !Permutations_stop(&perm); idx = Permutations_next(&perm)) {
+            ASSERT(idx == buf, "\nfound a result outside the buffer in test_combinatorics");
+            size_t code = combinatorics_code(idx, n, n, false);
+            ASSERT(!combinatorics_seen[code], "\nfound a repeated permutation of %zu in test_combinatorics", n);
+            combinatorics_seen[code] = true;
+            size_t changed = 0;
+            for (size_t j = 0; j < n; j++) {
+                ASSERT(idx[j] < n, "\nfound an index out of range in a permutation of %zu in test_combinatorics", n);
+                changed += count && idx[j] != prev[j];
+            }
+            if (count) { // a single swap of the reported positions
+                size_t a = perm.swapped[0], b = perm.swapped[1];
+                ASSERT(changed == 2 && idx[a] == prev[b] && idx[b] == prev[a], "\nfound more than one swap between permutations of %zu in test_combinatorics", n);
+            }
+            memcpy(prev, idx, n * sizeof(size_t));
+            count++;
+        }
+        ASSERT(count == expected, "\nfound wrong number of permutations of %zu in test_combinatorics. Found: %zu, expected: %zu", n, count, expected);
+    }
+
+    for (size_t n = 0; n <= 10; n++) {
+        for (size_t k = 0; k <= n + 1; k++) {
+            memset(combinatorics_seen, 0, sizeof(combinatorics_seen));
+            size_t count = 0, expected = k <= n;
+            for (size_t j = 0; j < k && j < n; j++) {
+                expected = expected * (n - j) / (j + 1);
+            }
+            Combinations comb;
+            Combinations_init(&comb, buf, n, k);
+            for (size_t * idx = Combinations_next(&comb); !Combinations_stop(&comb); idx = Combinations_next(&comb)) {
+                size_t code = combinatorics_code(idx, k, n, true);
+                ASSERT(!combinatorics_seen[code], "\nfound a repeated combination of %zu of %zu in test_combinatorics", k, n);
+                combinatorics_seen[code] = true;
+                for (size_t j = 0; j < k; j++) {
+                    ASSERT(idx[j] < n && (!j || idx[j-1] < idx[j]), "\nfound indices out of order in a combination of %zu of %zu in test_combinatorics", k, n);
+                }
+                if (count) { // exactly out left and in entered
+                    size_t prev_code = combinatorics_code(prev, k, n, true);
+                    size_t expected_code = (prev_code & ~((size_t) 1 << comb.out)) | ((size_t) 1 << comb.in);
+                    ASSERT(comb.out != comb.in && (prev_code >> comb.out & 1) && code == expected_code, "\nfound more than one change between combinations of %zu of %zu in test_combinatorics", k, n);
+                }
+                memcpy(prev, idx, k * sizeof(size_t));
+                count++;
+            }
+            ASSERT(count == expected, "\nfound wrong number of combinations of %zu of %zu in test_combinatorics. Found: %zu, expected: %zu", k, n, count, expected);
+        }
+    }
+
+    for (size_t n = 0; n <= 6; n++) {
+        for (size_t k = 0; k <= 6; k++) {
+            memset(combinatorics_seen, 0, sizeof(combinatorics_seen));
+            size_t count = 0, expected = n || !k;
+            for (size_t j = 0; j < k && n; j++) { // C(n + k - 1, k)
+                expected = expected * (n + j) / (j + 1);
+            }
+            CombinationsWithReplacement comb;
+            CombinationsWithReplacement_init(&comb, buf, n, k);
+            for_each(size_t, idx, CombinationsWithReplacement, &comb) {
+                size_t code = combinatorics_code(idx, k, n, false);
+                ASSERT(!combinatorics_seen[code], "\nfound a repeated combination with replacement of %zu of %zu in test_combinatorics", k, n);
+                combinatorics_seen[code] = true;
+                for (size_t j = 0; j < k; j++) {
+                    ASSERT(idx[j] < n && (!j || idx[j-1] <= idx[j]), "\nfound indices out of order in a combination with replacement of %zu of %zu in test_combinatorics", k, n);
+                }
+                if (count) { // lexicographic order
+                    size_t j = 0;
+                    while (j < k && prev[j] == idx[j]) {
+                        j++;
+                    }
+                    ASSERT(j < k && prev[j] < idx[j], "\nfound combinations with replacement of %zu of %zu out of order in test_combinatorics", k, n);
+                }
+                memcpy(prev, idx, k * sizeof(size_t));
+                count++;
+            }
+            ASSERT(count == expected, "\nfound wrong number of combinations with replacement of %zu of %zu in test_combinatorics. Found: %zu, expected: %zu", k, n, count, expected);
+        }
+    }
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
 int main(void) {
     test_iterator();
     test_filter();
     test_slice();
     test_array_comprehension();
+    test_sized_array_comprehension();
     test_array_clear();
+    test_next_n();
+    test_pipeline();
+    test_zip_chain();
+    test_chunked();
+    test_reductions();
+    test_advance();
+    test_combinatorics();
     test_array_iterator(); // need to fix to get rid of mallocs...requires slicing feature to be done
     return 0;
 }
\ No newline at end of file
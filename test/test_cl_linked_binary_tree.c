@@ -0,0 +1,444 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "cl_core.h"
+#include "cl_linked_binary_tree.h"
+
+#define NKEYS 1000
+
+int long_key_comp(const void * a, const void * b) {
+    return (*(long*)a > *(long*)b) - (*(long*)a < *(long*)b);
+}
+
+// returns the black height of the subtree at node. Checks ordering, parent links and the red-black properties along the way
+static size_t check_subtree(LinkedBinaryTree * lbt, Node * node, Node * parent, size_t * count, char * test_name) {
+    if (!node) {
+        return 1;
+    }
+    NodeAttributes * NA = lbt->NA;
+    (*count)++;
+    ASSERT(Node_get(NA, node, PARENT) == parent, "\nfound incorrect parent link in %s", test_name);
+    Node * left = Node_get(NA, node, LEFT);
+    Node * right = Node_get(NA, node, RIGHT);
+    if (Node_get(NA, node, COLOR) == TREE_COLOR_RED) {
+        ASSERT(!left || Node_get(NA, left, COLOR) == TREE_COLOR_BLACK, "\nfound red node with red left child in %s", test_name);
+        ASSERT(!right || Node_get(NA, right, COLOR) == TREE_COLOR_BLACK, "\nfound red node with red right child in %s", test_name);
+    }
+    if (left) {
+        ASSERT(lbt->compare(Node_get(NA, left, KEY), Node_get(NA, node, KEY)) <= 0, "\nfound left child greater than parent in %s", test_name);
+    }
+    if (right) {
+        ASSERT(lbt->compare(Node_get(NA, right, KEY), Node_get(NA, node, KEY)) >= 0, "\nfound right child less than parent in %s", test_name);
+    }
+    if (Node_has(NA, MAX_END)) {
+        const void * max_end = Node_get(NA, node, END);
+        if (left && lbt->compare(Node_get(NA, left, MAX_END), max_end) > 0) {
+            max_end = Node_get(NA, left, MAX_END);
+        }
+        if (right && lbt->compare(Node_get(NA, right, MAX_END), max_end) > 0) {
+            max_end = Node_get(NA, right, MAX_END);
+        }
+        ASSERT(!lbt->compare(Node_get(NA, node, MAX_END), max_end), "\nfound incorrect MAX_END in %s", test_name);
+    }
+    size_t start_count = *count;
+    size_t left_height = check_subtree(lbt, left, node, count, test_name);
+    size_t right_height = check_subtree(lbt, right, node, count, test_name);
+    ASSERT(Node_get(NA, node, SIZE) == *count - start_count + 1, "\nfound incorrect subtree size in %s. Found: %zu, expected: %zu", test_name, Node_get(NA, node, SIZE), *count - start_count + 1);
+    ASSERT(left_height == right_height, "\nfound unequal black heights in %s. Found: %zu and %zu", test_name, left_height, right_height);
+    return left_height + (Node_get(NA, node, COLOR) == TREE_COLOR_BLACK);
+}
+
+static void check_tree(LinkedBinaryTree * lbt, char * test_name) {
+    size_t count = 0;
+    ASSERT(!lbt->root || Node_get(lbt->NA, lbt->root, COLOR) == TREE_COLOR_BLACK, "\nfound red root in %s", test_name);
+    check_subtree(lbt, lbt->root, NULL, &count, test_name);
+    ASSERT(count == LinkedBinaryTree_size(lbt), "\nfound incorrect size in %s. Found: %zu, expected: %zu", test_name, LinkedBinaryTree_size(lbt), count);
+}
+
+int test_insert_find_erase(void) {
+    printf("Testing LinkedBinaryTree_insert, LinkedBinaryTree_find & LinkedBinaryTree_erase...");
+    static long keys[NKEYS];
+    static bool present[NKEYS];
+    for (long i = 0; i < NKEYS; i++) {
+        keys[i] = i;
+    }
+
+    LinkedBinaryTree * lbt = LinkedBinaryTree_new(long_key_comp, TREE_MOD_UNIQUE, 0, 0);
+
+    srand(12345);
+    for (size_t i = 0; i < 4 * NKEYS; i++) {
+        long k = rand() % NKEYS;
+        if (rand() % 3) {
+            enum cl_status status = LinkedBinaryTree_insert(lbt, &keys[k], &keys[k]);
+            ASSERT((status == CL_SUCCESS) == !present[k], "\nunexpected status on insert in test_insert_find_erase. Found: %d for key %ld", status, k);
+            present[k] = true;
+        } else {
+            enum cl_status status = LinkedBinaryTree_erase(lbt, &keys[k]);
+            ASSERT((status == CL_SUCCESS) == present[k], "\nunexpected status on erase in test_insert_find_erase. Found: %d for key %ld", status, k);
+            present[k] = false;
+        }
+        if (!(i % 64)) {
+            check_tree(lbt, "test_insert_find_erase");
+        }
+    }
+    check_tree(lbt, "test_insert_find_erase");
+
+    long prev = -1;
+    size_t count = 0;
+    for (Node * node = LinkedBinaryTree_min(lbt); node; node = LinkedBinaryTree_next(lbt, node)) {
+        long k = *(long*)Node_get(lbt->NA, node, KEY);
+        ASSERT(k > prev && present[k], "\nfound unexpected key in in-order walk in test_insert_find_erase. Found: %ld after %ld", k, prev);
+        prev = k;
+        count++;
+    }
+    ASSERT(count == LinkedBinaryTree_size(lbt), "\nin-order walk did not visit every node in test_insert_find_erase. Found: %zu, expected: %zu", count, LinkedBinaryTree_size(lbt));
+
+    for (long k = 0; k < NKEYS; k++) {
+        ASSERT(LinkedBinaryTree_contains(lbt, &keys[k]) == present[k], "\nfailed to find key in test_insert_find_erase: %ld", k);
+        if (present[k]) {
+            long retrieved = *(long*)LinkedBinaryTree_get(lbt, &keys[k]);
+            ASSERT(retrieved == k, "\nretrieved incorrect value in test_insert_find_erase. Found: %ld, expected: %ld", retrieved, k);
+        }
+        Node * lb = LinkedBinaryTree_lower_bound(lbt, &keys[k]);
+        long expected = k;
+        while (expected < NKEYS && !present[expected]) {
+            expected++;
+        }
+        if (expected == NKEYS) {
+            ASSERT(!lb, "\nfound lower bound past the last key in test_insert_find_erase for key %ld", k);
+        } else {
+            ASSERT(lb && *(long*)Node_get(lbt->NA, lb, KEY) == expected, "\nfound incorrect lower bound in test_insert_find_erase for key %ld", k);
+        }
+    }
+
+    // drain the tree through the root to exercise removal of internal nodes
+    while (!LinkedBinaryTree_is_empty(lbt)) {
+        LinkedBinaryTree_remove_node(lbt, lbt->root);
+        check_tree(lbt, "test_insert_find_erase");
+    }
+
+    LinkedBinaryTree_del(lbt);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_duplicates(void) {
+    printf("Testing LinkedBinaryTree with duplicate keys...");
+    long keys[] = {3, 1, 3, 2, 3, 1};
+    long values[] = {0, 1, 2, 3, 4, 5};
+    size_t nkeys = sizeof(keys)/sizeof(keys[0]);
+
+    LinkedBinaryTree * lbt = LinkedBinaryTree_new(long_key_comp, TREE_MOD_LAST_INORDER, 0, 0);
+    for (size_t i = 0; i < nkeys; i++) {
+        LinkedBinaryTree_insert(lbt, &keys[i], &values[i]);
+    }
+    check_tree(lbt, "test_duplicates");
+    ASSERT(LinkedBinaryTree_size(lbt) == nkeys, "\nfailed to keep duplicates in test_duplicates. Found: %zu, expected: %zu", LinkedBinaryTree_size(lbt), nkeys);
+
+    // equal keys stay in insertion order
+    long expected_values[] = {1, 5, 3, 0, 2, 4};
+    size_t i = 0;
+    for (Node * node = LinkedBinaryTree_min(lbt); node; node = LinkedBinaryTree_next(lbt, node), i++) {
+        long retrieved = *(long*)Node_get(lbt->NA, node, VALUE);
+        ASSERT(retrieved == expected_values[i], "\nfound duplicates out of insertion order in test_duplicates. Found: %ld, expected: %ld", retrieved, expected_values[i]);
+    }
+
+    long retrieved = *(long*)LinkedBinaryTree_get(lbt, &keys[0]);
+    ASSERT(retrieved == 4, "\nfailed to find last in-order duplicate in test_duplicates. Found: %ld, expected: %d", retrieved, 4);
+    lbt->flags = TREE_MOD_FIRST_INORDER;
+    retrieved = *(long*)LinkedBinaryTree_get(lbt, &keys[0]);
+    ASSERT(retrieved == 0, "\nfailed to find first in-order duplicate in test_duplicates. Found: %ld, expected: %d", retrieved, 0);
+
+    LinkedBinaryTree_erase(lbt, &keys[0]);
+    check_tree(lbt, "test_duplicates");
+    retrieved = *(long*)LinkedBinaryTree_get(lbt, &keys[0]);
+    ASSERT(retrieved == 2, "\nfailed to erase first in-order duplicate in test_duplicates. Found: %ld, expected: %d", retrieved, 2);
+
+    LinkedBinaryTree_del(lbt);
+
+    lbt = LinkedBinaryTree_new(long_key_comp, TREE_MOD_UNIQUE | TREE_MOD_UPDATE, 0, 0);
+    for (size_t i = 0; i < nkeys; i++) {
+        LinkedBinaryTree_insert(lbt, &keys[i], &values[i]);
+    }
+    ASSERT(LinkedBinaryTree_size(lbt) == 3, "\nfailed to keep keys unique in test_duplicates. Found: %zu, expected: %d", LinkedBinaryTree_size(lbt), 3);
+    retrieved = *(long*)LinkedBinaryTree_get(lbt, &keys[0]);
+    ASSERT(retrieved == 4, "\nfailed to update value in test_duplicates. Found: %ld, expected: %d", retrieved, 4);
+
+    LinkedBinaryTree_del(lbt);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+// reference traversals for comparison with the iterators
+static void collect_recursive(NodeAttributes * NA, Node * node, int order, bool reverse, Node ** out, size_t * n) {
+    if (!node) {
+        return;
+    }
+    Node * first = reverse ? Node_get(NA, node, RIGHT) : Node_get(NA, node, LEFT);
+    Node * second = reverse ? Node_get(NA, node, LEFT) : Node_get(NA, node, RIGHT);
+    if (order == TREE_ITERATE_PREORDER) {
+        out[(*n)++] = node;
+    }
+    collect_recursive(NA, first, order, reverse, out, n);
+    if (order == TREE_ITERATE_INORDER) {
+        out[(*n)++] = node;
+    }
+    collect_recursive(NA, second, order, reverse, out, n);
+    if (order == TREE_ITERATE_POSTORDER) {
+        out[(*n)++] = node;
+    }
+}
+
+static void collect_levelorder(NodeAttributes * NA, Node * root, bool reverse, Node ** out, size_t * n) {
+    size_t head = 0;
+    out[(*n)++] = root;
+    while (head < *n) {
+        Node * node = out[head++];
+        Node * first = reverse ? Node_get(NA, node, RIGHT) : Node_get(NA, node, LEFT);
+        Node * second = reverse ? Node_get(NA, node, LEFT) : Node_get(NA, node, RIGHT);
+        if (first) {
+            out[(*n)++] = first;
+        }
+        if (second) {
+            out[(*n)++] = second;
+        }
+    }
+}
+
+int test_iterators(void) {
+    printf("Testing LinkedBinaryTreeIterator...");
+    static long keys[NKEYS];
+    static Node * expected[NKEYS];
+    for (long i = 0; i < NKEYS; i++) {
+        keys[i] = i;
+    }
+    int orders[] = {TREE_ITERATE_INORDER, TREE_ITERATE_PREORDER, TREE_ITERATE_POSTORDER, TREE_ITERATE_LEVELORDER};
+    size_t sizes[] = {0, 1, 2, 3, 10, 100, NKEYS};
+
+    for (size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++) {
+        LinkedBinaryTree * lbt = LinkedBinaryTree_new(long_key_comp, TREE_MOD_UNIQUE, 0, 0);
+        srand((unsigned int) s);
+        while (LinkedBinaryTree_size(lbt) < sizes[s]) {
+            long k = rand() % NKEYS;
+            LinkedBinaryTree_insert(lbt, &keys[k], &keys[k]);
+        }
+        for (size_t o = 0; o < sizeof(orders)/sizeof(orders[0]); o++) {
+            for (int reverse = 0; reverse < 2; reverse++) {
+                size_t n = 0;
+                if (orders[o] == TREE_ITERATE_LEVELORDER) {
+                    if (lbt->root) {
+                        collect_levelorder(lbt->NA, lbt->root, reverse, expected, &n);
+                    }
+                } else {
+                    collect_recursive(lbt->NA, lbt->root, orders[o], reverse, expected, &n);
+                }
+
+                LinkedBinaryTreeIterator lbt_iter;
+                LinkedBinaryTreeIterator_init(&lbt_iter, lbt, orders[o] | (reverse ? TREE_ITERATE_REVERSE : 0));
+                size_t i = 0;
+                for (Node * node = LinkedBinaryTreeIterator_next_node(&lbt_iter); node; node = LinkedBinaryTreeIterator_next_node(&lbt_iter), i++) {
+                    ASSERT(i < n && node == expected[i], "\nfound incorrect node in test_iterators with order %d, reverse %d at index %zu", orders[o], reverse, i);
+                }
+                ASSERT(i == n, "\nfailed to visit every node in test_iterators with order %d, reverse %d. Found: %zu, expected: %zu", orders[o], reverse, i, n);
+                ASSERT(LinkedBinaryTreeIterator_stop(&lbt_iter) == ITERATOR_STOP, "\nfailed to stop iterator in test_iterators");
+            }
+        }
+        LinkedBinaryTree_del(lbt);
+    }
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_order_statistics(void) {
+    printf("Testing LinkedBinaryTree_select, LinkedBinaryTree_rank & LinkedBinaryTree_count_range...");
+    static long keys[NKEYS];
+    static bool present[NKEYS];
+    for (long i = 0; i < NKEYS; i++) {
+        keys[i] = i;
+    }
+    LinkedBinaryTree * lbt = LinkedBinaryTree_new(long_key_comp, TREE_MOD_UNIQUE, 0, 0);
+
+    srand(777);
+    for (size_t i = 0; i < 2 * NKEYS; i++) {
+        long k = rand() % NKEYS;
+        if (rand() % 4) {
+            LinkedBinaryTree_insert(lbt, &keys[k], &keys[k]);
+            present[k] = true;
+        } else {
+            LinkedBinaryTree_erase(lbt, &keys[k]);
+            present[k] = false;
+        }
+    }
+    check_tree(lbt, "test_order_statistics");
+
+    size_t rank = 0;
+    for (long k = 0; k < NKEYS; k++) {
+        ASSERT(LinkedBinaryTree_rank(lbt, &keys[k]) == rank, "\nfound incorrect rank in test_order_statistics for key %ld. Found: %zu, expected: %zu", k, LinkedBinaryTree_rank(lbt, &keys[k]), rank);
+        if (present[k]) {
+            Node * node = LinkedBinaryTree_select(lbt, rank);
+            ASSERT(node && *(long*)Node_get(lbt->NA, node, KEY) == k, "\nselected incorrect node in test_order_statistics for index %zu", rank);
+            ASSERT(LinkedBinaryTree_node_rank(lbt, node) == rank, "\nfound incorrect node rank in test_order_statistics for index %zu", rank);
+            rank++;
+        }
+    }
+    ASSERT(!LinkedBinaryTree_select(lbt, rank), "\nselected node past the end in test_order_statistics");
+
+    size_t count = 0;
+    for (long k = 100; k < 300; k++) {
+        count += present[k];
+    }
+    ASSERT(LinkedBinaryTree_count_range(lbt, &keys[100], &keys[300]) == count, "\nfound incorrect count in range in test_order_statistics. Found: %zu, expected: %zu", LinkedBinaryTree_count_range(lbt, &keys[100], &keys[300]), count);
+    ASSERT(LinkedBinaryTree_count_range(lbt, &keys[300], &keys[100]) == 0, "\nfound elements in empty range in test_order_statistics");
+
+    LinkedBinaryTree_del(lbt);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_bulk(void) {
+    printf("Testing LinkedBinaryTree_build_from_sorted, LinkedBinaryTree_union, LinkedBinaryTree_intersection & LinkedBinaryTree_difference...");
+    static long keys[NKEYS];
+    static const void * sorted[NKEYS];
+    static void * values[NKEYS];
+    for (long i = 0; i < NKEYS; i++) {
+        keys[i] = i;
+    }
+
+    // every size up to a few levels so that both complete and incomplete last levels are built
+    LinkedBinaryTree * a = LinkedBinaryTree_new(long_key_comp, TREE_MOD_UNIQUE, Node_flag(HEIGHT), 0);
+    for (size_t num = 0; num < 70; num++) {
+        for (size_t i = 0; i < num; i++) {
+            sorted[i] = &keys[i];
+        }
+        LinkedBinaryTree_build_from_sorted(a, sorted, NULL, num);
+        check_tree(a, "test_bulk");
+        size_t height = 0;
+        while (num >> height) {
+            height++;
+        }
+        ASSERT(!num || Node_get(a->NA, a->root, HEIGHT) == height, "\nfound incorrect height in test_bulk for %zu keys. Found: %zu, expected: %zu", num, Node_get(a->NA, a->root, HEIGHT), height);
+    }
+
+    // a holds the multiples of 2, b the multiples of 3
+    size_t na = 0, nb = 0;
+    for (long i = 0; i < NKEYS; i += 2) {
+        sorted[na] = &keys[i];
+        values[na++] = &keys[i];
+    }
+    LinkedBinaryTree_build_from_sorted(a, sorted, values, na);
+    LinkedBinaryTree * b = LinkedBinaryTree_new(long_key_comp, TREE_MOD_UNIQUE, 0, 0);
+    for (long i = 0; i < NKEYS; i += 3) {
+        sorted[nb] = &keys[i];
+        values[nb++] = &keys[NKEYS - 1 - i];
+    }
+    LinkedBinaryTree_build_from_sorted(b, sorted, values, nb);
+    check_tree(a, "test_bulk");
+    check_tree(b, "test_bulk");
+
+    // nodes from the block and the heap mix freely
+    LinkedBinaryTree_erase(a, &keys[500]);
+    LinkedBinaryTree_insert(a, &keys[501], &keys[501]);
+    LinkedBinaryTree_erase(a, &keys[501]);
+    LinkedBinaryTree_insert(a, &keys[500], &keys[500]);
+    check_tree(a, "test_bulk");
+
+    LinkedBinaryTree * dest = LinkedBinaryTree_new(long_key_comp, TREE_MOD_UNIQUE, 0, 0);
+    int (*ops[3]) (LinkedBinaryTree *, LinkedBinaryTree *, LinkedBinaryTree *) = {LinkedBinaryTree_union, LinkedBinaryTree_intersection, LinkedBinaryTree_difference};
+    for (int op = 0; op < 3; op++) {
+        ops[op](dest, a, b);
+        check_tree(dest, "test_bulk");
+        size_t count = 0;
+        for (long k = 0; k < NKEYS; k++) {
+            bool in_a = !(k % 2), in_b = !(k % 3);
+            bool expected = (op == 0) ? (in_a || in_b) : (op == 1) ? (in_a && in_b) : (in_a && !in_b);
+            void * value = LinkedBinaryTree_get(dest, &keys[k]);
+            ASSERT(LinkedBinaryTree_contains(dest, &keys[k]) == expected, "\nfound incorrect membership of %ld in test_bulk for operation %d", k, op);
+            if (expected) {
+                ASSERT(value == (in_a ? &keys[k] : &keys[NKEYS - 1 - k]), "\nfound incorrect value for %ld in test_bulk for operation %d", k, op);
+                count++;
+            }
+        }
+        ASSERT(LinkedBinaryTree_size(dest) == count, "\nfound incorrect size in test_bulk for operation %d. Found: %zu, expected: %zu", op, LinkedBinaryTree_size(dest), count);
+    }
+    ASSERT(LinkedBinaryTree_union(a, a, b) == CL_VALUE_ERROR, "\nfailed to reject aliased destination in test_bulk");
+
+    LinkedBinaryTree_del(a);
+    LinkedBinaryTree_del(b);
+    LinkedBinaryTree_del(dest);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+#define NINTERVALS 2000
+#define RANGE 10000
+
+int test_intervals(void) {
+    printf("Testing LinkedBinaryTree_insert_interval, LinkedBinaryTree_erase_interval & LinkedBinaryTreeIntervalIterator...");
+    static long points[RANGE];
+    static long starts[NINTERVALS], ends[NINTERVALS];
+    static bool present[NINTERVALS];
+    for (long i = 0; i < RANGE; i++) {
+        points[i] = i;
+    }
+    LinkedBinaryTree * lbt = LinkedBinaryTree_new(long_key_comp, 0, Node_flag(END) | Node_flag(MAX_END), 0);
+
+    srand(40);
+    for (size_t i = 0; i < NINTERVALS; i++) {
+        starts[i] = rand() % (RANGE - 500);
+        ends[i] = starts[i] + rand() % 500;
+        LinkedBinaryTree_insert_interval(lbt, &points[starts[i]], &points[ends[i]], &starts[i]);
+        present[i] = true;
+    }
+    for (size_t i = 0; i < NINTERVALS; i += 3) {
+        ASSERT(LinkedBinaryTree_erase_interval(lbt, &points[starts[i]], &points[ends[i]]) == CL_SUCCESS, "\nfailed to erase interval %zu in test_intervals", i);
+        present[i] = false;
+    }
+    ASSERT(LinkedBinaryTree_erase_interval(lbt, &points[0], &points[RANGE - 1]) == CL_FAILURE, "\nerased absent interval in test_intervals");
+    check_tree(lbt, "test_intervals");
+
+    for (int q = 0; q < 200; q++) {
+        long lo = rand() % RANGE;
+        long hi = (q % 2) ? lo : lo + rand() % (RANGE - lo);
+        size_t expected = 0;
+        for (size_t i = 0; i < NINTERVALS; i++) {
+            expected += present[i] && starts[i] <= hi && lo <= ends[i];
+        }
+        LinkedBinaryTreeIntervalIterator iter;
+        if (q % 2) {
+            LinkedBinaryTreeIntervalIterator_init_stab(&iter, lbt, &points[lo]);
+        } else {
+            LinkedBinaryTreeIntervalIterator_init(&iter, lbt, &points[lo], &points[hi]);
+        }
+        size_t found = 0;
+        long prev = -1;
+        for (long * start = LinkedBinaryTreeIntervalIterator_next(&iter); !LinkedBinaryTreeIntervalIterator_stop(&iter); start = LinkedBinaryTreeIntervalIterator_next(&iter)) {
+            size_t i = (size_t) (start - starts);
+            ASSERT(present[i] && starts[i] <= hi && lo <= ends[i], "\nfound interval [%ld, %ld] not overlapping [%ld, %ld] in test_intervals", starts[i], ends[i], lo, hi);
+            ASSERT(starts[i] >= prev, "\nfound intervals out of order in test_intervals");
+            prev = starts[i];
+            found++;
+        }
+        ASSERT(found == expected, "\nfound incorrect number of overlapping intervals for [%ld, %ld] in test_intervals. Found: %zu, expected: %zu", lo, hi, found, expected);
+    }
+    ASSERT(LinkedBinaryTree_build_from_sorted(lbt, NULL, NULL, 0) == CL_VALUE_ERROR, "\nfailed to reject bulk construction of interval tree in test_intervals");
+
+    LinkedBinaryTree_del(lbt);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int main(void) {
+    test_insert_find_erase();
+    test_duplicates();
+    test_iterators();
+    test_order_statistics();
+    test_bulk();
+    test_intervals();
+    return 0;
+}
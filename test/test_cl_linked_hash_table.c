@@ -324,6 +324,121 @@ int test_hash_table_resize(void) {
     return CL_SUCCESS;
 }
 
+int test_hash_table_next_n(void) {
+    printf("testing hash_table batched key and value iterators...");
+    size_t N = 10;
+    long values[10];
+    const void * keys[4];
+    void * vals[4];
+
+    LinkedHashTable * hash_table = LinkedHashTable_new(NULL, NULL, 0, 0, 0, 0);
+    for (size_t key = 0; key < N; key++) {
+        values[key] = (long) (key * key);
+        LinkedHashTable_set(hash_table, (void*)key, &values[key]);
+    }
+
+    for (size_t batch = 1; batch <= 4; batch++) {
+        LinkedHashTableKeyIterator key_iter;
+        LinkedHashTableKeyIterator_init(&key_iter, hash_table);
+        LinkedHashTableValueIterator value_iter;
+        LinkedHashTableValueIterator_init(&value_iter, hash_table);
+        size_t i = 0, n, m;
+        ASSERT(LinkedHashTableKeyIterator_size_hint(&key_iter) == N, "\nfound wrong size_hint of new key iterator in test_hash_table_next_n. Found: %zu, expected: %zu", LinkedHashTableKeyIterator_size_hint(&key_iter), N);
+        do {
+            n = LinkedHashTableKeyIterator_next_n(&key_iter, keys, batch);
+            m = LinkedHashTableValueIterator_next_n(&value_iter, vals, batch);
+            ASSERT(n == m, "\nfound different numbers of keys and values in test_hash_table_next_n. Found: %zu, %zu", n, m);
+            for (size_t j = 0; j < n; j++, i++) { // iterates in insertion order
+                ASSERT((size_t)keys[j] == i, "\nfound wrong key in test_hash_table_next_n. Found: %zu, expected: %zu", (size_t)keys[j], i);
+                ASSERT(vals[j] == &values[i], "\nfound wrong value for key %zu in test_hash_table_next_n", i);
+            }
+            ASSERT(LinkedHashTableKeyIterator_size_hint(&key_iter) == N - i && LinkedHashTableValueIterator_size_hint(&value_iter) == N - i, "\nfound wrong size_hint after %zu elements in test_hash_table_next_n", i);
+        } while (n == batch);
+        ASSERT(i == N, "\nfound wrong number of keys in test_hash_table_next_n. Found: %zu, expected: %zu", i, N);
+        ASSERT(key_iter.stop == ITERATOR_STOP && value_iter.stop == ITERATOR_STOP, "\nfound iterators not stopped after short batch in test_hash_table_next_n");
+    }
+
+    LinkedHashTable_del(hash_table);
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+// groups words by their first letter, counting them in the value itself and summing their lengths in ctx
+static char word_keys[26][2];
+
+static void * word_first_letter(void * element, void * ctx) {
+    (void) ctx;
+    const char * word = *(char **) element;
+    return word_keys[word[0] - 'a'];
+}
+
+static int word_count(void ** value, void * element, void * ctx) {
+    *(size_t *) ctx += strlen(*(char **) element);
+    *value = (void *) ((uintptr_t) *value + 1);
+    return CL_SUCCESS;
+}
+
+static int word_fail_on_z(void ** value, void * element, void * ctx) {
+    (void) value; (void) ctx;
+    return **(char **) element == 'z' ? CL_VALUE_ERROR : CL_SUCCESS;
+}
+
+int test_hash_table_aggregate(void) {
+    printf("testing hash_table upsert and group_by...");
+    for (int i = 0; i < 26; i++) {
+        word_keys[i][0] = (char) ('a' + i);
+        word_keys[i][1] = '\0';
+    }
+
+    LinkedHashTable * hash_table = LinkedHashTable_new(cstr_hash, cstr_comp, 0, 0, 0, 0);
+    bool inserted = false;
+    void ** slot = LinkedHashTable_upsert(hash_table, (void*)"a", &inserted);
+    ASSERT(slot && inserted && !*slot && LinkedHashTable_size(hash_table) == 1, "\nfailed to insert a new key in test_hash_table_aggregate");
+    *slot = (void*)"first";
+    ASSERT(LinkedHashTable_upsert(hash_table, (void*)"a", &inserted) == slot && !inserted, "\nfailed to find an existing key in test_hash_table_aggregate");
+    // the slot survives the resizes caused by later insertions
+    for (size_t i = 1; i < 26; i++) {
+        LinkedHashTable_upsert(hash_table, (void*)word_keys[i], NULL);
+    }
+    ASSERT(LinkedHashTable_capacity(hash_table) > LINKED_HASH_TABLE_DEFAULT_CAPACITY, "\nfailed to resize in test_hash_table_aggregate");
+    ASSERT(LinkedHashTable_upsert(hash_table, (void*)"a", NULL) == slot && !strcmp(*slot, "first"), "\nfound the value moved by resizing in test_hash_table_aggregate");
+    LinkedHashTable_set(hash_table, (void*)"a", NULL);
+    ASSERT(LinkedHashTable_size(hash_table) == 26 && !*slot, "\nfound wrong value after set in test_hash_table_aggregate");
+    LinkedHashTable_del(hash_table);
+
+    char * words[] = {"apple", "avocado", "banana", "blueberry", "cherry", "apricot", "date", "bilberry", "almond", "zucchini"};
+    size_t N = sizeof(words)/sizeof(words[0]);
+    size_t expected_counts[26] = {0}, expected_length = 0;
+    for (size_t i = 0; i < N; i++) {
+        expected_counts[words[i][0] - 'a']++;
+        expected_length += strlen(words[i]);
+    }
+
+    hash_table = LinkedHashTable_new(cstr_hash, cstr_comp, 0, 0, 0, 0);
+    size_t length = 0;
+    int result;
+    group_by(result, hash_table, word_first_letter, word_count, &length, pvoid, (pvoid*)words, N);
+    ASSERT(result == CL_SUCCESS, "\nfailed to aggregate in test_hash_table_aggregate");
+    ASSERT(length == expected_length, "\nfound wrong total length in test_hash_table_aggregate. Found: %zu, expected: %zu", length, expected_length);
+    ASSERT(LinkedHashTable_size(hash_table) == 5, "\nfound wrong number of groups in test_hash_table_aggregate. Found: %zu", LinkedHashTable_size(hash_table));
+    const char * order = "abcdz"; // groups are kept in order of first appearance
+    size_t g = 0;
+    LinkedHashTableItemIterator * item_iter = LinkedHashTable_items(hash_table); // deleted by stop
+    for (DictItem * item = LinkedHashTableItemIterator_next(item_iter); !LinkedHashTableItemIterator_stop(item_iter); item = LinkedHashTableItemIterator_next(item_iter), g++) {
+        char letter = *(const char *)item->key;
+        ASSERT(letter == order[g], "\nfound group %c out of order in test_hash_table_aggregate, expected: %c", letter, order[g]);
+        ASSERT((uintptr_t)item->value == expected_counts[letter - 'a'], "\nfound wrong count for group %c in test_hash_table_aggregate. Found: %zu, expected: %zu", letter, (size_t)(uintptr_t)item->value, expected_counts[letter - 'a']);
+    }
+    ASSERT(g == 5, "\nfound wrong number of items in test_hash_table_aggregate. Found: %zu", g);
+
+    group_by(result, hash_table, word_first_letter, word_fail_on_z, NULL, pvoid, (pvoid*)words, N);
+    ASSERT(result == CL_VALUE_ERROR, "\nfailed to return the error of the accumulator in test_hash_table_aggregate");
+    LinkedHashTable_del(hash_table);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
 int main() {
     test_is_prime();
     test_next_prime();
@@ -335,5 +450,7 @@ int main() {
     test_hash_table_cstr();
 
     test_hash_table_resize();
+    test_hash_table_next_n();
+    test_hash_table_aggregate();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,295 @@
+#include <stddef.h>
+#include <stdio.h>
+#include "cl_core.h"
+#include "cl_parallel.h"
+#include "cl_algorithms.h"
+#include "cl_circular_buffer.h"
+#include "cl_hybrid_dbl_linked_list.h"
+#include "cl_linked_hash_table.h"
+
+#define TEST_N 20000
+#define TEST_BLOCK_SIZE 16
+
+static long arr[TEST_N];
+static unsigned char seen[TEST_N];
+
+static void test_visit(void * el, void * ctx) {
+    seen[(long *) el - arr]++;
+}
+
+static void test_visit_item(void * el, void * ctx) {
+    seen[(long *) ((DictItem *) el)->value - arr]++;
+}
+
+static void test_sum(void * acc, void * el, void * ctx) {
+    *(long *) acc += *(long *) el;
+}
+
+static void test_combine(void * result, void * acc) {
+    *(long *) result += *(long *) acc;
+}
+
+// returns the number of elements not visited exactly once in the first n and clears the marks
+static size_t test_check_seen(size_t n) {
+    size_t bad = 0;
+    for (size_t i = 0; i < n; i++) {
+        bad += seen[i] != 1;
+        seen[i] = 0;
+    }
+    return bad;
+}
+
+static void test_hybrid_init(HybridDblLinkedList * hdll) {
+    NodeAttributes * NA = NodeAttributes_new(Node_flag(VALUE) | Node_flag(NEXT) | Node_flag(PREV) | Node_flag(SIZE), 0);
+    HybridDblLinkedList_init(hdll, NA, TEST_BLOCK_SIZE);
+}
+
+static void test_hybrid_clear(HybridDblLinkedList * hdll) {
+    while (HybridDblLinkedList_size(hdll)) {
+        HybridDblLinkedList_pop_front(hdll);
+    }
+    NodeAttributes_del(hdll->dll.ll.NA);
+}
+
+int test_split(void) {
+    printf("Testing iterator split...");
+    for (size_t i = 0; i < TEST_N; i++) {
+        arr[i] = (long) i;
+    }
+
+    size_t num = 10;
+    longIterator first, second;
+    longIterator_init(&first, arr, num);
+    ASSERT(!longIterator_split(&first, &second, 6), "\nfound split below grain in test_split");
+    ASSERT(longIterator_split(&first, &second, 5), "\nfailed to split array iterator in test_split");
+    size_t i = 0;
+    for (long * val = longIterator_next(&first); longIterator_stop(&first) != ITERATOR_STOP; val = longIterator_next(&first)) {
+        ASSERT(*val == arr[i], "\nfound wrong element in first part of array iterator in test_split. Found: %ld, expected: %ld", *val, arr[i]);
+        i++;
+    }
+    ASSERT(i == num / 2, "\nfound wrong size of first part of array iterator in test_split. Found: %zu, expected: %zu", i, num / 2);
+    for (long * val = longIterator_next(&second); longIterator_stop(&second) != ITERATOR_STOP; val = longIterator_next(&second)) {
+        ASSERT(*val == arr[i], "\nfound wrong element in second part of array iterator in test_split. Found: %ld, expected: %ld", *val, arr[i]);
+        i++;
+    }
+    ASSERT(i == num, "\nfound wrong size of second part of array iterator in test_split. Found: %zu, expected: %zu", i, num);
+
+    longIterator_init(&first, arr, num);
+    longIterator_next(&first);
+    ASSERT(!longIterator_split(&first, &second, 1), "\nfound split of started array iterator in test_split");
+
+    // odd number of elements in a strided slice
+    Slice sl, sl2;
+    slice(&sl, long, arr, num, 0, num, 3); // 0, 3, 6, 9
+    ASSERT(Slice_split(&sl, &sl2, 1), "\nfailed to split slice in test_split");
+    i = 0;
+    for_each(long, val, Slice, &sl) {
+        ASSERT(*val == arr[3 * i], "\nfound wrong element in first part of slice in test_split. Found: %ld, expected: %ld", *val, arr[3 * i]);
+        i++;
+    }
+    for_each(long, val, Slice, &sl2) {
+        ASSERT(*val == arr[3 * i], "\nfound wrong element in second part of slice in test_split. Found: %ld, expected: %ld", *val, arr[3 * i]);
+        i++;
+    }
+    ASSERT(i == 4, "\nfound wrong number of elements in split slice in test_split. Found: %zu, expected: 4", i);
+
+    HybridDblLinkedList hdll;
+    test_hybrid_init(&hdll);
+    num = 5 * TEST_BLOCK_SIZE + 3;
+    for (i = 0; i < num; i++) {
+        HybridDblLinkedList_push_back(&hdll, &arr[i]);
+    }
+    HybridDblLinkedListIterator hfirst, hsecond;
+    HybridDblLinkedListIterator_init(&hfirst, &hdll);
+    ASSERT(!HybridDblLinkedListIterator_split(&hfirst, &hsecond, num), "\nfound split below grain of HybridDblLinkedListIterator in test_split");
+    ASSERT(HybridDblLinkedListIterator_split(&hfirst, &hsecond, 1), "\nfailed to split HybridDblLinkedListIterator in test_split");
+    size_t nfirst = 0;
+    i = 0;
+    for (long * val = HybridDblLinkedListIterator_next(&hfirst); HybridDblLinkedListIterator_stop(&hfirst) != ITERATOR_STOP; val = HybridDblLinkedListIterator_next(&hfirst)) {
+        ASSERT(*val == arr[i], "\nfound wrong element in first part of HybridDblLinkedListIterator in test_split. Found: %ld, expected: %ld", *val, arr[i]);
+        i++;
+    }
+    nfirst = i;
+    void * batch[7];
+    size_t n;
+    while ((n = HybridDblLinkedListIterator_next_n(&hsecond, batch, 7))) {
+        for (size_t j = 0; j < n; j++) {
+            ASSERT(*(long *) batch[j] == arr[i], "\nfound wrong element in second part of HybridDblLinkedListIterator in test_split. Found: %ld, expected: %ld", *(long *) batch[j], arr[i]);
+            i++;
+        }
+    }
+    ASSERT(i == num, "\nfound wrong number of elements in split HybridDblLinkedListIterator in test_split. Found: %zu, expected: %zu", i, num);
+    ASSERT(nfirst % TEST_BLOCK_SIZE == 0 && nfirst >= num / 2 - TEST_BLOCK_SIZE && nfirst <= num / 2 + TEST_BLOCK_SIZE, "\nfound uneven split of HybridDblLinkedListIterator in test_split. Found: %zu elements in first part of %zu", nfirst, num);
+
+    HybridDblLinkedList_reverse(&hdll);
+    HybridDblLinkedListIterator_init(&hfirst, &hdll);
+    ASSERT(HybridDblLinkedListIterator_split(&hfirst, &hsecond, 1), "\nfailed to split reversed HybridDblLinkedListIterator in test_split");
+    i = num;
+    for (long * val = HybridDblLinkedListIterator_next(&hfirst); HybridDblLinkedListIterator_stop(&hfirst) != ITERATOR_STOP; val = HybridDblLinkedListIterator_next(&hfirst)) {
+        i--;
+        ASSERT(*val == arr[i], "\nfound wrong element in first part of reversed HybridDblLinkedListIterator in test_split. Found: %ld, expected: %ld", *val, arr[i]);
+    }
+    for (long * val = HybridDblLinkedListIterator_next(&hsecond); HybridDblLinkedListIterator_stop(&hsecond) != ITERATOR_STOP; val = HybridDblLinkedListIterator_next(&hsecond)) {
+        i--;
+        ASSERT(*val == arr[i], "\nfound wrong element in second part of reversed HybridDblLinkedListIterator in test_split. Found: %ld, expected: %ld", *val, arr[i]);
+    }
+    ASSERT(i == 0, "\nfound wrong number of elements in reversed split HybridDblLinkedListIterator in test_split. Found: %zu, expected: %zu", num - i, num);
+    test_hybrid_clear(&hdll);
+
+    LinkedHashTable * hash_table = LinkedHashTable_new(NULL, NULL, 0, 0, 0, 0);
+    num = 100;
+    for (i = 0; i < num; i++) {
+        LinkedHashTable_set(hash_table, &arr[i], &arr[i]);
+    }
+    LinkedHashTableBinIterator bfirst, bsecond;
+    LinkedHashTableBinIterator_init(&bfirst, hash_table);
+    ASSERT(!LinkedHashTableBinIterator_split(&bfirst, &bsecond, LinkedHashTable_capacity(hash_table)), "\nfound split below grain of LinkedHashTableBinIterator in test_split");
+    ASSERT(LinkedHashTableBinIterator_split(&bfirst, &bsecond, 1), "\nfailed to split LinkedHashTableBinIterator in test_split");
+    for (DictItem * item = LinkedHashTableBinIterator_next(&bfirst); LinkedHashTableBinIterator_stop(&bfirst) != ITERATOR_STOP; item = LinkedHashTableBinIterator_next(&bfirst)) {
+        ASSERT(item->key == item->value, "\nfound mismatched item in LinkedHashTableBinIterator in test_split");
+        test_visit(item->value, NULL);
+    }
+    for_each(DictItem, item, LinkedHashTableBinIterator, &bsecond) {
+        test_visit(item->value, NULL);
+    }
+    size_t bad = test_check_seen(num);
+    ASSERT(!bad, "\nfound %zu elements not visited exactly once by split LinkedHashTableBinIterator in test_split", bad);
+    LinkedHashTable_del(hash_table);
+
+    printf("PASS\n");
+    return 0;
+}
+
+int test_parallel_for_each(unsigned int nthreads) {
+    printf("Testing parallel_for_each with %u threads...", nthreads);
+    ThreadPool * pool = ThreadPool_new(nthreads);
+    ASSERT(pool && ThreadPool_size(pool) == nthreads, "\nfailed to create ThreadPool in test_parallel_for_each");
+
+    longIterator liter;
+    longIterator_init(&liter, arr, TEST_N);
+    ASSERT(parallel_for_each(pool, splittable(long), &liter, 64, test_visit, NULL) == CL_SUCCESS, "\nfailed parallel_for_each over array in test_parallel_for_each");
+    size_t bad = test_check_seen(TEST_N);
+    ASSERT(!bad, "\nfound %zu elements not visited exactly once in array in test_parallel_for_each", bad);
+    // the iterator is unchanged and can be reused
+    ASSERT(parallel_for_each(pool, splittable_batched(long), &liter, 64, test_visit, NULL) == CL_SUCCESS, "\nfailed batched parallel_for_each over array in test_parallel_for_each");
+    bad = test_check_seen(TEST_N);
+    ASSERT(!bad, "\nfound %zu elements not visited exactly once in batched array in test_parallel_for_each", bad);
+
+    static void * data[TEST_N];
+    CircularBuffer cb;
+    CircularBuffer_init(&cb, data, TEST_N);
+    for (size_t i = 0; i < TEST_N; i++) {
+        CircularBuffer_push_front(&cb, &arr[i]);
+    }
+    CircularBufferIterator cb_iter;
+    CircularBufferIterator_init(&cb_iter, &cb);
+    ASSERT(parallel_for_each(pool, splittable_batched(CircularBuffer), &cb_iter, 64, test_visit, NULL) == CL_SUCCESS, "\nfailed parallel_for_each over CircularBuffer in test_parallel_for_each");
+    bad = test_check_seen(TEST_N);
+    ASSERT(!bad, "\nfound %zu elements not visited exactly once in CircularBuffer in test_parallel_for_each", bad);
+
+    HybridDblLinkedList hdll;
+    test_hybrid_init(&hdll);
+    for (size_t i = 0; i < TEST_N; i++) {
+        HybridDblLinkedList_push_back(&hdll, &arr[i]);
+    }
+    HybridDblLinkedListIterator hdll_iter;
+    HybridDblLinkedListIterator_init(&hdll_iter, &hdll);
+    ASSERT(parallel_for_each(pool, splittable_batched(HybridDblLinkedList), &hdll_iter, 64, test_visit, NULL) == CL_SUCCESS, "\nfailed parallel_for_each over HybridDblLinkedList in test_parallel_for_each");
+    bad = test_check_seen(TEST_N);
+    ASSERT(!bad, "\nfound %zu elements not visited exactly once in HybridDblLinkedList in test_parallel_for_each", bad);
+    test_hybrid_clear(&hdll);
+
+    LinkedHashTable * hash_table = LinkedHashTable_new(NULL, NULL, 0, 0, 0, 0);
+    for (size_t i = 0; i < TEST_N; i++) {
+        LinkedHashTable_set(hash_table, &arr[i], &arr[i]);
+    }
+    LinkedHashTableBinIterator bin_iter;
+    LinkedHashTableBinIterator_init(&bin_iter, hash_table);
+    ASSERT(parallel_for_each(pool, splittable(LinkedHashTableBin), &bin_iter, 64, test_visit_item, NULL) == CL_SUCCESS, "\nfailed parallel_for_each over LinkedHashTable in test_parallel_for_each");
+    bad = test_check_seen(TEST_N);
+    ASSERT(!bad, "\nfound %zu elements not visited exactly once in LinkedHashTable in test_parallel_for_each", bad);
+    LinkedHashTable_del(hash_table);
+
+    longIterator_init(&liter, arr, 1);
+    ASSERT(parallel_for_each(pool, splittable(long), &liter, 64, test_visit, NULL) == CL_SUCCESS, "\nfailed parallel_for_each over single element in test_parallel_for_each");
+    bad = test_check_seen(1);
+    ASSERT(!bad, "\nfound single element not visited exactly once in test_parallel_for_each");
+
+    ThreadPool_del(pool);
+    printf("PASS\n");
+    return 0;
+}
+
+int test_parallel_reduce(unsigned int nthreads) {
+    printf("Testing parallel_reduce with %u threads...", nthreads);
+    ThreadPool * pool = ThreadPool_new(nthreads);
+    ASSERT(pool, "\nfailed to create ThreadPool in test_parallel_reduce");
+
+    long expected = (long) TEST_N * (TEST_N - 1) / 2;
+    size_t grains[] = {1, 64, TEST_N};
+    for (size_t g = 0; g < sizeof(grains) / sizeof(grains[0]); g++) {
+        longIterator liter;
+        longIterator_init(&liter, arr, TEST_N);
+        long sum = 0;
+        ASSERT(parallel_reduce(pool, splittable_batched(long), &liter, grains[g], &sum, sizeof(sum), test_sum, test_combine, NULL) == CL_SUCCESS, "\nfailed parallel_reduce with grain %zu in test_parallel_reduce", grains[g]);
+        ASSERT(sum == expected, "\nfound wrong sum with grain %zu in test_parallel_reduce. Found: %ld, expected: %ld", grains[g], sum, expected);
+    }
+
+    // reversed CircularBuffer
+    static void * data[TEST_N];
+    CircularBuffer cb;
+    CircularBuffer_init(&cb, data, TEST_N);
+    for (size_t i = 0; i < TEST_N; i++) {
+        CircularBuffer_push_back(&cb, &arr[i]);
+    }
+    CircularBuffer_reverse(&cb);
+    CircularBufferIterator cb_iter;
+    CircularBufferIterator_init(&cb_iter, &cb);
+    long sum = 0;
+    ASSERT(parallel_reduce(pool, splittable_batched(CircularBuffer), &cb_iter, 16, &sum, sizeof(sum), test_sum, test_combine, NULL) == CL_SUCCESS, "\nfailed parallel_reduce over CircularBuffer in test_parallel_reduce");
+    ASSERT(sum == expected, "\nfound wrong sum over CircularBuffer in test_parallel_reduce. Found: %ld, expected: %ld", sum, expected);
+
+    ThreadPool_del(pool);
+    printf("PASS\n");
+    return 0;
+}
+
+int test_parallel_radix_histogram(unsigned int nthreads) {
+    printf("Testing parallel_radix_histogram with %u threads...", nthreads);
+    ThreadPool * pool = ThreadPool_new(nthreads);
+    ASSERT(pool, "\nfailed to create ThreadPool in test_parallel_radix_histogram");
+
+    static long keys[TEST_N], buf[TEST_N];
+    static size_t hist[CL_RADIX_HIST_LEN(unsigned long)], expected[CL_RADIX_HIST_LEN(unsigned long)];
+    for (size_t i = 0; i < TEST_N; i++) {
+        keys[i] = (long) ((i * 2654435761u) % TEST_N) - TEST_N / 2;
+    }
+    memset(expected, 0, sizeof(expected));
+    long_radix_histogram(keys, TEST_N, expected);
+
+    size_t grains[] = {1, 1000, TEST_N};
+    for (size_t g = 0; g < sizeof(grains) / sizeof(grains[0]); g++) {
+        memset(hist, 0, sizeof(hist));
+        ASSERT(parallel_radix_histogram(pool, keys, TEST_N, sizeof(long), grains[g], (void (*)(void *, size_t, size_t *)) long_radix_histogram, hist, CL_RADIX_HIST_LEN(unsigned long)) == CL_SUCCESS, "\nfailed parallel_radix_histogram with grain %zu", grains[g]);
+        ASSERT(!memcmp(hist, expected, sizeof(hist)), "\nfound wrong histogram with grain %zu in test_parallel_radix_histogram", grains[g]);
+    }
+    long_radix_sort_buffered(keys, TEST_N, buf, hist);
+    for (size_t i = 0; i < TEST_N; i++) {
+        ASSERT(keys[i] == (long) i - TEST_N / 2, "\nfound wrong key %zu after sorting with the parallel histogram. Found: %ld, expected: %ld", i, keys[i], (long) i - TEST_N / 2);
+    }
+
+    ThreadPool_del(pool);
+    printf("PASS\n");
+    return 0;
+}
+
+int main(void) {
+    test_split();
+    test_parallel_for_each(1);
+    test_parallel_for_each(4);
+    test_parallel_reduce(1);
+    test_parallel_reduce(4);
+    test_parallel_radix_histogram(1);
+    test_parallel_radix_histogram(4);
+    return 0;
+}
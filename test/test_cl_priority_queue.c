@@ -0,0 +1,128 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "cl_core.h"
+#include "cl_priority_queue.h"
+
+#define NTIMERS 5000
+
+typedef struct Timer {
+    long deadline;
+    size_t id;
+} Timer;
+
+int timer_comp(const void * a, const void * b) {
+    return (((Timer*)a)->deadline > ((Timer*)b)->deadline) - (((Timer*)a)->deadline < ((Timer*)b)->deadline);
+}
+
+static void check_heap(PriorityQueue * pq, char * test_name) {
+    for (size_t i = 1; i < PriorityQueue_size(pq); i++) {
+        Timer * parent = (Timer *) (pq->data + ((i - 1) / pq->arity) * pq->elem_size);
+        Timer * child = (Timer *) (pq->data + i * pq->elem_size);
+        ASSERT(parent->deadline <= child->deadline, "\nfound heap order violated in %s. Found: %ld above %ld", test_name, parent->deadline, child->deadline);
+        ASSERT(pq->index[pq->handles[i]] == i, "\nfound inconsistent handle at index %zu in %s", i, test_name);
+    }
+}
+
+// pops everything and checks that deadlines come out in order
+static void check_drain(PriorityQueue * pq, size_t expected_size, char * test_name) {
+    Timer timer;
+    long prev = -1;
+    size_t count = 0;
+    while (PriorityQueue_pop(pq, &timer) == CL_SUCCESS) {
+        ASSERT(timer.deadline >= prev, "\nfound deadlines out of order in %s. Found: %ld after %ld", test_name, timer.deadline, prev);
+        prev = timer.deadline;
+        count++;
+    }
+    ASSERT(count == expected_size, "\nfailed to pop all elements in %s. Found: %zu, expected: %zu", test_name, count, expected_size);
+}
+
+int test_push_pop_update(unsigned int arity) {
+    printf("Testing PriorityQueue_push, PriorityQueue_pop, PriorityQueue_update & PriorityQueue_remove with arity %u...", arity);
+    static PriorityQueueHandle handles[NTIMERS];
+    static bool queued[NTIMERS];
+    PriorityQueue * pq = PriorityQueue_new(0, sizeof(Timer), arity, timer_comp);
+
+    srand(arity);
+    size_t nqueued = 0;
+    for (size_t id = 0; id < NTIMERS; id++) {
+        Timer timer = {rand() % 100000, id};
+        PriorityQueue_push(pq, &timer, &handles[id]);
+        queued[id] = true;
+        nqueued++;
+    }
+    check_heap(pq, "test_push_pop_update");
+
+    // reschedule, cancel and expire timers
+    for (size_t i = 0; i < NTIMERS; i++) {
+        size_t id = rand() % NTIMERS;
+        if (!queued[id]) {
+            continue;
+        }
+        Timer * timer = PriorityQueue_get(pq, handles[id]);
+        ASSERT(timer->id == id, "\nfound incorrect element for handle in test_push_pop_update. Found: %zu, expected: %zu", timer->id, id);
+        int action = rand() % 3;
+        if (action == 0) {
+            Timer rescheduled = {rand() % 100000, id};
+            PriorityQueue_update(pq, handles[id], &rescheduled);
+        } else if (action == 1) {
+            Timer removed;
+            PriorityQueue_remove(pq, handles[id], &removed);
+            ASSERT(removed.id == id, "\nremoved incorrect element in test_push_pop_update. Found: %zu, expected: %zu", removed.id, id);
+            queued[id] = false;
+            nqueued--;
+        } else {
+            Timer * top = PriorityQueue_peek(pq);
+            Timer expired;
+            size_t top_id = top->id;
+            PriorityQueue_pop(pq, &expired);
+            ASSERT(expired.id == top_id, "\npopped element other than the top in test_push_pop_update. Found: %zu, expected: %zu", expired.id, top_id);
+            queued[top_id] = false;
+            nqueued--;
+        }
+    }
+    check_heap(pq, "test_push_pop_update");
+    ASSERT(PriorityQueue_size(pq) == nqueued, "\nfound incorrect size in test_push_pop_update. Found: %zu, expected: %zu", PriorityQueue_size(pq), nqueued);
+
+    check_drain(pq, nqueued, "test_push_pop_update");
+    ASSERT(PriorityQueue_is_empty(pq) && !PriorityQueue_peek(pq), "\nfailed to empty queue in test_push_pop_update");
+
+    PriorityQueue_del(pq);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_heapify(void) {
+    printf("Testing PriorityQueue_new_from_array & PriorityQueue_extend...");
+    static Timer timers[NTIMERS];
+    for (size_t id = 0; id < NTIMERS; id++) {
+        timers[id].deadline = (long) ((id * 7919) % NTIMERS);
+        timers[id].id = id;
+    }
+
+    PriorityQueue * pq = PriorityQueue_new_from_array(timers, NTIMERS, sizeof(Timer), 4, timer_comp);
+    check_heap(pq, "test_heapify");
+    ASSERT(((Timer *) PriorityQueue_peek(pq))->deadline == 0, "\nfailed to find minimum at top in test_heapify. Found: %ld, expected: %d", ((Timer *) PriorityQueue_peek(pq))->deadline, 0);
+
+    // small extend sifts up each new element
+    PriorityQueueHandle handles[10];
+    PriorityQueue_extend(pq, timers, 10, handles);
+    check_heap(pq, "test_heapify");
+    for (size_t i = 0; i < 10; i++) {
+        ASSERT(((Timer *) PriorityQueue_get(pq, handles[i]))->id == i, "\nfound incorrect element for handle from extend in test_heapify at %zu", i);
+    }
+
+    check_drain(pq, NTIMERS + 10, "test_heapify");
+    PriorityQueue_del(pq);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int main(void) {
+    test_push_pop_update(2);
+    test_push_pop_update(4);
+    test_heapify();
+    return 0;
+}
@@ -0,0 +1,207 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cl_core.h"
+#include "cl_radix_tree.h"
+
+#define NKEYS 3000
+#define KEY_LEN 24
+
+static char keys[NKEYS][KEY_LEN];
+
+static int str_comp(const void * a, const void * b) {
+    return strcmp(*(const char **) a, *(const char **) b);
+}
+
+// short keys from a small alphabet share long prefixes and are often prefixes of each other. Some share a prefix
+// longer than RADIX_TREE_MAX_PREFIX
+static void make_keys(void) {
+    for (size_t i = 0; i < NKEYS; i++) {
+        size_t len = 0;
+        if (i % 5 == 0) {
+            len = (size_t) sprintf(keys[i], "/usr/local/share/");
+        }
+        size_t n = 1 + rand() % 5;
+        while (n--) {
+            keys[i][len++] = "abc/"[rand() % 4];
+        }
+        keys[i][len] = '\0';
+    }
+}
+
+// checks parent links and the child counts of each node type. Returns the number of leaves
+static size_t check_node(RadixTreeNode * node, RadixTreeInner * parent, char * test_name) {
+    ASSERT(node->parent == parent, "\nfound incorrect parent link in %s", test_name);
+    if (node->type == RADIX_TREE_LEAF) {
+        return 1;
+    }
+    RadixTreeInner * inner = (RadixTreeInner *) node;
+    RadixTreeNode ** children = NULL;
+    unsigned int n = 0, nchildren = 0;
+    switch (node->type) {
+        case RADIX_TREE_NODE4:
+            children = ((RadixTreeNode4 *) node)->children;
+            n = inner->nchildren;
+            ASSERT(inner->nchildren >= 2 && inner->nchildren <= 4, "\nfound Node4 with %u children in %s", inner->nchildren, test_name);
+            break;
+        case RADIX_TREE_NODE16:
+            children = ((RadixTreeNode16 *) node)->children;
+            n = inner->nchildren;
+            ASSERT(inner->nchildren >= 3 && inner->nchildren <= 16, "\nfound Node16 with %u children in %s", inner->nchildren, test_name);
+            break;
+        case RADIX_TREE_NODE48:
+            children = ((RadixTreeNode48 *) node)->children;
+            n = 48;
+            break;
+        default:
+            children = ((RadixTreeNode256 *) node)->children;
+            n = 256;
+    }
+    size_t leaves = 0;
+    for (unsigned int i = 0; i < n; i++) {
+        if (children[i]) {
+            nchildren++;
+            leaves += check_node(children[i], inner, test_name);
+        }
+    }
+    ASSERT(nchildren == inner->nchildren, "\nfound incorrect child count in %s. Found: %u, expected: %u", test_name, inner->nchildren, nchildren);
+    return leaves;
+}
+
+static void check_tree(RadixTree * rt, char * test_name) {
+    size_t leaves = rt->root ? check_node(rt->root, NULL, test_name) : 0;
+    ASSERT(leaves == RadixTree_size(rt), "\nfound incorrect size in %s. Found: %zu, expected: %zu", test_name, RadixTree_size(rt), leaves);
+}
+
+int test_insert_get_erase(void) {
+    printf("Testing RadixTree_insert, RadixTree_get & RadixTree_erase...");
+    static const char * present[NKEYS];
+    RadixTree * rt = RadixTree_new(0);
+    srand(39);
+    make_keys();
+
+    size_t n = 0;
+    for (size_t i = 0; i < NKEYS; i++) {
+        enum cl_status status = RadixTree_insert(rt, keys[i], keys[i]);
+        void * found = RadixTree_get(rt, keys[i]);
+        if (status == CL_SUCCESS) {
+            present[n++] = keys[i];
+        } else { // duplicate key keeps the first value
+            ASSERT(found != keys[i] && !strcmp(found, keys[i]), "\nfailed to keep first value of duplicate %s in test_insert_get_erase", keys[i]);
+        }
+    }
+    check_tree(rt, "test_insert_get_erase");
+    ASSERT(RadixTree_size(rt) == n, "\nfound incorrect size in test_insert_get_erase. Found: %zu, expected: %zu", RadixTree_size(rt), n);
+    ASSERT(!RadixTree_contains(rt, "/usr/local/share") && !RadixTree_contains(rt, "zzz"), "\nfound absent key in test_insert_get_erase");
+
+    // sorted order
+    qsort(present, n, sizeof(present[0]), str_comp);
+    RadixTreeIterator iter;
+    RadixTreeIterator_init(&iter, rt, NULL);
+    size_t i = 0;
+    for (char * value = RadixTreeIterator_next(&iter); !RadixTreeIterator_stop(&iter); value = RadixTreeIterator_next(&iter)) {
+        ASSERT(i < n && !strcmp(value, present[i]) && !strcmp(RadixTreeIterator_key(&iter), present[i]), "\nfound key out of order in test_insert_get_erase at %zu", i);
+        i++;
+    }
+    ASSERT(i == n, "\nfailed to iterate over all keys in test_insert_get_erase. Found: %zu, expected: %zu", i, n);
+
+    // erase every other key
+    for (i = 0; i < n; i += 2) {
+        ASSERT(RadixTree_erase(rt, present[i]) == CL_SUCCESS, "\nfailed to erase %s in test_insert_get_erase", present[i]);
+    }
+    ASSERT(RadixTree_erase(rt, present[0]) == CL_FAILURE, "\nerased absent key in test_insert_get_erase");
+    check_tree(rt, "test_insert_get_erase");
+    for (i = 0; i < n; i++) {
+        ASSERT(RadixTree_contains(rt, present[i]) == (i % 2 == 1), "\nfound incorrect membership of %s in test_insert_get_erase", present[i]);
+    }
+    for (i = 1; i < n; i += 2) {
+        RadixTree_erase(rt, present[i]);
+    }
+    ASSERT(RadixTree_is_empty(rt) && !rt->root, "\nfailed to empty tree in test_insert_get_erase");
+
+    RadixTree_del(rt);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+// every byte after a shared first byte grows the node through all four types and back
+int test_node_types(void) {
+    printf("Testing RadixTree node growth and shrinking...");
+    static char wide[256][3];
+    RadixTree * rt = RadixTree_new(TREE_MOD_UPDATE);
+    unsigned char types[] = {RADIX_TREE_NODE4, RADIX_TREE_NODE16, RADIX_TREE_NODE48, RADIX_TREE_NODE256};
+    unsigned int limits[] = {4, 16, 48, 255};
+    unsigned int t = 0;
+    for (unsigned int c = 1; c < 256; c++) {
+        wide[c][0] = 'x';
+        wide[c][1] = (char) c;
+        wide[c][2] = '\0';
+        RadixTree_insert(rt, wide[c], wide[c]);
+        if (c >= 2) {
+            while (c > limits[t]) {
+                t++;
+            }
+            ASSERT(rt->root->type == types[t], "\nfound incorrect node type with %u children. Found: %d, expected: %d", c, rt->root->type, types[t]);
+        }
+    }
+    check_tree(rt, "test_node_types");
+    RadixTree_insert(rt, wide[7], wide[8]);
+    ASSERT(RadixTree_get(rt, wide[7]) == wide[8] && RadixTree_size(rt) == 255, "\nfailed to update value in test_node_types");
+    for (unsigned int c = 255; c > 1; c--) {
+        RadixTree_erase(rt, wide[c]);
+        check_tree(rt, "test_node_types");
+    }
+    ASSERT(rt->root->type == RADIX_TREE_LEAF && RadixTree_get(rt, wide[1]) == wide[1], "\nfailed to collapse to a single leaf in test_node_types");
+    RadixTree_del(rt);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_prefixes(void) {
+    printf("Testing RadixTree_longest_prefix & RadixTreeIterator with a prefix...");
+    static char * routes[] = {"/", "/api", "/api/v1", "/api/v1/users", "/api/v2", "/static/img/icons/large", "/static/img/icons/small", "/apiary"};
+    RadixTree * rt = RadixTree_new(0);
+    for (size_t i = 0; i < sizeof(routes) / sizeof(routes[0]); i++) {
+        RadixTree_insert(rt, routes[i], routes[i]);
+    }
+    check_tree(rt, "test_prefixes");
+
+    char * queries[][2] = {{"/api/v1/users/42", "/api/v1/users"}, {"/api/v1/user", "/api/v1"}, {"/api/v3", "/api"}, {"/apiar", "/api"},
+                           {"/apiary", "/apiary"}, {"/static/img/icons/larg", "/"}, {"/static/img/icons/large.png", "/static/img/icons/large"},
+                           {"api", NULL}, {"", NULL}};
+    for (size_t i = 0; i < sizeof(queries) / sizeof(queries[0]); i++) {
+        const char * key = NULL;
+        void * value = RadixTree_longest_prefix(rt, queries[i][0], &key);
+        ASSERT(value == queries[i][1] && key == queries[i][1], "\nfound incorrect longest prefix of \"%s\" in test_prefixes. Found: %s, expected: %s", queries[i][0], key ? key : "NULL", queries[i][1] ? queries[i][1] : "NULL");
+    }
+
+    char * scans[][4] = {{"/api", "/api", "/api/v1", "/api/v1/users"}, {"/api/", "/api/v1", "/api/v1/users", "/api/v2"}, {"/static/img/icons/s", "/static/img/icons/small", NULL, NULL},
+                         {"/static/img/x", NULL, NULL, NULL}, {"/x", NULL, NULL, NULL}};
+    size_t scan_sizes[] = {5, 3, 1, 0, 0};
+    for (size_t i = 0; i < sizeof(scans) / sizeof(scans[0]); i++) {
+        RadixTreeIterator iter;
+        RadixTreeIterator_init(&iter, rt, scans[i][0]);
+        size_t count = 0;
+        for (char * value = RadixTreeIterator_next(&iter); !RadixTreeIterator_stop(&iter); value = RadixTreeIterator_next(&iter)) {
+            ASSERT(!strncmp(value, scans[i][0], strlen(scans[i][0])), "\nfound key %s without prefix %s in test_prefixes", value, scans[i][0]);
+            ASSERT(count >= 3 || value == scans[i][count + 1], "\nfound incorrect key for prefix %s in test_prefixes. Found: %s, expected: %s", scans[i][0], value, scans[i][count + 1]);
+            count++;
+        }
+        ASSERT(count == scan_sizes[i], "\nfound incorrect number of keys with prefix %s in test_prefixes. Found: %zu, expected: %zu", scans[i][0], count, scan_sizes[i]);
+    }
+
+    RadixTree_del(rt);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int main(void) {
+    test_insert_get_erase();
+    test_node_types();
+    test_prefixes();
+    return 0;
+}
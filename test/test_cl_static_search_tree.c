@@ -0,0 +1,83 @@
+#include <stddef.h>
+#include <stdio.h>
+#include "cl_core.h"
+#include "cl_static_search_tree.h"
+
+#define MAX_SIZE 300
+
+int int_comp(const void * a, const void * b) {
+    return (*(int*)a > *(int*)b) - (*(int*)a < *(int*)b);
+}
+
+int test_bounds(void) {
+    printf("Testing StaticSearchTree_lower_bound, StaticSearchTree_upper_bound & StaticSearchTree_find...");
+    int arr[MAX_SIZE];
+
+    for (size_t n = 0; n <= MAX_SIZE; n += (n < 20) ? 1 : 37) {
+        // even values with every fifth repeated
+        for (size_t i = 0; i < n; i++) {
+            arr[i] = 2 * (int) (i - i / 5);
+        }
+        StaticSearchTree * sst = StaticSearchTree_new(arr, n, sizeof(int), int_comp);
+        ASSERT(StaticSearchTree_size(sst) == n, "\nfound incorrect size in test_bounds. Found: %zu, expected: %zu", StaticSearchTree_size(sst), n);
+
+        for (int key = -1; key <= 2 * MAX_SIZE + 1; key++) {
+            size_t lower = 0;
+            while (lower < n && arr[lower] < key) {
+                lower++;
+            }
+            size_t upper = lower;
+            while (upper < n && arr[upper] <= key) {
+                upper++;
+            }
+            int * found = StaticSearchTree_lower_bound(sst, &key);
+            if (lower == n) {
+                ASSERT(!found, "\nfound lower bound past the end in test_bounds for key %d, size %zu", key, n);
+            } else {
+                ASSERT(found && *found == arr[lower], "\nfound incorrect lower bound in test_bounds for key %d, size %zu", key, n);
+            }
+            found = StaticSearchTree_upper_bound(sst, &key);
+            if (upper == n) {
+                ASSERT(!found, "\nfound upper bound past the end in test_bounds for key %d, size %zu", key, n);
+            } else {
+                ASSERT(found && *found == arr[upper], "\nfound incorrect upper bound in test_bounds for key %d, size %zu", key, n);
+            }
+            ASSERT(StaticSearchTree_contains(sst, &key) == (upper > lower), "\nfailed to find key in test_bounds: %d, size %zu", key, n);
+        }
+
+        StaticSearchTree_del(sst);
+    }
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_iterator(void) {
+    printf("Testing StaticSearchTreeIterator...");
+    int arr[MAX_SIZE];
+    for (size_t n = 0; n <= MAX_SIZE; n += (n < 20) ? 1 : 37) {
+        for (size_t i = 0; i < n; i++) {
+            arr[i] = (int) i;
+        }
+        StaticSearchTree * sst = StaticSearchTree_new(arr, n, sizeof(int), int_comp);
+        StaticSearchTreeIterator sst_iter;
+        StaticSearchTreeIterator_init(&sst_iter, sst);
+        int expected = 0;
+        for (int * value = StaticSearchTreeIterator_next(&sst_iter); value; value = StaticSearchTreeIterator_next(&sst_iter)) {
+            ASSERT(*value == expected, "\nfound element out of order in test_iterator. Found: %d, expected: %d", *value, expected);
+            expected++;
+        }
+        ASSERT((size_t) expected == n, "\nfailed to iterate over all elements in test_iterator. Found: %d, expected: %zu", expected, n);
+        ASSERT(StaticSearchTreeIterator_stop(&sst_iter) == ITERATOR_STOP, "\nfailed to stop iterator in test_iterator");
+        StaticSearchTree_del(sst);
+    }
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int main(void) {
+    test_bounds();
+    test_iterator();
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include <stddef.h>
+#include <stdio.h>
+#include "cl_core.h"
+#include "cl_xor_linked_list.h"
+
+int long_comp(void * a, void * b) {
+    return (*(long*)a > *(long*)b) - (*(long*)a < *(long*)b);
+}
+
+int test_push_pop_peek(void) {
+    printf("Testing XorLinkedList_push*, XorLinkedList_pop* & XorLinkedList_peek*...");
+    long arr[] = {123456, 234567, 345678, 456789, 567890, 2039784};
+    size_t arr_size = sizeof(arr)/sizeof(arr[0]);
+
+    XorLinkedList * xll = XorLinkedList_new(0, 0);
+
+    for (size_t i = 0; i < arr_size; i++) {
+        XorLinkedList_push_back(xll, &arr[i]);
+        ASSERT(XorLinkedList_size(xll) == i+1, "\nfailed to increment size of XorLinkedList after push back in test_push_pop_peek. Found: %zu, expected: %zu", XorLinkedList_size(xll), i+1);
+        long retrieved = *(long*)XorLinkedList_peek_front(xll);
+        ASSERT(retrieved == arr[0], "\nfailed to retrieve first element after pushing back in test_push_pop_peek. Found: %ld, expected: %ld", retrieved, arr[0]);
+        retrieved = *(long*)XorLinkedList_peek_back(xll);
+        ASSERT(retrieved == arr[i], "\nfailed to retrieve last element after pushing back in test_push_pop_peek. Found: %ld, expected: %ld", retrieved, arr[i]);
+    }
+    for (size_t i = 0; i < arr_size; i++) {
+        long retrieved = *(long*)XorLinkedList_get(xll, i);
+        ASSERT(retrieved == arr[i], "\nfailed to get element %zu in test_push_pop_peek. Found: %ld, expected: %ld", i, retrieved, arr[i]);
+    }
+
+    for (size_t i = arr_size; i > 0; i--) {
+        long retrieved = *(long*)XorLinkedList_pop_back(xll);
+        ASSERT(XorLinkedList_size(xll) == i-1, "\nfailed to decrement size of XorLinkedList after pop back in test_push_pop_peek. Found: %zu, expected: %zu", XorLinkedList_size(xll), i-1);
+        ASSERT(retrieved == arr[i-1], "\nfailed to retrieve element after pop back in test_push_pop_peek. Found: %ld, expected: %ld", retrieved, arr[i-1]);
+    }
+    ASSERT(!XorLinkedList_peek_front(xll) && !XorLinkedList_peek_back(xll), "\nfailed to find NULL at the ends of an empty XorLinkedList in test_push_pop_peek");
+
+    for (size_t i = 0; i < arr_size; i++) {
+        XorLinkedList_push_front(xll, &arr[i]);
+        long retrieved = *(long*)XorLinkedList_get(xll, 0);
+        ASSERT(retrieved == arr[i], "\nfailed to retrieve element after pushing front in test_push_pop_peek. Found: %ld, expected: %ld", retrieved, arr[i]);
+    }
+
+    for (size_t i = arr_size; i > 0; i--) {
+        long retrieved = *(long*)XorLinkedList_pop_front(xll);
+        ASSERT(retrieved == arr[i-1], "\nfailed to retrieve element after pop front in test_push_pop_peek. Found: %ld, expected: %ld", retrieved, arr[i-1]);
+    }
+    ASSERT(XorLinkedList_is_empty(xll), "\nfailed to empty XorLinkedList in test_push_pop_peek");
+
+    XorLinkedList_del(xll);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_insert_remove_reverse(void) {
+    printf("Testing XorLinkedList_insert, XorLinkedList_remove, XorLinkedList_reverse & iteration...");
+    long arr[] = {0, 1, 2, 3, 4, 5, 6, 7};
+    long expected[] = {0, 2, 3, 4, 6, 7};
+    size_t arr_size = sizeof(arr)/sizeof(arr[0]);
+    size_t expected_size = sizeof(expected)/sizeof(expected[0]);
+
+    XorLinkedList * xll = XorLinkedList_new(0, 0);
+    // build out of order through inserts in the middle
+    XorLinkedList_push_back(xll, &arr[0]);
+    XorLinkedList_push_back(xll, &arr[7]);
+    for (size_t i = 1; i < arr_size - 1; i++) {
+        XorLinkedList_insert(xll, i, &arr[i]);
+    }
+    size_t i = 0;
+    for_each(long, val, XorLinkedList, xll) {
+        ASSERT(*val == arr[i], "\nfailed to retrieve the %zu-th element after inserts in test_insert_remove_reverse. Found: %ld, expected: %ld", i, *val, arr[i]);
+        i++;
+    }
+    ASSERT(i == arr_size, "\nfailed to iterate over all elements in test_insert_remove_reverse. Found: %zu, expected: %zu", i, arr_size);
+
+    long * removed = XorLinkedList_remove(xll, 5);
+    ASSERT(*removed == 5, "\nfailed to remove the correct element in test_insert_remove_reverse. Found: %ld, expected: 5", *removed);
+    removed = XorLinkedList_remove(xll, 1);
+    ASSERT(*removed == 1, "\nfailed to remove the correct element in test_insert_remove_reverse. Found: %ld, expected: 1", *removed);
+
+    long key = 6;
+    ASSERT(XorLinkedList_find(xll, &key, long_comp) == &arr[6], "\nfailed to find element in test_insert_remove_reverse");
+    key = 5;
+    ASSERT(!XorLinkedList_contains(xll, &key, long_comp), "\nfound removed element in test_insert_remove_reverse");
+
+    XorLinkedList_reverse(xll);
+    i = expected_size;
+    for_each(long, rval, XorLinkedList, xll) {
+        i--;
+        ASSERT(*rval == expected[i], "\nfailed to retrieve the %zu-th element after reversal in test_insert_remove_reverse. Found: %ld, expected: %ld", i, *rval, expected[i]);
+    }
+    ASSERT(i == 0, "\nfailed to iterate over all elements after reversal in test_insert_remove_reverse. %zu remaining", i);
+
+    XorLinkedList * other = XorLinkedList_new(0, 0);
+    XorLinkedList_push_back(other, &arr[1]);
+    XorLinkedList_push_back(other, &arr[5]);
+    XorLinkedList_extend(xll, other);
+    ASSERT(XorLinkedList_size(xll) == expected_size + 2, "\nfailed to extend XorLinkedList in test_insert_remove_reverse. Found: %zu, expected: %zu", XorLinkedList_size(xll), expected_size + 2);
+    ASSERT(*(long*)XorLinkedList_peek_back(xll) == 5 && *(long*)XorLinkedList_get(xll, expected_size) == 1, "\nfailed to find extended elements in test_insert_remove_reverse");
+
+    XorLinkedList_del(other);
+    XorLinkedList_del(xll);
+
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_next_n(void) {
+    printf("Testing XorLinkedListIterator_next_n...");
+    long arr[] = {123456, 234567, 345678, 456789, 567890, 2039784, 1230987};
+    size_t arr_size = sizeof(arr)/sizeof(arr[0]);
+    void * buf[4];
+
+    XorLinkedList * xll = XorLinkedList_new(0, 0);
+    for (size_t i = 0; i < arr_size; i++) {
+        XorLinkedList_push_back(xll, &arr[i]);
+    }
+    for (size_t batch = 1; batch <= 4; batch++) {
+        XorLinkedListIterator xll_iter;
+        XorLinkedListIterator_init(&xll_iter, xll);
+        long * l = XorLinkedListIterator_next(&xll_iter);
+        ASSERT(*l == arr[0], "\nfound wrong first element in test_next_n. Found: %ld, expected: %ld", *l, arr[0]);
+        size_t i = 1, n;
+        do {
+            n = XorLinkedListIterator_next_n(&xll_iter, buf, batch);
+            for (size_t j = 0; j < n; j++, i++) {
+                ASSERT(*(long*)buf[j] == arr[i], "\nfound wrong element %zu in test_next_n. Found: %ld, expected: %ld", i, *(long*)buf[j], arr[i]);
+            }
+        } while (n == batch);
+        ASSERT(i == arr_size && XorLinkedListIterator_stop(&xll_iter) == ITERATOR_STOP, "\nfound wrong number of elements in test_next_n. Found: %zu, expected: %zu", i, arr_size);
+    }
+
+    XorLinkedList_del(xll);
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int test_advance(void) {
+    printf("Testing XorLinkedListIterator_advance...");
+    long arr[] = {123456, 234567, 345678, 456789, 567890, 2039784, 1230987};
+    size_t arr_size = sizeof(arr)/sizeof(arr[0]);
+
+    XorLinkedList * xll = XorLinkedList_new(0, 0);
+    for (size_t i = 0; i < arr_size; i++) {
+        XorLinkedList_push_back(xll, &arr[i]);
+    }
+    for (size_t k = 0; k <= arr_size; k++) {
+        XorLinkedListIterator xll_iter;
+        XorLinkedListIterator_init(&xll_iter, xll);
+        XorLinkedListIterator_next(&xll_iter);
+        size_t skipped = XorLinkedListIterator_advance(&xll_iter, k);
+        size_t expected = k < arr_size - 1 ? k : arr_size - 1;
+        ASSERT(skipped == expected, "\nfound wrong number of skipped elements in test_advance. Found: %zu, expected: %zu", skipped, expected);
+        long * l = XorLinkedListIterator_next(&xll_iter);
+        if (1 + k < arr_size) {
+            ASSERT(l && *l == arr[1 + k], "\nfound wrong element after advancing %zu in test_advance", k);
+            // the links must still be followed correctly after skipping
+            size_t i = 2 + k;
+            for (l = XorLinkedListIterator_next(&xll_iter); XorLinkedListIterator_stop(&xll_iter) != ITERATOR_STOP; l = XorLinkedListIterator_next(&xll_iter), i++) {
+                ASSERT(*l == arr[i], "\nfound wrong element %zu after advancing %zu in test_advance. Found: %ld, expected: %ld", i, k, *l, arr[i]);
+            }
+            ASSERT(i == arr_size, "\nfound wrong number of elements after advancing %zu in test_advance", k);
+        } else {
+            ASSERT(!l && XorLinkedListIterator_stop(&xll_iter) == ITERATOR_STOP, "\nfound element past the end after advancing %zu in test_advance", k);
+        }
+    }
+
+    XorLinkedList_del(xll);
+    printf("PASS\n");
+    return CL_SUCCESS;
+}
+
+int main(void) {
+    test_push_pop_peek();
+    test_insert_remove_reverse();
+    test_next_n();
+    test_advance();
+    return 0;
+}